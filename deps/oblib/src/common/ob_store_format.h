@@ -20,7 +20,7 @@
 namespace oceanbase {
 namespace common {
 
-enum ObRowStoreType { FLAT_ROW_STORE = 0, RESERVED_ROW_STORE = 1, SPARSE_ROW_STORE = 2, MAX_ROW_STORE };
+enum ObRowStoreType { FLAT_ROW_STORE = 0, ENCODING_ROW_STORE = 1, SPARSE_ROW_STORE = 2, MAX_ROW_STORE };
 
 enum ObStoreFormatType {
   OB_STORE_FORMAT_INVALID = 0,
@@ -59,7 +59,7 @@ class ObStoreFormat {
   public:
   static inline bool is_row_store_type_valid(const ObRowStoreType type)
   {
-    return type == FLAT_ROW_STORE || type == SPARSE_ROW_STORE;
+    return type == FLAT_ROW_STORE || type == ENCODING_ROW_STORE || type == SPARSE_ROW_STORE;
   }
   static inline const char* get_row_store_name(const ObRowStoreType type)
   {
@@ -1021,6 +1021,123 @@ int ObIOBenchmark::benchmark(const char* data_dir, const int64_t file_size, cons
   return ret;
 }
 
+int ObIOBenchmark::compare_io_backends(const char* data_dir, const int64_t file_size, const int32_t thread_cnt,
+    ObIArray<ObIOBenchResult>& aio_results, ObIArray<ObIOBenchResult>& uring_results)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObDiskFd fd;
+  fd.disk_id_.disk_idx_ = 0;
+  fd.disk_id_.install_seq_ = 0;
+  char data_file_path[MAX_BENCHMARK_FILE_PATH_LEN + 1];
+  MEMSET(data_file_path, 0, sizeof(data_file_path));
+  const ObIOConfig saved_conf = ObIOManager::get_instance().get_io_config();
+  const int32_t runner_thread_cnt = MAX(thread_cnt, FILL_FILE_THREAD_CNT);
+  int n = 0;
+
+  if (OB_ISNULL(data_dir) || file_size <= 0 || thread_cnt <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(data_dir), K(file_size), K(thread_cnt));
+  } else if (!ObIOUring::is_supported()) {
+    ret = OB_NOT_SUPPORTED;
+    COMMON_LOG(WARN, "io_uring is not supported, can not compare io backends", K(ret));
+  } else if ((n = snprintf(data_file_path, MAX_BENCHMARK_FILE_PATH_LEN, "%s/bench_file", data_dir)) <= 0 ||
+             n >= MAX_BENCHMARK_FILE_PATH_LEN) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "The data dir is too long, ", K(data_dir), K(ret));
+  } else if ((fd.fd_ = ::open(
+                  data_file_path, O_CREAT | O_TRUNC | O_DIRECT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)) < 0) {
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "open file error", K(data_file_path), K(errno), KERRMSG, K(ret));
+  } else if (OB_FAIL(FALLOCATE(fd.fd_, 0 /*MODE*/, 0 /*offset*/, file_size))) {
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "allocate file error", K(data_file_path), K(file_size), K(errno), KERRMSG, K(ret));
+  } else if (OB_FAIL(ObIOManager::get_instance().add_disk(fd))) {
+    COMMON_LOG(WARN, "add_disk failed", K(ret), K(fd));
+  } else {
+    ObIORunner runner;
+    if (OB_FAIL(runner.init(fd, file_size, runner_thread_cnt))) {
+      COMMON_LOG(WARN, "failed to init runner", K(ret));
+    } else if (OB_FAIL(fill_file(runner, FILL_FILE_THREAD_CNT))) {
+      COMMON_LOG(WARN, "failed to fill file", K(ret));
+    } else if (OB_FAIL(bench_io_backend(runner, fd, IO_BACKEND_LIBAIO, thread_cnt, aio_results))) {
+      COMMON_LOG(WARN, "failed to benchmark libaio", K(ret));
+    } else if (OB_FAIL(bench_io_backend(runner, fd, IO_BACKEND_IO_URING, thread_cnt, uring_results))) {
+      COMMON_LOG(WARN, "failed to benchmark io_uring", K(ret));
+    } else {
+      for (int64_t i = 0; i < aio_results.count() && i < uring_results.count(); ++i) {
+        COMMON_LOG(INFO,
+            "io backend benchmark",
+            "workload",
+            aio_results.at(i).workload_,
+            "aio_rt",
+            aio_results.at(i).rt_,
+            "uring_rt",
+            uring_results.at(i).rt_,
+            "aio_iops",
+            aio_results.at(i).iops_,
+            "uring_iops",
+            uring_results.at(i).iops_);
+      }
+    }
+    if (OB_SUCCESS != (tmp_ret = ObIOManager::get_instance().delete_disk(fd))) {
+      COMMON_LOG(WARN, "delete_disk failed", K(tmp_ret), K(fd));
+    }
+  }
+  if (OB_SUCCESS != (tmp_ret = ObIOManager::get_instance().set_io_config(saved_conf))) {
+    COMMON_LOG(WARN, "failed to restore io config", K(tmp_ret), K(saved_conf));
+  }
+
+  if (fd.is_valid()) {
+    // clean benchmark test file
+    if (0 != ::close(fd.fd_)) {
+      COMMON_LOG(WARN, "data file close error", K(errno), KERRMSG);
+    }
+    if (OB_SUCCESS != (tmp_ret = FileDirectoryUtils::delete_file(data_file_path))) {
+      COMMON_LOG(WARN, "failed to delete iops_data", K(tmp_ret));
+    }
+  }
+  return ret;
+}
+
+// re-add the disk with the given backend, then run all read workloads
+int ObIOBenchmark::bench_io_backend(ObIORunner& runner, const ObDiskFd& fd, const ObIOBackend backend,
+    const int32_t thread_cnt, ObIArray<ObIOBenchResult>& results)
+{
+  int ret = OB_SUCCESS;
+  ObIOConfig io_conf = ObIOManager::get_instance().get_io_config();
+  io_conf.io_backend_ = backend;
+  results.reuse();
+  if (OB_FAIL(ObIOManager::get_instance().set_io_config(io_conf))) {
+    COMMON_LOG(WARN, "failed to set io config", K(ret), K(io_conf));
+  } else if (OB_FAIL(ObIOManager::get_instance().delete_disk(fd))) {
+    COMMON_LOG(WARN, "delete_disk failed", K(ret), K(fd));
+  } else if (OB_FAIL(ObIOManager::get_instance().add_disk(fd, ObDisk::DEFAULT_SYS_IO_PERCENT))) {
+    COMMON_LOG(WARN, "add_disk failed", K(ret), K(fd), K(backend));
+  } else {
+    const int64_t wl_cnt = sizeof(WORKLOADS) / sizeof(ObIOWorkload);
+    ObIOBenchResult result;
+    ObIOBenchResult cur_result;
+    for (int64_t i = 0; OB_SUCC(ret) && i < wl_cnt; ++i) {
+      result.reset();
+      result.workload_ = WORKLOADS[i];
+      if (IO_MODE_READ != WORKLOADS[i].mode_) {
+        // skip
+      } else if (OB_FAIL(find_min_rt(runner, WORKLOADS[i], result.rt_))) {
+        COMMON_LOG(WARN, "failed to get min rt", K(WORKLOADS[i]), K(ret));
+      } else if (OB_FAIL(runner.run_test(thread_cnt, WORKLOADS[i], cur_result))) {
+        COMMON_LOG(WARN, "failed to run test", K(ret), K(thread_cnt), K(WORKLOADS[i]));
+      } else {
+        result.iops_ = cur_result.iops_;
+        if (OB_FAIL(results.push_back(result))) {
+          COMMON_LOG(WARN, "failed to push result", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObIOBenchmark::get_min_rt(ObIOMode mode, const int64_t io_size, double& rt)
 {
   int ret = OB_SUCCESS;
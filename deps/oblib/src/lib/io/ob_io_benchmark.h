@@ -208,6 +208,13 @@ class ObIOBenchmark {
   int init(const char* conf_dir, const char* data_dir = NULL, const int64_t file_size = DEFAULT_BENCHMARK_FILE_SIZE,
       const int32_t max_thread_cnt = DEFAULT_MAX_THREAD_CNT);
   void destroy();
+  /**
+   * Run the read workloads on data_dir with libaio and io_uring in turn, to compare the io backends.
+   * rt_ of result is measured by single thread, and iops_ is measured by thread_cnt threads.
+   * Return OB_NOT_SUPPORTED if io_uring is not available.
+   */
+  int compare_io_backends(const char* data_dir, const int64_t file_size, const int32_t thread_cnt,
+      ObIArray<ObIOBenchResult>& aio_results, ObIArray<ObIOBenchResult>& uring_results);
   int get_min_rt(ObIOMode mode, const int64_t io_size, double& rt);
   int get_max_iops(ObIOMode mode, const int64_t io_size, double& iops);
   int get_submit_thread_cnt(int64_t& submit_thread_cnt);
@@ -225,6 +232,8 @@ class ObIOBenchmark {
   ObIOBenchmark();
   virtual ~ObIOBenchmark();
   int benchmark(const char* data_dir, const int64_t file_size, const int32_t max_thread_cnt);
+  int bench_io_backend(ObIORunner& runner, const ObDiskFd& fd, const ObIOBackend backend, const int32_t thread_cnt,
+      ObIArray<ObIOBenchResult>& results);
   int fill_file(ObIORunner& runner, const int32_t max_thread_cnt);
   int find_max_iops(
       ObIORunner& runner, const int start_thread_cnt, const ObIOWorkload& workload, int& res_thread_cnt, double& iops);
@@ -156,6 +156,8 @@ void ObIOConfig::set_default_value()
   callback_thread_count_ = DEFAULT_IO_CALLBACK_THREAD_COUNT;
   large_query_io_percent_ = DEFAULT_LARGE_QUERY_IO_PERCENT;
   data_storage_io_timeout_ms_ = DEFAULT_DATA_STORAGE_IO_TIMEOUT_MS;
+  io_backend_ = IO_BACKEND_LIBAIO;
+  enable_io_uring_sqpoll_ = false;
 }
 
 bool ObIOConfig::is_valid() const
@@ -166,7 +168,7 @@ bool ObIOConfig::is_valid() const
          retry_warn_limit_ > 0 && retry_error_limit_ > retry_warn_limit_ && disk_io_thread_count_ > 0 &&
          disk_io_thread_count_ <= ObDisk::MAX_DISK_CHANNEL_CNT * 2 && disk_io_thread_count_ % 2 == 0 &&
          callback_thread_count_ > 0 && large_query_io_percent_ >= 0 && large_query_io_percent_ <= 100 &&
-         data_storage_io_timeout_ms_ > 0;
+         data_storage_io_timeout_ms_ > 0 && io_backend_ >= IO_BACKEND_LIBAIO && io_backend_ < IO_BACKEND_MAX;
 }
 
 void ObIOConfig::reset()
@@ -183,6 +185,8 @@ void ObIOConfig::reset()
   callback_thread_count_ = 0;
   large_query_io_percent_ = 0;
   data_storage_io_timeout_ms_ = 0;
+  io_backend_ = IO_BACKEND_LIBAIO;
+  enable_io_uring_sqpoll_ = false;
 }
 
 /**
@@ -377,7 +381,8 @@ bool ObIOQueue::ObIORequestCmp::operator()(const ObIORequest* a, const ObIOReque
 /**
  * ------------------------------------- ObIOChannel ------------------------------------
  */
-ObIOChannel::ObIOChannel() : inited_(false), context_(), submit_cnt_(0), can_submit_request_(true)
+ObIOChannel::ObIOChannel()
+    : inited_(false), backend_(IO_BACKEND_LIBAIO), context_(), ring_(), submit_cnt_(0), can_submit_request_(true)
 {}
 
 ObIOChannel::~ObIOChannel()
@@ -385,21 +390,28 @@ ObIOChannel::~ObIOChannel()
   destroy();
 }
 
-int ObIOChannel::init(const int32_t queue_depth)
+int ObIOChannel::init(const int32_t queue_depth, const ObIOBackend backend, const bool enable_sqpoll,
+    const struct iovec* fixed_bufs, const int64_t fixed_buf_cnt)
 {
   int ret = OB_SUCCESS;
   int io_ret = 0;
   if (inited_) {
     ret = OB_INIT_TWICE;
     COMMON_LOG(WARN, "The ObIOChannel has been inited, ", K(ret));
-  } else if (queue_depth <= 0) {
+  } else if (queue_depth <= 0 || backend < IO_BACKEND_LIBAIO || backend >= IO_BACKEND_MAX || fixed_buf_cnt < 0) {
     ret = OB_INVALID_ARGUMENT;
-    COMMON_LOG(WARN, "invalid argument", K(ret), K(queue_depth));
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(queue_depth), K(backend), K(fixed_buf_cnt));
   } else if (OB_FAIL(queue_cond_.init(ObWaitEventIds::IO_QUEUE_LOCK_WAIT))) {
     COMMON_LOG(WARN, "Fail to init queue condition, ", K(ret));
   } else if (OB_FAIL(queue_.init(queue_depth))) {
     COMMON_LOG(WARN, "Fail to init io queue, ", K(ret));
+  } else if (IO_BACKEND_IO_URING == backend && OB_SUCCESS == init_io_uring(enable_sqpoll, fixed_bufs, fixed_buf_cnt)) {
+    backend_ = IO_BACKEND_IO_URING;
+    submit_cnt_ = 0;
+    can_submit_request_ = true;
+    inited_ = true;
   } else {
+    backend_ = IO_BACKEND_LIBAIO;
     MEMSET(&context_, 0, sizeof(context_));
     if (0 != (io_ret = ob_io_setup(MAX_AIO_EVENT_CNT, &context_))) {
       ret = OB_IO_ERROR;
@@ -417,9 +429,28 @@ int ObIOChannel::init(const int32_t queue_depth)
   return ret;
 }
 
+int ObIOChannel::init_io_uring(const bool enable_sqpoll, const struct iovec* fixed_bufs, const int64_t fixed_buf_cnt)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  if (OB_FAIL(ring_.init(MAX_AIO_EVENT_CNT, enable_sqpoll))) {
+    COMMON_LOG(WARN, "fail to init io uring, fallback to libaio", K(ret), K(enable_sqpoll));
+  } else if (NULL != fixed_bufs && fixed_buf_cnt > 0 &&
+             OB_SUCCESS != (tmp_ret = ring_.register_buffers(fixed_bufs, fixed_buf_cnt))) {
+    // io can be done without fixed buffers
+    COMMON_LOG(WARN, "fail to register fixed buffers, io uring works without them", K(tmp_ret), K(fixed_buf_cnt));
+  }
+  return ret;
+}
+
 void ObIOChannel::destroy()
 {
-  ob_io_destroy(context_);
+  if (IO_BACKEND_IO_URING == backend_) {
+    ring_.destroy();
+  } else {
+    ob_io_destroy(context_);
+  }
+  backend_ = IO_BACKEND_LIBAIO;
   MEMSET(&context_, 0, sizeof(context_));
   submit_cnt_ = 0;
   can_submit_request_ = false;
@@ -463,11 +494,22 @@ int ObIOChannel::enqueue_request(ObIORequest& req)
 }
 
 int ObIOChannel::dequeue_request(ObIORequest*& req)
+{
+  int64_t req_cnt = 0;
+  return dequeue_requests(&req, 1, req_cnt);
+}
+
+// pop at most %max_cnt requests, returns the error of the first pop if no request is popped
+int ObIOChannel::dequeue_requests(ObIORequest** reqs, const int64_t max_cnt, int64_t& req_cnt)
 {
   int ret = OB_SUCCESS;
+  req_cnt = 0;
   if (!inited_) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "not init", K(ret));
+  } else if (OB_ISNULL(reqs) || max_cnt <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(reqs), K(max_cnt));
   } else {
     ObThreadCondGuard cond_guard(queue_cond_);
     const int64_t timeout_us = get_pop_wait_timeout(queue_.get_deadline());
@@ -480,17 +522,28 @@ int ObIOChannel::dequeue_request(ObIORequest*& req)
         COMMON_LOG(ERROR, "fail to wait queue condition", K(ret));
       }
     }
+    int64_t pop_cnt = max_cnt;
     if (OB_SUCC(ret)) {
-      if (ATOMIC_LOAD(&submit_cnt_) >= MAX_AIO_EVENT_CNT) {
+      const int64_t submit_cnt = ATOMIC_LOAD(&submit_cnt_);
+      if (submit_cnt >= MAX_AIO_EVENT_CNT) {
         ret = OB_EAGAIN;
         if (TC_REACH_TIME_INTERVAL(60 * 1000 * 1000)) {
           COMMON_LOG(
               INFO, "There are too many submit io request!", K_(submit_cnt), "queue_size", queue_.get_req_count());
         }
+      } else {
+        pop_cnt = MIN(max_cnt, MAX_AIO_EVENT_CNT - submit_cnt);
       }
     }
-    if (OB_SUCC(ret)) {
-      ret = queue_.pop(req);
+    while (OB_SUCC(ret) && req_cnt < pop_cnt) {
+      if (OB_FAIL(queue_.pop(reqs[req_cnt]))) {
+        if (req_cnt > 0) {
+          ret = OB_SUCCESS;
+          break;
+        }
+      } else {
+        ++req_cnt;
+      }
     }
   }
   return ret;
@@ -562,6 +615,8 @@ void ObIOChannel::submit()
     if (OB_SUCC(ret) && !can_submit_request_) {
       clear_all_requests();
     }
+  } else if (IO_BACKEND_IO_URING == backend_) {
+    submit_batch();
   } else {
     if (OB_FAIL(dequeue_request(req))) {
       if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
@@ -592,6 +647,50 @@ void ObIOChannel::submit()
   }
 }
 
+// pop a batch of requests and submit them to io_uring with one system call
+void ObIOChannel::submit_batch()
+{
+  int ret = OB_SUCCESS;
+  ObIORequest* reqs[MAX_SUBMIT_BATCH_CNT];
+  int64_t req_cnt = 0;
+  if (OB_FAIL(dequeue_requests(reqs, MAX_SUBMIT_BATCH_CNT, req_cnt))) {
+    if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      COMMON_LOG(WARN, "Fail to pop io requests from disk, ", K(ret));
+    }
+  }
+  for (int64_t i = 0; i < req_cnt; ++i) {
+    ObIORequest* req = reqs[i];
+    if (OB_ISNULL(req)) {
+      COMMON_LOG(WARN, "req is null", K(i), K(req_cnt));
+    } else {
+      MasterHolder master_holder(req->master_);
+      DiskHolder disk_holder(req->get_disk());
+      ObCurTraceId::TraceId saved_trace_id = *ObCurTraceId::get_trace_id();
+      ObCurTraceId::set(req->master_->get_trace_id());
+      req->channel_ = this;
+      int sys_ret = 0;
+      if (OB_FAIL(inner_submit(*req, sys_ret))) {
+        if (OB_CANCELED != ret) {
+          COMMON_LOG(WARN, "fail to inner submit req", K(ret), K(sys_ret));
+        }
+        req->finish(ret, sys_ret);
+      } else {
+        // the request is not visible to kernel until ring is submitted, so it is safe to inc ref here
+        req->get_disk()->inc_ref();
+      }
+      ObCurTraceId::set(saved_trace_id);
+    }
+  }
+  // also flush the requests left by last submission
+  if (OB_FAIL(ring_.submit())) {
+    if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      COMMON_LOG(ERROR, "Fail to submit io uring, ", K(ret), K(req_cnt));
+    }
+  }
+}
+
 int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
 {
   int ret = OB_SUCCESS;
@@ -614,9 +713,18 @@ int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
       req.io_time_.os_submit_time_ = ObTimeUtility::current_time();
       ATOMIC_INC(&submit_cnt_);
 
-      struct iocb* iocbp = &(req.iocb_);
-      if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
-        ret = OB_IO_ERROR;
+      if (IO_BACKEND_IO_URING == backend_) {
+        // only prepared here, submitted in batch by caller
+        const bool is_read = (IO_CMD_PREAD == req.iocb_.aio_lio_opcode);
+        if (OB_FAIL(ring_.prep_rw(is_read, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_, &req))) {
+          sys_ret = OB_EAGAIN == ret ? -EAGAIN : -EIO;
+          ret = OB_IO_ERROR;
+        }
+      } else {
+        struct iocb* iocbp = &(req.iocb_);
+        if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
+          ret = OB_IO_ERROR;
+        }
       }
 
       if (OB_FAIL(ret)) {
@@ -634,11 +742,10 @@ void ObIOChannel::get_events()
 {
   int ret = OB_SUCCESS;
   static __thread io_event events[MAX_AIO_EVENT_CNT];
-  int32_t event_cnt = 0;
-  int32_t finish_cnt = 0;
+  static __thread ObIOUringEvent uring_events[MAX_AIO_EVENT_CNT];
+  int64_t event_cnt = 0;
   ObIORequest* req = NULL;
   int64_t io_finish_time = 0;
-  MEMSET(events, 0, sizeof(events));
   struct timespec timeout;
   timeout.tv_sec = 0;
   timeout.tv_nsec = AIO_TIMEOUT_NS;
@@ -646,63 +753,83 @@ void ObIOChannel::get_events()
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObIOChannel has not been inited, ", K(ret));
-  } else {
-    event_cnt = ob_io_getevents(context_, 1, MAX_AIO_EVENT_CNT, events, &timeout);
-  }
-  if (OB_SUCC(ret) && event_cnt > 0) {
-    io_finish_time = ObTimeUtility::current_time();
-    finish_cnt = event_cnt;
-    for (int64_t i = 0; i < event_cnt; ++i) {
-      req = reinterpret_cast<ObIORequest*>(events[i].data);
-      if (OB_ISNULL(req)) {
-        ret = OB_ERR_UNEXPECTED;
-        COMMON_LOG(WARN, "req is null", K(ret));
-        continue;
-      }
-      const int system_errno = -static_cast<int>(events[i].res);
-      const int32_t complete_size = static_cast<int32_t>(events[i].res);
-      const int32_t res2 = static_cast<int32_t>(events[i].res2);
-
-      req->io_time_.os_return_time_ = io_finish_time;
-      if (0 == res2 && req->io_size_ == complete_size) {  // io full complete
-        COMMON_LOG(DEBUG, "Success to get io event, ", K(*req), K(complete_size), K(res2));
-        finish_flying_req(*req, OB_SUCCESS, 0);
-      } else if (0 == res2 && complete_size > 0 && complete_size < req->io_size_ &&
-                 (0 == complete_size % DIO_READ_ALIGN_SIZE)) {  // io partial complete, retry the left part
-        COMMON_LOG(WARN, "Partial execute io request, ", K(*req), K(complete_size), K(res2));
-        req->io_buf_ = req->io_buf_ + complete_size;
-        req->io_size_ -= complete_size;
-        req->io_offset_ += complete_size;
-
-        if (IO_CMD_PREAD == req->iocb_.aio_lio_opcode) {
-          io_prep_pread(&req->iocb_, req->fd_.fd_, req->io_buf_, req->io_size_, req->io_offset_);
+  } else if (IO_BACKEND_IO_URING == backend_) {
+    // completions are reaped from the shared ring, no system call if any io has completed
+    if (OB_FAIL(ring_.get_events(uring_events, MAX_AIO_EVENT_CNT, AIO_TIMEOUT_NS, event_cnt))) {
+      event_cnt = -1;
+    } else if (event_cnt > 0) {
+      io_finish_time = ObTimeUtility::current_time();
+      for (int64_t i = 0; i < event_cnt; ++i) {
+        if (OB_ISNULL(req = reinterpret_cast<ObIORequest*>(uring_events[i].data_))) {
+          ret = OB_ERR_UNEXPECTED;
+          COMMON_LOG(WARN, "req is null", K(ret));
         } else {
-          io_prep_pwrite(&req->iocb_, req->fd_.fd_, req->io_buf_, req->io_size_, req->io_offset_);
+          // io_uring reports error as negative res, always pass 0 as res2
+          handle_event(*req, uring_events[i].res_, 0, io_finish_time);
         }
-        req->iocb_.data = req;
-
-        int sys_ret = 0;
-        if (OB_SUCC(inner_submit(*req, sys_ret))) {
-          --finish_cnt;
+      }
+    }
+  } else {
+    MEMSET(events, 0, sizeof(events));
+    event_cnt = ob_io_getevents(context_, 1, MAX_AIO_EVENT_CNT, events, &timeout);
+    if (event_cnt > 0) {
+      io_finish_time = ObTimeUtility::current_time();
+      for (int64_t i = 0; i < event_cnt; ++i) {
+        if (OB_ISNULL(req = reinterpret_cast<ObIORequest*>(events[i].data))) {
+          ret = OB_ERR_UNEXPECTED;
+          COMMON_LOG(WARN, "req is null", K(ret));
         } else {
-          finish_flying_req(*req, OB_IO_ERROR, sys_ret);
+          handle_event(*req, events[i].res, events[i].res2, io_finish_time);
         }
-      } else {  // io failed
-        // first print error log
-        COMMON_LOG(ERROR, "Fail to execute io request, ", K(*req), K(complete_size), K(res2));
-        // then notify
-        finish_flying_req(*req, OB_IO_ERROR, system_errno);
       }
-      ATOMIC_DEC(&submit_cnt_);
     }
   }
   // ignore failure
   ret = OB_SUCCESS;
   if (event_cnt < 0) {  // get event failed
     if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
-      COMMON_LOG(ERROR, "Fail to get io events, ", "errno", event_cnt);
+      COMMON_LOG(ERROR, "Fail to get io events, ", "errno", event_cnt, K_(backend));
+    }
+  }
+}
+
+void ObIOChannel::handle_event(ObIORequest& req, const int64_t res, const int64_t res2, const int64_t io_finish_time)
+{
+  const int system_errno = -static_cast<int>(res);
+  const int32_t complete_size = static_cast<int32_t>(res);
+
+  req.io_time_.os_return_time_ = io_finish_time;
+  if (0 == res2 && req.io_size_ == complete_size) {  // io full complete
+    COMMON_LOG(DEBUG, "Success to get io event, ", K(req), K(complete_size), K(res2));
+    finish_flying_req(req, OB_SUCCESS, 0);
+  } else if (0 == res2 && complete_size > 0 && complete_size < req.io_size_ &&
+             (0 == complete_size % DIO_READ_ALIGN_SIZE)) {  // io partial complete, retry the left part
+    COMMON_LOG(WARN, "Partial execute io request, ", K(req), K(complete_size), K(res2));
+    req.io_buf_ = req.io_buf_ + complete_size;
+    req.io_size_ -= complete_size;
+    req.io_offset_ += complete_size;
+
+    if (IO_CMD_PREAD == req.iocb_.aio_lio_opcode) {
+      io_prep_pread(&req.iocb_, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_);
+    } else {
+      io_prep_pwrite(&req.iocb_, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_);
+    }
+    req.iocb_.data = &req;
+
+    int sys_ret = 0;
+    if (OB_SUCCESS != inner_submit(req, sys_ret)) {
+      finish_flying_req(req, OB_IO_ERROR, sys_ret);
+    } else if (IO_BACKEND_IO_URING == backend_) {
+      // inner_submit only prepares the sqe for io_uring
+      ring_.submit();
     }
+  } else {  // io failed
+    // first print error log
+    COMMON_LOG(ERROR, "Fail to execute io request, ", K(req), K(complete_size), K(res2));
+    // then notify
+    finish_flying_req(req, OB_IO_ERROR, system_errno);
   }
+  ATOMIC_DEC(&submit_cnt_);
 }
 
 void ObIOChannel::cancel(ObIORequest& req)
@@ -712,7 +839,7 @@ void ObIOChannel::cancel(ObIORequest& req)
   int sys_ret = 0;
   bool is_cancel = false;
 
-  if (0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
+  if (IO_BACKEND_LIBAIO == backend_ && 0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
     // Note: here if ob_io_cancel failed (possibly due to kernel not supporting io_cancel),
     // neither we or the get_events thread would call control.callback_->process(),
     // as we previously set need_callback to false.
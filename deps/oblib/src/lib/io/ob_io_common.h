@@ -33,6 +33,7 @@
 #include "lib/container/ob_array.h"
 #include "lib/container/ob_array_wrap.h"
 #include "lib/worker.h"
+#include "lib/io/ob_io_uring.h"
 
 namespace oceanbase {
 namespace common {
@@ -60,6 +61,9 @@ enum ObIOMode {
 
 enum ObIOCategory { USER_IO = 0, SYS_IO = 1, PREWARM_IO = 2, LARGE_QUERY_IO = 3, MAX_IO_CATEGORY };
 
+// asynchronous io interface used by disk channels, decided when the disk is added
+enum ObIOBackend { IO_BACKEND_LIBAIO = 0, IO_BACKEND_IO_URING = 1, IO_BACKEND_MAX };
+
 class ObIORequest;
 class ObDisk;
 
@@ -115,7 +119,7 @@ struct ObIOConfig {
   TO_STRING_KV(K_(sys_io_low_percent), K_(sys_io_high_percent), K_(user_iort_up_percent), K_(cpu_high_water_level),
       K_(write_failure_detect_interval), K_(read_failure_black_list_interval), K_(retry_warn_limit),
       K_(retry_error_limit), K_(disk_io_thread_count), K_(callback_thread_count), K_(large_query_io_percent),
-      K_(data_storage_io_timeout_ms));
+      K_(data_storage_io_timeout_ms), K_(io_backend), K_(enable_io_uring_sqpoll));
 
   public:
   int64_t sys_io_low_percent_;
@@ -130,6 +134,9 @@ struct ObIOConfig {
   int64_t callback_thread_count_;
   int64_t large_query_io_percent_;
   int64_t data_storage_io_timeout_ms_;
+  // only take effect on disks added later
+  ObIOBackend io_backend_;
+  bool enable_io_uring_sqpoll_;
 };
 
 struct ObIODesc {
@@ -337,10 +344,14 @@ class ObIOChannel {
   public:
   ObIOChannel();
   virtual ~ObIOChannel();
-  int init(const int32_t queue_depth);
+  // %fixed_bufs are registered to io_uring, ignored by libaio.
+  // fallback to libaio if io_uring is not available.
+  int init(const int32_t queue_depth, const ObIOBackend backend = IO_BACKEND_LIBAIO, const bool enable_sqpoll = false,
+      const struct iovec* fixed_bufs = NULL, const int64_t fixed_buf_cnt = 0);
   void destroy();
   int enqueue_request(ObIORequest& req);
   int dequeue_request(ObIORequest*& req);
+  int dequeue_requests(ObIORequest** reqs, const int64_t max_cnt, int64_t& req_cnt);
   int clear_all_requests();
   void submit();
   void get_events();
@@ -349,20 +360,30 @@ class ObIOChannel {
   {
     can_submit_request_ = false;
   }
-  TO_STRING_KV(K_(inited), K_(submit_cnt), K_(can_submit_request));
+  ObIOBackend get_backend() const
+  {
+    return backend_;
+  }
+  TO_STRING_KV(K_(inited), K_(backend), K_(submit_cnt), K_(can_submit_request), K_(ring));
 
   private:
+  int init_io_uring(const bool enable_sqpoll, const struct iovec* fixed_bufs, const int64_t fixed_buf_cnt);
+  void submit_batch();
   int inner_submit(ObIORequest& req, int& sys_ret);
+  void handle_event(ObIORequest& req, const int64_t res, const int64_t res2, const int64_t io_finish_time);
   void finish_flying_req(ObIORequest& req, int io_ret, int system_errno);
   int64_t get_pop_wait_timeout(const int64_t queue_deadline);
 
   private:
   static const int32_t MAX_AIO_EVENT_CNT = 512;
+  static const int64_t MAX_SUBMIT_BATCH_CNT = 32;
   static const int64_t DISK_WAIT_PERIOD_US = 1000;
   static const int64_t AIO_TIMEOUT_NS = 1000L * 10000L;  // 10ms
   static const int64_t DEFAULT_SUBMIT_WAIT_US = 10 * 1000;
   bool inited_;
+  ObIOBackend backend_;
   io_context_t context_;
+  ObIOUring ring_;
   int64_t submit_cnt_;
   ObIOQueue queue_;
   ObThreadCond queue_cond_;
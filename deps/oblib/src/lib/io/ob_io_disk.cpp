@@ -183,11 +183,26 @@ int ObDisk::init(
     sys_iops_up_limit_ = DEFAULT_SYS_IOPS;
     ref_cnt_ = 0;
     channel_count_ = channel_count;
+    const ObIOConfig io_conf = ObIOManager::get_instance().get_io_config();
+    struct iovec fixed_bufs[ObIOUring::MAX_FIXED_BUF_CNT];
+    int64_t fixed_buf_cnt = 0;
+    if (IO_BACKEND_IO_URING == io_conf.io_backend_) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = ObIOManager::get_instance().get_resource_manager().get_fixed_buffers(
+                             fixed_bufs, ObIOUring::MAX_FIXED_BUF_CNT, fixed_buf_cnt))) {
+        COMMON_LOG(WARN, "fail to get fixed buffers", K(tmp_ret));
+        fixed_buf_cnt = 0;
+      }
+    }
     for (int64_t i = 0; OB_SUCC(ret) && i < MAX_DISK_CHANNEL_CNT; ++i) {
-      if (OB_FAIL(channels_[i].init(queue_depth))) {
+      if (OB_FAIL(channels_[i].init(
+              queue_depth, io_conf.io_backend_, io_conf.enable_io_uring_sqpoll_, fixed_bufs, fixed_buf_cnt))) {
         COMMON_LOG(WARN, "fail to init channel", K(ret), K(i), K(queue_depth));
       }
     }
+    if (OB_SUCC(ret)) {
+      COMMON_LOG(INFO, "disk channel io backend", K(fd), "backend", channels_[0].get_backend(), K(io_conf));
+    }
 
     if (OB_SUCC(ret)) {
       real_max_channel_cnt_ = !lib::is_mini_mode() ? MAX_DISK_CHANNEL_CNT : MINI_MODE_DISK_CHANNEL_CNT;
@@ -312,6 +312,24 @@ int64_t ObIOAllocator::allocated()
   return allocator_.allocated();
 }
 
+int ObIOAllocator::get_pool_memory(struct iovec* iovs, const int64_t max_cnt, int64_t& cnt) const
+{
+  int ret = OB_SUCCESS;
+  cnt = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io allocator is not inited", K(ret));
+  } else if (OB_ISNULL(iovs) || max_cnt < 2) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid arguments", K(ret), KP(iovs), K(max_cnt));
+  } else {
+    // micro pool for micro block reads, macro pool for macro block reads and writes
+    micro_pool_.get_memory(iovs[cnt++]);
+    macro_pool_.get_memory(iovs[cnt++]);
+  }
+  return ret;
+}
+
 /**
  * ---------------------------------------- ObIOPool -------------------------------
  */
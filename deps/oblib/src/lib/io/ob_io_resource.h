@@ -42,6 +42,12 @@ class ObIOMemoryPool {
   {
     return SIZE;
   }
+  // the whole memory of blocks, which is continuous
+  void get_memory(struct iovec& iov) const
+  {
+    iov.iov_base = begin_ptr_;
+    iov.iov_len = is_inited_ ? capacity_ * SIZE : 0;
+  }
 
   private:
   int init_bitmap(const int64_t block_count, ObIAllocator& allocator);
@@ -68,6 +74,8 @@ class ObIOAllocator final {
   void* alloc(const int64_t size);
   void free(void* ptr);
   int64_t allocated();
+  // memory of block pools, which can be registered as io_uring fixed buffers
+  int get_pool_memory(struct iovec* iovs, const int64_t max_cnt, int64_t& cnt) const;
 
   private:
   static const int64_t MICRO_POOL_BLOCK_SIZE = 16L * 1024L + 2 * DIO_READ_ALIGN_SIZE;
@@ -118,6 +126,10 @@ class ObIOResourceManager {
 
   void* alloc_memory(const int64_t size);
   void free_memory(void* ptr);
+  int get_fixed_buffers(struct iovec* iovs, const int64_t max_cnt, int64_t& cnt) const
+  {
+    return io_allocator_.get_pool_memory(iovs, max_cnt, cnt);
+  }
   int alloc_master(const int64_t request_count, ObIOMaster*& master);
   int free_master(ObIOMaster* master);
   int alloc_request(ObDiskMemoryStat& mem_stat, ObIORequest*& req);
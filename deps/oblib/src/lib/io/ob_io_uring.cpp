@@ -0,0 +1,438 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+#include "lib/io/ob_io_uring.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "lib/atomic/ob_atomic.h"
+#include "lib/oblog/ob_log.h"
+
+// system call numbers of io_uring are the same on all architectures
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+namespace oceanbase {
+namespace common {
+
+#ifdef OB_HAS_IO_URING
+static inline int sys_io_uring_setup(const uint32_t entries, struct io_uring_params* p)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static inline int sys_io_uring_enter(
+    const int fd, const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags, void* arg, size_t sz)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, sz));
+}
+
+static inline int sys_io_uring_register(const int fd, const uint32_t opcode, const void* arg, const uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+#endif
+
+ObIOUring::ObIOUring()
+    : is_inited_(false),
+      ring_fd_(-1),
+      is_sqpoll_(false),
+      sq_entries_(0),
+      cq_entries_(0),
+      sq_ring_ptr_(NULL),
+      sq_ring_size_(0),
+      sq_khead_(NULL),
+      sq_ktail_(NULL),
+      sq_kflags_(NULL),
+      sq_mask_(0),
+      sqes_(NULL),
+      sqes_size_(0),
+      prepared_tail_(0),
+      cq_ring_ptr_(NULL),
+      cq_ring_size_(0),
+      cq_khead_(NULL),
+      cq_ktail_(NULL),
+      cq_mask_(0),
+      cqes_(NULL),
+      fixed_buf_cnt_(0),
+      sq_lock_()
+{
+  MEMSET(fixed_bufs_, 0, sizeof(fixed_bufs_));
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+bool ObIOUring::is_supported()
+{
+  bool bret = false;
+#ifdef OB_HAS_IO_URING
+  struct io_uring_params p;
+  MEMSET(&p, 0, sizeof(p));
+  const int fd = sys_io_uring_setup(1, &p);
+  if (fd >= 0) {
+    bret = (p.features & IORING_FEAT_EXT_ARG) != 0;
+    ::close(fd);
+  }
+#endif
+  return bret;
+}
+
+int ObIOUring::init(const uint32_t entries, const bool enable_sqpoll)
+{
+  int ret = OB_SUCCESS;
+#ifndef OB_HAS_IO_URING
+  UNUSED(entries);
+  UNUSED(enable_sqpoll);
+  ret = OB_NOT_SUPPORTED;
+  LOG_WARN("io_uring is not supported by this build", K(ret));
+#else
+  struct io_uring_params p;
+  MEMSET(&p, 0, sizeof(p));
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("io uring has been inited", K(ret));
+  } else if (0 == entries) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(entries));
+  } else {
+    if (enable_sqpoll) {
+      p.flags |= IORING_SETUP_SQPOLL;
+      p.sq_thread_idle = SQ_THREAD_IDLE_MS;
+    }
+    if ((ring_fd_ = sys_io_uring_setup(entries, &p)) < 0) {
+      ret = (ENOSYS == errno || EPERM == errno) ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+      LOG_WARN("fail to setup io uring", K(ret), K(errno), K(entries), K(enable_sqpoll));
+    } else if (0 == (p.features & IORING_FEAT_EXT_ARG)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("io uring wait with timeout is not supported by kernel", K(ret), K(p.features));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    sq_entries_ = p.sq_entries;
+    cq_entries_ = p.cq_entries;
+    sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+      sq_ring_size_ = MAX(sq_ring_size_, cq_ring_size_);
+      cq_ring_size_ = sq_ring_size_;
+    }
+    sq_ring_ptr_ = ::mmap(
+        NULL, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == sq_ring_ptr_) {
+      sq_ring_ptr_ = NULL;
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to mmap sq ring", K(ret), K(errno), K_(sq_ring_size));
+    } else if (p.features & IORING_FEAT_SINGLE_MMAP) {
+      cq_ring_ptr_ = sq_ring_ptr_;
+    } else {
+      cq_ring_ptr_ = ::mmap(
+          NULL, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+      if (MAP_FAILED == cq_ring_ptr_) {
+        cq_ring_ptr_ = NULL;
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to mmap cq ring", K(ret), K(errno), K_(cq_ring_size));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    sqes_size_ = p.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = ::mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (MAP_FAILED == sqes_) {
+      sqes_ = NULL;
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to mmap sqes", K(ret), K(errno), K_(sqes_size));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    char* sq_ptr = static_cast<char*>(sq_ring_ptr_);
+    char* cq_ptr = static_cast<char*>(cq_ring_ptr_);
+    sq_khead_ = reinterpret_cast<uint32_t*>(sq_ptr + p.sq_off.head);
+    sq_ktail_ = reinterpret_cast<uint32_t*>(sq_ptr + p.sq_off.tail);
+    sq_kflags_ = reinterpret_cast<uint32_t*>(sq_ptr + p.sq_off.flags);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq_ptr + p.sq_off.ring_mask);
+    // sqe index is always the same as the slot index in sq array
+    uint32_t* sq_array = reinterpret_cast<uint32_t*>(sq_ptr + p.sq_off.array);
+    for (uint32_t i = 0; i < sq_entries_; ++i) {
+      sq_array[i] = i;
+    }
+    prepared_tail_ = ATOMIC_LOAD(sq_ktail_);
+    cq_khead_ = reinterpret_cast<uint32_t*>(cq_ptr + p.cq_off.head);
+    cq_ktail_ = reinterpret_cast<uint32_t*>(cq_ptr + p.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq_ptr + p.cq_off.ring_mask);
+    cqes_ = cq_ptr + p.cq_off.cqes;
+    is_sqpoll_ = enable_sqpoll;
+    fixed_buf_cnt_ = 0;
+    is_inited_ = true;
+    LOG_INFO("succeed to init io uring", K(*this), K(p.features));
+  } else {
+    destroy();
+  }
+#endif
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (NULL != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (NULL != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  if (NULL != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    // registered buffers are released with the ring
+    ::close(ring_fd_);
+  }
+  ring_fd_ = -1;
+  is_sqpoll_ = false;
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  sq_ring_ptr_ = NULL;
+  sq_ring_size_ = 0;
+  sq_khead_ = NULL;
+  sq_ktail_ = NULL;
+  sq_kflags_ = NULL;
+  sq_mask_ = 0;
+  sqes_ = NULL;
+  sqes_size_ = 0;
+  prepared_tail_ = 0;
+  cq_ring_ptr_ = NULL;
+  cq_ring_size_ = 0;
+  cq_khead_ = NULL;
+  cq_ktail_ = NULL;
+  cq_mask_ = 0;
+  cqes_ = NULL;
+  fixed_buf_cnt_ = 0;
+  is_inited_ = false;
+}
+
+int ObIOUring::register_buffers(const struct iovec* iovs, const int64_t iov_cnt)
+{
+  int ret = OB_SUCCESS;
+#ifndef OB_HAS_IO_URING
+  UNUSED(iovs);
+  UNUSED(iov_cnt);
+  ret = OB_NOT_SUPPORTED;
+#else
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == iovs || iov_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(iovs), K(iov_cnt));
+  } else if (OB_UNLIKELY(fixed_buf_cnt_ > 0)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("fixed buffers have been registered", K(ret), K_(fixed_buf_cnt));
+  } else {
+    int64_t cnt = 0;
+    for (int64_t i = 0; i < iov_cnt && cnt < MAX_FIXED_BUF_CNT; ++i) {
+      if (NULL != iovs[i].iov_base && iovs[i].iov_len > 0 &&
+          iovs[i].iov_len <= static_cast<size_t>(MAX_FIXED_BUF_SIZE)) {
+        fixed_bufs_[cnt++] = iovs[i];
+      }
+    }
+    if (0 == cnt) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("no buffer can be registered", K(ret), K(iov_cnt));
+    } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS, fixed_bufs_, static_cast<uint32_t>(cnt))) {
+      // usually caused by RLIMIT_MEMLOCK, the ring still works without fixed buffers
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to register fixed buffers", K(ret), K(errno), K(cnt));
+    } else {
+      fixed_buf_cnt_ = cnt;
+      LOG_INFO("succeed to register fixed buffers", K_(ring_fd), K_(fixed_buf_cnt));
+    }
+  }
+#endif
+  return ret;
+}
+
+int ObIOUring::find_fixed_buf(const char* buf, const int32_t size) const
+{
+  int idx = -1;
+  for (int64_t i = 0; idx < 0 && i < fixed_buf_cnt_; ++i) {
+    const char* begin = static_cast<const char*>(fixed_bufs_[i].iov_base);
+    if (buf >= begin && buf + size <= begin + fixed_bufs_[i].iov_len) {
+      idx = static_cast<int>(i);
+    }
+  }
+  return idx;
+}
+
+int ObIOUring::prep_rw(
+    const bool is_read, const int fd, char* buf, const int32_t size, const int64_t offset, void* data)
+{
+  int ret = OB_SUCCESS;
+#ifndef OB_HAS_IO_URING
+  UNUSED(is_read);
+  UNUSED(fd);
+  UNUSED(buf);
+  UNUSED(size);
+  UNUSED(offset);
+  UNUSED(data);
+  ret = OB_NOT_SUPPORTED;
+#else
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_UNLIKELY(fd < 0 || NULL == buf || size <= 0 || offset < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(fd), KP(buf), K(size), K(offset));
+  } else {
+    ObSpinLockGuard guard(sq_lock_);
+    if (prepared_tail_ - ATOMIC_LOAD(sq_khead_) >= sq_entries_) {
+      ret = OB_EAGAIN;
+    } else {
+      struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(sqes_) + (prepared_tail_ & sq_mask_);
+      const int buf_idx = find_fixed_buf(buf, size);
+      MEMSET(sqe, 0, sizeof(*sqe));
+      if (buf_idx >= 0) {
+        sqe->opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe->buf_index = static_cast<uint16_t>(buf_idx);
+      } else {
+        sqe->opcode = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+      }
+      sqe->fd = fd;
+      sqe->off = static_cast<uint64_t>(offset);
+      sqe->addr = reinterpret_cast<uint64_t>(buf);
+      sqe->len = static_cast<uint32_t>(size);
+      sqe->user_data = reinterpret_cast<uint64_t>(data);
+      ++prepared_tail_;
+    }
+  }
+#endif
+  return ret;
+}
+
+int ObIOUring::submit()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else {
+    ObSpinLockGuard guard(sq_lock_);
+    ret = inner_submit();
+  }
+  return ret;
+}
+
+// caller must hold sq_lock_
+int ObIOUring::inner_submit()
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  // publish prepared sqes to kernel
+  ATOMIC_STORE(sq_ktail_, prepared_tail_);
+  if (is_sqpoll_) {
+    // kernel thread picks up sqes itself, wake it up only if it has gone to sleep
+    if (ATOMIC_LOAD(sq_kflags_) & IORING_SQ_NEED_WAKEUP) {
+      if (sys_io_uring_enter(ring_fd_, 0, 0, IORING_ENTER_SQ_WAKEUP, NULL, 0) < 0) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to wake up sq thread", K(ret), K(errno));
+      }
+    }
+  } else {
+    int sys_ret = 0;
+    uint32_t to_submit = prepared_tail_ - ATOMIC_LOAD(sq_khead_);
+    while (OB_SUCC(ret) && to_submit > 0) {
+      if ((sys_ret = sys_io_uring_enter(ring_fd_, to_submit, 0, 0, NULL, 0)) < 0) {
+        if (EINTR == errno) {
+          // retry
+        } else if (EAGAIN == errno || EBUSY == errno) {
+          // sqes are kept in ring, and will be submitted next time
+          break;
+        } else {
+          ret = OB_IO_ERROR;
+          LOG_ERROR("fail to submit io uring", K(ret), K(errno), K(to_submit));
+        }
+      } else {
+        to_submit -= MIN(to_submit, static_cast<uint32_t>(sys_ret));
+        if (0 == sys_ret) {
+          break;
+        }
+      }
+    }
+  }
+#endif
+  return ret;
+}
+
+int ObIOUring::get_events(
+    ObIOUringEvent* events, const int64_t max_cnt, const int64_t timeout_ns, int64_t& event_cnt)
+{
+  int ret = OB_SUCCESS;
+  event_cnt = 0;
+#ifndef OB_HAS_IO_URING
+  UNUSED(events);
+  UNUSED(max_cnt);
+  UNUSED(timeout_ns);
+  ret = OB_NOT_SUPPORTED;
+#else
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == events || max_cnt <= 0 || timeout_ns < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(events), K(max_cnt), K(timeout_ns));
+  } else {
+    uint32_t head = *cq_khead_;
+    if (head == ATOMIC_LOAD(cq_ktail_) && timeout_ns > 0) {
+      // no event completed, sleep in kernel until one completes or timeout
+      struct __kernel_timespec ts;
+      ts.tv_sec = timeout_ns / 1000000000L;
+      ts.tv_nsec = timeout_ns % 1000000000L;
+      struct io_uring_getevents_arg arg;
+      MEMSET(&arg, 0, sizeof(arg));
+      arg.ts = reinterpret_cast<uint64_t>(&ts);
+      if (sys_io_uring_enter(
+              ring_fd_, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)) < 0) {
+        if (ETIME != errno && EINTR != errno && EAGAIN != errno && EBUSY != errno) {
+          ret = OB_IO_ERROR;
+          LOG_WARN("fail to wait io uring events", K(ret), K(errno));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      const uint32_t tail = ATOMIC_LOAD(cq_ktail_);
+      const struct io_uring_cqe* cqes = static_cast<const struct io_uring_cqe*>(cqes_);
+      while (head != tail && event_cnt < max_cnt) {
+        const struct io_uring_cqe& cqe = cqes[head & cq_mask_];
+        events[event_cnt].data_ = reinterpret_cast<void*>(cqe.user_data);
+        events[event_cnt].res_ = cqe.res;
+        ++event_cnt;
+        ++head;
+      }
+      // release cqes to kernel
+      ATOMIC_STORE(cq_khead_, head);
+    }
+  }
+#endif
+  return ret;
+}
+
+} /* namespace common */
+} /* namespace oceanbase */
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_IO_URING_H
+#define OB_IO_URING_H
+
+#include <sys/uio.h>
+#include "lib/utility/ob_macro_utils.h"
+#include "lib/utility/ob_print_utils.h"
+#include "lib/lock/ob_spin_lock.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// wait with timeout (IORING_ENTER_EXT_ARG) is required, which means kernel 5.11 or later
+#ifdef IORING_FEAT_EXT_ARG
+#define OB_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace oceanbase {
+namespace common {
+
+struct ObIOUringEvent {
+  void* data_;
+  int32_t res_;  // completed bytes, or -errno if failed
+};
+
+/*
+ * A thin io_uring wrapper based on the raw system calls (liburing is not required).
+ *
+ * Submission side (prep_rw/submit) is protected by a spin lock, completion side (get_events)
+ * must be called by a single thread.
+ * Buffers registered by register_buffers() are read and written with the *_FIXED opcodes,
+ * which saves the page pinning of each io in kernel.
+ */
+class ObIOUring {
+  public:
+  static const int64_t MAX_FIXED_BUF_CNT = 8;
+  static const int64_t MAX_FIXED_BUF_SIZE = 1L << 30;  // limited by kernel
+  static const uint32_t SQ_THREAD_IDLE_MS = 100;
+  ObIOUring();
+  ~ObIOUring();
+  // check whether io_uring is available in current kernel
+  static bool is_supported();
+  int init(const uint32_t entries, const bool enable_sqpoll);
+  void destroy();
+  // register fixed buffers, buffer larger than MAX_FIXED_BUF_SIZE is skipped
+  int register_buffers(const struct iovec* iovs, const int64_t iov_cnt);
+  // prepare one read or write, it is not visible to kernel until submit() is called
+  int prep_rw(const bool is_read, const int fd, char* buf, const int32_t size, const int64_t offset, void* data);
+  // submit all prepared requests with one system call
+  int submit();
+  // reap completed requests, wait at most %timeout_ns if no request completed
+  int get_events(ObIOUringEvent* events, const int64_t max_cnt, const int64_t timeout_ns, int64_t& event_cnt);
+  bool is_inited() const
+  {
+    return is_inited_;
+  }
+  bool is_sqpoll() const
+  {
+    return is_sqpoll_;
+  }
+  int64_t get_fixed_buf_cnt() const
+  {
+    return fixed_buf_cnt_;
+  }
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(is_sqpoll), K_(sq_entries), K_(cq_entries), K_(fixed_buf_cnt),
+      K_(prepared_tail));
+
+  private:
+  int find_fixed_buf(const char* buf, const int32_t size) const;
+  int inner_submit();
+
+  private:
+  bool is_inited_;
+  int ring_fd_;
+  bool is_sqpoll_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  // submission queue
+  void* sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  uint32_t* sq_khead_;
+  uint32_t* sq_ktail_;
+  uint32_t* sq_kflags_;
+  uint32_t sq_mask_;
+  void* sqes_;
+  int64_t sqes_size_;
+  uint32_t prepared_tail_;  // sqes before it are prepared, but may not be visible to kernel
+  // completion queue
+  void* cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  uint32_t* cq_khead_;
+  uint32_t* cq_ktail_;
+  uint32_t cq_mask_;
+  void* cqes_;
+  // fixed buffers
+  struct iovec fixed_bufs_[MAX_FIXED_BUF_CNT];
+  int64_t fixed_buf_cnt_;
+  ObSpinLock sq_lock_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} /* namespace common */
+} /* namespace oceanbase */
+
+#endif
@@ -243,6 +243,95 @@ int ObNumber::from_(const uint64_t value, IAllocator& allocator)
   return from_integer_(value, allocator);
 }
 
+template <class FixedT, class UFixedT>
+int ObNumber::from_fixed_(const FixedT fixed, const int64_t frac_len, ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  // an unsigned int128 has at most 5 base digits
+  static const int64_t MAX_FIXED_DIGIT_CNT = 5;
+  if (0 == fixed) {
+    set_zero();
+  } else {
+    uint32_t digits[MAX_FIXED_DIGIT_CNT];  // the lowest digit first
+    int64_t cnt = 0;
+    UFixedT abs_val = fixed < 0 ? 0 - static_cast<UFixedT>(fixed) : static_cast<UFixedT>(fixed);
+    for (; abs_val > 0 && cnt < MAX_FIXED_DIGIT_CNT; abs_val /= BASE) {
+      digits[cnt++] = static_cast<uint32_t>(abs_val % BASE);
+    }
+    int64_t start_id = 0;
+    for (; 0 == digits[start_id]; ++start_id)
+      ;
+    const int64_t len = cnt - start_id;
+    Desc base_desc;
+    Desc desc;
+    uint32_t* digit_mem = NULL;
+    base_desc.sign_ = fixed < 0 ? NEGATIVE : POSITIVE;
+    if (OB_FAIL(calc_desc_and_check(
+            base_desc.desc_, cnt - 1 - frac_len, static_cast<uint8_t>(len), desc, is_oracle_mode()))) {
+      LOG_WARN("fail to calc desc of fixed point", K(ret), K(cnt), K(frac_len));
+    } else if (OB_ISNULL(digit_mem = (uint32_t*)allocator.alloc(sizeof(uint32_t) * len))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_ERROR("failed to alloc mem", "size", sizeof(uint32_t) * len, K(ret));
+    } else {
+      for (int64_t i = 0; i < len; ++i) {
+        digit_mem[i] = digits[cnt - 1 - i];
+      }
+      assign(desc.desc_, digit_mem);
+    }
+  }
+  return ret;
+}
+
+int ObNumber::from_fixed(const int128_t fixed, const int64_t frac_len, ObIAllocator& allocator)
+{
+  return from_fixed_<int128_t, unsigned __int128>(fixed, frac_len, allocator);
+}
+
+int ObNumber::from_fixed(const int64_t fixed, const int64_t frac_len, ObIAllocator& allocator)
+{
+  return from_fixed_<int64_t, uint64_t>(fixed, frac_len, allocator);
+}
+
+int ObNumber::fixed_arith_(
+    const ObNumber& other, const FixedArithOp op, ObNumber& value, ObIAllocator& allocator, bool& is_done) const
+{
+  int ret = OB_SUCCESS;
+  static const int64_t BASE_POWERS[] = {1, static_cast<int64_t>(BASE), static_cast<int64_t>(BASE2)};
+  int64_t left = 0;
+  int64_t right = 0;
+  int64_t left_frac_len = 0;
+  int64_t right_frac_len = 0;
+  int64_t res = 0;
+  int64_t res_frac_len = 0;
+  is_done = false;
+  if (to_fixed(left, left_frac_len) && other.to_fixed(right, right_frac_len)) {
+    if (FIXED_MUL == op) {
+      res_frac_len = left_frac_len + right_frac_len;
+      is_done = !__builtin_mul_overflow(left, right, &res);
+    } else {
+      const int64_t diff = left_frac_len - right_frac_len;
+      res_frac_len = std::max(left_frac_len, right_frac_len);
+      if (diff > 2 || diff < -2) {
+        // out of range
+      } else if (diff > 0) {
+        is_done = !__builtin_mul_overflow(right, BASE_POWERS[diff], &right);
+      } else if (diff < 0) {
+        is_done = !__builtin_mul_overflow(left, BASE_POWERS[-diff], &left);
+      } else {
+        is_done = true;
+      }
+      if (is_done) {
+        is_done = FIXED_ADD == op ? !__builtin_add_overflow(left, right, &res)
+                                  : !__builtin_sub_overflow(left, right, &res);
+      }
+    }
+    if (is_done && OB_FAIL(value.from_fixed(res, res_frac_len, allocator))) {
+      LOG_WARN("fail to convert from fixed point", K(ret), K(res), K(res_frac_len));
+    }
+  }
+  return ret;
+}
+
 int ObNumber::from_(const char* str, IAllocator& allocator, int16_t* precision, int16_t* scale, const bool do_rounding)
 {
   int ret = OB_SUCCESS;
@@ -4347,11 +4436,16 @@ int ObNumber::add_v3(const ObNumber& other, ObNumber& value, ObIAllocator& alloc
   int ret = OB_SUCCESS;
   ObNumber res;
   const bool use_oracle_mode = is_oracle_mode();
+  bool is_fixed_done = false;
   LOG_DEBUG("add_v3", K(ret), KPC(this), K(other));
   if (OB_UNLIKELY(is_zero())) {
     ret = res.deep_copy_v3(other, allocator);
   } else if (OB_UNLIKELY(other.is_zero())) {
     ret = res.deep_copy_v3(*this, allocator);
+  } else if (OB_FAIL(fixed_arith_(other, FIXED_ADD, res, allocator, is_fixed_done))) {
+    LOG_WARN("fail to add fixed point", K(ret), KPC(this), K(other));
+  } else if (is_fixed_done) {
+    // done by fixed point fast path
   } else if (d_.sign_ == other.d_.sign_) {
     const int64_t this_exp = get_decode_exp(d_);
     const int64_t other_exp = get_decode_exp(other.d_);
@@ -4605,11 +4699,16 @@ int ObNumber::sub_v3(const ObNumber& other, ObNumber& value, ObIAllocator& alloc
   int ret = OB_SUCCESS;
   ObNumber res;
   const bool use_oracle_mode = is_oracle_mode();
+  bool is_fixed_done = false;
   LOG_DEBUG("sub_v3", K(ret), KPC(this), K(other));
   if (OB_UNLIKELY(is_zero())) {
     ret = other.negate_v3_(res, allocator);
   } else if (OB_UNLIKELY(other.is_zero())) {
     ret = res.deep_copy_v3(*this, allocator);
+  } else if (OB_FAIL(fixed_arith_(other, FIXED_SUB, res, allocator, is_fixed_done))) {
+    LOG_WARN("fail to sub fixed point", K(ret), KPC(this), K(other));
+  } else if (is_fixed_done) {
+    // done by fixed point fast path
   } else if (d_.sign_ == other.d_.sign_) {
     const int64_t this_exp = get_decode_exp(d_);
     const int64_t other_exp = get_decode_exp(other.d_);
@@ -5003,9 +5102,14 @@ int ObNumber::mul_v3(const ObNumber& other, ObNumber& value, ObIAllocator& alloc
   int ret = OB_SUCCESS;
   ObNumber res;
   const bool use_oracle_mode = is_oracle_mode();
+  bool is_fixed_done = false;
   LOG_DEBUG("mul_v3_", K(ret), KPC(this), K(other));
   if (is_zero() || other.is_zero()) {
     res.set_zero();
+  } else if (OB_FAIL(fixed_arith_(other, FIXED_MUL, res, allocator, is_fixed_done))) {
+    LOG_WARN("fail to mul fixed point", K(ret), KPC(this), K(other));
+  } else if (is_fixed_done) {
+    // done by fixed point fast path
   } else {
     Desc multiplicand_desc(d_.desc_);
     Desc multiplier_desc(other.d_.desc_);
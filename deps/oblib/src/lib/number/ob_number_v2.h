@@ -444,6 +444,13 @@ class ObNumber final {
 
   template <class IntegerT>
   int from_integer_(IntegerT integer_val, IAllocator& allocator);
+  template <class FixedT, class UFixedT>
+  int from_fixed_(const FixedT fixed, const int64_t frac_len, ObIAllocator& allocator);
+  enum FixedArithOp { FIXED_ADD = 0, FIXED_SUB, FIXED_MUL };
+  // int64 fixed point fast path of add_v3/sub_v3/mul_v3, %is_done is false if the operands or the
+  // result are out of range and the digits should be calculated.
+  int fixed_arith_(
+      const ObNumber& other, const FixedArithOp op, ObNumber& value, ObIAllocator& allocator, bool& is_done) const;
   int from_(const int64_t value, IAllocator& allocator);
   int from_(const uint64_t value, IAllocator& allocator);
   int from_(const char* str, IAllocator& allocator, int16_t* precision = NULL, int16_t* scale = NULL,
@@ -551,6 +558,20 @@ class ObNumber final {
     return from_integer_(value, allocator);
   }
 
+  // Fixed point representation of short decimals: the number equals fixed / BASE^frac_len.
+  // Numbers less than 10^38 in magnitude and spanning at most MAX_FIXED_LEN base digits (e.g. all
+  // values of DECIMAL(18,2) or DECIMAL(38,0)) are representable in int128, and in int64 if the value
+  // fits. Calculation on fixed point values needs no digit loops and no allocation, it is used by
+  // add_v3/sub_v3/mul_v3 and sum aggregation.
+  typedef __int128 int128_t;
+  static const int64_t MAX_FIXED_LEN = 5;
+  inline bool to_fixed(int128_t& fixed, int64_t& frac_len) const;
+  inline bool to_fixed(int64_t& fixed, int64_t& frac_len) const;
+  int from_fixed(const int128_t fixed, const int64_t frac_len, ObIAllocator& allocator);
+  int from_fixed(const int64_t fixed, const int64_t frac_len, ObIAllocator& allocator);
+  // sum += value with the larger frac_len, return false and keep %sum unchanged on int128 overflow.
+  inline static bool add_fixed(int128_t& sum, int64_t& sum_frac_len, const int128_t value, const int64_t frac_len);
+
   public:
   Desc d_;
 
@@ -2803,6 +2824,70 @@ inline bool ObNumber::is_integer() const
   return bret;
 }
 
+inline bool ObNumber::to_fixed(int128_t& fixed, int64_t& frac_len) const
+{
+  bool bret = true;
+  fixed = 0;
+  frac_len = 0;
+  if (!is_zero()) {
+    const int64_t exp = get_decode_exp(d_);
+    // digits after the point, negative for zero digits before the point
+    const int64_t tail_len = d_.len_ - 1 - exp;
+    frac_len = tail_len > 0 ? tail_len : 0;
+    const int64_t span_len = (exp >= 0 ? exp + 1 : 0) + frac_len;
+    // the highest of MAX_FIXED_LEN digits less than 100 for 10^38
+    if (span_len > MAX_FIXED_LEN || (MAX_FIXED_LEN == span_len && exp >= -1 && digits_[0] >= 100)) {
+      bret = false;
+    } else {
+      for (int64_t i = 0; i < d_.len_; ++i) {
+        fixed = fixed * BASE + digits_[i];
+      }
+      for (int64_t i = tail_len; i < 0; ++i) {
+        fixed *= BASE;
+      }
+      if (NEGATIVE == d_.sign_) {
+        fixed = -fixed;
+      }
+    }
+  }
+  return bret;
+}
+
+inline bool ObNumber::to_fixed(int64_t& fixed, int64_t& frac_len) const
+{
+  int128_t value = 0;
+  bool bret = to_fixed(value, frac_len) && value >= INT64_MIN && value <= INT64_MAX;
+  if (bret) {
+    fixed = static_cast<int64_t>(value);
+  }
+  return bret;
+}
+
+inline bool ObNumber::add_fixed(int128_t& sum, int64_t& sum_frac_len, const int128_t value, const int64_t frac_len)
+{
+  // less than INT128_MAX / BASE
+  const int128_t max_scale = static_cast<int128_t>(BASE2) * BASE * 100;
+  bool bret = true;
+  int128_t left = sum;
+  int128_t right = value;
+  int64_t res_frac_len = sum_frac_len;
+  for (; bret && res_frac_len < frac_len; ++res_frac_len) {
+    if ((bret = (left <= max_scale && left >= -max_scale))) {
+      left *= BASE;
+    }
+  }
+  for (int64_t i = frac_len; bret && i < res_frac_len; ++i) {
+    if ((bret = (right <= max_scale && right >= -max_scale))) {
+      right *= BASE;
+    }
+  }
+  if (bret && (bret = !__builtin_add_overflow(left, right, &left))) {
+    sum = left;
+    sum_frac_len = res_frac_len;
+  }
+  return bret;
+}
+
 inline int32_t ObNumber::get_decode_exp(const ObNumber::Desc& desc)
 {
   return (POSITIVE == desc.sign_ ? (desc.se_ - POSITIVE_EXP_BOUNDARY) : (NEGATIVE_EXP_BOUNDARY - desc.se_));
@@ -202,6 +202,143 @@ class ObPriorityQueue2 {
   int64_t limit_ CACHE_ALIGNED;
   DISALLOW_COPY_AND_ASSIGN(ObPriorityQueue2);
 };
+
+// ObPriorityQueue2 split into shards to avoid the shared size and cond of one queue.
+//
+// Each producer thread pushes to the shards in round robin, and a consumer pops from
+// its home shard first then steals from the others. A priority is checked in all
+// shards before the next one, so a stolen request never bypasses a higher priority
+// one. Consumers sleep on the cond of their home shard, push wakes up a waiter of
+// the pushed shard and turns to the other shards only if nobody waits there.
+template <int HIGH_PRIOS, int LOW_PRIOS, int SHARD_CNT = 8>
+class ObStealingPriorityQueue {
+  public:
+  enum { PRIO_CNT = HIGH_PRIOS + LOW_PRIOS };
+
+  ObStealingPriorityQueue() : shards_(), size_(0), limit_(INT64_MAX)
+  {}
+  ~ObStealingPriorityQueue()
+  {}
+
+  // limit of total size of all shards, same as ObPriorityQueue.
+  void set_limit(int64_t limit)
+  {
+    limit_ = limit;
+  }
+  inline int64_t size() const
+  {
+    return ATOMIC_LOAD(&size_);
+  }
+  int64_t queue_size(const int i) const
+  {
+    int64_t size = 0;
+    for (int64_t j = 0; j < SHARD_CNT; j++) {
+      size += ATOMIC_LOAD(&shards_[j].cnt_[i]);
+    }
+    return size;
+  }
+  int64_t to_string(char* buf, const int64_t buf_len) const
+  {
+    int64_t pos = 0;
+    common::databuff_printf(buf, buf_len, pos, "total_size=%ld ", size());
+    for (int i = 0; i < PRIO_CNT; i++) {
+      common::databuff_printf(buf, buf_len, pos, "queue[%d]=%ld ", i, queue_size(i));
+    }
+    return pos;
+  }
+
+  int push(ObLink* data, int priority)
+  {
+    int ret = OB_SUCCESS;
+    if (ATOMIC_FAA(&size_, 1) > limit_) {
+      ret = OB_SIZE_OVERFLOW;
+    } else if (OB_UNLIKELY(NULL == data) || OB_UNLIKELY(priority < 0) || OB_UNLIKELY(priority >= PRIO_CNT)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "push error, invalid argument", KP(data), K(priority));
+    } else {
+      const int64_t idx = next_push_shard();
+      Shard& shard = shards_[idx];
+      (void)ATOMIC_FAA(&shard.cnt_[priority], 1);
+      if (OB_FAIL(shard.queue_[priority].push(data))) {
+        (void)ATOMIC_FAA(&shard.cnt_[priority], -1);
+      } else {
+        for (int64_t i = 0; i < SHARD_CNT && 0 == shards_[(idx + i) % SHARD_CNT].cond_.signal(); i++) {
+          // a signal always changes the key of the cond, so a consumer going to sleep on
+          // any shard will see it even if nobody is woken up.
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+      (void)ATOMIC_FAA(&size_, -1);
+    }
+    return ret;
+  }
+
+  // %home is the home shard of the consumer, usually the index of worker.
+  inline int do_pop(ObLink*& data, int64_t plimit, int64_t timeout_us, int64_t home)
+  {
+    int ret = OB_ENTRY_NOT_EXIST;
+    if (OB_UNLIKELY(timeout_us < 0)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(ERROR, "timeout is invalid", K(ret), K(timeout_us));
+    } else {
+      const int64_t home_idx = static_cast<int64_t>(static_cast<uint64_t>(home) % SHARD_CNT);
+      SimpleCond& cond = shards_[home_idx].cond_;
+      const uint32_t key = cond.get_key();
+      for (int i = 0; OB_ENTRY_NOT_EXIST == ret && i < plimit; i++) {
+        for (int64_t j = 0; OB_ENTRY_NOT_EXIST == ret && j < SHARD_CNT; j++) {
+          Shard& shard = shards_[(home_idx + j) % SHARD_CNT];
+          if (ATOMIC_LOAD(&shard.cnt_[i]) > 0 && OB_SUCCESS == shard.queue_[i].pop(data)) {
+            (void)ATOMIC_FAA(&shard.cnt_[i], -1);
+            (void)ATOMIC_FAA(&size_, -1);
+            ret = OB_SUCCESS;
+          }
+        }
+      }
+      if (OB_FAIL(ret)) {
+        cond.wait(key, timeout_us);
+        data = NULL;
+      }
+    }
+    return ret;
+  }
+
+  int pop(ObLink*& data, int64_t timeout_us, int64_t home)
+  {
+    return do_pop(data, PRIO_CNT, timeout_us, home);
+  }
+
+  int pop_high(ObLink*& data, int64_t timeout_us, int64_t home)
+  {
+    return do_pop(data, HIGH_PRIOS, timeout_us, home);
+  }
+
+  private:
+  struct Shard {
+    Shard() : cond_(), queue_()
+    {
+      MEMSET(cnt_, 0, sizeof(cnt_));
+    }
+    SimpleCond cond_ CACHE_ALIGNED;
+    ObSpLinkQueue queue_[PRIO_CNT];
+    // number of requests of each priority, checked before popping to skip empty queues
+    // of other shards without writing them.
+    int64_t cnt_[PRIO_CNT] CACHE_ALIGNED;
+  } CACHE_ALIGNED;
+
+  static int64_t next_push_shard()
+  {
+    static RLOCAL(uint64_t, push_seq);
+    uint64_t& seq = push_seq;
+    return static_cast<int64_t>(seq++ % SHARD_CNT);
+  }
+
+  private:
+  Shard shards_[SHARD_CNT];
+  int64_t size_ CACHE_ALIGNED;
+  int64_t limit_ CACHE_ALIGNED;
+  DISALLOW_COPY_AND_ASSIGN(ObStealingPriorityQueue);
+};
 }  // end namespace common
 }  // end namespace oceanbase
 
@@ -522,6 +522,67 @@ TEST_F(TestIOManager, multi)
   }
 }
 
+TEST_F(TestIOManager, io_uring)
+{
+  static const int64_t MULTI_CNT = 256;
+  int ret = OB_SUCCESS;
+  ObIOInfo io_info;
+  ObIOHandle io_handle[MULTI_CNT];
+  char data[4096] = "test io uring";
+  const ObIOBackend expect_backend = ObIOUring::is_supported() ? IO_BACKEND_IO_URING : IO_BACKEND_LIBAIO;
+
+  io_info.size_ = 4096;
+  io_info.io_desc_.category_ = USER_IO;
+  io_info.batch_count_ = 1;
+  ObIOPoint& io_point = io_info.io_points_[0];
+  io_point.fd_ = fd_;
+  io_point.size_ = io_info.size_;
+  io_point.write_buf_ = data;
+
+  for (int64_t sqpoll = 0; sqpoll < 2; ++sqpoll) {
+    // re-add the disk with io_uring backend, fallback to libaio if not supported
+    ObIOConfig io_conf = ObIOManager::get_instance().get_io_config();
+    io_conf.io_backend_ = IO_BACKEND_IO_URING;
+    io_conf.enable_io_uring_sqpoll_ = (1 == sqpoll);
+    ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().set_io_config(io_conf));
+    ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().delete_disk(fd_));
+    ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().add_disk(fd_, 2));
+    {
+      ObDiskGuard guard;
+      ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().get_disk_manager().get_disk_with_guard(fd_, guard));
+      ASSERT_EQ(expect_backend, guard.get_disk()->channels_[0].get_backend());
+    }
+
+    io_info.io_desc_.mode_ = ObIOMode::IO_MODE_WRITE;
+    for (int64_t i = 0; i < MULTI_CNT; ++i) {
+      io_point.offset_ = 4096 * i;
+      data[0] = static_cast<char>('a' + i % 26);
+      ret = ObIOManager::get_instance().aio_write(io_info, io_handle[i]);
+      ASSERT_EQ(OB_SUCCESS, ret);
+    }
+    for (int64_t i = 0; i < MULTI_CNT; ++i) {
+      ret = io_handle[i].wait(DEFAULT_IO_WAIT_TIME_MS);
+      ASSERT_EQ(OB_SUCCESS, ret);
+      io_handle[i].reset();
+    }
+
+    io_info.io_desc_.mode_ = ObIOMode::IO_MODE_READ;
+    for (int64_t i = 0; i < MULTI_CNT; ++i) {
+      io_point.offset_ = 4096 * i;
+      ret = ObIOManager::get_instance().aio_read(io_info, io_handle[i]);
+      ASSERT_EQ(OB_SUCCESS, ret);
+    }
+    for (int64_t i = 0; i < MULTI_CNT; ++i) {
+      ret = io_handle[i].wait(DEFAULT_IO_WAIT_TIME_MS);
+      ASSERT_EQ(OB_SUCCESS, ret);
+      data[0] = static_cast<char>('a' + i % 26);
+      ret = strncmp(data, io_handle[i].get_buffer(), strlen(data));
+      ASSERT_EQ(0, ret);
+      io_handle[i].reset();
+    }
+  }
+}
+
 #ifdef ERRSIM
 TEST_F(TestIOManager, abnormal)
 {
@@ -3985,6 +3985,103 @@ TEST(ObNumber, int64_conversion)
   ASSERT_EQ(OB_INTEGER_PRECISION_OVERFLOW, num.cast_to_int64(to_int));
 }
 
+TEST(ObNumber, fixed_point)
+{
+  const int64_t MAX_BUF_SIZE = 1024;
+  char buf_alloc[MAX_BUF_SIZE];
+  ObDataBuffer allocator(buf_alloc, MAX_BUF_SIZE);
+  const char* fixed_strs[] = {"0",
+      "1",
+      "-1",
+      "0.25",
+      "-12345678.25",
+      "99999999999999.99",
+      "-9999999999999999.99",
+      "1000000000",
+      "0.000000000000000001",
+      "12345678901234567890123456789.12345",
+      "-99999999999999999999999999999999999999"};
+  const char* non_fixed_strs[] = {"100000000000000000000000000000000000000",
+      "0.0000000000000000000000000000000000000000000001",
+      "123456789012345678.1234567890123456789"};
+  number::ObNumber num;
+  number::ObNumber res;
+  number::ObNumber::int128_t fixed = 0;
+  int64_t frac_len = 0;
+  for (int64_t i = 0; i < ARRAYSIZEOF(fixed_strs); ++i) {
+    allocator.free();
+    ASSERT_EQ(OB_SUCCESS, num.from(fixed_strs[i], allocator));
+    ASSERT_TRUE(num.to_fixed(fixed, frac_len)) << fixed_strs[i];
+    ASSERT_EQ(OB_SUCCESS, res.from_fixed(fixed, frac_len, allocator));
+    ASSERT_EQ(0, num.compare(res)) << fixed_strs[i];
+    ASSERT_EQ(num.get_desc_value(), res.get_desc_value()) << fixed_strs[i];
+  }
+  for (int64_t i = 0; i < ARRAYSIZEOF(non_fixed_strs); ++i) {
+    allocator.free();
+    ASSERT_EQ(OB_SUCCESS, num.from(non_fixed_strs[i], allocator));
+    ASSERT_FALSE(num.to_fixed(fixed, frac_len)) << non_fixed_strs[i];
+  }
+
+  // int64 fixed point
+  int64_t fixed_int = 0;
+  allocator.free();
+  ASSERT_EQ(OB_SUCCESS, num.from("-12345678.25", allocator));
+  ASSERT_TRUE(num.to_fixed(fixed_int, frac_len));
+  ASSERT_EQ(-12345678250000000, fixed_int);
+  ASSERT_EQ(1, frac_len);
+  ASSERT_EQ(OB_SUCCESS, num.from("123456789012345678901234567890", allocator));
+  ASSERT_FALSE(num.to_fixed(fixed_int, frac_len));
+
+  // sum of fixed point values
+  number::ObNumber::int128_t sum = 0;
+  int64_t sum_frac_len = 0;
+  allocator.free();
+  ASSERT_EQ(OB_SUCCESS, num.from("100", allocator));
+  ASSERT_TRUE(num.to_fixed(fixed, frac_len));
+  ASSERT_TRUE(number::ObNumber::add_fixed(sum, sum_frac_len, fixed, frac_len));
+  ASSERT_EQ(OB_SUCCESS, num.from("-0.5", allocator));
+  ASSERT_TRUE(num.to_fixed(fixed, frac_len));
+  ASSERT_TRUE(number::ObNumber::add_fixed(sum, sum_frac_len, fixed, frac_len));
+  ASSERT_EQ(OB_SUCCESS, res.from_fixed(sum, sum_frac_len, allocator));
+  ASSERT_EQ(OB_SUCCESS, num.from("99.5", allocator));
+  ASSERT_EQ(0, num.compare(res));
+  // out of range, sum unchanged
+  ASSERT_EQ(OB_SUCCESS, num.from("99999999999999999999999999999999999999", allocator));
+  ASSERT_TRUE(num.to_fixed(fixed, frac_len));
+  ASSERT_FALSE(number::ObNumber::add_fixed(sum, sum_frac_len, fixed, frac_len));
+  ASSERT_EQ(OB_SUCCESS, num.from("50000000000000000000000000000000000000", allocator));
+  ASSERT_TRUE(num.to_fixed(fixed, frac_len));
+  ASSERT_TRUE(number::ObNumber::add_fixed(fixed, frac_len, fixed, frac_len));
+  ASSERT_FALSE(number::ObNumber::add_fixed(fixed, frac_len, fixed, frac_len));
+  ASSERT_EQ(OB_SUCCESS, res.from_fixed(sum, sum_frac_len, allocator));
+  ASSERT_EQ(OB_SUCCESS, num.from("99.5", allocator));
+  ASSERT_EQ(0, num.compare(res));
+
+  // fast path of add_v3/sub_v3/mul_v3 is the same with add_v2/sub_v2/mul_v2
+  const char* calc_strs[] = {
+      "0.01", "-0.99", "12345678.25", "-99999999999999.99", "4611686018427387904", "-0.000000001", "7", "-1000000000.5"};
+  number::ObNumber num1;
+  number::ObNumber num2;
+  number::ObNumber value_v2;
+  number::ObNumber value_v3;
+  for (int64_t i = 0; i < ARRAYSIZEOF(calc_strs); ++i) {
+    for (int64_t j = 0; j < ARRAYSIZEOF(calc_strs); ++j) {
+      allocator.free();
+      ASSERT_EQ(OB_SUCCESS, num1.from(calc_strs[i], allocator));
+      ASSERT_EQ(OB_SUCCESS, num2.from(calc_strs[j], allocator));
+      ASSERT_EQ(OB_SUCCESS, num1.add_v2(num2, value_v2, allocator));
+      ASSERT_EQ(OB_SUCCESS, num1.add_v3(num2, value_v3, allocator));
+      ASSERT_EQ(0, value_v2.compare(value_v3)) << calc_strs[i] << " + " << calc_strs[j];
+      ASSERT_EQ(OB_SUCCESS, num1.sub_v2(num2, value_v2, allocator));
+      ASSERT_EQ(OB_SUCCESS, num1.sub_v3(num2, value_v3, allocator));
+      ASSERT_EQ(0, value_v2.compare(value_v3)) << calc_strs[i] << " - " << calc_strs[j];
+      ASSERT_EQ(OB_SUCCESS, num1.mul_v2(num2, value_v2, allocator));
+      ASSERT_EQ(OB_SUCCESS, num1.mul_v3(num2, value_v3, allocator));
+      ASSERT_EQ(0, value_v2.compare(value_v3)) << calc_strs[i] << " * " << calc_strs[j];
+    }
+  }
+}
+
 TEST(ObNumber, arithmetic_cmp)
 {
   const int64_t MAX_TEST_COUNT = 100;
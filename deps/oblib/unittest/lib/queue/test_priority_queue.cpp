@@ -113,6 +113,58 @@ TEST(TestPriorityQueue, WithCoro)
   tq.do_stress();
 }
 
+TEST(TestPriorityQueue, Stealing)
+{
+  typedef ObStealingPriorityQueue<1, 2, 4> Queue;
+  Queue queue;
+  TestQueue::QData datas[8];
+  ObLink* data = NULL;
+  for (int64_t i = 0; i < 8; i++) {
+    datas[i].val_ = i;
+  }
+  // pushed to shards in round robin, popped in priority order from any home
+  for (int64_t i = 7; i >= 0; i--) {
+    ASSERT_EQ(OB_SUCCESS, queue.push(&datas[i], (int)datas[i].val_ % 3));
+  }
+  ASSERT_EQ(8, queue.size());
+  ASSERT_EQ(3, queue.queue_size(0));
+  ASSERT_EQ(OB_SUCCESS, queue.pop_high(data, 0, 1));
+  ASSERT_EQ(0, static_cast<TestQueue::QData*>(data)->val_ % 3);
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 2));
+  ASSERT_EQ(0, static_cast<TestQueue::QData*>(data)->val_ % 3);
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 3));
+  ASSERT_EQ(0, static_cast<TestQueue::QData*>(data)->val_ % 3);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop_high(data, 0, 0));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, -1));
+  ASSERT_EQ(1, static_cast<TestQueue::QData*>(data)->val_ % 3);
+  for (int64_t i = 0; i < 4; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, i));
+  }
+  ASSERT_EQ(2, static_cast<TestQueue::QData*>(data)->val_ % 3);
+  ASSERT_EQ(0, queue.size());
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop(data, 0, 0));
+
+  // limit of the total size, regardless of the shards the requests are pushed to
+  queue.set_limit(2);
+  for (int64_t i = 0; i < 3; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.push(&datas[i], 2));
+  }
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&datas[3], 2));
+  ASSERT_EQ(3, queue.size());
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 3));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&datas[3], 2));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&datas[4], 2));
+  for (int64_t i = 0; i < 3; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 0));
+  }
+  ASSERT_EQ(0, queue.size());
+  queue.set_limit(0);
+  ASSERT_EQ(OB_SUCCESS, queue.push(&datas[5], 1));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&datas[6], 1));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 1));
+  ASSERT_EQ(5, static_cast<TestQueue::QData*>(data)->val_);
+}
+
 int main(int argc, char* argv[])
 {
   oceanbase::common::ObLogger::get_logger().set_log_level("debug");
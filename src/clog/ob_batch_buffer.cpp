@@ -19,6 +19,40 @@
 namespace oceanbase {
 using namespace common;
 namespace clog {
+void ObGroupCommitPolicy::reset()
+{
+  flush_time_ = 0;
+  arrival_rate_ = 0;
+}
+
+void ObGroupCommitPolicy::update(const int64_t entry_cnt, const int64_t flush_time)
+{
+  if (entry_cnt >= 0 && flush_time > 0) {
+    const int64_t arrival_rate = entry_cnt * 1000000 / flush_time;
+    if (0 == flush_time_) {
+      flush_time_ = flush_time;
+      arrival_rate_ = arrival_rate;
+    } else {
+      flush_time_ = (flush_time_ * HISTORY_WEIGHT + flush_time) / (HISTORY_WEIGHT + 1);
+      arrival_rate_ = (arrival_rate_ * HISTORY_WEIGHT + arrival_rate) / (HISTORY_WEIGHT + 1);
+    }
+  }
+}
+
+int64_t ObGroupCommitPolicy::get_wait_time(const int64_t max_wait_time) const
+{
+  int64_t wait_time = 0;
+  if (max_wait_time > 0 && get_target_entry_cnt(0) >= MIN_GROUP_ENTRY_CNT) {
+    wait_time = std::min(max_wait_time, flush_time_);
+  }
+  return wait_time;
+}
+
+int64_t ObGroupCommitPolicy::get_target_entry_cnt(const int64_t wait_time) const
+{
+  return arrival_rate_ * (flush_time_ + wait_time) / 1000000;
+}
+
 int ObBatchBuffer::IncPos::try_freeze(IncPos& cur_pos, const int64_t seq)
 {
   int ret = OB_SUCCESS;
@@ -77,6 +111,7 @@ class ObBatchBuffer::Block : public ObIBatchBufferTask {
         ref_(0),
         buf_(buf),
         block_count_(block_count),
+        freeze_ts_(0),
         auto_freeze_(auto_freeze)
   {}
   virtual ~Block()
@@ -94,6 +129,10 @@ class ObBatchBuffer::Block : public ObIBatchBufferTask {
   {
     return seq_;
   }
+  int64_t get_freeze_ts() const
+  {
+    return ATOMIC_LOAD(&freeze_ts_);
+  }
   void reuse();
 
   private:
@@ -103,6 +142,7 @@ class ObBatchBuffer::Block : public ObIBatchBufferTask {
   int64_t ref_;
   char* buf_;
   int64_t block_count_;
+  int64_t freeze_ts_;
   ObCLogItem flush_task_;
   bool auto_freeze_;
 };
@@ -168,6 +208,7 @@ void ObBatchBuffer::Block::fill(const offset_t offset, ObIBufferTask* task)
 void ObBatchBuffer::Block::freeze(const offset_t offset)
 {
   set_batch_buffer(buf_, offset);
+  ATOMIC_STORE(&freeze_ts_, ObTimeUtility::current_time());
 }
 
 void ObBatchBuffer::Block::set_submitted()
@@ -192,7 +233,8 @@ ObBatchBuffer::ObBatchBuffer()
       block_size_(OB_INVALID_SIZE),
       next_flush_block_id_(OB_INVALID_ID),
       next_pos_(),
-      auto_freeze_(true)
+      auto_freeze_(true),
+      group_commit_policy_()
 {}
 
 ObBatchBuffer::~ObBatchBuffer()
@@ -288,6 +330,50 @@ int ObBatchBuffer::try_freeze_next_block()
   return ret;
 }
 
+int ObBatchBuffer::freeze_next_block_after_flush(const int64_t block_id, const int64_t max_wait_time)
+{
+  int ret = OB_SUCCESS;
+  Block* block = NULL;
+  const int64_t next_block_id = block_id + 1;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+  } else if (block_id < 0) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == (block = get_block(block_id))) {
+    ret = OB_ERR_UNEXPECTED;
+  } else {
+    // next_flush_block_id_ is not advanced while waiting, so submit() doesn't freeze the next block.
+    int64_t cur_ts = ObTimeUtility::current_time();
+    const int64_t entry_cnt = get_entry_cnt(next_block_id);
+    group_commit_policy_.update(entry_cnt, cur_ts - block->get_freeze_ts());
+    const int64_t wait_time = entry_cnt > 0 ? group_commit_policy_.get_wait_time(max_wait_time) : 0;
+    if (wait_time > 0) {
+      const int64_t wait_end_ts = cur_ts + wait_time;
+      const int64_t target_entry_cnt = group_commit_policy_.get_target_entry_cnt(wait_time);
+      while (cur_ts < wait_end_ts && get_entry_cnt(next_block_id) < target_entry_cnt) {
+        usleep(static_cast<uint32_t>(std::min(wait_end_ts - cur_ts, GROUP_COMMIT_POLL_INTERVAL)));
+        cur_ts = ObTimeUtility::current_time();
+      }
+    }
+    update_next_flush_block_id(next_block_id);
+    if (OB_FAIL(try_freeze(next_block_id))) {
+      CLOG_LOG(WARN, "try_freeze failed", K(ret), K(next_block_id));
+    }
+    if (wait_time > 0 && REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      CLOG_LOG(INFO, "clog group commit", K(wait_time), K(entry_cnt), K_(group_commit_policy));
+    }
+  }
+  return ret;
+}
+
+// entry count of the open block, MAX_ENTRY_CNT if %block_id has been switched
+int64_t ObBatchBuffer::get_entry_cnt(const int64_t block_id)
+{
+  IncPos cur_pos;
+  LOAD128(cur_pos, &next_pos_);
+  return cur_pos.seq_ == block_id ? cur_pos.entry_cnt_ : IncPos::MAX_ENTRY_CNT;
+}
+
 int ObBatchBuffer::try_freeze(const int64_t block_id)
 {
   int ret = OB_SUCCESS;
@@ -19,6 +19,39 @@
 namespace oceanbase {
 namespace clog {
 class ObLogWriterWrapper;
+
+// Group commit policy of the batch buffer, only accessed by the writer thread.
+//
+// A block is frozen as soon as the previous one is flushed, so under high concurrency each
+// write carries what arrived during one flush. When the arrival rate and the flush time say
+// enough entries are coming, the writer waits a little longer (at most one flush time) before
+// freezing, so that fewer and larger writes are issued. Under low load nothing is waited.
+class ObGroupCommitPolicy {
+  public:
+  // wait only when at least this many entries are expected to arrive during one flush
+  static const int64_t MIN_GROUP_ENTRY_CNT = 8;
+
+  ObGroupCommitPolicy() : flush_time_(0), arrival_rate_(0)
+  {}
+  ~ObGroupCommitPolicy()
+  {}
+  void reset();
+  // %entry_cnt entries arrived during %flush_time, which is from freezing a block to its flush finished.
+  void update(const int64_t entry_cnt, const int64_t flush_time);
+  // time to wait before freezing the next block, 0 means freezing at once.
+  int64_t get_wait_time(const int64_t max_wait_time) const;
+  // entries expected in the next block after waiting %wait_time.
+  int64_t get_target_entry_cnt(const int64_t wait_time) const;
+  TO_STRING_KV(K_(flush_time), K_(arrival_rate));
+
+  private:
+  // weight of the old value in moving average
+  static const int64_t HISTORY_WEIGHT = 7;
+  int64_t flush_time_;
+  // entries per second
+  int64_t arrival_rate_;
+};
+
 class ObBatchBuffer : public ObIBufferConsumer {
   public:
   ObBatchBuffer();
@@ -29,6 +62,9 @@ class ObBatchBuffer : public ObIBufferConsumer {
   int try_freeze_next_block();
   int try_freeze(const int64_t block_id);
   void update_next_flush_block_id(const int64_t block_id);
+  // Called by the writer after block %block_id is flushed, freeze the next block after waiting
+  // at most %max_wait_time for more entries to join it, see ObGroupCommitPolicy.
+  int freeze_next_block_after_flush(const int64_t block_id, const int64_t max_wait_time);
   bool is_all_consumed() const;
 
   private:
@@ -54,10 +90,13 @@ class ObBatchBuffer : public ObIBufferConsumer {
   } __attribute__((__aligned__(16)));
   class Block;
 
+  static const int64_t GROUP_COMMIT_POLL_INTERVAL = 50;
+
   private:
   int wait_block(const int64_t block_id);
   Block* get_block(const int64_t block_id);
   int fill_buffer(const IncPos cur_pos, ObIBufferTask* task);
+  int64_t get_entry_cnt(const int64_t block_id);
 
   private:
   bool is_inited_;
@@ -68,6 +107,7 @@ class ObBatchBuffer : public ObIBufferConsumer {
   int64_t next_flush_block_id_;
   IncPos next_pos_;
   bool auto_freeze_;
+  ObGroupCommitPolicy group_commit_policy_;
 
   DISALLOW_COPY_AND_ASSIGN(ObBatchBuffer);
 };
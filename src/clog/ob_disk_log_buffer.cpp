@@ -13,6 +13,7 @@
 #include "ob_disk_log_buffer.h"
 #include "ob_log_block.h"
 #include "ob_log_define.h"
+#include "share/config/ob_server_config.h"
 
 namespace oceanbase {
 using namespace common;
@@ -81,11 +82,6 @@ int ObCLogItem::after_flushed(
     }
     buffer_task_->reuse();
     host_->add_group_size(task_num, type);
-    const int64_t next_flush_block_id = seq + 1;
-    batch_buffer_->update_next_flush_block_id(next_flush_block_id);
-    if (OB_SUCCESS != (tmp_ret = batch_buffer_->try_freeze(next_flush_block_id))) {
-      CLOG_LOG(ERROR, "batch_buffer try_freeze failed", K(tmp_ret));
-    }
     if (CLOG_WRITE_POOL == type) {
       bool curr_is_aggre_task = false;
       bool last_is_aggre_task = false;
@@ -117,6 +113,11 @@ int ObCLogItem::after_flushed(
         CLOG_LOG(ERROR, "after_consume failed", K(tmp_ret));
       }
     }
+    // callbacks are handed over before waiting for group commit
+    const int64_t max_wait_time = ObServerConfig::get_instance()._clog_group_commit_max_wait_time;
+    if (OB_SUCCESS != (tmp_ret = batch_buffer_->freeze_next_block_after_flush(seq, max_wait_time))) {
+      CLOG_LOG(ERROR, "batch_buffer freeze_next_block_after_flush failed", K(tmp_ret));
+    }
   }
   return ret;
 }
@@ -1054,6 +1054,8 @@ int ObServer::init_io()
       io_config.cpu_high_water_level_ = GCONF.sys_cpu_limit_trigger * cpu_cnt;
       io_config.disk_io_thread_count_ = GCONF.disk_io_thread_count;
       io_config.callback_thread_count_ = GCONF._io_callback_thread_count;
+      io_config.io_backend_ = GCONF._enable_io_uring ? IO_BACKEND_IO_URING : IO_BACKEND_LIBAIO;
+      io_config.enable_io_uring_sqpoll_ = GCONF._enable_io_uring_sqpoll;
       if (OB_FAIL(ObIOManager::get_instance().set_io_config(io_config))) {
         LOG_ERROR("config io manager fail, ", K(ret));
       } else {
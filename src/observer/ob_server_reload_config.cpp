@@ -107,6 +107,8 @@ int ObServerReloadConfig::operator()()
     io_config.cpu_high_water_level_ = GCONF.sys_cpu_limit_trigger * cpu_cnt;
     io_config.disk_io_thread_count_ = GCONF.disk_io_thread_count;
     io_config.callback_thread_count_ = GCONF._io_callback_thread_count;
+    io_config.io_backend_ = GCONF._enable_io_uring ? IO_BACKEND_IO_URING : IO_BACKEND_LIBAIO;
+    io_config.enable_io_uring_sqpoll_ = GCONF._enable_io_uring_sqpoll;
     io_config.large_query_io_percent_ = GCONF._large_query_io_percentage;
     // In the 2.x version, reuse the sys_bkgd_io_timeout configuration item to indicate the data disk io timeout time
     // After version 3.1, use the data_storage_io_timeout configuration item.
@@ -255,6 +257,7 @@ int ObServerReloadConfig::operator()()
     lib::g_runtime_enabled = true;
   }
   common::ObKVGlobalCache::get_instance().reload_wash_interval();
+  common::ObKVGlobalCache::get_instance().reload_admission();
   ObPartitionScheduler::get_instance().reload_minor_merge_schedule_interval();
   {
     OB_STORE_FILE.resize_file(GCONF.datafile_size, GCONF.datafile_disk_percentage);
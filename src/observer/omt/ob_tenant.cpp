@@ -641,11 +641,11 @@ int ObTenant::get_new_request(ObThWorker& w, int64_t timeout, rpc::ObRequest*& r
         if (OB_UNLIKELY(only_high_high_prio)) {
           // We must ensure at least one worker can process the highest
           // priority task.
-          ret = req_queue_.do_pop(task, QQ_HIGH + 1, timeout);
+          ret = req_queue_.do_pop(task, QQ_HIGH + 1, timeout, w.ObWorker::get_tidx());
         } else if (OB_UNLIKELY(only_high_prio)) {
           // We must ensure at least number of tokens of workers which don't
           // process low priority task.
-          ret = req_queue_.pop_high(task, timeout);
+          ret = req_queue_.pop_high(task, timeout, w.ObWorker::get_tidx());
         } else {
           // If large requests exist and this worker doesn't have LQT but
           // can acquire, do it.
@@ -654,7 +654,7 @@ int ObTenant::get_new_request(ObThWorker& w, int64_t timeout, rpc::ObRequest*& r
             w.set_lq_token();
           }
           if (OB_LIKELY(!w.has_lq_token())) {
-            ret = req_queue_.pop(task, 0L);
+            ret = req_queue_.pop(task, 0L, w.ObWorker::get_tidx());
           }
           if (OB_UNLIKELY(nullptr == task)) {
             // If large query flag is set, we prefer large query.
@@ -663,7 +663,7 @@ int ObTenant::get_new_request(ObThWorker& w, int64_t timeout, rpc::ObRequest*& r
             } else {
               // Ignore return code from large queue and get request from
               // normal queue.
-              ret = req_queue_.pop(task, timeout);
+              ret = req_queue_.pop(task, timeout, w.ObWorker::get_tidx());
             }
           }
         }
@@ -558,7 +558,8 @@ class ObTenant : public share::ObTenantBase {
 
   /// tenant task queue,
   // 'hp' for high priority and 'np' for normal priority
-  common::ObPriorityQueue2<QQ_MAX_PRIO, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
+  // shards are homes of workers by tenant index, idle workers steal from other shards.
+  common::ObStealingPriorityQueue<QQ_MAX_PRIO, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
   common::ObLinkQueue large_req_queue_;
 
   // Create a request queue for each level of nested requests
@@ -699,7 +700,7 @@ inline void ObTenant::resume_it(ObThWorker& w)
 
 OB_INLINE int ObTenant::pop_req(common::ObLink*& req, int64_t timeout)
 {
-  return req_queue_.pop(req, timeout);
+  return req_queue_.pop(req, timeout, 0);
 }
 
 inline int ObTenant::rdlock(common::ObLDHandle& handle)
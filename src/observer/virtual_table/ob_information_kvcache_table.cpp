@@ -244,6 +244,14 @@ int ObInfoSchemaKvCacheTable::inner_get_next_row(ObNewRow*& row)
             cells_[cell_idx].set_int(inst->status_.hold_size_);
             break;
           }
+          case TOTAL_ADMIT_CNT: {
+            cells_[cell_idx].set_int(inst->status_.total_admit_cnt_.value());
+            break;
+          }
+          case TOTAL_REJECT_CNT: {
+            cells_[cell_idx].set_int(inst->status_.total_reject_cnt_.value());
+            break;
+          }
           default: {
             ret = OB_ERR_UNEXPECTED;
             SERVER_LOG(WARN, "invalid column id", K(ret), K(cell_idx), K(output_column_ids_), K(col_id));
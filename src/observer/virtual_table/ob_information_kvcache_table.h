@@ -56,7 +56,9 @@ class ObInfoSchemaKvCacheTable : public common::ObVirtualTableScannerIterator {
     TOTAL_PUT_CNT,
     TOTAL_HIT_CNT,
     TOTAL_MISS_CNT,
-    HOLD_SIZE
+    HOLD_SIZE,
+    TOTAL_ADMIT_CNT,
+    TOTAL_REJECT_CNT
   };
   common::ObAddr* addr_;
   common::ObString ipstr_;
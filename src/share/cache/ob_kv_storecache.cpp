@@ -235,9 +235,9 @@ void ObKVGlobalCache::destroy()
 }
 
 int ObKVGlobalCache::put(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
-    const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite)
+    const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite, const bool need_admit)
 {
-  return put(store_, cache_id, key, value, pvalue, mb_handle, overwrite);
+  return put(store_, cache_id, key, value, pvalue, mb_handle, overwrite, need_admit);
 }
 
 int ObKVGlobalCache::put(ObWorkingSet* working_set, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
@@ -261,7 +261,8 @@ int ObKVGlobalCache::put(ObWorkingSet* working_set, const ObIKVCacheKey& key, co
 
 template <typename MBWrapper>
 int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const ObIKVCacheKey& key,
-    const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite)
+    const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite,
+    const bool need_admit)
 {
   int ret = OB_SUCCESS;
   ObKVCacheInstKey inst_key(cache_id, key.get_tenant_id());
@@ -283,6 +284,9 @@ int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (!overwrite && (OB_SUCC(map_.get(cache_id, key, pvalue, mb_handle)))) {
     ret = OB_ENTRY_EXIST;
+  } else if (need_admit && !admit(*inst_handle.get_inst(), key, overwrite)) {
+    // rejected, the kvpair is not worth washing others out
+    ret = OB_SUCCESS;
   } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper))) {
     COMMON_LOG(WARN, "Fail to store kvpair to store, ", K(ret));
   } else {
@@ -364,6 +368,7 @@ int ObKVGlobalCache::get(
     COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
   } else {
     revert(mb_handle);
+    store_.record_access(cache_id, key);
     if (OB_FAIL(map_.get(cache_id, key, pvalue, mb_handle))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         COMMON_LOG(WARN, "fail to get value from map, ", K(ret));
@@ -686,6 +691,27 @@ int ObKVGlobalCache::reload_wash_interval()
   return ret;
 }
 
+void ObKVGlobalCache::reload_admission()
+{
+  store_.set_admission_enabled(GCONF._enable_kvcache_admission);
+}
+
+bool ObKVGlobalCache::admit(ObKVCacheInst& inst, const ObIKVCacheKey& key, const bool overwrite)
+{
+  bool admitted = true;
+  if (store_.need_admission(inst)) {
+    const ObIKVCacheValue* pvalue = NULL;
+    ObKVMemBlockHandle* mb_handle = NULL;
+    if (overwrite && OB_SUCCESS == map_.get(inst.cache_id_, key, pvalue, mb_handle)) {
+      // never reject the kvpair overwriting the cached one, or the stale value is kept in cache
+      revert(mb_handle);
+    } else {
+      admitted = store_.admit(inst, key);
+    }
+  }
+  return admitted;
+}
+
 int ObKVGlobalCache::set_hold_size(const uint64_t tenant_id, const char* cache_name, const int64_t hold_size)
 {
   int ret = OB_SUCCESS;
@@ -54,6 +54,12 @@ class ObKVCache : public ObIKVCache<Key, Value> {
   int init(const char* cache_name, const int64_t priority = 1);
   void destroy();
   int set_priority(const int64_t priority);
+  // Plain put() of the cache may be rejected by the frequency based admission when the tenant's
+  // cache memory is under pressure, for caches filled by scan workloads (e.g.: row cache) only.
+  void set_admission_enabled(const bool enabled)
+  {
+    admission_enabled_ = enabled;
+  }
   virtual int put(const Key& key, const Value& value, bool overwrite = true);
   virtual int put_and_fetch(
       const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite = true);
@@ -76,6 +82,7 @@ class ObKVCache : public ObIKVCache<Key, Value> {
   private:
   bool inited_;
   int64_t cache_id_;
+  bool admission_enabled_;
 };
 
 // working set is a special cache that limit memory used
@@ -123,6 +130,7 @@ class ObKVGlobalCache : public lib::ObICacheWasher {
   void destroy();
   void reload_priority();
   int reload_wash_interval();
+  void reload_admission();
   int64_t get_suitable_bucket_num();
   int get_tenant_cache_info(const uint64_t tenant_id, ObIArray<ObKVCacheInstHandle>& inst_handles);
   int get_all_cache_info(ObIArray<ObKVCacheInstHandle>& inst_handles);
@@ -154,14 +162,16 @@ class ObKVGlobalCache : public lib::ObICacheWasher {
   int create_working_set(const ObKVCacheInstKey& inst_key, ObWorkingSet*& working_set);
   int delete_working_set(ObWorkingSet* working_set);
   int set_priority(const int64_t cache_id, const int64_t priority);
+  // if %need_admit is true, the kvpair may be rejected by admission, OB_SUCCESS with NULL mb_handle is returned then
   int put(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
-      const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true);
+      const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true,
+      const bool need_admit = false);
   int put(ObWorkingSet* working_set, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
       const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true);
   template <typename MBWrapper>
   int put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const ObIKVCacheKey& key,
       const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle,
-      bool overwrite = true);
+      bool overwrite = true, const bool need_admit = false);
   int alloc(const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
       ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle);
   int alloc(ObWorkingSet* working_set, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
@@ -190,6 +200,9 @@ class ObKVGlobalCache : public lib::ObICacheWasher {
   static const int64_t MAX_BUCKET_NUM_LEVEL = 6;
   static const int64_t bucket_num_array_[MAX_BUCKET_NUM_LEVEL];
 
+  private:
+  bool admit(ObKVCacheInst& inst, const ObIKVCacheKey& key, const bool overwrite);
+
   private:
   class KVStoreWashTask : public ObTimerTask {
     public:
@@ -317,7 +330,7 @@ int ObIKVCache<Key, Value>::put_kvpair(
  * ------------------------------------------------------------ObKVCache-----------------------------------------------------------------
  */
 template <class Key, class Value>
-ObKVCache<Key, Value>::ObKVCache() : inited_(false), cache_id_(-1)
+ObKVCache<Key, Value>::ObKVCache() : inited_(false), cache_id_(-1), admission_enabled_(false)
 {}
 
 template <class Key, class Value>
@@ -468,8 +481,8 @@ int ObKVCache<Key, Value>::put(const Key& key, const Value& value, bool overwrit
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
-  } else if (OB_FAIL(
-                 ObKVGlobalCache::get_instance().put(cache_id_, key, value, pvalue, handle.mb_handle_, overwrite))) {
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().put(
+                 cache_id_, key, value, pvalue, handle.mb_handle_, overwrite, admission_enabled_))) {
     if (OB_ENTRY_EXIST != ret) {
       COMMON_LOG(WARN, "Fail to put kv to ObKVGlobalCache, ", K_(cache_id), K(ret));
     }
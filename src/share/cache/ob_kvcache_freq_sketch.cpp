@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_kvcache_freq_sketch.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/atomic/ob_atomic.h"
+
+namespace oceanbase {
+namespace common {
+
+static const uint64_t FREQ_SKETCH_SEEDS[] = {
+    0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+static const uint64_t FREQ_SKETCH_HALF_MASK = 0x7777777777777777ULL;
+
+ObKVCacheFreqSketch::ObKVCacheFreqSketch() : table_(NULL), word_cnt_(0), sample_size_(0), add_cnt_(0)
+{}
+
+ObKVCacheFreqSketch::~ObKVCacheFreqSketch()
+{
+  destroy();
+}
+
+int ObKVCacheFreqSketch::init(const int64_t counter_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL != table_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "The ObKVCacheFreqSketch has been inited, ", K(ret));
+  } else if (OB_UNLIKELY(counter_cnt < COUNTERS_PER_WORD)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(counter_cnt), K(ret));
+  } else {
+    int64_t word_cnt = 1;
+    while (word_cnt * COUNTERS_PER_WORD < counter_cnt) {
+      word_cnt <<= 1;
+    }
+    if (NULL == (table_ = static_cast<uint64_t*>(
+                     ob_malloc(word_cnt * sizeof(uint64_t), ObNewModIds::OB_KVSTORE_CACHE)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(ERROR, "Fail to allocate memory for freq sketch, ", K(word_cnt), K(ret));
+    } else {
+      MEMSET(table_, 0, word_cnt * sizeof(uint64_t));
+      word_cnt_ = word_cnt;
+      sample_size_ = word_cnt * COUNTERS_PER_WORD / ROW_CNT * SAMPLE_FACTOR;
+      add_cnt_ = 0;
+    }
+  }
+  return ret;
+}
+
+void ObKVCacheFreqSketch::destroy()
+{
+  if (NULL != table_) {
+    ob_free(table_);
+    table_ = NULL;
+  }
+  word_cnt_ = 0;
+  sample_size_ = 0;
+  add_cnt_ = 0;
+}
+
+int64_t ObKVCacheFreqSketch::word_idx(const uint64_t hash, const int64_t row) const
+{
+  uint64_t h = (hash + FREQ_SKETCH_SEEDS[row]) * FREQ_SKETCH_SEEDS[row];
+  h ^= (h >> 32);
+  return static_cast<int64_t>(h & (word_cnt_ - 1));
+}
+
+int64_t ObKVCacheFreqSketch::counter_offset(const uint64_t hash, const int64_t row) const
+{
+  // each row owns 4 counters of a word, pick one of them by 2 bits of the hash
+  return ((row << 2) + static_cast<int64_t>((hash >> (row << 1)) & 3)) << 2;
+}
+
+bool ObKVCacheFreqSketch::increment_at(const int64_t idx, const int64_t offset)
+{
+  bool added = false;
+  const uint64_t mask = 0xFULL << offset;
+  uint64_t old_word = ATOMIC_LOAD(&table_[idx]);
+  while ((old_word & mask) != mask) {
+    const uint64_t new_word = old_word + (1ULL << offset);
+    const uint64_t cur_word = ATOMIC_VCAS(&table_[idx], old_word, new_word);
+    if (cur_word == old_word) {
+      added = true;
+      break;
+    }
+    old_word = cur_word;
+  }
+  return added;
+}
+
+void ObKVCacheFreqSketch::increment(const uint64_t hash)
+{
+  if (OB_LIKELY(NULL != table_)) {
+    bool added = false;
+    for (int64_t row = 0; row < ROW_CNT; ++row) {
+      added = increment_at(word_idx(hash, row), counter_offset(hash, row)) || added;
+    }
+    if (added && ATOMIC_AAF(&add_cnt_, 1) == sample_size_) {
+      // only the thread reaching the sample size does aging
+      age();
+    }
+  }
+}
+
+int64_t ObKVCacheFreqSketch::estimate(const uint64_t hash) const
+{
+  int64_t freq = MAX_FREQ;
+  if (OB_LIKELY(NULL != table_)) {
+    for (int64_t row = 0; row < ROW_CNT; ++row) {
+      const int64_t offset = counter_offset(hash, row);
+      const int64_t count = static_cast<int64_t>((ATOMIC_LOAD(&table_[word_idx(hash, row)]) >> offset) & 0xF);
+      freq = count < freq ? count : freq;
+    }
+  } else {
+    freq = 0;
+  }
+  return freq;
+}
+
+void ObKVCacheFreqSketch::age()
+{
+  if (NULL != table_) {
+    for (int64_t i = 0; i < word_cnt_; ++i) {
+      uint64_t old_word = ATOMIC_LOAD(&table_[i]);
+      uint64_t cur_word = 0;
+      while (old_word != (cur_word = ATOMIC_VCAS(&table_[i], old_word, (old_word >> 1) & FREQ_SKETCH_HALF_MASK))) {
+        old_word = cur_word;
+      }
+    }
+    ATOMIC_STORE(&add_cnt_, sample_size_ / 2);
+  }
+}
+
+}  // end namespace common
+}  // end namespace oceanbase
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_CACHE_OB_KVCACHE_FREQ_SKETCH_H_
+#define OCEANBASE_CACHE_OB_KVCACHE_FREQ_SKETCH_H_
+
+#include "share/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace common {
+
+/*
+ * Count-min sketch with 4-bit counters, used to estimate the recent access frequency of kvcache keys.
+ * Each 64-bit word holds 16 counters, each of the 4 hash rows owns 4 of them, so one key only touches
+ * 4 words. All counters are halved after sample_size_ increments, which makes the estimation
+ * favor the recent accesses.
+ */
+class ObKVCacheFreqSketch {
+  public:
+  static const int64_t DEFAULT_COUNTER_CNT = 1L << 22;  // 2MB memory
+  static const int64_t MAX_FREQ = 15;
+  ObKVCacheFreqSketch();
+  virtual ~ObKVCacheFreqSketch();
+  int init(const int64_t counter_cnt);
+  void destroy();
+  void increment(const uint64_t hash);
+  int64_t estimate(const uint64_t hash) const;
+  // halve all counters
+  void age();
+  bool is_inited() const
+  {
+    return NULL != table_;
+  }
+  TO_STRING_KV(KP_(table), K_(word_cnt), K_(sample_size), K_(add_cnt));
+
+  private:
+  static const int64_t ROW_CNT = 4;
+  static const int64_t COUNTERS_PER_WORD = 16;
+  static const int64_t SAMPLE_FACTOR = 10;
+  inline int64_t word_idx(const uint64_t hash, const int64_t row) const;
+  inline int64_t counter_offset(const uint64_t hash, const int64_t row) const;
+  bool increment_at(const int64_t idx, const int64_t offset);
+
+  private:
+  uint64_t* table_;
+  int64_t word_cnt_;
+  int64_t sample_size_;
+  int64_t add_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheFreqSketch);
+};
+
+}  // end namespace common
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_CACHE_OB_KVCACHE_FREQ_SKETCH_H_
@@ -37,7 +37,9 @@ ObKVCacheStore::ObKVCacheStore()
       mb_ptr_free_heap_(),
       tenant_reserve_mem_ratio_(TENANT_RESERVE_MEM_RATIO),
       wash_itid_(-1),
-      tenant_mgr_(NULL)
+      tenant_mgr_(NULL),
+      admission_enabled_(false),
+      freq_sketch_()
 {}
 
 ObKVCacheStore::~ObKVCacheStore()
@@ -78,6 +80,8 @@ int ObKVCacheStore::init(
     if (OB_SUCC(ret)) {
       if (OB_FAIL(prepare_wash_structs())) {
         COMMON_LOG(WARN, "preapre wash structs failed", K(ret));
+      } else if (OB_FAIL(freq_sketch_.init(ObKVCacheFreqSketch::DEFAULT_COUNTER_CNT))) {
+        COMMON_LOG(WARN, "Fail to init freq sketch, ", K(ret));
       }
     }
   }
@@ -119,6 +123,8 @@ void ObKVCacheStore::destroy()
   insts_ = NULL;
 
   destroy_wash_structs();
+  freq_sketch_.destroy();
+  admission_enabled_ = false;
   inited_ = false;
 }
 
@@ -228,6 +234,7 @@ void ObKVCacheStore::refresh_score()
           score = mb_handles_[i].score_;
           score = score * CACHE_SCORE_DECAY_FACTOR + (double)(mb_handles_[i].recent_get_cnt_ * priority);
           mb_handles_[i].score_ = score;
+          refresh_segment(mb_handles_[i]);
           ATOMIC_STORE(&mb_handles_[i].recent_get_cnt_, 0);
         }
         de_handle_ref(&mb_handles_[i]);
@@ -237,6 +244,73 @@ void ObKVCacheStore::refresh_score()
   return;
 }
 
+void ObKVCacheStore::refresh_segment(ObKVMemBlockHandle& mb_handle)
+{
+  ObKVCacheStatus& status = mb_handle.inst_->status_;
+  if (FULL == ATOMIC_LOAD(&mb_handle.status_)) {
+    const int64_t recent_get_cnt = ATOMIC_LOAD(&mb_handle.recent_get_cnt_);
+    if (PROBATION == mb_handle.segment_) {
+      const int64_t mb_cnt = ATOMIC_LOAD(&status.lru_mb_cnt_) + ATOMIC_LOAD(&status.lfu_mb_cnt_);
+      if (recent_get_cnt >= PROMOTE_GET_CNT &&
+          ATOMIC_LOAD(&status.protected_mb_cnt_) * 100 < mb_cnt * MAX_PROTECTED_PERCENTAGE) {
+        mb_handle.segment_ = PROTECTED;
+        (void)ATOMIC_AAF(&status.protected_mb_cnt_, 1);
+      }
+    } else if (0 == recent_get_cnt && mb_handle.score_ < status.base_mb_score_) {
+      // not accessed any more, give it back to probation segment
+      mb_handle.segment_ = PROBATION;
+      (void)ATOMIC_SAF(&status.protected_mb_cnt_, 1);
+    }
+  }
+}
+
+void ObKVCacheStore::refresh_admission()
+{
+  int ret = OB_SUCCESS;
+  ObKVCacheInst* inst = NULL;
+  TenantWashInfo* tenant_wash_info = NULL;
+  const bool admission_enabled = is_admission_enabled();
+  for (int64_t i = 0; i < inst_handles_.count(); ++i) {
+    bool need_admission = false;
+    if (NULL != (inst = inst_handles_.at(i).get_inst())) {
+      if (admission_enabled && OB_SUCC(tenant_wash_map_.get(inst->tenant_id_, tenant_wash_info))) {
+        need_admission = tenant_wash_info->wash_size_ > 0;
+      }
+      ATOMIC_STORE(&inst->status_.need_admission_, need_admission);
+    }
+  }
+}
+
+void ObKVCacheStore::set_admission_enabled(const bool enabled)
+{
+  if (enabled != is_admission_enabled()) {
+    ATOMIC_STORE(&admission_enabled_, enabled);
+    COMMON_LOG(INFO, "set kvcache admission", K(enabled));
+  }
+}
+
+void ObKVCacheStore::record_access(const int64_t cache_id, const ObIKVCacheKey& key)
+{
+  if (is_admission_enabled()) {
+    freq_sketch_.increment(key.hash() + cache_id);
+  }
+}
+
+bool ObKVCacheStore::admit(ObKVCacheInst& inst, const ObIKVCacheKey& key)
+{
+  bool admitted = true;
+  if (need_admission(inst)) {
+    // the cache is full, only keys accessed repeatedly are worth evicting others
+    if (freq_sketch_.estimate(key.hash() + inst.cache_id_) >= ADMIT_FREQ) {
+      inst.status_.total_admit_cnt_.inc();
+    } else {
+      admitted = false;
+      inst.status_.total_reject_cnt_.inc();
+    }
+  }
+  return admitted;
+}
+
 void ObKVCacheStore::wash()
 {
   int ret = OB_SUCCESS;
@@ -257,6 +331,7 @@ void ObKVCacheStore::wash()
 
   // compute the wash size of each tenant
   compute_tenant_wash_size();
+  refresh_admission();
   cur_time = ObTimeUtility::current_time();
   int64_t compute_wash_size_time = cur_time - start_time;
   start_time = cur_time;
@@ -862,6 +937,10 @@ int ObKVCacheStore::do_wash_mb(ObKVMemBlockHandle* mb_handle, void*& buf, int64_
       } else {
         (void)ATOMIC_SAF(&mb_handle->inst_->status_.lfu_mb_cnt_, 1);
       }
+      if (PROTECTED == mb_handle->segment_) {
+        mb_handle->segment_ = PROBATION;
+        (void)ATOMIC_SAF(&mb_handle->inst_->status_.protected_mb_cnt_, 1);
+      }
     }
     buf = mb_handle->mem_block_;
     mb_size = mb_handle->mem_block_->get_align_size();
@@ -1116,7 +1195,11 @@ bool ObKVCacheStore::StoreMBHandleCmp::operator()(const ObKVMemBlockHandle* a, c
 {
   bool bret = false;
   if (NULL != a && NULL != b) {
-    bret = a->score_ < b->score_;
+    if (a->segment_ != b->segment_) {
+      bret = a->segment_ < b->segment_;
+    } else {
+      bret = a->score_ < b->score_;
+    }
   }
   return bret;
 }
@@ -17,6 +17,7 @@
 #include "lib/resource/ob_cache_washer.h"
 #include "ob_kvcache_struct.h"
 #include "ob_kvcache_inst_map.h"
+#include "ob_kvcache_freq_sketch.h"
 #include "ob_cache_utils.h"
 
 namespace oceanbase {
@@ -58,6 +59,19 @@ class ObKVCacheStore : public ObIKVCacheStore<ObKVMemBlockHandle>, public ObIMBH
   int get_avg_cache_item_size(const uint64_t tenant_id, const int64_t cache_id, int64_t& avg_cache_item_size);
   int sync_wash_mbs(const uint64_t tenant_id, const int64_t wash_size, const bool wash_single_mb,
       lib::ObICacheWasher::ObCacheMemBlock*& wash_blocks);
+  // admission of new kvpairs, only takes effect on tenants under memory pressure
+  void set_admission_enabled(const bool enabled);
+  bool is_admission_enabled() const
+  {
+    return ATOMIC_LOAD(&admission_enabled_);
+  }
+  // new kvpairs of %inst must pass admit() now
+  bool need_admission(const ObKVCacheInst& inst) const
+  {
+    return is_admission_enabled() && ATOMIC_LOAD(&inst.status_.need_admission_);
+  }
+  void record_access(const int64_t cache_id, const ObIKVCacheKey& key);
+  bool admit(ObKVCacheInst& inst, const ObIKVCacheKey& key);
 
   virtual int alloc_mbhandle(ObKVCacheInst& inst, const int64_t block_size, ObKVMemBlockHandle*& mb_handle);
   virtual int alloc_mbhandle(ObKVCacheInst& inst, ObKVMemBlockHandle*& mb_handle);
@@ -85,6 +99,11 @@ class ObKVCacheStore : public ObIKVCacheStore<ObKVMemBlockHandle>, public ObIMBH
   static const int64_t RETIRE_LIMIT = 16;
   static const int64_t WASH_THREAD_RETIRE_LIMIT = 2048;
   static const int64_t SUPPLY_MB_NUM_ONCE = 128;
+  // memory block got at least PROMOTE_GET_CNT gets in last wash period is promoted to protected segment
+  static const int64_t PROMOTE_GET_CNT = 2;
+  static const int64_t MAX_PROTECTED_PERCENTAGE = 80;
+  // key accessed less than ADMIT_FREQ times recently is not admitted
+  static const int64_t ADMIT_FREQ = 2;
   struct StoreMBHandleCmp {
     bool operator()(const ObKVMemBlockHandle* a, const ObKVMemBlockHandle* b) const;
   };
@@ -120,6 +139,8 @@ class ObKVCacheStore : public ObIKVCacheStore<ObKVMemBlockHandle>, public ObIMBH
   int alloc_mbhandle(
       ObKVCacheInst& inst, const enum ObKVCachePolicy policy, const int64_t block_size, ObKVMemBlockHandle*& mb_handle);
   void compute_tenant_wash_size();
+  void refresh_segment(ObKVMemBlockHandle& mb_handle);
+  void refresh_admission();
   void wash_mb(ObKVMemBlockHandle* mb_handle);
   void wash_mbs(WashHeap& heap);
   bool try_wash_mb(ObKVMemBlockHandle* mb_handle, const uint64_t tenant_id, void*& buf, int64_t& mb_size);
@@ -173,6 +194,10 @@ class ObKVCacheStore : public ObIKVCacheStore<ObKVMemBlockHandle>, public ObIMBH
 
   int64_t wash_itid_;
   const ObITenantMgr* tenant_mgr_;
+
+  // data structures for admission
+  bool admission_enabled_;
+  ObKVCacheFreqSketch freq_sketch_;
 };
 
 template <typename MBWrapper>
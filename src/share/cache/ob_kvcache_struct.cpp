@@ -56,6 +56,7 @@ void ObKVCacheStatus::reset()
   map_size_ = 0;
   lru_mb_cnt_ = 0;
   lfu_mb_cnt_ = 0;
+  protected_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
   total_miss_cnt_ = 0;
@@ -63,6 +64,9 @@ void ObKVCacheStatus::reset()
   base_mb_score_ = 0;
   hold_size_ = 0;
   total_miss_cnt_ = 0;
+  need_admission_ = false;
+  total_admit_cnt_.reset();
+  total_reject_cnt_.reset();
 }
 
 /*
@@ -257,6 +261,7 @@ ObKVMemBlockHandle::ObKVMemBlockHandle()
       status_(FREE),
       inst_(NULL),
       policy_(LRU),
+      segment_(PROBATION),
       get_cnt_(0),
       recent_get_cnt_(0),
       score_(0),
@@ -272,6 +277,7 @@ void ObKVMemBlockHandle::reset()
   status_ = FREE;
   inst_ = NULL;
   policy_ = LRU;
+  segment_ = PROBATION;
   get_cnt_ = 0;
   recent_get_cnt_ = 0;
   score_ = 0;
@@ -106,6 +106,12 @@ enum ObKVMBHandleStatus {
   FULL = 2,
 };
 
+// memory blocks in probation segment are washed before the ones in protected segment
+enum ObKVMBSegment {
+  PROBATION = 0,
+  PROTECTED = 1,
+};
+
 class ObKVCacheInst;
 class ObWorkingSet;
 struct ObKVMemBlockHandle : public common::ObDLink {
@@ -113,6 +119,7 @@ struct ObKVMemBlockHandle : public common::ObDLink {
   volatile enum ObKVMBHandleStatus status_;
   ObKVCacheInst* inst_;
   enum ObKVCachePolicy policy_;
+  enum ObKVMBSegment segment_;
   int64_t get_cnt_;
   int64_t recent_get_cnt_;
   double score_;
@@ -144,7 +151,8 @@ struct ObKVMemBlockHandle : public common::ObDLink {
     return this;
   }
   TO_STRING_KV(
-      KP_(mem_block), K_(status), KP_(inst), K_(policy), K_(get_cnt), K_(recent_get_cnt), K_(score), K_(kv_cnt));
+      KP_(mem_block), K_(status), KP_(inst), K_(policy), K_(segment), K_(get_cnt), K_(recent_get_cnt), K_(score),
+      K_(kv_cnt));
 };
 
 struct ObKVCacheInstKey {
@@ -201,8 +209,8 @@ struct ObKVCacheStatus {
     return ATOMIC_LOAD(&hold_size_);
   }
   void reset();
-  TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt), K_(lfu_mb_cnt), K_(base_mb_score),
-      K_(hold_size));
+  TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt), K_(lfu_mb_cnt),
+      K_(protected_mb_cnt), K_(base_mb_score), K_(hold_size), K_(need_admission));
 
   const ObKVCacheConfig* config_;
   ObPCNonAtomicCounter total_put_cnt_;
@@ -211,12 +219,17 @@ struct ObKVCacheStatus {
   int64_t store_size_;
   int64_t lru_mb_cnt_;
   int64_t lfu_mb_cnt_;
+  int64_t protected_mb_cnt_;
   int64_t map_size_;
   int64_t last_hit_cnt_;
   int64_t total_miss_cnt_;
   double base_mb_score_;
   // guarantee at least hold_size_ memory left in cache after wash
   int64_t hold_size_;
+  // set by wash thread when the tenant is under memory pressure, new kvpairs must pass admission then
+  bool need_admission_;
+  ObPCNonAtomicCounter total_admit_cnt_;
+  ObPCNonAtomicCounter total_reject_cnt_;
 };
 
 struct ObKVCacheInfo {
@@ -3372,6 +3372,36 @@ int ObInnerTableSchema::all_virtual_kvcache_info_schema(ObTableSchema& table_sch
         false,                      // is_nullable
         false);                     // is_autoincrement
   }
+
+  if (OB_SUCC(ret)) {
+    ADD_COLUMN_SCHEMA("total_admit_cnt",  // column_name
+        ++column_id,                      // column_id
+        0,                                // rowkey_id
+        0,                                // index_id
+        0,                                // part_key_pos
+        ObIntType,                        // column_type
+        CS_TYPE_INVALID,                  // column_collation_type
+        sizeof(int64_t),                  // column_length
+        -1,                               // column_precision
+        -1,                               // column_scale
+        false,                            // is_nullable
+        false);                           // is_autoincrement
+  }
+
+  if (OB_SUCC(ret)) {
+    ADD_COLUMN_SCHEMA("total_reject_cnt",  // column_name
+        ++column_id,                       // column_id
+        0,                                 // rowkey_id
+        0,                                 // index_id
+        0,                                 // part_key_pos
+        ObIntType,                         // column_type
+        CS_TYPE_INVALID,                   // column_collation_type
+        sizeof(int64_t),                   // column_length
+        -1,                                // column_precision
+        -1,                                // column_scale
+        false,                             // is_nullable
+        false);                            // is_autoincrement
+  }
   if (OB_SUCC(ret)) {
     table_schema.get_part_option().set_part_func_type(PARTITION_FUNC_TYPE_HASH);
     if (OB_FAIL(table_schema.get_part_option().set_part_expr("hash (addr_to_partition_id(svr_ip, svr_port))"))) {
@@ -447,7 +447,10 @@ const int64_t OB_STATUS_LENGTH = 64;
 
 ///////////////////////////
 //// used for replay
-const int64_t REPLAY_TASK_QUEUE_SIZE = 4;
+// trans logs of one partition are dispatched to the replay task queues by trans id, so that
+// logs of different transactions are replayed in parallel while each transaction keeps its order.
+// Max count of replay task queues, the count in use is specified by _replay_task_queue_count.
+const int64_t REPLAY_TASK_QUEUE_SIZE = 8;
 inline int64_t& get_replay_queue_index()
 {
   static __thread int64_t replay_queue_index = -1;
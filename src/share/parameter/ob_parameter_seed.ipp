@@ -246,6 +246,11 @@ DEF_BOOL(enable_sql_operator_dump, OB_CLUSTER_PARAMETER, "True",
 DEF_CAP(_chunk_row_store_mem_limit, OB_CLUSTER_PARAMETER, "0B", "[0,]",
     "the maximum size of memory used by ChunkRowStore, 0 means follow operator's setting. Range: [0, +∞)",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_chunk_row_store_compress_func, OB_CLUSTER_PARAMETER, "none",
+    common::ObConfigPerfCompressFuncChecker,
+    "compressor used for blocks of ChunkDatumStore dumped to disk, blocks which can not be compressed well "
+    "are written uncompressed. Values: none, lz4_1.0, zstd_1.0, zstd_1.3.8",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR_WITH_CHECKER(tableapi_transport_compress_func, OB_CLUSTER_PARAMETER, "none",
     common::ObConfigCompressFuncChecker,
     "compressor used for tableAPI query result. Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0 zstd 1.3.8",
@@ -382,6 +387,11 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "False",
     "Enable DTL send message with compression"
     "Value: True: enable compression False: disable compression",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_message_columnar_encoding, OB_TENANT_PARAMETER, "True",
+    "Transpose DTL datum rows to column major layout before compression, "
+    "only takes effect when _px_message_compression is enabled. "
+    "Value: True: enable columnar encoding False: disable columnar encoding",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
     "the ratio of the dtl buffer manager list. Range: [1, 128]",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -401,6 +411,17 @@ DEF_BOOL(_enable_filter_push_down_storage, OB_TENANT_PARAMETER, "False",
     "Enable filter push down to storage"
     "Value:  True:turned on  False: turned off",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_rowsets_enabled, OB_TENANT_PARAMETER, "False",
+    "enable vectorized (batch of rows) execution for the plans whose operators all support it "
+    "Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_rowsets_max_rows, OB_TENANT_PARAMETER, "256", "[1, 1024]",
+    "max rows of one batch in vectorized execution. Range: [1, 1024]",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_runtime_join_filter, OB_TENANT_PARAMETER, "True",
+    "enable hash join to build runtime filter from build side join keys and push it to probe side table scan "
+    "Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_WORK_AREA_POLICY(workarea_size_policy, OB_TENANT_PARAMETER, "AUTO",
     "policy used to size SQL working areas (MANUAL/AUTO)",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -505,7 +526,7 @@ DEF_TIME(get_leader_candidate_rpc_timeout, OB_CLUSTER_PARAMETER, "9s", "[2s, 180
     "the time during a get leader candidate rpc request "
     "is permitted to execute before it is terminated. Range: [2s, 180s]",
     ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
-DEF_STR(min_observer_version, OB_CLUSTER_PARAMETER, "3.1.0", "the min observer version",
+DEF_STR(min_observer_version, OB_CLUSTER_PARAMETER, "3.1.1", "the min observer version",
     ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_ddl, OB_CLUSTER_PARAMETER, "True",
     "specifies whether DDL operation is turned on. "
@@ -763,12 +784,20 @@ DEF_TIME(_ob_clog_timeout_to_force_switch_leader, OB_CLUSTER_PARAMETER, "0s", "[
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_ob_clog_disk_buffer_cnt, OB_CLUSTER_PARAMETER, "64", "[1, 2000]", "clog disk buffer cnt. Range: [1, 2000]",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_clog_group_commit_max_wait_time, OB_CLUSTER_PARAMETER, "1ms", "[0ms, 10ms]",
+    "the max time clog writer waits for more logs to join a write when the arrival rate is high, "
+    "it never exceeds the measured flush time. 0 means no wait. Range: [0ms, 10ms]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_TIME(_ob_trans_rpc_timeout, OB_CLUSTER_PARAMETER, "3s", "[0s, 3600s]",
     "transaction rpc timeout(s). Range: [0s, 3600s]",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_early_lock_release, OB_TENANT_PARAMETER, "False", "enable early lock release",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_INT(_replay_task_queue_count, OB_CLUSTER_PARAMETER, "4", "[1, 8]",
+    "count of replay task queues of each partition, trans logs of different queues are replayed in parallel. "
+    "Only takes effect on the partitions created or loaded later. Range: [1, 8]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(__enable_block_receiving_clog, OB_CLUSTER_PARAMETER, "True",
     "If this option is set to true, block receiving clog for slave replicas when too much clog is waiting for beening "
     "submited to replaying. The default is true",
@@ -885,6 +914,14 @@ DEF_INT(sys_bkgd_net_percentage, OB_CLUSTER_PARAMETER, "60", "[0,100]",
 DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8", common::ObConfigEvenIntChecker, "[2,32]",
     "The number of io threads on each disk. The default value is 8. Range: [2,32] in even integer",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether disk io is submitted by io_uring instead of libaio, fallback to libaio if io_uring is not "
+    "supported by kernel. Value: True: turned on False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring_sqpoll, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether io_uring submission queue is polled by kernel thread, only take effect if _enable_io_uring "
+    "is turned on. Value: True: turned on False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(_io_callback_thread_count, OB_CLUSTER_PARAMETER, "8", "[1,64]",
     "The number of io callback threads. The default value is 8. Range: [1,64] in integer",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -1008,8 +1045,17 @@ DEF_INT(_migrate_block_verify_level, OB_CLUSTER_PARAMETER, "1", "[0,2]",
     "2 : logical verification",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_INT(_micro_block_compress_thread_count, OB_CLUSTER_PARAMETER, "4", "[0,64]",
+    "the number of threads compressing micro blocks for the merge threads, "
+    "0 means micro blocks are compressed by the merge thread itself. Range: [0,64] in integer",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+
 DEF_TIME(_cache_wash_interval, OB_CLUSTER_PARAMETER, "200ms", "[1ms, 1m]", "specify interval of cache background wash",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_kvcache_admission, OB_CLUSTER_PARAMETER, "False",
+    "enable frequency based admission of kvcache when tenant memory is under pressure, so that scan workloads "
+    "can not wash out the hot kvpairs. Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(_max_partition_cnt_per_server, OB_CLUSTER_PARAMETER, "500000", "[10000, 500000]",
     "specify max partition count on one observer",
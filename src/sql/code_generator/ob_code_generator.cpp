@@ -16,6 +16,11 @@
 #include "sql/code_generator/ob_code_generator_impl.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
+#include "sql/optimizer/ob_log_plan.h"
+#include "sql/optimizer/ob_log_table_scan.h"
+#include "sql/optimizer/ob_log_group_by.h"
+#include "sql/optimizer/ob_log_join.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
 namespace sql {
@@ -28,7 +33,11 @@ int ObCodeGenerator::generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_pla
       LOG_WARN("fail to generate old plan", K(ret));
     }
   } else {
-    if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
+    int64_t batch_size = 0;
+    if (OB_FAIL(detect_batch_size(log_plan, batch_size))) {
+      LOG_WARN("detect batch size failed", K(ret));
+    } else if (FALSE_IT(phy_plan.set_batch_size(batch_size))) {
+    } else if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
       LOG_WARN("fail to get all raw exprs", K(ret));
     } else if (OB_FAIL(generate_operators(log_plan, phy_plan))) {
       LOG_WARN("fail to generate plan", K(ret));
@@ -55,6 +64,7 @@ int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& p
   ObStaticEngineExprCG expr_cg(phy_plan.get_allocator(), param_store_);
   // init ctx for operator cg
   expr_cg.init_operator_cg_ctx(log_plan.get_optimizer_context().get_exec_ctx());
+  expr_cg.set_batch_size(phy_plan.get_batch_size());
   ObRawExprUniqueSet all_raw_exprs(phy_plan.get_allocator());
   if (OB_FAIL(all_raw_exprs.init())) {
     LOG_WARN("fail to create hash set", K(ret));
@@ -80,6 +90,83 @@ int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPla
   return ret;
 }
 
+int ObCodeGenerator::detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size)
+{
+  int ret = OB_SUCCESS;
+  batch_size = 0;
+  bool enabled = false;
+  int64_t max_rows = 0;
+  const ObSQLSessionInfo* session = log_plan.get_optimizer_context().get_session_info();
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is NULL", K(ret));
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      enabled = tenant_config->_rowsets_enabled;
+      max_rows = tenant_config->_rowsets_max_rows;
+    }
+  }
+  if (OB_SUCC(ret) && enabled && max_rows > 0 && NULL != log_plan.get_stmt() &&
+      log_plan.get_stmt()->is_select_stmt()) {
+    ObSEArray<const ObLogPlan*, 4> plans;
+    bool vectorizable = true;
+    if (OB_FAIL(get_all_log_plan(&log_plan, plans))) {
+      LOG_WARN("get all log plan failed", K(ret));
+    } else if (plans.count() > 1) {
+      // subplan filter and subquery expressions evaluate in row by row
+      vectorizable = false;
+    } else if (OB_FAIL(check_vectorizable(log_plan.get_plan_root(), vectorizable))) {
+      LOG_WARN("check vectorizable failed", K(ret));
+    }
+    if (OB_SUCC(ret) && vectorizable) {
+      batch_size = max_rows;
+    }
+  }
+  LOG_DEBUG("detect batch size", K(ret), K(enabled), K(max_rows), K(batch_size));
+  return ret;
+}
+
+int ObCodeGenerator::check_vectorizable(ObLogicalOperator* op, bool& vectorizable)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(op)) {
+    vectorizable = false;
+  } else if (OB_FAIL(check_stack_overflow())) {
+    LOG_WARN("check stack overflow failed", K(ret));
+  } else {
+    switch (op->get_type()) {
+      case log_op_def::LOG_TABLE_SCAN: {
+        ObLogTableScan* tsc = static_cast<ObLogTableScan*>(op);
+        vectorizable = !tsc->get_is_fake_cte_table() && !tsc->is_sample_scan() &&
+                       !tsc->get_is_multi_part_table_scan() && !tsc->is_for_update() &&
+                       !is_virtual_table(tsc->get_ref_table_id());
+        break;
+      }
+      case log_op_def::LOG_GROUP_BY: {
+        ObLogGroupBy* group_by = static_cast<ObLogGroupBy*>(op);
+        vectorizable = (HASH_AGGREGATE == group_by->get_algo() || SCALAR_AGGREGATE == group_by->get_algo()) &&
+                       !group_by->has_rollup();
+        break;
+      }
+      case log_op_def::LOG_JOIN: {
+        vectorizable = HASH_JOIN == static_cast<ObLogJoin*>(op)->get_join_algo();
+        break;
+      }
+      default: {
+        vectorizable = false;
+        break;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && vectorizable && i < op->get_num_of_child(); i++) {
+      if (OB_FAIL(check_vectorizable(op->get_child(i), vectorizable))) {
+        LOG_WARN("check vectorizable failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObCodeGenerator::get_plan_all_exprs(const ObLogPlan& plan, ObRawExprUniqueSet& exprs)
 {
   int ret = OB_SUCCESS;
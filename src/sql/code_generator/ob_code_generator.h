@@ -49,6 +49,11 @@ class ObCodeGenerator {
 
   int generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
 
+  // detect max batch size of vectorized execution, zero if plan can not be vectorized.
+  // All operators of the plan should support vectorized execution, no mixed plan.
+  int detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size);
+  int check_vectorizable(ObLogicalOperator* op, bool& vectorizable);
+
   // get all raw exprs of logical plan (include the subplans)
   int get_plan_all_exprs(const ObLogPlan& plan, ObRawExprUniqueSet& exprs);
 
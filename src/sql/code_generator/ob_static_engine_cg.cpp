@@ -426,6 +426,7 @@ int ObStaticEngineCG::generate_spec_basic(ObLogicalOperator& op, ObOpSpec& spec,
   spec.width_ = op.get_width();
   spec.plan_depth_ = op.get_plan_depth();
   spec.px_est_size_factor_ = op.get_px_est_size_factor();
+  spec.max_batch_size_ = phy_plan_->get_batch_size();
 
   OZ(generate_rt_exprs(op.get_startup_exprs(), spec.startup_filters_));
 
@@ -4410,6 +4411,8 @@ int ObStaticEngineCG::generate_join_spec(ObLogJoin& op, ObJoinSpec& spec)
           LOG_WARN("failed to append join keys", K(ret));
         } else if (OB_FAIL(append(hj_spec.all_hash_funcs_, right_hash_funcs))) {
           LOG_WARN("failed to append join keys", K(ret));
+        } else if (OB_FAIL(generate_hash_join_filter(op, hj_spec, right_key_exprs))) {
+          LOG_WARN("failed to generate hash join filter", K(ret));
         }
       }
     }
@@ -4742,6 +4745,55 @@ int ObStaticEngineCG::add_fk_arg_to_phy_op(ObForeignKeyArg& fk_arg, uint64_t nam
   return ret;
 }
 
+// The runtime join filter is pushed to the table scan which outputs the right join keys
+// directly, granule iterator is transparent. Table scan across exchange (in another DFO)
+// is not supported.
+int ObStaticEngineCG::generate_hash_join_filter(
+    ObLogJoin& op, ObHashJoinSpec& spec, const common::ObIArray<ObExpr*>& right_keys)
+{
+  int ret = OB_SUCCESS;
+  bool enabled = false;
+  const ObOpSpec* left = spec.get_left();
+  const ObOpSpec* right = spec.get_right();
+  ObBasicSessionInfo* session_info = op.get_plan()->get_optimizer_context().get_session_info();
+  if (OB_ISNULL(left) || OB_ISNULL(right)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("hash join child is NULL", K(ret), KP(left), KP(right));
+  } else if (OB_NOT_NULL(session_info) && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_3101) {
+    // the table scan of observer before 3.1.1 can not apply the join filter in upgrading
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session_info->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      enabled = tenant_config->_enable_runtime_join_filter;
+    }
+  }
+  // right rows which can not find a match are not needed only for these join types
+  if (OB_SUCC(ret) && enabled && !right_keys.empty() &&
+      (INNER_JOIN == spec.join_type_ || LEFT_SEMI_JOIN == spec.join_type_ || LEFT_ANTI_JOIN == spec.join_type_ ||
+          LEFT_OUTER_JOIN == spec.join_type_ || RIGHT_SEMI_JOIN == spec.join_type_)) {
+    while (PHY_GRANULE_ITERATOR == right->type_ && 1 == right->get_child_cnt() && NULL != right->get_child()) {
+      right = right->get_child();
+    }
+    if (PHY_TABLE_SCAN == right->type_ && left->rows_ < right->rows_) {
+      const ObTableScanSpec* tsc = static_cast<const ObTableScanSpec*>(right);
+      bool keys_in_output = !tsc->is_vt_mapping_ && !tsc->batch_scan_flag_;
+      for (int64_t i = 0; keys_in_output && i < right_keys.count(); i++) {
+        keys_in_output = has_exist_in_array(tsc->output_, right_keys.at(i));
+      }
+      if (keys_in_output) {
+        spec.join_filter_scan_id_ = tsc->id_;
+        spec.join_filter_bits_ = left->rows_ * 8;
+        LOG_TRACE("push runtime join filter to table scan",
+            K(spec.id_),
+            K(tsc->id_),
+            K(left->rows_),
+            K(right->rows_),
+            K(spec.join_filter_bits_));
+      }
+    }
+  }
+  return ret;
+}
+
 bool ObStaticEngineCG::enable_pushdown_filter_to_storage(const ObLogTableScan& op)
 {
   int ret = OB_SUCCESS;
@@ -232,6 +232,8 @@ class ObStaticEngineCG : public ObCodeGeneratorImpl {
   int generate_spec(ObLogJoin& op, ObMergeJoinSpec& spec, const bool in_root_job);
 
   int generate_join_spec(ObLogJoin& op, ObJoinSpec& spec);
+  // push runtime join filter of hash join to the probe side table scan
+  int generate_hash_join_filter(ObLogJoin& op, ObHashJoinSpec& spec, const common::ObIArray<ObExpr*>& right_keys);
 
   int set_optimization_info(ObLogTableScan& op, ObTableScanSpec& spec);
   int set_partition_range_info(ObLogTableScan& op, ObTableScanSpec& spec);
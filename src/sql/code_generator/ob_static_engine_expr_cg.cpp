@@ -308,6 +308,11 @@ int ObStaticEngineExprCG::cg_expr_by_operator(const ObIArray<ObRawExpr*>& raw_ex
             KP(rt_expr->eval_func_),
             K(*raw_expr),
             K(*rt_expr));
+      } else if (NULL != rt_expr->eval_batch_func_ &&
+                 OB_INVALID_INDEX ==
+                     ObFuncSerialization::get_serialize_index(reinterpret_cast<void*>(rt_expr->eval_batch_func_))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("batch evaluate function not serializable", K(ret), K(*raw_expr), K(*rt_expr));
       } else if (rt_expr->inner_func_cnt_ > 0) {
         if (OB_ISNULL(rt_expr->inner_functions_)) {
           ret = OB_ERR_UNEXPECTED;
@@ -448,7 +453,9 @@ int ObStaticEngineExprCG::cg_const_frame_layout(
 {
   const bool reserve_empty_string = true;
   const bool continuous_datum = true;
-  return cg_frame_layout(const_exprs, reserve_empty_string, continuous_datum, frame_index_pos, frame_info_arr);
+  const bool batch_result = false;
+  return cg_frame_layout(
+      const_exprs, reserve_empty_string, continuous_datum, batch_result, frame_index_pos, frame_info_arr);
 }
 
 int ObStaticEngineExprCG::cg_param_frame_layout(
@@ -516,7 +523,8 @@ int ObStaticEngineExprCG::cg_dynamic_frame_layout(
 {
   const bool reserve_empty_string = true;
   const bool continuous_datum = true;
-  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, frame_index_pos, frame_info_arr);
+  const bool batch_result = false;
+  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, batch_result, frame_index_pos, frame_info_arr);
 }
 
 int ObStaticEngineExprCG::cg_datum_frame_layout(
@@ -525,11 +533,14 @@ int ObStaticEngineExprCG::cg_datum_frame_layout(
   const bool reserve_empty_string = false;
   // const bool continuous_datum = false;
   const bool continuous_datum = true;
-  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, frame_index_pos, frame_info_arr);
+  // only the exprs of datum frame are batch result in vectorized execution
+  const bool batch_result = batch_size_ > 0;
+  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, batch_result, frame_index_pos, frame_info_arr);
 }
 
 int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, const bool reserve_empty_string,
-    const bool continuous_datum, int64_t& frame_index_pos, ObIArray<ObFrameInfo>& frame_info_arr)
+    const bool continuous_datum, const bool batch_result, int64_t& frame_index_pos,
+    ObIArray<ObFrameInfo>& frame_info_arr)
 {
   int ret = OB_SUCCESS;
   int64_t start_pos = 0;
@@ -559,7 +570,8 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
   }
   for (int64_t expr_idx = 0; OB_SUCC(ret) && expr_idx < exprs.count(); expr_idx++) {
     ObExpr* rt_expr = get_rt_expr(*exprs.at(expr_idx));
-    const int64_t datum_size = DATUM_EVAL_INFO_SIZE + reserve_data_consume(*rt_expr);
+    const int64_t slot_cnt = ObExpr::get_batch_slot_cnt(batch_result ? batch_size_ : 0);
+    const int64_t datum_size = datum_eval_info_size(batch_result) + reserve_data_consume(*rt_expr) * slot_cnt;
     if (frame_size + datum_size <= MAX_FRAME_SIZE) {
       frame_size += datum_size;
       frame_expr_cnt++;
@@ -587,7 +599,7 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
     int64_t expr_start_pos = tmp_frame_infos.at(idx).expr_start_pos_;
     ObArrayHelper<ObRawExpr*> frame_exprs(
         frame.expr_cnt_, const_cast<ObRawExpr**>(exprs.get_data() + expr_start_pos), frame.expr_cnt_);
-    OZ(arrange_datum_data(frame_exprs, frame, continuous_datum));
+    OZ(arrange_datum_data(frame_exprs, frame, continuous_datum, batch_result));
   }
   // init ObFrameInfo
   if (OB_SUCC(ret)) {
@@ -607,25 +619,38 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
 }
 
 int ObStaticEngineExprCG::arrange_datum_data(
-    ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum)
+    ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum, const bool batch_result)
 {
   int ret = OB_SUCCESS;
   if (continuous_datum) {
-    int64_t data_off = frame.expr_cnt_ * DATUM_EVAL_INFO_SIZE;
+    // datums of all exprs first, then the reserved buffers:
+    //   [datums, eval info, evaluated flags] * expr_cnt | [reserved buffers] * expr_cnt
+    const int64_t max_batch_size = batch_result ? batch_size_ : 0;
+    const int64_t slot_cnt = ObExpr::get_batch_slot_cnt(max_batch_size);
+    const int64_t datum_size = datum_eval_info_size(batch_result);
+    int64_t data_off = frame.expr_cnt_ * datum_size;
     for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
       ObExpr* e = get_rt_expr(*exprs.at(i));
       e->frame_idx_ = frame.frame_idx_;
-      e->datum_off_ = i * DATUM_EVAL_INFO_SIZE;
-      e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum);
+      e->datum_off_ = i * datum_size;
+      e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum) * slot_cnt;
+      e->max_batch_size_ = max_batch_size;
+      e->batch_idx_mask_ = batch_result ? UINT64_MAX : 0;
       const int64_t consume_size = reserve_data_consume(*e);
       if (consume_size > 0) {
         data_off += consume_size;
         e->res_buf_off_ = data_off - e->res_buf_len_;
+        e->res_buf_stride_ = batch_result ? consume_size : 0;
+        data_off += consume_size * (slot_cnt - 1);
       } else {
         e->res_buf_off_ = 0;
+        e->res_buf_stride_ = 0;
       }
     }
     CK(data_off == frame.frame_size_);
+  } else if (batch_result) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("batch result only supported in continuous datum layout", K(ret));
   } else {
     // FIXME : ALIGN_SIZE may affect the performance, set to 1 if no affect
     // make sure all ObDatum is aligned with %ALIGN_SIZE
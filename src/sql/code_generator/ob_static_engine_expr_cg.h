@@ -49,7 +49,7 @@ class ObStaticEngineExprCG {
   static const int64_t DATUM_EVAL_INFO_SIZE = sizeof(ObDatum) + sizeof(ObEvalInfo);
   friend class ObRawExpr;
   ObStaticEngineExprCG(common::ObIAllocator& allocator, DatumParamStore* param_store)
-      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0)
+      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0), batch_size_(0)
   {}
   virtual ~ObStaticEngineExprCG()
   {}
@@ -81,6 +81,13 @@ class ObStaticEngineExprCG {
     return op_cg_ctx_;
   }
 
+  // Set max batch size of vectorized execution, the exprs of datum frame are generated
+  // as batch result expression if batch size is greater than zero.
+  void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
   private:
   static ObExpr* get_rt_expr(const ObRawExpr& raw_expr);
   int construct_exprs(const common::ObIArray<ObRawExpr*>& raw_exprs, common::ObIArray<ObExpr>& rt_exprs);
@@ -129,7 +136,8 @@ class ObStaticEngineExprCG {
       common::ObIArray<ObFrameInfo>& frame_info_arr);
 
   int cg_frame_layout(const common::ObIArray<ObRawExpr*>& exprs, const bool reserve_empty_string,
-      const bool continuous_datum, int64_t& frame_index_pos, common::ObIArray<ObFrameInfo>& frame_info_arr);
+      const bool continuous_datum, const bool batch_result, int64_t& frame_index_pos,
+      common::ObIArray<ObFrameInfo>& frame_info_arr);
 
   int alloc_const_frame(const common::ObIArray<ObRawExpr*>& exprs, const common::ObIArray<ObFrameInfo>& const_frames,
       common::ObIArray<char*>& frame_ptrs);
@@ -141,7 +149,16 @@ class ObStaticEngineExprCG {
     return expr.res_buf_len_ + (need_dyn_buf && expr.res_buf_len_ > 0 ? sizeof(ObDynReserveBuf) : 0);
   }
 
-  int arrange_datum_data(common::ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum);
+  // size of ObDatum, ObEvalInfo and evaluated flags (for batch result) of expression
+  int64_t datum_eval_info_size(const bool batch_result) const
+  {
+    const int64_t slot_cnt = ObExpr::get_batch_slot_cnt(batch_result ? batch_size_ : 0);
+    return batch_result ? sizeof(ObDatum) * slot_cnt + sizeof(ObEvalInfo) + ObBitVector::memory_size(slot_cnt)
+                        : DATUM_EVAL_INFO_SIZE;
+  }
+
+  int arrange_datum_data(common::ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum,
+      const bool batch_result);
 
   int inner_generate_calculable_exprs(
       const common::ObIArray<ObHiddenColumnItem>& calculable_exprs, ObPreCalcExprFrameInfo& expr_info);
@@ -156,6 +173,8 @@ class ObStaticEngineExprCG {
   ObExprCGCtx op_cg_ctx_;
   // Count of param store in generating, for calculable expressions CG.
   int64_t flying_param_cnt_;
+  // max batch size of vectorized execution, zero for row by row execution.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
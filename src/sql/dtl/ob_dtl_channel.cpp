@@ -42,6 +42,7 @@ ObDtlChannel::ObDtlChannel(uint64_t id, const common::ObAddr& peer)
       use_interm_result_(false),
       loop_idx_(OB_INVALID_INDEX_INT64),
       compressor_type_(common::ObCompressorType::NONE_COMPRESSOR),
+      columnar_encoding_(false),
       prev_link_(nullptr),
       next_link_(nullptr)
 {
@@ -256,6 +256,10 @@ class ObDtlChannel : public common::ObDLinkBase<ObDtlChannel> {
   {
     compressor_type_ = type;
   }
+  void set_columnar_encoding(bool columnar_encoding)
+  {
+    columnar_encoding_ = columnar_encoding;
+  }
 
   protected:
   common::ObThreadCond cond_;
@@ -280,6 +284,7 @@ class ObDtlChannel : public common::ObDLinkBase<ObDtlChannel> {
   int64_t loop_idx_;
 
   common::ObCompressorType compressor_type_;
+  bool columnar_encoding_;
 
   public:
   // ObDtlChannel is link base, so it add extra link
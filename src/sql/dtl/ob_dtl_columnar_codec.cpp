@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+
+#include "ob_dtl_columnar_codec.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/container/ob_se_array.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+typedef ObChunkDatumStore::Block Block;
+typedef ObChunkDatumStore::StoredRow StoredRow;
+
+int ObDtlColumnarCodec::encode(const char* src, const int64_t size, char* dst, bool& encoded)
+{
+  int ret = OB_SUCCESS;
+  encoded = false;
+  const int64_t head_size = static_cast<int64_t>(sizeof(Block));
+  const Block* blk = reinterpret_cast<const Block*>(src);
+  int64_t rows = 0;
+  int64_t col_cnt = 0;
+  int64_t pos = head_size;
+  bool valid = false;
+  ObSEArray<int64_t, 64> col_offs;
+  if (OB_ISNULL(src) || OB_ISNULL(dst)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(src), KP(dst));
+  } else if (size > head_size && blk->rows_ > 0) {
+    // 1st pass: check the rows are laid out as StoredRow::copy_datums does and collect column sizes
+    rows = blk->rows_;
+    valid = true;
+    for (int64_t i = 0; valid && OB_SUCC(ret) && i < rows; ++i) {
+      const StoredRow* sr = reinterpret_cast<const StoredRow*>(src + pos);
+      if (pos + static_cast<int64_t>(sizeof(StoredRow)) > size) {
+        valid = false;
+      } else if (0 == i) {
+        col_cnt = sr->cnt_;
+        for (int64_t j = 0; OB_SUCC(ret) && j < col_cnt; ++j) {
+          if (OB_FAIL(col_offs.push_back(0))) {
+            LOG_WARN("push back failed", K(ret));
+          }
+        }
+      }
+      if (valid && OB_SUCC(ret)) {
+        int64_t data_off = sizeof(StoredRow) + sizeof(ObDatum) * col_cnt;
+        if (sr->cnt_ != col_cnt || pos + data_off > size) {
+          valid = false;
+        }
+        for (int64_t j = 0; valid && j < col_cnt; ++j) {
+          const ObDatum& datum = sr->cells()[j];
+          if (!datum.is_null()) {
+            if (reinterpret_cast<int64_t>(datum.ptr_) != data_off) {
+              valid = false;
+            } else {
+              data_off += datum.len_;
+              col_offs.at(j) += datum.len_;
+            }
+          }
+        }
+        if (valid && (sr->row_size_ != data_off || pos + data_off > size)) {
+          valid = false;
+        }
+        pos += data_off;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && valid) {
+    const int64_t rows_end = pos;
+    char* col_area = dst + head_size;
+    uint32_t* descs = reinterpret_cast<uint32_t*>(col_area + sizeof(uint32_t));
+    char* data = col_area + sizeof(uint32_t) + sizeof(uint32_t) * rows * col_cnt;
+    // prefix sum of column sizes to get start offset of each column
+    int64_t data_size = 0;
+    for (int64_t j = 0; j < col_cnt; ++j) {
+      const int64_t len = col_offs.at(j);
+      col_offs.at(j) = data_size;
+      data_size += len;
+    }
+    MEMCPY(dst, src, head_size);
+    *reinterpret_cast<uint32_t*>(col_area) = static_cast<uint32_t>(col_cnt);
+    // 2nd pass: scatter the datums to columns
+    pos = head_size;
+    for (int64_t i = 0; i < rows; ++i) {
+      const StoredRow* sr = reinterpret_cast<const StoredRow*>(src + pos);
+      for (int64_t j = 0; j < col_cnt; ++j) {
+        const ObDatum& datum = sr->cells()[j];
+        descs[j * rows + i] = datum.pack_;
+        if (!datum.is_null()) {
+          MEMCPY(data + col_offs.at(j), reinterpret_cast<const char*>(sr) + reinterpret_cast<int64_t>(datum.ptr_),
+              datum.len_);
+          col_offs.at(j) += datum.len_;
+        }
+      }
+      pos += sr->row_size_;
+    }
+    const int64_t used = (data - dst) + data_size;
+    MEMSET(dst + used, 0, rows_end - used);
+    MEMCPY(dst + rows_end, src + rows_end, size - rows_end);
+    encoded = true;
+  }
+  return ret;
+}
+
+int ObDtlColumnarCodec::decode(char* buf, const int64_t size, const uint64_t tenant_id)
+{
+  int ret = OB_SUCCESS;
+  const int64_t head_size = static_cast<int64_t>(sizeof(Block));
+  const Block* blk = reinterpret_cast<const Block*>(buf);
+  int64_t rows = 0;
+  int64_t col_cnt = 0;
+  ObSEArray<int64_t, 64> col_offs;
+  if (OB_ISNULL(buf) || size < head_size + static_cast<int64_t>(sizeof(uint32_t)) || 0 == blk->rows_) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid columnar buffer", K(ret), KP(buf), K(size));
+  } else {
+    rows = blk->rows_;
+    col_cnt = *reinterpret_cast<const uint32_t*>(buf + head_size);
+    if (head_size + static_cast<int64_t>(sizeof(uint32_t)) * (1 + rows * col_cnt) > size) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid columnar buffer", K(ret), K(size), K(rows), K(col_cnt));
+    }
+  }
+  const uint32_t* descs = reinterpret_cast<const uint32_t*>(buf + head_size + sizeof(uint32_t));
+  const char* data = buf + head_size + sizeof(uint32_t) + sizeof(uint32_t) * rows * col_cnt;
+  int64_t data_size = 0;
+  for (int64_t j = 0; OB_SUCC(ret) && j < col_cnt; ++j) {
+    if (OB_FAIL(col_offs.push_back(data_size))) {
+      LOG_WARN("push back failed", K(ret));
+    } else {
+      for (int64_t i = 0; i < rows; ++i) {
+        ObDatumDesc desc;
+        desc.pack_ = descs[j * rows + i];
+        if (!desc.null_) {
+          data_size += desc.len_;
+        }
+      }
+    }
+  }
+  const int64_t rows_size = (sizeof(StoredRow) + sizeof(ObDatum) * col_cnt) * rows + data_size;
+  char* rows_buf = NULL;
+  if (OB_FAIL(ret)) {
+  } else if (data + data_size > buf + size || head_size + rows_size > size) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid columnar buffer", K(ret), K(size), K(rows), K(col_cnt), K(data_size));
+  } else if (OB_ISNULL(rows_buf = static_cast<char*>(ob_malloc(rows_size, ObMemAttr(tenant_id, "DtlColDecode"))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(rows_size));
+  } else {
+    int64_t pos = 0;
+    for (int64_t i = 0; i < rows; ++i) {
+      StoredRow* sr = reinterpret_cast<StoredRow*>(rows_buf + pos);
+      int64_t data_off = sizeof(StoredRow) + sizeof(ObDatum) * col_cnt;
+      sr->cnt_ = static_cast<uint32_t>(col_cnt);
+      for (int64_t j = 0; j < col_cnt; ++j) {
+        ObDatum* datum = new (&sr->cells()[j]) ObDatum();
+        datum->pack_ = descs[j * rows + i];
+        datum->ptr_ = reinterpret_cast<const char*>(data_off);
+        if (!datum->is_null()) {
+          MEMCPY(reinterpret_cast<char*>(sr) + data_off, data + col_offs.at(j), datum->len_);
+          col_offs.at(j) += datum->len_;
+          data_off += datum->len_;
+        }
+      }
+      sr->row_size_ = static_cast<uint32_t>(data_off);
+      pos += data_off;
+    }
+    MEMCPY(buf + head_size, rows_buf, rows_size);
+    ob_free(rows_buf);
+  }
+  return ret;
+}
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_DTL_COLUMNAR_CODEC_H
+#define OB_DTL_COLUMNAR_CODEC_H
+
+#include "lib/ob_define.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+/*
+ * Transpose the unswizzled ObChunkDatumStore block of a PX_DATUM_ROW buffer into column major
+ * layout before it is sent through rpc, so that the rpc compressor sees the values of the same
+ * column next to each other.
+ *
+ * The rows area of the block is rewritten as:
+ *   | col_cnt | datum desc of column 0 for all rows | ... | data of column 0 for all rows | ... | zero padding |
+ * Datum pointers and row sizes are dropped since they can be derived from the descs, so the
+ * encoded area is never larger than the rows area and the buffer size is unchanged.
+ * The block header and the space after the rows area are copied as is.
+ */
+class ObDtlColumnarCodec {
+  public:
+  // encode %src of %size bytes to %dst, %encoded is false if the block is not in the expected
+  // layout, %dst is untouched in that case.
+  static int encode(const char* src, const int64_t size, char* dst, bool& encoded);
+  // decode the buffer in place.
+  static int decode(char* buf, const int64_t size, const uint64_t tenant_id);
+};
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
+
+#endif /* OB_DTL_COLUMNAR_CODEC_H */
@@ -86,6 +86,7 @@ class ObDtlFlowControl {
         timeout_ts_(0),
         communicate_flag_(0),
         compressor_type_(common::ObCompressorType::NONE_COMPRESSOR),
+        columnar_encoding_(false),
         is_init_(false),
         block_ch_cnt_(0),
         total_memory_size_(0),
@@ -318,6 +319,10 @@ class ObDtlFlowControl {
   {
     return compressor_type_;
   }
+  bool get_columnar_encoding() const
+  {
+    return columnar_encoding_;
+  }
 
   private:
   static const int64_t THRESHOLD_SIZE = 2097152;
@@ -328,6 +333,7 @@ class ObDtlFlowControl {
   // mark flag for transmit,receive,qc etc
   int communicate_flag_;
   common::ObCompressorType compressor_type_;
+  bool columnar_encoding_;
   bool is_init_;
   int64_t block_ch_cnt_;
   int64_t total_memory_size_;
@@ -15,12 +15,15 @@
 
 #include "lib/queue/ob_link.h"
 #include "sql/dtl/ob_dtl_msg_type.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
 
 namespace oceanbase {
 namespace sql {
 namespace dtl {
 
 #define DTL_BROADCAST (1ULL)
+// datum rows are sent in column major layout, see ObDtlColumnarCodec
+#define DTL_COLUMNAR_ENCODING (1ULL << 1)
 
 class ObDtlMsgHeader;
 class ObDtlChannel;
@@ -345,13 +348,20 @@ OB_DEF_SERIALIZE(ObDtlLinkedBuffer, OB_INLINE)
 {
   using namespace oceanbase::common;
   int ret = OB_SUCCESS;
+  bool encoded = false;
   OB_UNIS_ENCODE(size_);
   if (OB_SUCC(ret)) {
     if (buf_len - pos < size_) {
       ret = OB_SIZE_OVERFLOW;
+    } else if (ObDtlMsgType::PX_DATUM_ROW == msg_type_ && has_flag(DTL_COLUMNAR_ENCODING) &&
+               OB_FAIL(ObDtlColumnarCodec::encode(buf_, size_, buf + pos, encoded))) {
+      SQL_DTL_LOG(WARN, "encode columnar buffer failed", K(ret));
     } else {
-      MEMCPY(buf + pos, buf_, size_);
+      if (!encoded) {
+        MEMCPY(buf + pos, buf_, size_);
+      }
       pos += size_;
+      const uint64_t flags = encoded ? flags_ : (flags_ & ~DTL_COLUMNAR_ENCODING);
       LST_DO_CODE(OB_UNIS_ENCODE,
           is_data_msg_,
           seq_no_,
@@ -359,7 +369,7 @@ OB_DEF_SERIALIZE(ObDtlLinkedBuffer, OB_INLINE)
           is_eof_,
           timeout_ts_,
           msg_type_,
-          flags_,
+          flags,
           dfo_key_,
           use_interm_result_);
     }
@@ -385,6 +395,13 @@ OB_DEF_DESERIALIZE(ObDtlLinkedBuffer, OB_INLINE)
         flags_,
         dfo_key_,
         use_interm_result_);
+    if (OB_SUCC(ret) && has_flag(DTL_COLUMNAR_ENCODING)) {
+      if (OB_FAIL(ObDtlColumnarCodec::decode(buf_, size_, tenant_id_))) {
+        SQL_DTL_LOG(WARN, "decode columnar buffer failed", K(ret));
+      } else {
+        remove_flag(DTL_COLUMNAR_ENCODING);
+      }
+    }
   }
   return ret;
 }
@@ -21,6 +21,7 @@
 #include "sql/dtl/ob_dtl_flow_control.h"
 #include "sql/dtl/ob_dtl_channel_agent.h"
 #include "share/rc/ob_context.h"
+#include "share/ob_cluster_version.h"
 #include "sql/dtl/ob_dtl_channel_watcher.h"
 
 using namespace oceanbase::common;
@@ -270,6 +271,12 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer*& buf)
     // we wait first message return and retry until peer setup.
     int64_t timeout_us = buf->timeout_ts() - ObTimeUtility::current_time();
     SendMsgCB cb(msg_response_, *cur_trace_id);
+    if (columnar_encoding_ && common::ObCompressorType::NONE_COMPRESSOR != compressor_type_ &&
+        ObDtlMsgType::PX_DATUM_ROW == buf->msg_type() && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_3101) {
+      // transposed to column major when the rpc packet is serialized,
+      // observer before 3.1.1 can not decode it in upgrading.
+      buf->add_flag(DTL_COLUMNAR_ENCODING);
+    }
     if (timeout_us <= 0) {
       ret = OB_TIMEOUT;
       LOG_WARN("send dtl message timeout", K(ret), K(peer_), K(buf->timeout_ts()));
@@ -148,7 +148,7 @@ int ObAggregateProcessor::AggrCell::collect_result(
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("count sum should be int", K(ret), K(tc), K(is_tiny_num_used_));
     }
-  } else if (is_tiny_num_used_ && (ObIntTC == tc || ObUIntTC == tc)) {
+  } else if (is_tiny_num_used_ && (ObIntTC == tc || ObUIntTC == tc || ObNumberTC == tc)) {
     ObNumStackAllocator<2> tmp_alloc;
     ObNumber result_nmb;
     const bool strict_mode = false;  // this is tmp allocator, so we can ues non-strinct mode
@@ -157,6 +157,10 @@ int ObAggregateProcessor::AggrCell::collect_result(
       if (OB_FAIL(right_nmb.from(tiny_num_int_, tmp_alloc))) {
         LOG_WARN("create number from int failed", K(ret), K(right_nmb), K(tc));
       }
+    } else if (ObNumberTC == tc) {
+      if (OB_FAIL(right_nmb.from_fixed(get_tiny_num_fixed(), tiny_num_frac_len_, tmp_alloc))) {
+        LOG_WARN("create number from fixed point failed", K(ret), K(tiny_num_frac_len_), K(tc));
+      }
     } else {
       if (OB_FAIL(right_nmb.from(tiny_num_uint_, tmp_alloc))) {
         LOG_WARN("create number from int failed", K(ret), K(right_nmb), K(tc));
@@ -188,6 +192,7 @@ int64_t ObAggregateProcessor::AggrCell::to_string(char* buf, const int64_t buf_l
   J_KV(K_(row_count),
       K_(tiny_num_int),
       K_(tiny_num_uint),
+      K_(tiny_num_frac_len),
       K_(is_tiny_num_used),
       K_(llc_bitmap),
       K_(iter_result),
@@ -2443,7 +2448,15 @@ int ObAggregateProcessor::prepare_add_calc(const ObDatum& first_value, AggrCell&
       break;
     }
     case ObNumberTC: {
-      ret = clone_cell(result_datum, first_value, true);
+      ObNumber::int128_t fixed = 0;
+      int64_t frac_len = 0;
+      if (ObNumber(first_value.get_number()).to_fixed(fixed, frac_len)) {
+        aggr_cell.set_tiny_num_fixed(fixed, frac_len);
+      } else {
+        aggr_cell.set_tiny_num_fixed(0, 0);
+        ret = clone_cell(result_datum, first_value, true);
+      }
+      aggr_cell.set_tiny_num_used();
       break;
     }
     default: {
@@ -2544,9 +2557,17 @@ int ObAggregateProcessor::add_calc(const ObDatum& iter_value, AggrCell& aggr_cel
       break;
     }
     case ObNumberTC: {
-      if (result_datum.is_null()) {
+      ObNumber::int128_t sum = aggr_cell.get_tiny_num_fixed();
+      int64_t sum_frac_len = aggr_cell.get_tiny_num_frac_len();
+      ObNumber::int128_t fixed = 0;
+      int64_t frac_len = 0;
+      if (ObNumber(iter_value.get_number()).to_fixed(fixed, frac_len) &&
+          ObNumber::add_fixed(sum, sum_frac_len, fixed, frac_len)) {
+        // add to the fixed point sum, merged with %result_datum in collect_result()
+        aggr_cell.set_tiny_num_fixed(sum, sum_frac_len);
+        aggr_cell.set_tiny_num_used();
+      } else if (result_datum.is_null()) {
         ret = clone_cell(result_datum, iter_value, true);
-        ObNumber left_nmb(result_datum.get_number());
       } else {
         char buf_alloc[ObNumber::MAX_CALC_BYTE_LEN];
         ObDataBuffer allocator(buf_alloc, ObNumber::MAX_CALC_BYTE_LEN);
@@ -2667,7 +2688,33 @@ int ObAggregateProcessor::rollup_add_calc(AggrCell& aggr_cell, AggrCell& rollup_
       break;
     }
     case ObNumberTC: {
-      ret = rollup_add_number_calc(aggr_result, rollup_result);
+      if (aggr_cell.is_tiny_num_used()) {
+        ObNumber::int128_t sum = rollup_cell.get_tiny_num_fixed();
+        int64_t sum_frac_len = rollup_cell.get_tiny_num_frac_len();
+        if (ObNumber::add_fixed(
+                sum, sum_frac_len, aggr_cell.get_tiny_num_fixed(), aggr_cell.get_tiny_num_frac_len())) {
+          rollup_cell.set_tiny_num_fixed(sum, sum_frac_len);
+          rollup_cell.set_tiny_num_used();
+        } else {
+          char buf_alloc[ObNumber::MAX_CALC_BYTE_LEN * 2];
+          ObDataBuffer allocator(buf_alloc, ObNumber::MAX_CALC_BYTE_LEN * 2);
+          ObNumber aggr_nmb;
+          ObNumber result_nmb;
+          if (OB_FAIL(aggr_nmb.from_fixed(
+                  aggr_cell.get_tiny_num_fixed(), aggr_cell.get_tiny_num_frac_len(), allocator))) {
+            LOG_WARN("create number from fixed point failed", K(ret));
+          } else if (rollup_result.is_null()) {
+            ret = clone_number_cell(aggr_nmb, rollup_result);
+          } else if (OB_FAIL(aggr_nmb.add_v3(ObNumber(rollup_result.get_number()), result_nmb, allocator, false))) {
+            LOG_WARN("number add failed", K(ret), K(aggr_nmb));
+          } else if (OB_FAIL(clone_number_cell(result_nmb, rollup_result))) {
+            LOG_WARN("clone_number_cell failed", K(ret), K(result_nmb));
+          }
+        }
+      }
+      if (OB_SUCC(ret)) {
+        ret = rollup_add_number_calc(aggr_result, rollup_result);
+      }
       break;
     }
     case ObFloatTC: {
@@ -2865,8 +2912,8 @@ int ObGroupRowHashTable::init(ObIAllocator* allocator, lib::ObMemAttr& mem_attr,
     const common::ObIArray<ObCmpFunc>* cmp_funcs, int64_t initial_size)
 {
   int ret = OB_SUCCESS;
-  if (OB_FAIL(ObExtendHashTable<ObGroupRowItem>::init(allocator, mem_attr, initial_size))) {
-    LOG_WARN("failed to init extended hash table", K(ret));
+  if (OB_FAIL(ObOpenHashTable<ObGroupRowItem>::init(allocator, mem_attr, initial_size))) {
+    LOG_WARN("failed to init open hash table", K(ret));
   } else {
     eval_ctx_ = eval_ctx;
     cmp_funcs_ = cmp_funcs;
@@ -2902,14 +2949,14 @@ const ObGroupRowItem* ObGroupRowHashTable::get(const ObGroupRowItem& item) const
   if (OB_UNLIKELY(NULL == buckets_)) {
     // do nothing
   } else {
+    // compare the inline hash value first, the group row is accessed only if hash value matched.
     const uint64_t hash_val = item.hash();
-    ObGroupRowItem* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == bucket->hash() && compare(*bucket, item)) {
-        res = bucket;
+    const int64_t mask = get_bucket_num() - 1;
+    for (int64_t idx = hash_val & mask; NULL != buckets_[idx].item_; idx = (idx + 1) & mask) {
+      if (hash_val == buckets_[idx].hash_ && compare(*buckets_[idx].item_, item)) {
+        res = buckets_[idx].item_;
         break;
       }
-      bucket = bucket->next();
     }
   }
   return res;
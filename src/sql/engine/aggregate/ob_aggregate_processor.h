@@ -225,7 +225,8 @@ class ObAggregateProcessor {
     AggrCell()
         : curr_row_results_(),
           row_count_(0),
-          tiny_num_int_(0),
+          tiny_num_fixed_(),
+          tiny_num_frac_len_(0),
           is_tiny_num_used_(false),
           llc_bitmap_(),
           iter_result_(),
@@ -282,6 +283,22 @@ class ObAggregateProcessor {
     {
       tiny_num_uint_ = value;
     }
+    // int128 fixed point sum of number, see ObNumber::to_fixed()
+    number::ObNumber::int128_t get_tiny_num_fixed() const
+    {
+      number::ObNumber::int128_t value = 0;
+      MEMCPY(&value, tiny_num_fixed_, sizeof(value));
+      return value;
+    }
+    int64_t get_tiny_num_frac_len() const
+    {
+      return tiny_num_frac_len_;
+    }
+    void set_tiny_num_fixed(const number::ObNumber::int128_t value, const int64_t frac_len)
+    {
+      MEMCPY(tiny_num_fixed_, &value, sizeof(value));
+      tiny_num_frac_len_ = frac_len;
+    }
     void set_tiny_num_used()
     {
       is_tiny_num_used_ = true;
@@ -303,7 +320,9 @@ class ObAggregateProcessor {
     inline void reuse()
     {
       row_count_ = 0;
-      tiny_num_int_ = 0;
+      tiny_num_fixed_[0] = 0;
+      tiny_num_fixed_[1] = 0;
+      tiny_num_frac_len_ = 0;
       is_tiny_num_used_ = false;
       iter_result_.reset();
       iter_result_.set_null();
@@ -326,11 +345,14 @@ class ObAggregateProcessor {
     // for avg/count
     int64_t row_count_;
 
-    // for int fast path
+    // for int and number fast path
     union {
       int64_t tiny_num_int_;
       uint64_t tiny_num_uint_;
+      // int128 fixed point of number kept in two words, the cell may be not 16 bytes aligned
+      uint64_t tiny_num_fixed_[2];
     };
+    int64_t tiny_num_frac_len_;
     bool is_tiny_num_used_;
 
     // for T_FUN_APPROX_COUNT_DISTINCT
@@ -536,9 +558,9 @@ class ObGroupRowItem {
   void* next_;
 };
 
-class ObGroupRowHashTable : public ObExtendHashTable<ObGroupRowItem> {
+class ObGroupRowHashTable : public ObOpenHashTable<ObGroupRowItem> {
   public:
-  ObGroupRowHashTable() : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr)
+  ObGroupRowHashTable() : ObOpenHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr)
   {}
 
   const ObGroupRowItem* get(const ObGroupRowItem& item) const;
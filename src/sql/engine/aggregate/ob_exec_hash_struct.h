@@ -267,6 +267,244 @@ int ObExtendHashTable<Item>::extend()
   return ret;
 }
 
+// Open addressing hash table with linear probing, extend to double buckets size if hash table is half filled.
+// The hash value is stored inline with the item pointer, mismatched items are skipped without touching
+// the item itself. Buckets are cache line aligned, one cache line holds 4 buckets.
+template <typename Item>
+class ObOpenHashTable {
+  public:
+  const static int64_t INITIAL_SIZE = 128;
+  const static int64_t SIZE_BUCKET_SCALE = 2;
+  struct Bucket {
+    uint64_t hash_;
+    Item* item_;
+  };
+  ObOpenHashTable()
+      : initial_bucket_num_(0), size_(0), bucket_num_(0), buckets_(NULL), buckets_buf_(NULL), allocator_(NULL)
+  {}
+  ~ObOpenHashTable()
+  {
+    destroy();
+  }
+
+  int init(ObIAllocator* allocator, lib::ObMemAttr& mem_attr, int64_t initial_size = INITIAL_SIZE);
+  bool is_inited() const
+  {
+    return NULL != buckets_;
+  }
+  // return the first item which equal to, NULL for none exist.
+  const Item* get(const Item& item) const;
+  // Put item to hash table, extend buckets if needed.
+  // (Do not check item is exist or not)
+  int set(Item& item);
+  int64_t size() const
+  {
+    return size_;
+  }
+  // prefetch the bucket of %hash_val, used to hide cache miss of batch lookup.
+  void prefetch(const uint64_t hash_val) const
+  {
+    if (NULL != buckets_) {
+      __builtin_prefetch(&buckets_[hash_val & (bucket_num_ - 1)], 0 /* read */);
+    }
+  }
+
+  void reuse()
+  {
+    if (NULL != buckets_) {
+      MEMSET(buckets_, 0, sizeof(Bucket) * bucket_num_);
+    }
+    size_ = 0;
+  }
+
+  int resize(ObIAllocator* allocator, int64_t bucket_num);
+
+  void destroy()
+  {
+    free_buckets(buckets_buf_);
+    buckets_buf_ = NULL;
+    buckets_ = NULL;
+    allocator_.set_allocator(nullptr);
+    size_ = 0;
+    bucket_num_ = 0;
+    initial_bucket_num_ = 0;
+  }
+  int64_t mem_used() const
+  {
+    return NULL == buckets_ ? 0 : sizeof(Bucket) * bucket_num_ + CACHE_ALIGN_SIZE;
+  }
+
+  inline int64_t get_bucket_num() const
+  {
+    return bucket_num_;
+  }
+  template <typename CB>
+  int foreach (CB& cb) const
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_ISNULL(buckets_)) {
+      ret = OB_INVALID_ARGUMENT;
+      SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < bucket_num_; i++) {
+      if (NULL != buckets_[i].item_) {
+        if (OB_FAIL(cb(*buckets_[i].item_))) {
+          SQL_ENG_LOG(WARN, "call back failed", K(ret));
+        }
+      }
+    }
+    return ret;
+  }
+
+  protected:
+  DISALLOW_COPY_AND_ASSIGN(ObOpenHashTable);
+  int extend();
+  int alloc_buckets(const int64_t bucket_num, Bucket*& buckets, void*& buf);
+  void free_buckets(void* buf)
+  {
+    if (NULL != buf) {
+      allocator_.free(buf);
+    }
+  }
+  static inline void insert(Bucket* buckets, const int64_t bucket_num, const uint64_t hash_val, Item* item)
+  {
+    int64_t idx = hash_val & (bucket_num - 1);
+    while (NULL != buckets[idx].item_) {
+      idx = (idx + 1) & (bucket_num - 1);
+    }
+    buckets[idx].hash_ = hash_val;
+    buckets[idx].item_ = item;
+  }
+
+  protected:
+  lib::ObMemAttr mem_attr_;
+  int64_t initial_bucket_num_;
+  int64_t size_;
+  int64_t bucket_num_;
+  Bucket* buckets_;
+  void* buckets_buf_;
+  common::ModulePageAllocator allocator_;
+};
+
+template <typename Item>
+int ObOpenHashTable<Item>::init(
+    ObIAllocator* allocator, lib::ObMemAttr& mem_attr, const int64_t initial_size /* INITIAL_SIZE */)
+{
+  int ret = common::OB_SUCCESS;
+  if (initial_size < 2) {
+    ret = common::OB_INVALID_ARGUMENT;
+    SQL_ENG_LOG(WARN, "invalid argument", K(ret));
+  } else {
+    mem_attr_ = mem_attr;
+    allocator_.set_allocator(allocator);
+    allocator_.set_label(mem_attr.label_);
+    initial_bucket_num_ = common::next_pow2(initial_size * SIZE_BUCKET_SCALE);
+    size_ = 0;
+    if (OB_FAIL(extend())) {
+      SQL_ENG_LOG(WARN, "extend failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+template <typename Item>
+int ObOpenHashTable<Item>::resize(ObIAllocator* allocator, int64_t bucket_num)
+{
+  int ret = OB_SUCCESS;
+  if (bucket_num < get_bucket_num() / 2) {
+    destroy();
+    if (OB_FAIL(init(allocator, mem_attr_, bucket_num))) {
+      SQL_ENG_LOG(WARN, "failed to reuse with bucket", K(bucket_num), K(ret));
+    }
+  } else {
+    reuse();
+  }
+  return ret;
+}
+
+template <typename Item>
+const Item* ObOpenHashTable<Item>::get(const Item& item) const
+{
+  Item* res = NULL;
+  if (NULL == buckets_) {
+    // do nothing
+  } else {
+    common::hash::hash_func<Item> hf;
+    common::hash::equal_to<Item> eqf;
+    const uint64_t hash_val = hf(item);
+    int64_t idx = hash_val & (bucket_num_ - 1);
+    while (NULL != buckets_[idx].item_) {
+      if (hash_val == buckets_[idx].hash_ && eqf(*buckets_[idx].item_, item)) {
+        res = buckets_[idx].item_;
+        break;
+      }
+      idx = (idx + 1) & (bucket_num_ - 1);
+    }
+  }
+  return res;
+}
+
+template <typename Item>
+int ObOpenHashTable<Item>::set(Item& item)
+{
+  common::hash::hash_func<Item> hf;
+  int ret = common::OB_SUCCESS;
+  if ((size_ + 1) * SIZE_BUCKET_SCALE > bucket_num_) {
+    if (OB_FAIL(extend())) {
+      SQL_ENG_LOG(WARN, "extend failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_ISNULL(buckets_)) {
+    ret = OB_INVALID_ARGUMENT;
+    SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
+  } else {
+    insert(buckets_, bucket_num_, hf(item), &item);
+    size_ += 1;
+  }
+  return ret;
+}
+
+template <typename Item>
+int ObOpenHashTable<Item>::alloc_buckets(const int64_t bucket_num, Bucket*& buckets, void*& buf)
+{
+  int ret = common::OB_SUCCESS;
+  const int64_t size = sizeof(Bucket) * bucket_num + CACHE_ALIGN_SIZE;
+  if (OB_ISNULL(buf = allocator_.alloc(size, mem_attr_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret), K(size));
+  } else {
+    buckets = reinterpret_cast<Bucket*>(common::upper_align(reinterpret_cast<int64_t>(buf), CACHE_ALIGN_SIZE));
+    MEMSET(buckets, 0, sizeof(Bucket) * bucket_num);
+  }
+  return ret;
+}
+
+template <typename Item>
+int ObOpenHashTable<Item>::extend()
+{
+  int ret = common::OB_SUCCESS;
+  const int64_t new_bucket_num =
+      0 == bucket_num_ ? (0 == initial_bucket_num_ ? INITIAL_SIZE : initial_bucket_num_) : bucket_num_ * 2;
+  Bucket* new_buckets = NULL;
+  void* new_buf = NULL;
+  if (OB_FAIL(alloc_buckets(new_bucket_num, new_buckets, new_buf))) {
+    SQL_ENG_LOG(WARN, "alloc buckets failed", K(ret), K(new_bucket_num));
+  } else {
+    for (int64_t i = 0; i < bucket_num_; i++) {
+      if (NULL != buckets_[i].item_) {
+        insert(new_buckets, new_bucket_num, buckets_[i].hash_, buckets_[i].item_);
+      }
+    }
+    free_buckets(buckets_buf_);
+    buckets_buf_ = new_buf;
+    buckets_ = new_buckets;
+    bucket_num_ = new_bucket_num;
+  }
+  return ret;
+}
+
 // Used for calc hash for columns
 class ObHashCols {
   public:
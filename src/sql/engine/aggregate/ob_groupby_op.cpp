@@ -98,5 +98,20 @@ void ObGroupByOp::destroy()
   ObOperator::destroy();
 }
 
+int ObGroupByOp::eval_aggr_param_batch(const ObBatchRows& brs)
+{
+  int ret = OB_SUCCESS;
+  const AggrInfoFixedArray& aggr_infos = static_cast<const ObGroupBySpec&>(spec_).aggr_infos_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < aggr_infos.count(); i++) {
+    const ObAggrInfo& aggr_info = aggr_infos.at(i);
+    for (int64_t j = 0; OB_SUCC(ret) && j < aggr_info.param_exprs_.count(); j++) {
+      if (OB_FAIL(aggr_info.param_exprs_.at(j)->eval_batch(eval_ctx_, *brs.skip_, brs.size_))) {
+        LOG_WARN("expr evaluate failed", K(ret), K(aggr_info));
+      }
+    }
+  }
+  return ret;
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
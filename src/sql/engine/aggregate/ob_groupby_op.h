@@ -59,6 +59,10 @@ class ObGroupByOp : public ObOperator {
   virtual int inner_close() override;
   virtual void destroy() override;
 
+  protected:
+  // evaluate parameters of aggregate functions for rows of batch
+  int eval_aggr_param_batch(const ObBatchRows& brs);
+
   private:
   void reset_default();
   // disallow copy
@@ -15,6 +15,7 @@
 #include "sql/engine/aggregate/ob_hash_groupby_op.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 #include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
 
 namespace oceanbase {
 using namespace common;
@@ -67,6 +68,11 @@ int ObHashGroupByOp::inner_open()
     LOG_WARN("failed to inner_open", K(ret));
   } else if (OB_FAIL(init_mem_context())) {
     LOG_WARN("init memory entity failed", K(ret));
+  } else if (is_vectorized() && NULL == batch_hash_vals_ &&
+             OB_ISNULL(batch_hash_vals_ = static_cast<uint64_t*>(
+                           ctx_.get_allocator().alloc(sizeof(uint64_t) * MY_SPEC.max_batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate batch hash values failed", K(ret), K(MY_SPEC.max_batch_size_));
   } else if (!local_group_rows_.is_inited()) {
     // create bucket
     int64_t est_group_cnt = MY_SPEC.est_group_cnt_;
@@ -153,6 +159,7 @@ void ObHashGroupByOp::destroy()
     destroy_all_parts();
   }
   group_store_.reset();
+  batch_hash_vals_ = NULL;
   ObGroupByOp::destroy();
   if (NULL != mem_context_) {
     DESTROY_CONTEXT(mem_context_);
@@ -254,6 +261,71 @@ int ObHashGroupByOp::inner_get_next_row()
   return ret;
 }
 
+int ObHashGroupByOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_cnt = 0;
+  while (OB_SUCC(ret) && row_cnt < max_row_cnt) {
+    if (row_cnt > 0 && curr_group_id_ >= 0 && curr_group_id_ + 1 >= local_group_rows_.size() &&
+        !dumped_group_parts_.is_empty()) {
+      // The aggregate results of output rows are released when loading the next dumped
+      // partition, stop this batch here.
+      break;
+    }
+    eval_ctx_.set_batch_idx(row_cnt);
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END == ret) {
+        brs_.end_ = true;
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("get next row failed", K(ret));
+      }
+      break;
+    }
+    row_cnt++;
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = row_cnt;
+  }
+  return ret;
+}
+
+int ObHashGroupByOp::get_child_next_batch_row(const ObBatchRows*& child_brs, int64_t& row_idx)
+{
+  int ret = OB_SUCCESS;
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    while (NULL != child_brs && row_idx < child_brs->size_ && child_brs->skip_->at(row_idx)) {
+      row_idx++;
+    }
+    if (NULL != child_brs && row_idx < child_brs->size_) {
+      eval_ctx_.set_batch_idx(row_idx);
+      row_idx++;
+      got_row = true;
+    } else if (NULL != child_brs && child_brs->end_) {
+      ret = OB_ITER_END;
+    } else {
+      row_idx = 0;
+      clear_evaluated_flag();
+      if (OB_FAIL(child_->get_next_batch(MY_SPEC.max_batch_size_, child_brs))) {
+        LOG_WARN("get next batch failed", K(ret));
+      } else if (OB_FAIL(eval_aggr_param_batch(*child_brs))) {
+        LOG_WARN("evaluate aggregate parameters failed", K(ret));
+      } else {
+        for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.group_exprs_.count(); i++) {
+          if (OB_FAIL(MY_SPEC.group_exprs_.at(i)->eval_batch(eval_ctx_, *child_brs->skip_, child_brs->size_))) {
+            LOG_WARN("expr evaluate failed", K(ret));
+          }
+        }
+        if (OB_SUCC(ret) && OB_FAIL(calc_groupby_exprs_hash_batch(*child_brs))) {
+          LOG_WARN("calc group by exprs hash of batch failed", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObHashGroupByOp::load_data()
 {
   int ret = OB_SUCCESS;
@@ -315,13 +387,23 @@ int ObHashGroupByOp::load_data()
   ObGbyBloomFilter* bloom_filter = NULL;
   const ObChunkDatumStore::StoredRow* srow = NULL;
 
+  // fetch child rows batch by batch in vectorized execution, rows of dumped partition
+  // are always restored one by one.
+  const bool batch_input = is_vectorized() && NULL == cur_part;
+  const ObBatchRows* child_brs = NULL;
+  int64_t batch_row_idx = 0;
+
   for (int64_t loop_cnt = 0; OB_SUCC(ret); ++loop_cnt) {
-    if (NULL == cur_part) {
+    if (batch_input) {
+      ret = get_child_next_batch_row(child_brs, batch_row_idx);
+    } else if (NULL == cur_part) {
       ret = child_->get_next_row();
     } else {
       ret = row_store_iter.get_next_row(child_->get_spec().output_, eval_ctx_, &srow);
     }
-    clear_evaluated_flag();
+    if (!batch_input) {
+      clear_evaluated_flag();
+    }
 
     if (common::OB_SUCCESS != ret) {
       if (OB_ITER_END != ret) {
@@ -345,6 +427,8 @@ int ObHashGroupByOp::load_data()
     if (OB_SUCC(ret)) {
       if (NULL != srow) {
         curr_gr_item.groupby_datums_hash_ = *static_cast<uint64_t*>(srow->get_extra_payload());
+      } else if (batch_input) {
+        curr_gr_item.groupby_datums_hash_ = batch_hash_vals_[eval_ctx_.get_batch_idx()];
       } else {
         if (OB_FAIL(calc_groupby_exprs_hash(curr_gr_item.groupby_datums_hash_))) {
           LOG_WARN("failed to get_groupby_exprs_hash", K(ret));
@@ -527,7 +611,7 @@ int64_t ObHashGroupByOp::detect_part_cnt(const int64_t rows) const
 
 void ObHashGroupByOp::calc_data_mem_ratio(const int64_t part_cnt, double& data_ratio)
 {
-  int64_t extra_size = (get_local_hash_used_size() + part_cnt * FIX_SIZE_PER_PART) * (1 + EXTRA_MEM_RATIO);
+  int64_t extra_size = (get_local_hash_peak_size() + part_cnt * FIX_SIZE_PER_PART) * (1 + EXTRA_MEM_RATIO);
   int64_t data_size = max(get_aggr_used_size(), (get_mem_bound_size() - extra_size) * 0.8);
   data_ratio = data_size * 1.0 / (extra_size + data_size);
   sql_mem_processor_.set_data_ratio(data_ratio);
@@ -571,6 +655,36 @@ int ObHashGroupByOp::calc_groupby_exprs_hash(uint64_t& hash_value)
   return ret;
 }
 
+int ObHashGroupByOp::calc_groupby_exprs_hash_batch(const ObBatchRows& child_brs)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(batch_hash_vals_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("batch hash values not allocated", K(ret));
+  } else {
+    for (int64_t i = 0; i < child_brs.size_; i++) {
+      batch_hash_vals_[i] = 99194853094755497L;
+    }
+    // column by column, the same seed and hash functions with calc_groupby_exprs_hash()
+    for (int64_t col = 0; OB_SUCC(ret) && col < MY_SPEC.group_exprs_.count(); ++col) {
+      ObExpr* expr = MY_SPEC.group_exprs_.at(col);
+      if (OB_ISNULL(expr) || OB_ISNULL(expr->basic_funcs_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("expr node is null", K(ret));
+      } else if (OB_FAIL(ObExprBatchEvalHelper::calc_murmur_hash_batch(
+                     *expr, eval_ctx_, *child_brs.skip_, child_brs.size_, batch_hash_vals_))) {
+        LOG_WARN("calc batch hash failed", K(ret));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < child_brs.size_; i++) {
+      if (!child_brs.skip_->at(i)) {
+        local_group_rows_.prefetch(batch_hash_vals_[i]);
+      }
+    }
+  }
+  return ret;
+}
+
 bool ObHashGroupByOp::need_start_dump(const int64_t input_rows, int64_t& est_part_cnt, const bool check_dump)
 {
   bool need_dump = false;
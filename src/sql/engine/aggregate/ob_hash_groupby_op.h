@@ -84,7 +84,8 @@ class ObHashGroupByOp : public ObGroupByOp {
         agged_dumped_cnt_(0),
         profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
         sql_mem_processor_(profile_),
-        iter_end_(false)
+        iter_end_(false),
+        batch_hash_vals_(NULL)
   {}
   void reset();
   virtual int inner_open() override;
@@ -92,8 +93,12 @@ class ObHashGroupByOp : public ObGroupByOp {
   virtual int rescan() override;
   virtual int switch_iterator() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   int load_data();
+  // get next row of child's batch (located by the batch index of evaluate context),
+  // fetch and evaluate the next batch if iterate end.
+  int get_child_next_batch_row(const ObBatchRows*& child_brs, int64_t& row_idx);
 
   int check_same_group(int64_t& diff_pos);
   int restore_groupby_datum(const int64_t diff_pos);
@@ -116,6 +121,13 @@ class ObHashGroupByOp : public ObGroupByOp {
   {
     return local_group_rows_.mem_used();
   }
+  // Buckets of the open hash table are 16 bytes (hash value and item pointer) and at most half filled,
+  // the doubled bucket array is allocated before the current one is freed, so the bucket memory peaks
+  // at 3 times of the used when the table extends.
+  OB_INLINE int64_t get_local_hash_peak_size() const
+  {
+    return get_local_hash_used_size() * 3;
+  }
   OB_INLINE int64_t get_dumped_part_used_size() const
   {
     return (NULL == mem_context_ ? 0 : mem_context_->used());
@@ -136,9 +148,10 @@ class ObHashGroupByOp : public ObGroupByOp {
   {
     return sql_mem_processor_.get_mem_bound();
   }
+  // bucket array size of the open hash table holding %bucket_cnt groups at the max load factor
   OB_INLINE int64_t estimate_hash_bucket_size(const int64_t bucket_cnt) const
   {
-    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(void*);
+    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(ObGroupRowHashTable::Bucket);
   }
   OB_INLINE int64_t estimate_hash_bucket_cnt_by_mem_size(
       const int64_t bucket_cnt, const int64_t max_mem_size, const double extra_ratio) const
@@ -150,7 +163,7 @@ class ObHashGroupByOp : public ObGroupByOp {
         mem_size >>= 1;
       }
     }
-    return (mem_size / sizeof(void*) / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
+    return (mem_size / sizeof(ObGroupRowHashTable::Bucket) / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
   }
   int update_mem_status_periodically(
       const int64_t nth_cnt, const int64_t input_row, int64_t& est_part_cnt, bool& need_dump);
@@ -158,6 +171,9 @@ class ObHashGroupByOp : public ObGroupByOp {
   void calc_data_mem_ratio(const int64_t part_cnt, double& data_ratio);
   void adjust_part_cnt(int64_t& part_cnt);
   int calc_groupby_exprs_hash(uint64_t& hash_value);
+  // calculate hash values of the child batch and prefetch the hash buckets, so that the
+  // bucket cache misses of the whole batch are overlapped instead of stalled one by one.
+  int calc_groupby_exprs_hash_batch(const ObBatchRows& child_brs);
   int init_group_row_item(const ObGroupRowItem& curr_item, ObGroupRowItem*& gr_row_item);
   bool need_start_dump(const int64_t input_rows, int64_t& est_part_cnt, const bool check_dump);
   // Setup: memory entity, bloom filter, spill partitions
@@ -189,6 +205,8 @@ class ObHashGroupByOp : public ObGroupByOp {
   ObSqlWorkAreaProfile profile_;
   ObSqlMemMgrProcessor sql_mem_processor_;
   bool iter_end_;
+  // group by hash values of the current child batch, indexed by batch index.
+  uint64_t* batch_hash_vals_;
 };
 
 }  // end namespace sql
@@ -42,6 +42,7 @@ class ObScalarAggregateOp : public ObGroupByOp {
   virtual int rescan() override;
   virtual int switch_iterator() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   // reset default value of %cur_rownum_ && %rownum_limit_
   private:
@@ -16,6 +16,7 @@
 // for ObChunkStoreUtil
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "lib/container/ob_se_array_iterator.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/config/ob_server_config.h"
 
@@ -403,6 +404,19 @@ ObChunkDatumStore::ObChunkDatumStore(common::ObIAllocator* alloc /* = NULL */)
       dumped_row_cnt_(0),
       file_size_(0),
       n_block_in_file_(0),
+      compressor_(NULL),
+      frames_(),
+      tmp_file_size_(0),
+      poor_compress_cnt_(0),
+      compress_buf_(NULL),
+      compress_buf_size_(0),
+      frame_buf_(NULL),
+      frame_buf_size_(0),
+      frame_idx_(-1),
+      read_ahead_buf_(NULL),
+      read_ahead_buf_size_(0),
+      read_ahead_idx_(-1),
+      read_ahead_handle_(),
       mem_hold_(0),
       mem_used_(0),
       allocator_(NULL == alloc ? &inner_allocator_ : alloc),
@@ -452,6 +466,7 @@ void ObChunkDatumStore::reset()
   }
   file_size_ = 0;
   n_block_in_file_ = 0;
+  reset_compressed_file();
 
   while (!blocks_.is_empty()) {
     Block* item = blocks_.remove_first();
@@ -1322,7 +1337,7 @@ int ObChunkDatumStore::load_next_block(ChunkIterator& it)
        * */
       // when chunk read size is same as max blk size, then enable aio
       // every buffer is CHUNK_SIZE(64K)
-      enable_aio = (BLOCK_SIZE == this->max_blk_size_ && BLOCK_SIZE == this->min_blk_size_);
+      enable_aio = (BLOCK_SIZE == this->max_blk_size_ && BLOCK_SIZE == this->min_blk_size_) && !is_file_compressed();
       int64_t block_size = INT64_MAX == min_blk_size_
                                ? it.chunk_read_size_
                                : (it.chunk_read_size_ > min_blk_size_ ? it.chunk_read_size_ : min_blk_size_);
@@ -1873,6 +1888,8 @@ int ObChunkDatumStore::write_file(void* buf, int64_t size)
         LOG_WARN("temp file dir id is not init", K(ret), K(io_.dir_id_));
       } else if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.open(io_.fd_, io_.dir_id_))) {
         LOG_WARN("open file failed", K(ret));
+      } else if (OB_FAIL(init_compressor())) {
+        LOG_WARN("init compressor failed", K(ret));
       } else {
         file_size_ = 0;
         io_.tenant_id_ = tenant_id_;
@@ -1884,11 +1901,28 @@ int ObChunkDatumStore::write_file(void* buf, int64_t size)
     ret = E(EventTable::EN_8) ret;
   }
   if (OB_SUCC(ret) && size > 0) {
-    set_io(size, static_cast<char*>(buf));
+    char* write_buf = static_cast<char*>(buf);
+    int64_t write_size = size;
     if (aio_write_handle_.is_valid() && OB_FAIL(aio_write_handle_.wait(timeout_ms))) {
       LOG_WARN("failed to wait write", K(ret));
-    } else if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.aio_write(io_, aio_write_handle_))) {
-      LOG_WARN("write to file failed", K(ret), K_(io), K(timeout_ms));
+    } else if (is_file_compressed() && OB_FAIL(compress_block(write_buf, size, write_buf, write_size))) {
+      LOG_WARN("compress block failed", K(ret), K(size));
+    } else {
+      set_io(write_size, write_buf);
+      if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.aio_write(io_, aio_write_handle_))) {
+        LOG_WARN("write to file failed", K(ret), K_(io), K(timeout_ms));
+      } else if (is_file_compressed()) {
+        FileFrame frame;
+        frame.offset_ = file_size_;
+        frame.size_ = size;
+        frame.file_offset_ = tmp_file_size_;
+        frame.file_size_ = write_size;
+        if (OB_FAIL(frames_.push_back(frame))) {
+          LOG_WARN("push back frame failed", K(ret));
+        } else {
+          tmp_file_size_ += write_size;
+        }
+      }
     }
   }
   if (OB_SUCC(ret)) {
@@ -1919,7 +1953,17 @@ int ObChunkDatumStore::read_file(
     }
   }
 
-  if (OB_SUCC(ret) && size > 0) {
+  if (OB_SUCC(ret) && size > 0 && is_file_compressed()) {
+    int64_t read_size = 0;
+    if (OB_FAIL(read_frames(static_cast<char*>(buf), size, offset, handle, read_size))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("read frames failed", K(ret), K(size), K(offset));
+      }
+    } else if (read_size != size) {
+      ret = OB_INNER_STAT_ERROR;
+      LOG_WARN("read data less than expected", K(ret), K(size), K(offset), K(read_size));
+    }
+  } else if (OB_SUCC(ret) && size > 0) {
     this->set_io(size, static_cast<char*>(buf));
     io_.io_desc_.category_ = common::USER_IO;
     io_.io_desc_.wait_event_no_ = ObWaitEventIds::ROW_STORE_DISK_READ;
@@ -1945,6 +1989,14 @@ int ObChunkDatumStore::aio_read_file(
   } else if (offset < 0 || size < 0 || (size > 0 && NULL == buf)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid argument", K(size), K(offset), KP(buf));
+  } else if (size > 0 && is_file_compressed()) {
+    // compressed frames are read ahead by read_frames(), read synchronously here
+    int64_t read_size = 0;
+    if (OB_FAIL(read_frames(static_cast<char*>(buf), size, offset, handle, read_size))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("read frames failed", K(ret), K(size), K(offset));
+      }
+    }
   } else if (size > 0) {
     this->set_io(size, static_cast<char*>(buf));
     io_.io_desc_.category_ = common::USER_IO;
@@ -1958,6 +2010,206 @@ int ObChunkDatumStore::aio_read_file(
   return ret;
 }
 
+int ObChunkDatumStore::init_compressor()
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType type = INVALID_COMPRESSOR;
+  reset_compressed_file();
+  if (OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(GCONF._chunk_row_store_compress_func.str(), type))) {
+    LOG_WARN("get compressor type failed", K(ret));
+  } else if (NONE_COMPRESSOR == type) {
+    // not compressed
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor_))) {
+    LOG_WARN("get compressor failed", K(ret), K(type));
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::compress_block(char* buf, const int64_t size, char*& write_buf, int64_t& write_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t overflow_size = 0;
+  int64_t compressed_size = 0;
+  write_buf = buf;
+  write_size = size;
+  if (poor_compress_cnt_ >= MAX_POOR_COMPRESS_CNT && 0 != frames_.count() % POOR_COMPRESS_PROBE_INTERVAL) {
+    // incompressible data, write directly
+  } else if (OB_FAIL(compressor_->get_max_overflow_size(size, overflow_size))) {
+    LOG_WARN("get max overflow size failed", K(ret), K(size));
+  } else if (OB_FAIL(prepare_file_buf(compress_buf_, compress_buf_size_, size + overflow_size))) {
+    LOG_WARN("prepare compress buffer failed", K(ret), K(size), K(overflow_size));
+  } else if (OB_FAIL(compressor_->compress(buf, size, compress_buf_, compress_buf_size_, compressed_size))) {
+    LOG_WARN("compress failed", K(ret), K(size));
+  } else if (compressed_size * COMPRESS_RATIO_THRESHOLD > size * (COMPRESS_RATIO_THRESHOLD - 1)) {
+    ++poor_compress_cnt_;
+  } else {
+    poor_compress_cnt_ = 0;
+    write_buf = compress_buf_;
+    write_size = compressed_size;
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::read_frames(char* buf, const int64_t size, const int64_t offset,
+    blocksstable::ObTmpFileIOHandle& handle, int64_t& read_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t timeout_ms = 0;
+  read_size = 0;
+  if (offset >= file_size_) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(get_timeout(timeout_ms))) {
+    LOG_WARN("get timeout failed", K(ret));
+  } else {
+    // binary search the last frame starting before or at offset
+    int64_t idx = 0;
+    int64_t high = frames_.count() - 1;
+    while (idx < high) {
+      const int64_t mid = (idx + high + 1) / 2;
+      if (frames_.at(mid).offset_ <= offset) {
+        idx = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    while (OB_SUCC(ret) && read_size < size && idx < frames_.count()) {
+      const FileFrame& frame = frames_.at(idx);
+      const int64_t pos = offset + read_size - frame.offset_;
+      const int64_t copy_size = std::min(size - read_size, frame.size_ - pos);
+      if (frame.is_compressed()) {
+        if (OB_FAIL(load_frame(idx))) {
+          LOG_WARN("load frame failed", K(ret), K(idx), K(frame));
+        } else {
+          MEMCPY(buf + read_size, frame_buf_ + pos, copy_size);
+        }
+      } else {
+        set_io(copy_size, buf + read_size);
+        io_.io_desc_.category_ = common::USER_IO;
+        io_.io_desc_.wait_event_no_ = ObWaitEventIds::ROW_STORE_DISK_READ;
+        if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.pread(io_, frame.file_offset_ + pos, timeout_ms, handle))) {
+          LOG_WARN("read form file failed", K(ret), K(io_), K(frame), K(pos));
+        } else if (handle.get_data_size() != copy_size) {
+          ret = OB_INNER_STAT_ERROR;
+          LOG_WARN("read data less than expected", K(ret), K(io_), "read_size", handle.get_data_size());
+        }
+      }
+      if (OB_SUCC(ret)) {
+        read_size += copy_size;
+        ++idx;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::load_frame(const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  int64_t timeout_ms = 0;
+  int64_t data_size = 0;
+  const FileFrame& frame = frames_.at(idx);
+  if (idx == frame_idx_) {
+    // already decompressed
+  } else if (OB_FAIL(get_timeout(timeout_ms))) {
+    LOG_WARN("get timeout failed", K(ret));
+  } else {
+    if (idx == read_ahead_idx_) {
+      if (OB_FAIL(read_ahead_handle_.wait(timeout_ms))) {
+        LOG_WARN("wait read ahead failed", K(ret), K(timeout_ms));
+      }
+    } else {
+      // the data of a discarded read ahead is copied only when waited
+      read_ahead_handle_.reset();
+      if (OB_FAIL(prepare_file_buf(read_ahead_buf_, read_ahead_buf_size_, frame.file_size_))) {
+        LOG_WARN("prepare read buffer failed", K(ret), K(frame));
+      } else {
+        set_io(frame.file_size_, read_ahead_buf_);
+        io_.io_desc_.category_ = common::USER_IO;
+        io_.io_desc_.wait_event_no_ = ObWaitEventIds::ROW_STORE_DISK_READ;
+        if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.pread(io_, frame.file_offset_, timeout_ms, read_ahead_handle_))) {
+          LOG_WARN("read form file failed", K(ret), K(io_), K(frame));
+        }
+      }
+    }
+    read_ahead_idx_ = -1;
+    frame_idx_ = -1;
+    if (OB_FAIL(ret)) {
+    } else if (read_ahead_handle_.get_data_size() != frame.file_size_) {
+      ret = OB_INNER_STAT_ERROR;
+      LOG_WARN("read data less than expected", K(ret), K(frame), "read_size", read_ahead_handle_.get_data_size());
+    } else if (OB_FAIL(prepare_file_buf(frame_buf_, frame_buf_size_, frame.size_))) {
+      LOG_WARN("prepare frame buffer failed", K(ret), K(frame));
+    } else if (OB_FAIL(compressor_->decompress(
+                   read_ahead_buf_, frame.file_size_, frame_buf_, frame_buf_size_, data_size))) {
+      LOG_WARN("decompress failed", K(ret), K(frame));
+    } else if (data_size != frame.size_) {
+      ret = OB_INNER_STAT_ERROR;
+      LOG_WARN("decompressed size mismatch", K(ret), K(frame), K(data_size));
+    } else {
+      frame_idx_ = idx;
+    }
+    // read ahead the next compressed frame, the frame is read again if failed
+    if (OB_SUCC(ret) && idx + 1 < frames_.count() && frames_.at(idx + 1).is_compressed()) {
+      int tmp_ret = OB_SUCCESS;
+      const FileFrame& next = frames_.at(idx + 1);
+      read_ahead_handle_.reset();
+      if (OB_SUCCESS != (tmp_ret = prepare_file_buf(read_ahead_buf_, read_ahead_buf_size_, next.file_size_))) {
+        LOG_WARN("prepare read buffer failed", K(tmp_ret), K(next));
+      } else {
+        set_io(next.file_size_, read_ahead_buf_);
+        io_.io_desc_.category_ = common::USER_IO;
+        io_.io_desc_.wait_event_no_ = ObWaitEventIds::ROW_STORE_DISK_READ;
+        if (OB_SUCCESS != (tmp_ret = FILE_MANAGER_INSTANCE_V2.aio_pread(io_, next.file_offset_, read_ahead_handle_))) {
+          LOG_WARN("read ahead failed", K(tmp_ret), K(io_), K(next));
+          read_ahead_handle_.reset();
+        } else {
+          read_ahead_idx_ = idx + 1;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::prepare_file_buf(char*& buf, int64_t& buf_size, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (size > buf_size) {
+    free_file_buf(buf, buf_size);
+    if (OB_ISNULL(buf = static_cast<char*>(alloc_blk_mem(size, true)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(size));
+    } else {
+      buf_size = size;
+    }
+  }
+  return ret;
+}
+
+void ObChunkDatumStore::free_file_buf(char*& buf, int64_t& buf_size)
+{
+  if (NULL != buf) {
+    allocator_->free(buf);
+    callback_free(buf_size);
+    buf = NULL;
+  }
+  buf_size = 0;
+}
+
+void ObChunkDatumStore::reset_compressed_file()
+{
+  read_ahead_handle_.reset();
+  compressor_ = NULL;
+  frames_.reset();
+  tmp_file_size_ = 0;
+  poor_compress_cnt_ = 0;
+  frame_idx_ = -1;
+  read_ahead_idx_ = -1;
+  free_file_buf(compress_buf_, compress_buf_size_);
+  free_file_buf(frame_buf_, frame_buf_size_);
+  free_file_buf(read_ahead_buf_, read_ahead_buf_size_);
+}
+
 bool ObChunkDatumStore::need_dump(int64_t extra_size)
 {
   bool dump = false;
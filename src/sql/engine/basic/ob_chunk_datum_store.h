@@ -22,6 +22,7 @@
 #include "common/row/ob_row_iterator.h"
 #include "share/datum/ob_datum.h"
 #include "sql/engine/expr/ob_expr.h"
+#include "lib/compress/ob_compressor.h"
 #include "storage/blocksstable/ob_tmp_file.h"
 #include "sql/engine/basic/ob_sql_mem_callback.h"
 
@@ -895,6 +896,28 @@ class ObChunkDatumStore {
   int clean_block(Block* clean_block);
 
   private:
+  // Dumped block in file. Offsets of the file used by row store are offsets of the uncompressed
+  // data, they are mapped to the temp file by frames if the file is compressed.
+  struct FileFrame {
+    FileFrame() : offset_(0), size_(0), file_offset_(0), file_size_(0)
+    {}
+    bool is_compressed() const
+    {
+      return file_size_ != size_;
+    }
+    TO_STRING_KV(K_(offset), K_(size), K_(file_offset), K_(file_size));
+
+    int64_t offset_;
+    int64_t size_;
+    int64_t file_offset_;
+    int64_t file_size_;
+  };
+  // blocks are written uncompressed if compressed size is larger than 7/8 of the block
+  static const int64_t COMPRESS_RATIO_THRESHOLD = 8;
+  // stop compressing after so many blocks not compressed, only try once per interval
+  static const int64_t MAX_POOR_COMPRESS_CNT = 8;
+  static const int64_t POOR_COMPRESS_PROBE_INTERVAL = 64;
+
   OB_INLINE int add_row(
       const common::ObIArray<ObExpr*>& exprs, ObEvalCtx* ctx, const int64_t row_size, StoredRow** stored_row);
   static int get_timeout(int64_t& timeout_ms);
@@ -922,6 +945,18 @@ class ObChunkDatumStore {
   int read_file(void* buf, const int64_t size, const int64_t offset, blocksstable::ObTmpFileIOHandle& handle);
   int aio_read_file(void* buf, const int64_t size, const int64_t offset, blocksstable::ObTmpFileIOHandle& handle);
   int aio_read_file(ChunkIterator& it, int64_t read_size);
+  bool is_file_compressed() const
+  {
+    return NULL != compressor_;
+  }
+  int init_compressor();
+  int compress_block(char* buf, const int64_t size, char*& write_buf, int64_t& write_size);
+  int read_frames(char* buf, const int64_t size, const int64_t offset, blocksstable::ObTmpFileIOHandle& handle,
+      int64_t& read_size);
+  int load_frame(const int64_t idx);
+  int prepare_file_buf(char*& buf, int64_t& buf_size, const int64_t size);
+  void free_file_buf(char*& buf, int64_t& buf_size);
+  void reset_compressed_file();
   bool need_dump(int64_t extra_size);
   BlockBuffer* new_block();
   void set_io(int64_t size, char* buf)
@@ -973,6 +1008,23 @@ class ObChunkDatumStore {
   int64_t file_size_;
   int64_t n_block_in_file_;
 
+  // compressed file, compressor is chosen when file is opened and NULL if not compressed
+  common::ObCompressor* compressor_;
+  common::ObArray<FileFrame> frames_;
+  int64_t tmp_file_size_;  // size written to temp file
+  int64_t poor_compress_cnt_;
+  char* compress_buf_;
+  int64_t compress_buf_size_;
+  // the last decompressed frame
+  char* frame_buf_;
+  int64_t frame_buf_size_;
+  int64_t frame_idx_;
+  // compressed data of the frame being read or read ahead
+  char* read_ahead_buf_;
+  int64_t read_ahead_buf_size_;
+  int64_t read_ahead_idx_;
+  blocksstable::ObTmpFileIOHandle read_ahead_handle_;
+
   // BlockList blocks_;  // ASSERT: all linked blocks has at least one row stored
   int64_t mem_hold_;
   int64_t mem_used_;
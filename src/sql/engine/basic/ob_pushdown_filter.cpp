@@ -17,6 +17,7 @@
 #include "sql/resolver/expr/ob_raw_expr_util.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
 #include "storage/ob_i_store.h"
+#include "share/ob_cluster_version.h"
 
 namespace oceanbase {
 using namespace common;
@@ -41,7 +42,7 @@ OB_SERIALIZE_MEMBER(ObPushdownFilterNode, type_, n_child_, col_ids_);
 OB_SERIALIZE_MEMBER((ObPushdownAndFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownOrFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownBlackFilterNode, ObPushdownFilterNode), column_exprs_, filter_exprs_);
-OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode));
+OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode), op_type_, const_exprs_);
 
 int ObPushdownBlackFilterNode::merge(ObIArray<ObPushdownFilterNode*>& merged_node)
 {
@@ -119,6 +120,188 @@ int ObPushdownFilterConstructor::create_black_filter_node(ObRawExpr* raw_expr, O
   return ret;
 }
 
+bool ObPushdownFilterConstructor::is_white_column(const ObRawExpr* raw_expr) const
+{
+  bool is_white = false;
+  if (OB_NOT_NULL(raw_expr) && raw_expr->is_column_ref_expr() &&
+      !static_cast<const ObColumnRefRawExpr*>(raw_expr)->is_generated_column()) {
+    // types compared in storage by ObObj::compare with the same semantic as expression,
+    // fixed length char is padded by the storage and lob is read as outrow locator, not supported
+    const ObObjType type = raw_expr->get_data_type();
+    switch (ob_obj_type_class(type)) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObFloatTC:
+      case ObDoubleTC:
+      case ObNumberTC:
+      case ObDateTimeTC:
+      case ObDateTC:
+      case ObTimeTC:
+      case ObYearTC:
+        is_white = true;
+        break;
+      case ObStringTC:
+        is_white = ObVarcharType == type;
+        break;
+      default:
+        break;
+    }
+  }
+  return is_white;
+}
+
+bool ObPushdownFilterConstructor::is_white_const(const ObRawExpr* const_expr, const ObRawExpr* column_expr) const
+{
+  bool is_white = false;
+  if (OB_NOT_NULL(const_expr) && OB_NOT_NULL(column_expr) && const_expr->is_const_expr()) {
+    // no implicit cast allowed, the const is compared with the stored cell directly
+    is_white = const_expr->get_data_type() == column_expr->get_data_type() &&
+               const_expr->get_collation_type() == column_expr->get_collation_type();
+  }
+  return is_white;
+}
+
+int ObPushdownFilterConstructor::extract_white_filter(ObRawExpr* raw_expr, ObColumnRefRawExpr*& column_expr,
+    ObIArray<ObRawExpr*>& const_exprs, ObWhiteFilterOperatorType& op_type)
+{
+  int ret = OB_SUCCESS;
+  column_expr = nullptr;
+  op_type = WHITE_OP_MAX;
+  const_exprs.reset();
+  if (OB_ISNULL(raw_expr)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid null raw expr", K(ret));
+  } else if (!raw_expr->is_op_expr() || 2 > raw_expr->get_param_count()) {
+  } else {
+    const ObItemType expr_type = raw_expr->get_expr_type();
+    switch (expr_type) {
+      case T_OP_EQ:
+      case T_OP_LE:
+      case T_OP_LT:
+      case T_OP_GE:
+      case T_OP_GT:
+      case T_OP_NE: {
+        ObRawExpr* left = raw_expr->get_param_expr(0);
+        ObRawExpr* right = raw_expr->get_param_expr(1);
+        bool reverse = false;
+        if (is_white_column(left) && is_white_const(right, left)) {
+        } else if (is_white_column(right) && is_white_const(left, right)) {
+          reverse = true;
+          std::swap(left, right);
+        } else {
+          left = nullptr;
+        }
+        if (OB_NOT_NULL(left) && raw_expr->get_result_type().get_calc_type() == left->get_data_type() &&
+            (!ob_is_string_type(left->get_data_type()) ||
+                raw_expr->get_result_type().get_calc_collation_type() == left->get_collation_type())) {
+          // index by item type from T_OP_EQ (T_OP_NSEQ not included), the reverse one is for `const op column`
+          static const ObWhiteFilterOperatorType OP_TYPES[] = {
+              WHITE_OP_EQ, WHITE_OP_MAX, WHITE_OP_LE, WHITE_OP_LT, WHITE_OP_GE, WHITE_OP_GT, WHITE_OP_NE};
+          static const ObWhiteFilterOperatorType REVERSE_OP_TYPES[] = {
+              WHITE_OP_EQ, WHITE_OP_MAX, WHITE_OP_GE, WHITE_OP_GT, WHITE_OP_LE, WHITE_OP_LT, WHITE_OP_NE};
+          const int64_t idx = expr_type - T_OP_EQ;
+          if (OB_FAIL(const_exprs.push_back(right))) {
+            LOG_WARN("failed to push back const expr", K(ret));
+          } else {
+            column_expr = static_cast<ObColumnRefRawExpr*>(left);
+            op_type = reverse ? REVERSE_OP_TYPES[idx] : OP_TYPES[idx];
+          }
+        }
+        break;
+      }
+      case T_OP_IN: {
+        ObRawExpr* left = raw_expr->get_param_expr(0);
+        ObRawExpr* right = raw_expr->get_param_expr(1);
+        bool is_white = is_white_column(left) && OB_NOT_NULL(right) &&
+                        T_OP_ROW == right->get_expr_type() && 0 < right->get_param_count();
+        for (int64_t i = 0; is_white && OB_SUCC(ret) && i < right->get_param_count(); ++i) {
+          if (!(is_white = is_white_const(right->get_param_expr(i), left))) {
+          } else if (OB_FAIL(const_exprs.push_back(right->get_param_expr(i)))) {
+            LOG_WARN("failed to push back const expr", K(ret));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          if (is_white) {
+            column_expr = static_cast<ObColumnRefRawExpr*>(left);
+            op_type = WHITE_OP_IN;
+          } else {
+            const_exprs.reset();
+          }
+        }
+        break;
+      }
+      case T_OP_IS:
+      case T_OP_IS_NOT: {
+        // zero date and auto increment column have special semantic for `is null` in mysql mode
+        ObRawExpr* left = raw_expr->get_param_expr(0);
+        ObRawExpr* right = raw_expr->get_param_expr(1);
+        if (is_white_column(left) && OB_NOT_NULL(right) &&
+            T_NULL == right->get_expr_type() && ObDateTC != left->get_type_class() &&
+            ObDateTimeTC != left->get_type_class() &&
+            !left->is_auto_increment()) {
+          column_expr = static_cast<ObColumnRefRawExpr*>(left);
+          op_type = T_OP_IS == expr_type ? WHITE_OP_NU : WHITE_OP_NN;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return ret;
+}
+
+bool ObPushdownFilterConstructor::is_white_mode(ObRawExpr* raw_expr)
+{
+  int ret = OB_SUCCESS;
+  ObColumnRefRawExpr* column_expr = nullptr;
+  ObSEArray<ObRawExpr*, 4> const_exprs;
+  ObWhiteFilterOperatorType op_type = WHITE_OP_MAX;
+  if (OB_FAIL(extract_white_filter(raw_expr, column_expr, const_exprs, op_type))) {
+    LOG_WARN("failed to extract white filter", K(ret));
+  }
+  return OB_SUCC(ret) && WHITE_OP_MAX != op_type;
+}
+
+int ObPushdownFilterConstructor::create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_node)
+{
+  int ret = OB_SUCCESS;
+  ObColumnRefRawExpr* column_expr = nullptr;
+  ObSEArray<ObRawExpr*, 4> const_exprs;
+  ObWhiteFilterOperatorType op_type = WHITE_OP_MAX;
+  ObPushdownWhiteFilterNode* white_filter_node = nullptr;
+  if (OB_FAIL(extract_white_filter(raw_expr, column_expr, const_exprs, op_type))) {
+    LOG_WARN("failed to extract white filter", K(ret));
+  } else if (OB_ISNULL(column_expr) || WHITE_OP_MAX == op_type) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("not white filter", K(ret), KPC(raw_expr));
+  } else if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE_FILTER, 0, filter_node))) {
+    LOG_WARN("failed t o alloc pushdown filter", K(ret));
+  } else if (OB_ISNULL(filter_node)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("white filter node is null", K(ret));
+  } else if (FALSE_IT(white_filter_node = static_cast<ObPushdownWhiteFilterNode*>(filter_node))) {
+  } else if (OB_FAIL(white_filter_node->col_ids_.init(1))) {
+    LOG_WARN("failed to init column ids", K(ret));
+  } else if (OB_FAIL(white_filter_node->col_ids_.push_back(column_expr->get_column_id()))) {
+    LOG_WARN("failed to push back column id", K(ret));
+  } else if (OB_FAIL(white_filter_node->const_exprs_.init(const_exprs.count()))) {
+    LOG_WARN("failed to init const exprs", K(ret));
+  } else {
+    white_filter_node->op_type_ = op_type;
+    for (int64_t i = 0; i < const_exprs.count() && OB_SUCC(ret); ++i) {
+      ObExpr* expr = nullptr;
+      if (OB_FAIL(static_cg_.generate_rt_expr(*const_exprs.at(i), expr))) {
+        LOG_WARN("failed to generate rt expr", K(ret));
+      } else if (OB_FAIL(white_filter_node->const_exprs_.push_back(expr))) {
+        LOG_WARN("failed to push back const expr", K(ret));
+      }
+    }
+    LOG_DEBUG("debug white_filter_node", K(*raw_expr), K(*white_filter_node));
+  }
+  return ret;
+}
+
 int ObPushdownFilterConstructor::merge_filter_node(
     ObPushdownFilterNode* dst, ObPushdownFilterNode* other, ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged)
 {
@@ -182,13 +365,11 @@ int ObPushdownFilterConstructor::apply(ObRawExpr* raw_expr, ObPushdownFilterNode
     // }
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("not supported", K(ret));
-  } else if (is_white_mode(raw_expr)) {
-    // create white filter
-    // if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE, filter_node))) {
-    //   LOG_WARN("failed t o alloc pushdown filter", K(ret));
-    // }
-    ret = OB_NOT_SUPPORTED;
-    LOG_WARN("not supported", K(ret));
+  } else if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_3101 && is_white_mode(raw_expr)) {
+    // observer before 3.1.1 can not evaluate white filter, use black filter in upgrading
+    if (OB_FAIL(create_white_filter_node(raw_expr, filter_node))) {
+      LOG_WARN("failed t o alloc pushdown filter", K(ret));
+    }
   } else {
     if (OB_FAIL(create_black_filter_node(raw_expr, filter_node))) {
       LOG_WARN("failed t o alloc pushdown filter", K(ret));
@@ -547,6 +728,76 @@ int ObWhiteFilterExecutor::filter(bool& filtered)
 }
 // end for test filter
 
+int ObWhiteFilterExecutor::compare_param(const ObObj& cell, const ObObj& param, int& cmp) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(cell.compare(param, param.get_collation_type(), cmp))) {
+    LOG_WARN("failed to compare cell with filter param", K(ret), K(cell), K(param));
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::filter(const ObObj& cell, bool& filtered) const
+{
+  int ret = OB_SUCCESS;
+  const ObWhiteFilterOperatorType op_type = get_op_type();
+  int cmp = 0;
+  filtered = true;
+  if (OB_UNLIKELY(!params_ready_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("white filter params not ready", K(ret));
+  } else if (WHITE_OP_NU == op_type || WHITE_OP_NN == op_type) {
+    filtered = (WHITE_OP_NU == op_type) != cell.is_null();
+  } else if (cell.is_null()) {
+  } else if (WHITE_OP_IN == op_type) {
+    // params are sorted, binary search
+    int64_t low = 0;
+    int64_t high = params_.count() - 1;
+    while (OB_SUCC(ret) && filtered && low <= high) {
+      const int64_t mid = low + (high - low) / 2;
+      if (OB_FAIL(compare_param(cell, params_.at(mid), cmp))) {
+      } else if (0 == cmp) {
+        filtered = false;
+      } else if (cmp < 0) {
+        high = mid - 1;
+      } else {
+        low = mid + 1;
+      }
+    }
+  } else if (OB_UNLIKELY(1 != params_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected param count", K(ret), K(op_type), K(params_));
+  } else if (params_.at(0).is_null()) {
+  } else if (OB_FAIL(compare_param(cell, params_.at(0), cmp))) {
+  } else {
+    switch (op_type) {
+      case WHITE_OP_EQ:
+        filtered = 0 != cmp;
+        break;
+      case WHITE_OP_LE:
+        filtered = cmp > 0;
+        break;
+      case WHITE_OP_LT:
+        filtered = cmp >= 0;
+        break;
+      case WHITE_OP_GE:
+        filtered = cmp < 0;
+        break;
+      case WHITE_OP_GT:
+        filtered = cmp <= 0;
+        break;
+      case WHITE_OP_NE:
+        filtered = 0 == cmp;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter operator", K(ret), K(op_type));
+        break;
+    }
+  }
+  return ret;
+}
+
 int ObPushdownFilterExecutor::find_evaluated_datums(
     ObExpr* expr, const ObIArray<ObExpr*>& calc_exprs, ObIArray<ObExpr*>& eval_exprs)
 {
@@ -676,8 +927,70 @@ int ObWhiteFilterExecutor::init_evaluated_datums(
   int ret = OB_SUCCESS;
   UNUSED(alloc);
   UNUSED(calc_exprs);
-  UNUSED(eval_ctx);
-  ret = OB_NOT_SUPPORTED;
+  if (OB_ISNULL(eval_ctx)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("eval ctx is null", K(ret));
+  } else {
+    eval_ctx_ = eval_ctx;
+    params_ready_ = false;
+  }
+  return ret;
+}
+
+int ObPushdownFilterExecutor::prepare_filter_params()
+{
+  int ret = OB_SUCCESS;
+  for (uint32_t i = 0; i < n_child_ && OB_SUCC(ret); ++i) {
+    if (OB_ISNULL(childs_[i])) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("child is null", K(ret), K(i));
+    } else if (OB_FAIL(childs_[i]->prepare_filter_params())) {
+      LOG_WARN("failed to prepare filter params", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::prepare_filter_params()
+{
+  int ret = OB_SUCCESS;
+  const ObPushdownWhiteFilterNode& node = static_cast<const ObPushdownWhiteFilterNode&>(filter_);
+  params_ready_ = false;
+  params_.clear();
+  if (OB_ISNULL(eval_ctx_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("eval ctx is null", K(ret));
+  } else if (OB_FAIL(params_.reserve(node.const_exprs_.count()))) {
+    LOG_WARN("failed to reserve params", K(ret), K(node.const_exprs_.count()));
+  } else {
+    for (int64_t i = 0; i < node.const_exprs_.count() && OB_SUCC(ret); ++i) {
+      ObExpr* expr = node.const_exprs_.at(i);
+      ObDatum* datum = nullptr;
+      ObObj param;
+      if (OB_ISNULL(expr)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("const expr is null", K(ret), K(i));
+      } else if (OB_FAIL(expr->eval(*eval_ctx_, datum))) {
+        LOG_WARN("failed to eval const expr", K(ret), K(i));
+      } else if (OB_FAIL(datum->to_obj(param, expr->obj_meta_, expr->obj_datum_map_))) {
+        LOG_WARN("failed to convert datum to obj", K(ret), K(i));
+      } else if (WHITE_OP_IN == node.op_type_ && param.is_null()) {
+        // null in the list never matches
+      } else if (OB_FAIL(params_.push_back(param))) {
+        LOG_WARN("failed to push back param", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && WHITE_OP_IN == node.op_type_ && params_.count() > 1) {
+      // same type and collation with the column, sort for binary search in filter()
+      const ObCollationType cs_type = params_.at(0).get_collation_type();
+      std::sort(&params_.at(0), &params_.at(0) + params_.count(), [cs_type](const ObObj& l, const ObObj& r) {
+        return l.compare(r, cs_type) < 0;
+      });
+    }
+    if (OB_SUCC(ret)) {
+      params_ready_ = true;
+    }
+  }
   return ret;
 }
 
@@ -33,6 +33,8 @@ struct ObTableAccessContext;
 namespace sql {
 
 class ObStaticEngineCG;
+class ObRawExpr;
+class ObColumnRefRawExpr;
 
 enum PushdownFilterType { BLACK_FILTER, WHITE_FILTER, AND_FILTER, OR_FILTER, MAX_FILTER_TYPE };
 
@@ -44,6 +46,20 @@ enum FilterExecutorType {
   MAX_EXECUTOR_TYPE
 };
 
+// compare operator of white filter, evaluated by storage on the encoded/flat micro block directly
+enum ObWhiteFilterOperatorType {
+  WHITE_OP_EQ,  // =
+  WHITE_OP_LE,  // <=
+  WHITE_OP_LT,  // <
+  WHITE_OP_GE,  // >=
+  WHITE_OP_GT,  // >
+  WHITE_OP_NE,  // <>
+  WHITE_OP_IN,  // in (const, ...)
+  WHITE_OP_NU,  // is null
+  WHITE_OP_NN,  // is not null
+  WHITE_OP_MAX
+};
+
 class ObPushdownFilterUtils {
   public:
   static bool is_pushdown_storage(int32_t pd_storage_flag)
@@ -136,10 +152,17 @@ class ObPushdownWhiteFilterNode : public ObPushdownFilterNode {
   OB_UNIS_VERSION_V(1);
 
   public:
-  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc) : ObPushdownFilterNode(alloc)
+  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc)
+      : ObPushdownFilterNode(alloc), op_type_(WHITE_OP_MAX), const_exprs_(alloc)
   {}
   ~ObPushdownWhiteFilterNode()
   {}
+  INHERIT_TO_STRING_KV("ObPushdownFilterNode", ObPushdownFilterNode, K_(op_type), K_(const_exprs));
+
+  public:
+  // column op const [, const ...], the only column is in col_ids_
+  ObWhiteFilterOperatorType op_type_;
+  ExprFixedArray const_exprs_;
 };
 
 class ObPushdownFilterExecutor;
@@ -184,16 +207,17 @@ class ObPushdownFilterConstructor {
       common::ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged);
   int deduplicate_filter_node(common::ObIArray<ObPushdownFilterNode*>& filter_nodes, uint32_t& n_node);
   int create_black_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
+  int create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
   bool can_split_or(ObRawExpr* raw_expr)
   {
     UNUSED(raw_expr);
     return false;
   }
-  bool is_white_mode(ObRawExpr* raw_expr)
-  {
-    UNUSED(raw_expr);
-    return false;
-  }
+  bool is_white_mode(ObRawExpr* raw_expr);
+  int extract_white_filter(ObRawExpr* raw_expr, ObColumnRefRawExpr*& column_expr,
+      common::ObIArray<ObRawExpr*>& const_exprs, ObWhiteFilterOperatorType& op_type);
+  bool is_white_column(const ObRawExpr* raw_expr) const;
+  bool is_white_const(const ObRawExpr* const_expr, const ObRawExpr* column_expr) const;
 
   private:
   common::ObIAllocator* alloc_;
@@ -376,6 +400,9 @@ class ObPushdownFilterExecutor {
     UNUSED(eval_ctx);
     return common::OB_NOT_SUPPORTED;
   }
+  // evaluate the parameters of white filters, called before every scan since they may be
+  // question marks or exec params of nested loop join
+  virtual int prepare_filter_params();
   VIRTUAL_TO_STRING_KV(K_(type), K_(n_cols), "col_offsets", common::ObArrayWrap<int32_t>(col_offsets_, n_cols_),
       K_(n_child), KP_(childs), KP_(filter_bitmap), KP_(col_params));
 
@@ -429,7 +456,7 @@ OB_INLINE void ObBlackFilterExecutor::clear_evaluated_datums()
 class ObWhiteFilterExecutor : public ObPushdownFilterExecutor {
   public:
   ObWhiteFilterExecutor(common::ObIAllocator& alloc, ObPushdownWhiteFilterNode& filter)
-      : ObPushdownFilterExecutor(alloc, filter)
+      : ObPushdownFilterExecutor(alloc, filter), params_(alloc), params_ready_(false), eval_ctx_(nullptr)
   {}
   ~ObWhiteFilterExecutor()
   {}
@@ -437,9 +464,32 @@ class ObWhiteFilterExecutor : public ObPushdownFilterExecutor {
   virtual int filter(bool& filtered) override;
   virtual int init_evaluated_datums(
       common::ObIAllocator& alloc, const common::ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx) override;
-  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter));
+  virtual int prepare_filter_params() override;
+  // evaluate filter on one cell of the filter column, %filtered is true if the row is filtered out
+  int filter(const common::ObObj& cell, bool& filtered) const;
+  OB_INLINE ObWhiteFilterOperatorType get_op_type() const
+  {
+    return static_cast<const ObPushdownWhiteFilterNode&>(filter_).op_type_;
+  }
+  OB_INLINE const common::ObIArray<common::ObObj>& get_params() const
+  {
+    return params_;
+  }
+  // storage treats the filter as always true until the params are evaluated
+  OB_INLINE bool is_params_ready() const
+  {
+    return params_ready_;
+  }
+  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter), K_(params), K_(params_ready));
+
+  private:
+  int compare_param(const common::ObObj& cell, const common::ObObj& param, int& cmp) const;
 
   private:
+  // sorted and without null for WHITE_OP_IN
+  common::ObFixedArray<common::ObObj, common::ObIAllocator> params_;
+  bool params_ready_;
+  ObEvalCtx* eval_ctx_;
 };
 
 class ObAndFilterExecutor : public ObPushdownFilterExecutor {
@@ -31,7 +31,12 @@ STATIC_ASSERT(sizeof(ObPrecision) == sizeof(ObLengthSemantics), "size of ObPreci
 OB_SERIALIZE_MEMBER(ObDatumMeta, type_, cs_type_, scale_, precision_);
 
 ObEvalCtx::ObEvalCtx(ObExecContext& exec_ctx, ObArenaAllocator& res_alloc, ObArenaAllocator& tmp_alloc)
-    : frames_(exec_ctx.get_frames()), exec_ctx_(exec_ctx), expr_res_alloc_(res_alloc), tmp_alloc_(tmp_alloc)
+    : frames_(exec_ctx.get_frames()),
+      exec_ctx_(exec_ctx),
+      expr_res_alloc_(res_alloc),
+      tmp_alloc_(tmp_alloc),
+      batch_idx_(0),
+      batch_size_(0)
 
 {}
 
@@ -39,7 +44,7 @@ DEF_TO_STRING(ObEvalInfo)
 {
   int64_t pos = 0;
   J_OBJ_START();
-  J_KV(K_(evaluated), K_(projected), K_(notnull), K_(point_to_frame), K_(cnt));
+  J_KV(K_(evaluated), K_(projected), K_(notnull), K_(point_to_frame), K_(eval_flags_valid), K_(cnt));
   J_OBJ_END();
   return pos;
 }
@@ -76,6 +81,7 @@ OB_DEF_SERIALIZE(ObExpr)
   }
 
   LST_DO_CODE(OB_UNIS_ENCODE, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ENCODE, max_batch_size_, res_buf_stride_, ser_eval_batch_func_);
 
   return ret;
 }
@@ -117,6 +123,10 @@ OB_DEF_DESERIALIZE(ObExpr)
     // compatible with 3.0, ObExprDatum::flag_ is ObEvalInfo
     eval_info_off_ = datum_off_ + sizeof(ObDatum);
   }
+  LST_DO_CODE(OB_UNIS_DECODE, max_batch_size_, res_buf_stride_, ser_eval_batch_func_);
+  if (OB_SUCC(ret)) {
+    batch_idx_mask_ = is_batch_result() ? UINT64_MAX : 0;
+  }
 
   if (OB_SUCC(ret)) {
     basic_funcs_ = ObDatumFuncs::get_basic_func(datum_meta_.type_, datum_meta_.cs_type_);
@@ -154,6 +164,7 @@ OB_DEF_SERIALIZE_SIZE(ObExpr)
   }
 
   LST_DO_CODE(OB_UNIS_ADD_LEN, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ADD_LEN, max_batch_size_, res_buf_stride_, ser_eval_batch_func_);
 
   return len;
 }
@@ -178,8 +189,12 @@ ObExpr::ObExpr()
       res_buf_off_(0),
       res_buf_len_(0),
       expr_ctx_id_(INVALID_EXP_CTX_ID),
+      max_batch_size_(0),
       extra_(0),
-      basic_funcs_(NULL)
+      basic_funcs_(NULL),
+      eval_batch_func_(NULL),
+      res_buf_stride_(0),
+      batch_idx_mask_(0)
 {}
 
 char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
@@ -189,8 +204,7 @@ char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   if (OB_UNLIKELY(!ObDynReserveBuf::supported(datum_meta_.type_))) {
     LOG_ERROR("unexpected alloc string result memory called", K(size), K(*this));
   } else {
-    ObDynReserveBuf* drb =
-        reinterpret_cast<ObDynReserveBuf*>(ctx.frames_[frame_idx_] + res_buf_off_ - sizeof(ObDynReserveBuf));
+    ObDynReserveBuf* drb = reinterpret_cast<ObDynReserveBuf*>(get_res_buf(ctx) - sizeof(ObDynReserveBuf));
     if (OB_LIKELY(drb->len_ >= size)) {
       mem = drb->mem_;
     } else {
@@ -223,13 +237,19 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
   int ret = common::OB_SUCCESS;
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  datum = (ObDatum*)(frame + datum_off_);
+  const int64_t batch_idx = is_batch_result() ? ctx.batch_idx_ : 0;
+  datum = (ObDatum*)(frame + datum_off_) + batch_idx;
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
+  bool evaluated = eval_info->evaluated_;
+  if (!evaluated && is_batch_result() && eval_info->eval_flags_valid_) {
+    evaluated = get_evaluated_flags(ctx).at(batch_idx);
+  }
 
   // do nothing for const/column reference expr or already evaluated expr
-  if (!eval_info->evaluated_) {
-    if (datum->ptr_ != frame + res_buf_off_) {
-      datum->ptr_ = frame + res_buf_off_;
+  if (!evaluated) {
+    char* res_buf = get_res_buf(ctx);
+    if (datum->ptr_ != res_buf) {
+      datum->ptr_ = res_buf;
     }
     const common::ObObjTypeClass in_tc = args_[0]->obj_meta_.get_type_class();
     EvalEnumSetFunc eval_func;
@@ -240,7 +260,7 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
     }
 
     if (OB_LIKELY(common::OB_SUCCESS == ret)) {
-      eval_info->evaluated_ = true;
+      set_evaluated_flag(ctx);
     } else {
       datum->set_null();
     }
@@ -248,6 +268,80 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
   return ret;
 }
 
+int ObExpr::eval_batch_row(ObEvalCtx& ctx, ObDatum*& datum) const
+{
+  int ret = OB_SUCCESS;
+  char* frame = ctx.frames_[frame_idx_];
+  const int64_t batch_idx = ctx.batch_idx_;
+  datum = (ObDatum*)(frame + datum_off_) + batch_idx;
+  ObEvalInfo& eval_info = *reinterpret_cast<ObEvalInfo*>(frame + eval_info_off_);
+  // do nothing for const/column reference expr or already evaluated batch
+  if (NULL != eval_func_ && !eval_info.evaluated_) {
+    ObBitVector& flags = get_evaluated_flags(ctx);
+    if (!eval_info.eval_flags_valid_) {
+      flags.reset(get_batch_slot_cnt(max_batch_size_));
+      eval_info.eval_flags_valid_ = true;
+    }
+    if (!flags.at(batch_idx)) {
+      char* res_buf = frame + res_buf_off_ + res_buf_stride_ * batch_idx;
+      if (datum->ptr_ != res_buf) {
+        datum->ptr_ = res_buf;
+      }
+      ret = eval_func_(*this, ctx, *datum);
+      if (OB_LIKELY(OB_SUCCESS == ret)) {
+        flags.set(batch_idx);
+      } else {
+        datum->set_null();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExpr::eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const
+{
+  int ret = OB_SUCCESS;
+  ObEvalInfo& eval_info = get_eval_info(ctx);
+  if (!is_batch_result()) {
+    // non batch result expression is evaluated only once
+    ObDatum* datum = NULL;
+    if (OB_FAIL(eval(ctx, datum))) {
+      LOG_WARN("evaluate expression failed", K(ret));
+    }
+  } else if (NULL == eval_func_ || eval_info.evaluated_) {
+    // do nothing for const/column reference expr or already evaluated expr
+  } else if (OB_UNLIKELY(size > max_batch_size_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("batch size exceed max batch size", K(ret), K(size), K(max_batch_size_));
+  } else {
+    ObBitVector& flags = get_evaluated_flags(ctx);
+    if (!eval_info.eval_flags_valid_) {
+      flags.reset(get_batch_slot_cnt(max_batch_size_));
+      eval_info.eval_flags_valid_ = true;
+    }
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(size);
+    if (NULL != eval_batch_func_) {
+      if (OB_FAIL(eval_batch_func_(*this, ctx, skip, size))) {
+        LOG_WARN("evaluate batch failed", K(ret), K(size));
+      }
+    } else {
+      // Evaluate row by row, parameters are evaluated on demand by eval_func_,
+      // which keeps the short-circuit semantics of case when/and/or.
+      ObDatum* datum = NULL;
+      for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+        if (!skip.at(i) && !flags.at(i)) {
+          batch_info_guard.set_batch_idx(i);
+          if (OB_FAIL(eval(ctx, datum))) {
+            LOG_WARN("evaluate expression failed", K(ret), K(i));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 void* ObExprStrResAlloc::alloc(const int64_t size)
 {
   void* mem = expr_.get_str_res_mem(ctx_, off_ + size);
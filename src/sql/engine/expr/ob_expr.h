@@ -17,6 +17,7 @@
 #include "lib/allocator/ob_allocator.h"
 #include "share/datum/ob_datum.h"
 #include "sql/engine/ob_serializable_function.h"
+#include "sql/engine/ob_bit_vector.h"
 #include "sql/parser/ob_item_type.h"
 
 namespace oceanbase {
@@ -80,8 +81,9 @@ struct ObDatumMeta {
 struct ObEvalInfo {
   void clear_evaluated_flag()
   {
-    if (evaluated_) {
+    if (evaluated_ || eval_flags_valid_) {
       evaluated_ = false;
+      eval_flags_valid_ = false;
     }
   }
   DECLARE_TO_STRING;
@@ -98,6 +100,9 @@ struct ObEvalInfo {
       uint16_t notnull_ : 1;
       // pointer is point to reserved buffer in frame.
       uint16_t point_to_frame_ : 1;
+      // evaluated flags of batch result expression (the bit vector follows ObEvalInfo) are valid,
+      // the bit vector is reset lazily in evaluation if not valid.
+      uint16_t eval_flags_valid_ : 1;
     };
     uint16_t flag_;
   };
@@ -108,8 +113,51 @@ struct ObEvalInfo {
 // expression evaluate context
 struct ObEvalCtx {
   friend class ObExpr;
+  // Restore batch index and batch size of evaluate context when the guard destroyed.
+  class BatchInfoScopeGuard {
+    public:
+    explicit BatchInfoScopeGuard(ObEvalCtx& eval_ctx)
+        : eval_ctx_(eval_ctx), batch_idx_(eval_ctx.batch_idx_), batch_size_(eval_ctx.batch_size_)
+    {}
+    ~BatchInfoScopeGuard()
+    {
+      eval_ctx_.batch_idx_ = batch_idx_;
+      eval_ctx_.batch_size_ = batch_size_;
+    }
+    OB_INLINE void set_batch_idx(const int64_t idx)
+    {
+      eval_ctx_.batch_idx_ = idx;
+    }
+    OB_INLINE void set_batch_size(const int64_t size)
+    {
+      eval_ctx_.batch_size_ = size;
+    }
+
+    private:
+    ObEvalCtx& eval_ctx_;
+    int64_t batch_idx_;
+    int64_t batch_size_;
+  };
+
   ObEvalCtx(ObExecContext& exec_ctx, common::ObArenaAllocator& res_alloc, common::ObArenaAllocator& tmp_alloc);
 
+  OB_INLINE int64_t get_batch_idx() const
+  {
+    return batch_idx_;
+  }
+  OB_INLINE void set_batch_idx(const int64_t idx)
+  {
+    batch_idx_ = idx;
+  }
+  OB_INLINE int64_t get_batch_size() const
+  {
+    return batch_size_;
+  }
+  OB_INLINE void set_batch_size(const int64_t size)
+  {
+    batch_size_ = size;
+  }
+
   common::ObArenaAllocator& get_reset_tmp_alloc()
   {
 #ifndef NDEBUG
@@ -140,6 +188,11 @@ struct ObEvalCtx {
   // Temporary allocator for expression evaluating, may be reset immediately after ObExpr::eval().
   // Can not use allocator for expression result. (ObExpr::get_str_res_mem() is used for result).
   common::ObArenaAllocator& tmp_alloc_;
+
+  // Row index of batch, the datum of batch result expression is located by it.
+  int64_t batch_idx_;
+  // Rows count of batch in evaluating.
+  int64_t batch_size_;
 };
 
 typedef uint64_t (*ObExprHashFuncType)(const common::ObDatum& datum, const uint64_t seed);
@@ -186,6 +239,9 @@ struct ObExpr {
 
   ObExpr();
   OB_INLINE int eval(ObEvalCtx& ctx, common::ObDatum*& datum) const;
+  // Evaluate rows of batch which are not skipped, the results are located by locate_batch_datums().
+  // Evaluate row by row with eval_func_ if no eval_batch_func_ provided.
+  int eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const;
   int eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString>& str_values, const uint64_t cast_mode,
       common::ObDatum*& datum) const;
 
@@ -196,7 +252,14 @@ struct ObExpr {
   ObDatum& locate_expr_datum(ObEvalCtx& ctx) const
   {
     // performance critical, do not check pointer validity.
-    return *reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+    ObDatum* datum = reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+    return OB_LIKELY(!is_batch_result()) ? *datum : datum[ctx.batch_idx_];
+  }
+
+  // datum array of batch result expression, the datum of row i is locate_batch_datums()[i]
+  ObDatum* locate_batch_datums(ObEvalCtx& ctx) const
+  {
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
   }
 
   ObEvalInfo& get_eval_info(ObEvalCtx& ctx) const
@@ -204,6 +267,20 @@ struct ObExpr {
     return *reinterpret_cast<ObEvalInfo*>(ctx.frames_[frame_idx_] + eval_info_off_);
   }
 
+  // evaluated flags of each row, only valid for batch result expression.
+  ObBitVector& get_evaluated_flags(ObEvalCtx& ctx) const
+  {
+    return *to_bit_vector(ctx.frames_[frame_idx_] + eval_info_off_ + sizeof(ObEvalInfo));
+  }
+
+  // mark the datum located by evaluate context is evaluated
+  OB_INLINE void set_evaluated_flag(ObEvalCtx& ctx) const;
+
+  OB_INLINE bool is_batch_result() const
+  {
+    return max_batch_size_ > 0;
+  }
+
   // locate expr datum && reset ptr_ to reserved buf
   OB_INLINE ObDatum& locate_datum_for_write(ObEvalCtx& ctx) const;
   OB_INLINE ObDatum& locate_param_datum(ObEvalCtx& ctx, int param_index) const
@@ -215,7 +292,14 @@ struct ObExpr {
   // Dynamic allocated memory is allocated if reserved buffer if not enough.
   char* get_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   {
-    return OB_LIKELY(size <= res_buf_len_) ? ctx.frames_[frame_idx_] + res_buf_off_ : alloc_str_res_mem(ctx, size);
+    return OB_LIKELY(size <= res_buf_len_) ? get_res_buf(ctx) : alloc_str_res_mem(ctx, size);
+  }
+
+  // reserved buffer of the datum located by evaluate context
+  OB_INLINE char* get_res_buf(ObEvalCtx& ctx) const
+  {
+    char* res_buf = ctx.frames_[frame_idx_] + res_buf_off_;
+    return OB_LIKELY(!is_batch_result()) ? res_buf : res_buf + res_buf_stride_ * ctx.batch_idx_;
   }
 
   // Evaluate all parameters, assign the first sizeof...(args) parameters to %args.
@@ -247,15 +331,26 @@ struct ObExpr {
 
   TO_STRING_KV("type", get_type_name(type_), K_(datum_meta), K_(obj_meta), K_(obj_datum_map), KP_(eval_func),
       KP_(inner_functions), K_(inner_func_cnt), K_(arg_cnt), K_(parent_cnt), K_(frame_idx), K_(datum_off),
-      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), KP(this));
+      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), K_(max_batch_size), K_(res_buf_stride),
+      KP_(eval_batch_func), KP(this));
+
+  // slots count of datum, reserved buffer and evaluated flags of batch result expression
+  static int64_t get_batch_slot_cnt(const int64_t max_batch_size)
+  {
+    return max_batch_size > 0 ? max_batch_size + 1 : 1;
+  }
 
   private:
   char* alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const;
+  // eval() of batch result expression, out of line to keep the row by row path free of batch handling
+  int eval_batch_row(ObEvalCtx& ctx, common::ObDatum*& datum) const;
 
   public:
   typedef int (*EvalFunc)(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   typedef int (*EvalEnumSetFunc)(const ObExpr& expr, const common::ObIArray<common::ObString>& str_values,
       const uint64_t cast_mode, ObEvalCtx& ctx, ObDatum& expr_datum);
+  // evaluate rows which are not skipped and not evaluated, set evaluated flags after evaluated.
+  typedef int (*EvalBatchFunc)(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
 
   const static uint64_t MAGIC_NUM = 0x6367614D72707845L;  // string of "ExprMagc"
   uint64_t magic_;
@@ -304,6 +399,12 @@ struct ObExpr {
   uint32_t res_buf_len_;
   // expr context id
   uint32_t expr_ctx_id_;
+  // Max batch size of vectorized execution, zero for non batch result expression.
+  // Batch result expression's frame layout (N is max_batch_size_, slot N is reserved for
+  // storage layer projecting):
+  //   ObDatum * (N + 1) | ObEvalInfo | evaluated flags (N + 1 bits) | reserved buffer * (N + 1)
+  // Kept beside the frame offsets, it is tested by eval() before them.
+  uint32_t max_batch_size_;
   // extra info, reinterpreted by each expr
   union {
     uint64_t extra_;
@@ -311,6 +412,17 @@ struct ObExpr {
     ObIExprExtraInfo* extra_info_;
   };
   ObExprBasicFuncs* basic_funcs_;
+  // batch evaluate function, NULL if not provided.
+  union {
+    EvalBatchFunc eval_batch_func_;
+    // helper union member for eval_batch_func_ serialize && deserialize
+    sql::serializable_function ser_eval_batch_func_;
+  };
+  // distance of reserved buffers (with ObDynReserveBuf) of adjacent rows
+  uint32_t res_buf_stride_;
+  // UINT64_MAX for batch result expression, zero for others. Used by batch kernels to locate
+  // datum of batch and non batch parameters without branch, never used in row by row path.
+  uint64_t batch_idx_mask_;
 };
 
 // helper template to access ObExpr::extra_
@@ -568,12 +680,32 @@ OB_INLINE ObDatum& ObExpr::locate_datum_for_write(ObEvalCtx& ctx) const
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
   ObDatum* expr_datum = (ObDatum*)(frame + datum_off_);
-  if (expr_datum->ptr_ != frame + res_buf_off_) {
-    expr_datum->ptr_ = frame + res_buf_off_;
+  char* res_buf = frame + res_buf_off_;
+  if (OB_UNLIKELY(is_batch_result())) {
+    expr_datum += ctx.batch_idx_;
+    res_buf += res_buf_stride_ * ctx.batch_idx_;
+  }
+  if (expr_datum->ptr_ != res_buf) {
+    expr_datum->ptr_ = res_buf;
   }
   return *expr_datum;
 }
 
+OB_INLINE void ObExpr::set_evaluated_flag(ObEvalCtx& ctx) const
+{
+  ObEvalInfo& eval_info = get_eval_info(ctx);
+  if (!is_batch_result()) {
+    eval_info.evaluated_ = true;
+  } else {
+    ObBitVector& flags = get_evaluated_flags(ctx);
+    if (!eval_info.eval_flags_valid_) {
+      flags.reset(get_batch_slot_cnt(max_batch_size_));
+      eval_info.eval_flags_valid_ = true;
+    }
+    flags.set(ctx.batch_idx_);
+  }
+}
+
 template <typename... TS>
 OB_INLINE int ObExpr::eval_param_value(ObEvalCtx& ctx, TS&... args) const
 {
@@ -597,8 +729,11 @@ OB_INLINE int ObExpr::eval(ObEvalCtx& ctx, common::ObDatum*& datum) const
   datum = (ObDatum*)(frame + datum_off_);
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
 
-  // do nothing for const/column reference expr or already evaluated expr
-  if (NULL != eval_func_ && !eval_info->evaluated_) {
+  if (OB_UNLIKELY(is_batch_result())) {
+    // only exists in vectorized plan
+    ret = eval_batch_row(ctx, datum);
+  } else if (NULL != eval_func_ && !eval_info->evaluated_) {
+    // do nothing for const/column reference expr or already evaluated expr
     if (datum->ptr_ != frame + res_buf_off_) {
       datum->ptr_ = frame + res_buf_off_;
     }
@@ -18,6 +18,7 @@
 #include "sql/resolver/expr/ob_raw_expr.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
 namespace oceanbase {
 using namespace common;
 using namespace common::number;
@@ -534,6 +535,9 @@ int ObExprAdd::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
     if (OB_ISNULL(rt_expr.eval_func_)) {
       ret = OB_INVALID_ARGUMENT;
       LOG_WARN("unexpected params type", K(ret), K(left_type), K(right_type), K(result_type));
+    } else {
+      rt_expr.eval_batch_func_ =
+          ObExprBatchEvalHelper::get_arith_batch_func(ObBatchKernel::ARITH_ADD, result_type, left_type, right_type);
     }
   }
   return ret;
@@ -0,0 +1,947 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
+#include <math.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+#include "lib/worker.h"
+#include "sql/engine/ob_serializable_function.h"
+
+#if defined(__x86_64__)
+#define OB_KERNEL_AVX2 __attribute__((target("avx2")))
+#define OB_KERNEL_AVX512 __attribute__((target("avx512f,avx512dq")))
+#endif
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+
+static const uint64_t MURMUR_MULTIPLIER = 0xc6a4a7935bd1e995;
+static const int MURMUR_SHIFT = 47;
+
+// ---------------------------------- scalar kernels ----------------------------------
+
+template <typename T>
+static void cmp_scalar(const ObCmpOp cmp_op, const T* l, const T* r, int64_t* res, const int64_t n)
+{
+  switch (cmp_op) {
+    case CO_EQ:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] == r[i];
+      }
+      break;
+    case CO_NE:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = !(l[i] == r[i]);
+      }
+      break;
+    case CO_LT:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] < r[i];
+      }
+      break;
+    case CO_LE:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] == r[i] || l[i] < r[i];
+      }
+      break;
+    case CO_GT:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = !(l[i] == r[i] || l[i] < r[i]);
+      }
+      break;
+    case CO_GE:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = !(l[i] < r[i]);
+      }
+      break;
+    default:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] == r[i] ? 0 : (l[i] < r[i] ? -1 : 1);
+      }
+      break;
+  }
+}
+
+static bool arith_int64_scalar(
+    const ObBatchKernel::ArithOp op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  bool overflow = false;
+  switch (op) {
+    case ObBatchKernel::ARITH_ADD:
+      for (int64_t i = 0; i < n; i++) {
+        overflow |= __builtin_add_overflow(l[i], r[i], &res[i]);
+      }
+      break;
+    case ObBatchKernel::ARITH_SUB:
+      for (int64_t i = 0; i < n; i++) {
+        overflow |= __builtin_sub_overflow(l[i], r[i], &res[i]);
+      }
+      break;
+    default:
+      for (int64_t i = 0; i < n; i++) {
+        overflow |= __builtin_mul_overflow(l[i], r[i], &res[i]);
+      }
+      break;
+  }
+  return overflow;
+}
+
+static bool arith_double_scalar(
+    const ObBatchKernel::ArithOp op, const double* l, const double* r, double* res, const int64_t n)
+{
+  bool overflow = false;
+  switch (op) {
+    case ObBatchKernel::ARITH_ADD:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] + r[i];
+        overflow |= (0 != isinf(res[i]));
+      }
+      break;
+    case ObBatchKernel::ARITH_SUB:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] - r[i];
+        overflow |= (0 != isinf(res[i]));
+      }
+      break;
+    default:
+      for (int64_t i = 0; i < n; i++) {
+        res[i] = l[i] * r[i];
+        overflow |= (0 != isinf(res[i]));
+      }
+      break;
+  }
+  return overflow;
+}
+
+// murmurhash64A() of 8 bytes key
+OB_INLINE static uint64_t murmur_hash_uint64(const uint64_t v, const uint64_t seed)
+{
+  uint64_t h = seed ^ (sizeof(v) * MURMUR_MULTIPLIER);
+  uint64_t k = v * MURMUR_MULTIPLIER;
+  k ^= k >> MURMUR_SHIFT;
+  k *= MURMUR_MULTIPLIER;
+  h ^= k;
+  h *= MURMUR_MULTIPLIER;
+  h ^= h >> MURMUR_SHIFT;
+  h *= MURMUR_MULTIPLIER;
+  h ^= h >> MURMUR_SHIFT;
+  return h;
+}
+
+static void murmur_hash_scalar(const uint64_t* vals, uint64_t* hash, const int64_t n)
+{
+  for (int64_t i = 0; i < n; i++) {
+    hash[i] = murmur_hash_uint64(vals[i], hash[i]);
+  }
+}
+
+#if defined(__x86_64__)
+// ---------------------------------- AVX2 kernels ----------------------------------
+
+template <ObCmpOp cmp_op>
+OB_KERNEL_AVX2 static void cmp_int64_avx2(const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  const __m256i one = _mm256_set1_epi64x(1);
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+    __m256i v;
+    switch (cmp_op) {
+      case CO_EQ:
+        v = _mm256_and_si256(_mm256_cmpeq_epi64(a, b), one);
+        break;
+      case CO_NE:
+        v = _mm256_andnot_si256(_mm256_cmpeq_epi64(a, b), one);
+        break;
+      case CO_LT:
+        v = _mm256_and_si256(_mm256_cmpgt_epi64(b, a), one);
+        break;
+      case CO_LE:
+        v = _mm256_andnot_si256(_mm256_cmpgt_epi64(a, b), one);
+        break;
+      case CO_GT:
+        v = _mm256_and_si256(_mm256_cmpgt_epi64(a, b), one);
+        break;
+      default:
+        v = _mm256_andnot_si256(_mm256_cmpgt_epi64(b, a), one);
+        break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), v);
+  }
+  cmp_scalar(cmp_op, l + i, r + i, res + i, n - i);
+}
+
+// %PRED is the ordered or unordered predicate matches cmp_scalar() for NaN
+template <ObCmpOp cmp_op, int PRED>
+OB_KERNEL_AVX2 static void cmp_double_avx2(const double* l, const double* r, int64_t* res, const int64_t n)
+{
+  const __m256i one = _mm256_set1_epi64x(1);
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d a = _mm256_loadu_pd(l + i);
+    const __m256d b = _mm256_loadu_pd(r + i);
+    const __m256i v = _mm256_and_si256(_mm256_castpd_si256(_mm256_cmp_pd(a, b, PRED)), one);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), v);
+  }
+  cmp_scalar(cmp_op, l + i, r + i, res + i, n - i);
+}
+
+template <ObBatchKernel::ArithOp op>
+OB_KERNEL_AVX2 static bool arith_int64_avx2(const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  // sign bit of %sign is set if any result overflow
+  __m256i sign = _mm256_setzero_si256();
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+    __m256i v;
+    if (ObBatchKernel::ARITH_ADD == op) {
+      v = _mm256_add_epi64(a, b);
+      sign = _mm256_or_si256(sign, _mm256_and_si256(_mm256_xor_si256(a, v), _mm256_xor_si256(b, v)));
+    } else {
+      v = _mm256_sub_epi64(a, b);
+      sign = _mm256_or_si256(sign, _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, v)));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), v);
+  }
+  bool overflow = 0 != _mm256_movemask_pd(_mm256_castsi256_pd(sign));
+  overflow |= arith_int64_scalar(op, l + i, r + i, res + i, n - i);
+  return overflow;
+}
+
+template <ObBatchKernel::ArithOp op>
+OB_KERNEL_AVX2 static bool arith_double_avx2(const double* l, const double* r, double* res, const int64_t n)
+{
+  const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(INT64_MAX));
+  const __m256d inf = _mm256_set1_pd(INFINITY);
+  __m256d is_inf = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d a = _mm256_loadu_pd(l + i);
+    const __m256d b = _mm256_loadu_pd(r + i);
+    __m256d v;
+    if (ObBatchKernel::ARITH_ADD == op) {
+      v = _mm256_add_pd(a, b);
+    } else if (ObBatchKernel::ARITH_SUB == op) {
+      v = _mm256_sub_pd(a, b);
+    } else {
+      v = _mm256_mul_pd(a, b);
+    }
+    is_inf = _mm256_or_pd(is_inf, _mm256_cmp_pd(_mm256_and_pd(v, abs_mask), inf, _CMP_EQ_OQ));
+    _mm256_storeu_pd(res + i, v);
+  }
+  bool overflow = 0 != _mm256_movemask_pd(is_inf);
+  overflow |= arith_double_scalar(op, l + i, r + i, res + i, n - i);
+  return overflow;
+}
+
+// low 64 bits of a * MURMUR_MULTIPLIER, AVX2 has no 64 bits multiplication.
+OB_KERNEL_AVX2 static inline __m256i murmur_mul_avx2(const __m256i a)
+{
+  const __m256i m_lo = _mm256_set1_epi64x(MURMUR_MULTIPLIER & 0xFFFFFFFF);
+  const __m256i m_hi = _mm256_set1_epi64x(MURMUR_MULTIPLIER >> 32);
+  const __m256i lo_lo = _mm256_mul_epu32(a, m_lo);
+  const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), m_lo), _mm256_mul_epu32(a, m_hi));
+  return _mm256_add_epi64(lo_lo, _mm256_slli_epi64(cross, 32));
+}
+
+OB_KERNEL_AVX2 static void murmur_hash_avx2(const uint64_t* vals, uint64_t* hash, const int64_t n)
+{
+  const __m256i len_mul = _mm256_set1_epi64x(sizeof(uint64_t) * MURMUR_MULTIPLIER);
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals + i));
+    __m256i h = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hash + i)), len_mul);
+    k = murmur_mul_avx2(k);
+    k = _mm256_xor_si256(k, _mm256_srli_epi64(k, MURMUR_SHIFT));
+    k = murmur_mul_avx2(k);
+    h = murmur_mul_avx2(_mm256_xor_si256(h, k));
+    h = murmur_mul_avx2(_mm256_xor_si256(h, _mm256_srli_epi64(h, MURMUR_SHIFT)));
+    h = _mm256_xor_si256(h, _mm256_srli_epi64(h, MURMUR_SHIFT));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(hash + i), h);
+  }
+  murmur_hash_scalar(vals + i, hash + i, n - i);
+}
+
+// ---------------------------------- AVX-512 kernels ----------------------------------
+
+template <ObCmpOp cmp_op, int PRED>
+OB_KERNEL_AVX512 static void cmp_int64_avx512(const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  const __m512i one = _mm512_set1_epi64(1);
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512i a = _mm512_loadu_si512(l + i);
+    const __m512i b = _mm512_loadu_si512(r + i);
+    _mm512_storeu_si512(res + i, _mm512_maskz_mov_epi64(_mm512_cmp_epi64_mask(a, b, PRED), one));
+  }
+  cmp_scalar(cmp_op, l + i, r + i, res + i, n - i);
+}
+
+template <ObCmpOp cmp_op, int PRED>
+OB_KERNEL_AVX512 static void cmp_double_avx512(const double* l, const double* r, int64_t* res, const int64_t n)
+{
+  const __m512i one = _mm512_set1_epi64(1);
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d a = _mm512_loadu_pd(l + i);
+    const __m512d b = _mm512_loadu_pd(r + i);
+    _mm512_storeu_si512(res + i, _mm512_maskz_mov_epi64(_mm512_cmp_pd_mask(a, b, PRED), one));
+  }
+  cmp_scalar(cmp_op, l + i, r + i, res + i, n - i);
+}
+
+template <ObBatchKernel::ArithOp op>
+OB_KERNEL_AVX512 static bool arith_int64_avx512(const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  __m512i sign = _mm512_setzero_si512();
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512i a = _mm512_loadu_si512(l + i);
+    const __m512i b = _mm512_loadu_si512(r + i);
+    __m512i v;
+    if (ObBatchKernel::ARITH_ADD == op) {
+      v = _mm512_add_epi64(a, b);
+      sign = _mm512_or_si512(sign, _mm512_and_si512(_mm512_xor_si512(a, v), _mm512_xor_si512(b, v)));
+    } else {
+      v = _mm512_sub_epi64(a, b);
+      sign = _mm512_or_si512(sign, _mm512_and_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(a, v)));
+    }
+    _mm512_storeu_si512(res + i, v);
+  }
+  bool overflow = 0 != _mm512_cmp_epi64_mask(sign, _mm512_setzero_si512(), _MM_CMPINT_LT);
+  overflow |= arith_int64_scalar(op, l + i, r + i, res + i, n - i);
+  return overflow;
+}
+
+template <ObBatchKernel::ArithOp op>
+OB_KERNEL_AVX512 static bool arith_double_avx512(const double* l, const double* r, double* res, const int64_t n)
+{
+  const __m512i abs_mask = _mm512_set1_epi64(INT64_MAX);
+  const __m512d inf = _mm512_set1_pd(INFINITY);
+  __mmask8 is_inf = 0;
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d a = _mm512_loadu_pd(l + i);
+    const __m512d b = _mm512_loadu_pd(r + i);
+    __m512d v;
+    if (ObBatchKernel::ARITH_ADD == op) {
+      v = _mm512_add_pd(a, b);
+    } else if (ObBatchKernel::ARITH_SUB == op) {
+      v = _mm512_sub_pd(a, b);
+    } else {
+      v = _mm512_mul_pd(a, b);
+    }
+    const __m512d abs = _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(v), abs_mask));
+    is_inf = is_inf | _mm512_cmp_pd_mask(abs, inf, _CMP_EQ_OQ);
+    _mm512_storeu_pd(res + i, v);
+  }
+  bool overflow = 0 != is_inf;
+  overflow |= arith_double_scalar(op, l + i, r + i, res + i, n - i);
+  return overflow;
+}
+
+OB_KERNEL_AVX512 static void murmur_hash_avx512(const uint64_t* vals, uint64_t* hash, const int64_t n)
+{
+  const __m512i m = _mm512_set1_epi64(MURMUR_MULTIPLIER);
+  const __m512i len_mul = _mm512_set1_epi64(sizeof(uint64_t) * MURMUR_MULTIPLIER);
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512i k = _mm512_loadu_si512(vals + i);
+    __m512i h = _mm512_xor_si512(_mm512_loadu_si512(hash + i), len_mul);
+    k = _mm512_mullo_epi64(k, m);
+    k = _mm512_xor_si512(k, _mm512_srli_epi64(k, MURMUR_SHIFT));
+    k = _mm512_mullo_epi64(k, m);
+    h = _mm512_mullo_epi64(_mm512_xor_si512(h, k), m);
+    h = _mm512_mullo_epi64(_mm512_xor_si512(h, _mm512_srli_epi64(h, MURMUR_SHIFT)), m);
+    h = _mm512_xor_si512(h, _mm512_srli_epi64(h, MURMUR_SHIFT));
+    _mm512_storeu_si512(hash + i, h);
+  }
+  murmur_hash_scalar(vals + i, hash + i, n - i);
+}
+
+static ObBatchKernel::SimdLevel detect_simd_level()
+{
+  ObBatchKernel::SimdLevel level = ObBatchKernel::SIMD_NONE;
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid_max(0, NULL) >= 7) {
+    __cpuid(1, eax, ebx, ecx, edx);
+    const bool os_xsave = (ecx & bit_OSXSAVE);
+    uint32_t xcr0 = 0;
+    if (os_xsave) {
+      uint32_t xcr0_hi = 0;
+      __asm__ __volatile__("xgetbv" : "=a"(xcr0), "=d"(xcr0_hi) : "c"(0));
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    // YMM state enabled by OS
+    if ((xcr0 & 0x6) == 0x6 && (ebx & bit_AVX2)) {
+      level = ObBatchKernel::SIMD_AVX2;
+      // opmask and ZMM state enabled by OS, AVX512F: ebx bit 16, AVX512DQ: ebx bit 17
+      if ((xcr0 & 0xE6) == 0xE6 && (ebx & (1U << 16)) && (ebx & (1U << 17))) {
+        level = ObBatchKernel::SIMD_AVX512;
+      }
+    }
+  }
+  return level;
+}
+#else
+static ObBatchKernel::SimdLevel detect_simd_level()
+{
+  return ObBatchKernel::SIMD_NONE;
+}
+#endif
+
+// ---------------------------------- dispatch ----------------------------------
+
+ObBatchKernel::SimdLevel ObBatchKernel::simd_level_ = detect_simd_level();
+
+ObBatchKernel::SimdLevel ObBatchKernel::get_cpu_simd_level()
+{
+  static SimdLevel cpu_level = detect_simd_level();
+  return cpu_level;
+}
+
+int ObBatchKernel::set_simd_level(const SimdLevel level)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(level < SIMD_NONE || level > get_cpu_simd_level())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("SIMD level not supported by CPU", K(ret), K(level), "cpu_level", get_cpu_simd_level());
+  } else {
+    simd_level_ = level;
+  }
+  return ret;
+}
+
+void ObBatchKernel::cmp(const ObCmpOp cmp_op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  switch (simd_level_) {
+#if defined(__x86_64__)
+    case SIMD_AVX512:
+      switch (cmp_op) {
+        case CO_EQ:
+          cmp_int64_avx512<CO_EQ, _MM_CMPINT_EQ>(l, r, res, n);
+          break;
+        case CO_NE:
+          cmp_int64_avx512<CO_NE, _MM_CMPINT_NE>(l, r, res, n);
+          break;
+        case CO_LT:
+          cmp_int64_avx512<CO_LT, _MM_CMPINT_LT>(l, r, res, n);
+          break;
+        case CO_LE:
+          cmp_int64_avx512<CO_LE, _MM_CMPINT_LE>(l, r, res, n);
+          break;
+        case CO_GT:
+          cmp_int64_avx512<CO_GT, _MM_CMPINT_NLE>(l, r, res, n);
+          break;
+        case CO_GE:
+          cmp_int64_avx512<CO_GE, _MM_CMPINT_NLT>(l, r, res, n);
+          break;
+        default:
+          cmp_scalar(cmp_op, l, r, res, n);
+          break;
+      }
+      break;
+    case SIMD_AVX2:
+      switch (cmp_op) {
+        case CO_EQ:
+          cmp_int64_avx2<CO_EQ>(l, r, res, n);
+          break;
+        case CO_NE:
+          cmp_int64_avx2<CO_NE>(l, r, res, n);
+          break;
+        case CO_LT:
+          cmp_int64_avx2<CO_LT>(l, r, res, n);
+          break;
+        case CO_LE:
+          cmp_int64_avx2<CO_LE>(l, r, res, n);
+          break;
+        case CO_GT:
+          cmp_int64_avx2<CO_GT>(l, r, res, n);
+          break;
+        case CO_GE:
+          cmp_int64_avx2<CO_GE>(l, r, res, n);
+          break;
+        default:
+          cmp_scalar(cmp_op, l, r, res, n);
+          break;
+      }
+      break;
+#endif
+    default:
+      cmp_scalar(cmp_op, l, r, res, n);
+      break;
+  }
+}
+
+void ObBatchKernel::cmp(const ObCmpOp cmp_op, const double* l, const double* r, int64_t* res, const int64_t n)
+{
+  // NaN is not equal to and not less than any value:
+  //   EQ: ordered equal, NE: unordered not equal, LT/LE: ordered,
+  //   GT: unordered not less equal, GE: unordered not less than.
+  switch (simd_level_) {
+#if defined(__x86_64__)
+    case SIMD_AVX512:
+      switch (cmp_op) {
+        case CO_EQ:
+          cmp_double_avx512<CO_EQ, _CMP_EQ_OQ>(l, r, res, n);
+          break;
+        case CO_NE:
+          cmp_double_avx512<CO_NE, _CMP_NEQ_UQ>(l, r, res, n);
+          break;
+        case CO_LT:
+          cmp_double_avx512<CO_LT, _CMP_LT_OQ>(l, r, res, n);
+          break;
+        case CO_LE:
+          cmp_double_avx512<CO_LE, _CMP_LE_OQ>(l, r, res, n);
+          break;
+        case CO_GT:
+          cmp_double_avx512<CO_GT, _CMP_NLE_UQ>(l, r, res, n);
+          break;
+        case CO_GE:
+          cmp_double_avx512<CO_GE, _CMP_NLT_UQ>(l, r, res, n);
+          break;
+        default:
+          cmp_scalar(cmp_op, l, r, res, n);
+          break;
+      }
+      break;
+    case SIMD_AVX2:
+      switch (cmp_op) {
+        case CO_EQ:
+          cmp_double_avx2<CO_EQ, _CMP_EQ_OQ>(l, r, res, n);
+          break;
+        case CO_NE:
+          cmp_double_avx2<CO_NE, _CMP_NEQ_UQ>(l, r, res, n);
+          break;
+        case CO_LT:
+          cmp_double_avx2<CO_LT, _CMP_LT_OQ>(l, r, res, n);
+          break;
+        case CO_LE:
+          cmp_double_avx2<CO_LE, _CMP_LE_OQ>(l, r, res, n);
+          break;
+        case CO_GT:
+          cmp_double_avx2<CO_GT, _CMP_NLE_UQ>(l, r, res, n);
+          break;
+        case CO_GE:
+          cmp_double_avx2<CO_GE, _CMP_NLT_UQ>(l, r, res, n);
+          break;
+        default:
+          cmp_scalar(cmp_op, l, r, res, n);
+          break;
+      }
+      break;
+#endif
+    default:
+      cmp_scalar(cmp_op, l, r, res, n);
+      break;
+  }
+}
+
+bool ObBatchKernel::arith(const ArithOp op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t n)
+{
+  bool overflow = false;
+  // no SIMD overflow detection of 64 bits multiplication, always scalar
+  switch (ARITH_MUL == op ? SIMD_NONE : simd_level_) {
+#if defined(__x86_64__)
+    case SIMD_AVX512:
+      overflow = ARITH_ADD == op ? arith_int64_avx512<ARITH_ADD>(l, r, res, n)
+                                 : arith_int64_avx512<ARITH_SUB>(l, r, res, n);
+      break;
+    case SIMD_AVX2:
+      overflow =
+          ARITH_ADD == op ? arith_int64_avx2<ARITH_ADD>(l, r, res, n) : arith_int64_avx2<ARITH_SUB>(l, r, res, n);
+      break;
+#endif
+    default:
+      overflow = arith_int64_scalar(op, l, r, res, n);
+      break;
+  }
+  return overflow;
+}
+
+bool ObBatchKernel::arith(const ArithOp op, const double* l, const double* r, double* res, const int64_t n)
+{
+  bool overflow = false;
+  switch (simd_level_) {
+#if defined(__x86_64__)
+    case SIMD_AVX512:
+      overflow = ARITH_ADD == op   ? arith_double_avx512<ARITH_ADD>(l, r, res, n)
+                 : ARITH_SUB == op ? arith_double_avx512<ARITH_SUB>(l, r, res, n)
+                                   : arith_double_avx512<ARITH_MUL>(l, r, res, n);
+      break;
+    case SIMD_AVX2:
+      overflow = ARITH_ADD == op   ? arith_double_avx2<ARITH_ADD>(l, r, res, n)
+                 : ARITH_SUB == op ? arith_double_avx2<ARITH_SUB>(l, r, res, n)
+                                   : arith_double_avx2<ARITH_MUL>(l, r, res, n);
+      break;
+#endif
+    default:
+      overflow = arith_double_scalar(op, l, r, res, n);
+      break;
+  }
+  return overflow;
+}
+
+void ObBatchKernel::murmur_hash(const uint64_t* vals, uint64_t* hash, const int64_t n)
+{
+  switch (simd_level_) {
+#if defined(__x86_64__)
+    case SIMD_AVX512:
+      murmur_hash_avx512(vals, hash, n);
+      break;
+    case SIMD_AVX2:
+      murmur_hash_avx2(vals, hash, n);
+      break;
+#endif
+    default:
+      murmur_hash_scalar(vals, hash, n);
+      break;
+  }
+}
+
+// ---------------------------------- batch evaluate functions ----------------------------------
+
+// fixed width value of datum, as kernel input
+struct ObBatchIntValue {
+  typedef int64_t ValueType;
+  OB_INLINE static int64_t get(const ObDatum& d)
+  {
+    return *d.int_;
+  }
+  OB_INLINE static void set(ObDatum& d, const int64_t v)
+  {
+    d.set_int(v);
+  }
+};
+
+// flip the sign bit, so signed comparison of the value is the same with unsigned comparison
+struct ObBatchUIntValue {
+  typedef int64_t ValueType;
+  OB_INLINE static int64_t get(const ObDatum& d)
+  {
+    return static_cast<int64_t>(*d.uint_ ^ (1UL << 63));
+  }
+};
+
+struct ObBatchDateValue {
+  typedef int64_t ValueType;
+  OB_INLINE static int64_t get(const ObDatum& d)
+  {
+    return *reinterpret_cast<const int32_t*>(d.ptr_);
+  }
+};
+
+struct ObBatchDoubleValue {
+  typedef double ValueType;
+  OB_INLINE static double get(const ObDatum& d)
+  {
+    return *d.double_;
+  }
+  OB_INLINE static void set(ObDatum& d, const double v)
+  {
+    d.set_double(v);
+  }
+};
+
+OB_INLINE static ObDatum& locate_datum_for_write(const ObExpr& expr, char* frame, ObDatum* datums, const int64_t idx)
+{
+  ObDatum& datum = datums[idx];
+  datum.ptr_ = frame + expr.res_buf_off_ + expr.res_buf_stride_ * idx;
+  return datum;
+}
+
+// Evaluate operands of binary operator. If %short_circuit is true, right operand is evaluated
+// only for rows whose left operand is not null, which is the same with row by row evaluation.
+static int eval_batch_operands(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size, const bool short_circuit)
+{
+  int ret = OB_SUCCESS;
+  const ObExpr& left = *expr.args_[0];
+  const ObExpr& right = *expr.args_[1];
+  if (OB_FAIL(left.eval_batch(ctx, skip, size))) {
+    LOG_WARN("evaluate left operand failed", K(ret));
+  } else if (!short_circuit || NULL == right.eval_func_) {
+    if (OB_FAIL(right.eval_batch(ctx, skip, size))) {
+      LOG_WARN("evaluate right operand failed", K(ret));
+    }
+  } else {
+    const ObDatum* l_datums = left.locate_batch_datums(ctx);
+    const ObBitVector& flags = expr.get_evaluated_flags(ctx);
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    ObDatum* datum = NULL;
+    for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+      if (!skip.at(i) && !flags.at(i) && !l_datums[i & left.batch_idx_mask_].is_null()) {
+        batch_info_guard.set_batch_idx(i);
+        if (OB_FAIL(right.eval(ctx, datum))) {
+          LOG_WARN("evaluate right operand failed", K(ret), K(i));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+// Gather operand values of rows in [start, end) to evaluate, the result of row with null operand
+// is set to null directly. Return count of gathered rows.
+template <typename V>
+static int64_t gather_operands(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t start,
+    const int64_t end, typename V::ValueType* l_vals, typename V::ValueType* r_vals, int64_t* rows)
+{
+  const ObExpr& left = *expr.args_[0];
+  const ObExpr& right = *expr.args_[1];
+  const ObDatum* l_datums = left.locate_batch_datums(ctx);
+  const ObDatum* r_datums = right.locate_batch_datums(ctx);
+  ObDatum* results = expr.locate_batch_datums(ctx);
+  ObBitVector& flags = expr.get_evaluated_flags(ctx);
+  int64_t cnt = 0;
+  for (int64_t i = start; i < end; i++) {
+    if (!skip.at(i) && !flags.at(i)) {
+      const ObDatum& l = l_datums[i & left.batch_idx_mask_];
+      const ObDatum& r = r_datums[i & right.batch_idx_mask_];
+      if (l.is_null() || r.is_null()) {
+        results[i].set_null();
+        flags.set(i);
+      } else {
+        l_vals[cnt] = V::get(l);
+        r_vals[cnt] = V::get(r);
+        rows[cnt] = i;
+        cnt++;
+      }
+    }
+  }
+  return cnt;
+}
+
+template <typename V, ObCmpOp cmp_op>
+struct ObRelationalBatchEval {
+  static int eval(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_FAIL(eval_batch_operands(expr, ctx, skip, size, true /* short circuit */))) {
+      LOG_WARN("evaluate operands failed", K(ret));
+    } else {
+      typename V::ValueType l_vals[ObBatchKernel::KERNEL_BATCH_SIZE];
+      typename V::ValueType r_vals[ObBatchKernel::KERNEL_BATCH_SIZE];
+      int64_t res[ObBatchKernel::KERNEL_BATCH_SIZE];
+      int64_t rows[ObBatchKernel::KERNEL_BATCH_SIZE];
+      char* frame = ctx.frames_[expr.frame_idx_];
+      ObDatum* results = expr.locate_batch_datums(ctx);
+      ObBitVector& flags = expr.get_evaluated_flags(ctx);
+      for (int64_t start = 0; start < size; start += ObBatchKernel::KERNEL_BATCH_SIZE) {
+        const int64_t end = size - start > ObBatchKernel::KERNEL_BATCH_SIZE ? start + ObBatchKernel::KERNEL_BATCH_SIZE
+                                                                              : size;
+        const int64_t cnt = gather_operands<V>(expr, ctx, skip, start, end, l_vals, r_vals, rows);
+        ObBatchKernel::cmp(cmp_op, l_vals, r_vals, res, cnt);
+        for (int64_t i = 0; i < cnt; i++) {
+          locate_datum_for_write(expr, frame, results, rows[i]).set_int(res[i]);
+          flags.set(rows[i]);
+        }
+      }
+    }
+    return ret;
+  }
+};
+
+template <typename V, ObBatchKernel::ArithOp op>
+struct ObArithBatchEval {
+  static int eval(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+  {
+    int ret = OB_SUCCESS;
+    // both operands are evaluated in mysql mode, see ObArithExprOperator::get_arith_operand()
+    if (OB_FAIL(eval_batch_operands(expr, ctx, skip, size, lib::is_oracle_mode()))) {
+      LOG_WARN("evaluate operands failed", K(ret));
+    } else {
+      typename V::ValueType l_vals[ObBatchKernel::KERNEL_BATCH_SIZE];
+      typename V::ValueType r_vals[ObBatchKernel::KERNEL_BATCH_SIZE];
+      typename V::ValueType res[ObBatchKernel::KERNEL_BATCH_SIZE];
+      int64_t rows[ObBatchKernel::KERNEL_BATCH_SIZE];
+      char* frame = ctx.frames_[expr.frame_idx_];
+      ObDatum* results = expr.locate_batch_datums(ctx);
+      ObBitVector& flags = expr.get_evaluated_flags(ctx);
+      for (int64_t start = 0; OB_SUCC(ret) && start < size; start += ObBatchKernel::KERNEL_BATCH_SIZE) {
+        const int64_t end = size - start > ObBatchKernel::KERNEL_BATCH_SIZE ? start + ObBatchKernel::KERNEL_BATCH_SIZE
+                                                                              : size;
+        const int64_t cnt = gather_operands<V>(expr, ctx, skip, start, end, l_vals, r_vals, rows);
+        if (!ObBatchKernel::arith(op, l_vals, r_vals, res, cnt)) {
+          for (int64_t i = 0; i < cnt; i++) {
+            V::set(locate_datum_for_write(expr, frame, results, rows[i]), res[i]);
+            flags.set(rows[i]);
+          }
+        } else {
+          // overflow, evaluate row by row to get the same result and error message with eval_func_
+          ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+          ObDatum* datum = NULL;
+          for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+            batch_info_guard.set_batch_idx(rows[i]);
+            if (OB_FAIL(expr.eval(ctx, datum))) {
+              LOG_WARN("evaluate failed", K(ret), K(rows[i]));
+            }
+          }
+        }
+      }
+    }
+    return ret;
+  }
+};
+
+enum ObBatchValueKind { BATCH_VALUE_INT = 0, BATCH_VALUE_UINT, BATCH_VALUE_DATE, BATCH_VALUE_DOUBLE, BATCH_VALUE_MAX };
+
+static ObBatchValueKind get_batch_value_kind(const ObObjTypeClass tc)
+{
+  ObBatchValueKind kind = BATCH_VALUE_MAX;
+  switch (tc) {
+    case ObIntTC:
+    case ObDateTimeTC:
+    case ObTimeTC:
+      kind = BATCH_VALUE_INT;
+      break;
+    case ObUIntTC:
+      kind = BATCH_VALUE_UINT;
+      break;
+    case ObDateTC:
+      kind = BATCH_VALUE_DATE;
+      break;
+    case ObDoubleTC:
+      kind = BATCH_VALUE_DOUBLE;
+      break;
+    default:
+      break;
+  }
+  return kind;
+}
+
+#define RELATIONAL_BATCH_FUNCS(V)                                                                            \
+  {                                                                                                          \
+    ObRelationalBatchEval<V, CO_EQ>::eval, ObRelationalBatchEval<V, CO_LE>::eval,                            \
+        ObRelationalBatchEval<V, CO_LT>::eval, ObRelationalBatchEval<V, CO_GE>::eval,                        \
+        ObRelationalBatchEval<V, CO_GT>::eval, ObRelationalBatchEval<V, CO_NE>::eval, NULL /* CO_CMP */ \
+  }
+
+static_assert(7 == CO_MAX, "unexpected size");
+static ObExpr::EvalBatchFunc RELATIONAL_BATCH_FUNCS[BATCH_VALUE_MAX][CO_MAX] = {
+    RELATIONAL_BATCH_FUNCS(ObBatchIntValue),
+    RELATIONAL_BATCH_FUNCS(ObBatchUIntValue),
+    RELATIONAL_BATCH_FUNCS(ObBatchDateValue),
+    RELATIONAL_BATCH_FUNCS(ObBatchDoubleValue),
+};
+
+static ObExpr::EvalBatchFunc ARITH_BATCH_FUNCS[2][ObBatchKernel::ARITH_MAX] = {
+    {ObArithBatchEval<ObBatchIntValue, ObBatchKernel::ARITH_ADD>::eval,
+        ObArithBatchEval<ObBatchIntValue, ObBatchKernel::ARITH_SUB>::eval,
+        ObArithBatchEval<ObBatchIntValue, ObBatchKernel::ARITH_MUL>::eval},
+    {ObArithBatchEval<ObBatchDoubleValue, ObBatchKernel::ARITH_ADD>::eval,
+        ObArithBatchEval<ObBatchDoubleValue, ObBatchKernel::ARITH_SUB>::eval,
+        ObArithBatchEval<ObBatchDoubleValue, ObBatchKernel::ARITH_MUL>::eval},
+};
+
+ObExpr::EvalBatchFunc ObExprBatchEvalHelper::get_relational_batch_func(
+    const ObObjType type1, const ObObjType type2, const ObCmpOp cmp_op)
+{
+  ObExpr::EvalBatchFunc func = NULL;
+  const ObObjTypeClass tc1 = ob_obj_type_class(type1);
+  const ObObjTypeClass tc2 = ob_obj_type_class(type2);
+  if (tc1 == tc2 && ob_is_valid_cmp_op_bool(cmp_op)) {
+    const ObBatchValueKind kind = get_batch_value_kind(tc1);
+    if (BATCH_VALUE_MAX != kind) {
+      func = RELATIONAL_BATCH_FUNCS[kind][cmp_op];
+    }
+  }
+  return func;
+}
+
+ObExpr::EvalBatchFunc ObExprBatchEvalHelper::get_arith_batch_func(
+    const ObBatchKernel::ArithOp op, const ObObjType res_type, const ObObjType type1, const ObObjType type2)
+{
+  ObExpr::EvalBatchFunc func = NULL;
+  const ObObjTypeClass tc1 = ob_obj_type_class(type1);
+  const ObObjTypeClass tc2 = ob_obj_type_class(type2);
+  if (op >= ObBatchKernel::ARITH_ADD && op < ObBatchKernel::ARITH_MAX && tc1 == tc2) {
+    if (ObIntType == res_type && ObIntTC == tc1) {
+      func = ARITH_BATCH_FUNCS[0][op];
+    } else if (ObDoubleType == res_type && ObDoubleTC == tc1) {
+      func = ARITH_BATCH_FUNCS[1][op];
+    }
+  }
+  return func;
+}
+
+int ObExprBatchEvalHelper::calc_murmur_hash_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size, uint64_t* hash_vals)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(expr.basic_funcs_) || OB_ISNULL(hash_vals)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(expr.basic_funcs_), KP(hash_vals));
+  } else {
+    // all fixed width types are hashed as 8 bytes value, see ObjHashCalculator
+    const ObBatchValueKind kind = get_batch_value_kind(ob_obj_type_class(expr.datum_meta_.type_));
+    const ObExprHashFuncType hash_func = expr.basic_funcs_->murmur_hash_;
+    const ObDatum* datums = expr.locate_batch_datums(ctx);
+    const uint64_t mask = expr.batch_idx_mask_;
+    uint64_t vals[ObBatchKernel::KERNEL_BATCH_SIZE];
+    uint64_t hash[ObBatchKernel::KERNEL_BATCH_SIZE];
+    int64_t rows[ObBatchKernel::KERNEL_BATCH_SIZE];
+    for (int64_t start = 0; start < size; start += ObBatchKernel::KERNEL_BATCH_SIZE) {
+      const int64_t end =
+          size - start > ObBatchKernel::KERNEL_BATCH_SIZE ? start + ObBatchKernel::KERNEL_BATCH_SIZE : size;
+      int64_t cnt = 0;
+      for (int64_t i = start; i < end; i++) {
+        if (skip.at(i)) {
+        } else if (BATCH_VALUE_MAX == kind || datums[i & mask].is_null()) {
+          hash_vals[i] = hash_func(datums[i & mask], hash_vals[i]);
+        } else {
+          const ObDatum& datum = datums[i & mask];
+          if (BATCH_VALUE_DOUBLE == kind) {
+            // -0.0 is hashed as 0.0
+            double v = *datum.double_;
+            v = (0.0 == v) ? 0.0 : v;
+            MEMCPY(&vals[cnt], &v, sizeof(v));
+          } else if (BATCH_VALUE_DATE == kind) {
+            vals[cnt] = static_cast<uint64_t>(ObBatchDateValue::get(datum));
+          } else {
+            vals[cnt] = *datum.uint_;
+          }
+          hash[cnt] = hash_vals[i];
+          rows[cnt] = i;
+          cnt++;
+        }
+      }
+      ObBatchKernel::murmur_hash(vals, hash, cnt);
+      for (int64_t i = 0; i < cnt; i++) {
+        hash_vals[rows[i]] = hash[i];
+      }
+    }
+  }
+  return ret;
+}
+
+static_assert(BATCH_VALUE_MAX * CO_MAX == sizeof(RELATIONAL_BATCH_FUNCS) / sizeof(void*), "unexpected size");
+REG_SER_FUNC_ARRAY(
+    OB_SFA_RELATION_EXPR_EVAL_BATCH, RELATIONAL_BATCH_FUNCS, sizeof(RELATIONAL_BATCH_FUNCS) / sizeof(void*));
+
+static_assert(2 * ObBatchKernel::ARITH_MAX == sizeof(ARITH_BATCH_FUNCS) / sizeof(void*), "unexpected size");
+REG_SER_FUNC_ARRAY(OB_SFA_ARITH_EXPR_EVAL_BATCH, ARITH_BATCH_FUNCS, sizeof(ARITH_BATCH_FUNCS) / sizeof(void*));
+
+}  // end namespace sql
+}  // end namespace oceanbase
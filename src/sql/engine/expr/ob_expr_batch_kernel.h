@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_BATCH_KERNEL_H_
+#define OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_BATCH_KERNEL_H_
+
+#include "common/object/ob_obj_compare.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Kernels over contiguous arrays of fixed width values.
+//
+// The SIMD implementation (scalar, AVX2 or AVX-512) is chosen by the CPU at runtime,
+// all levels produce exactly the same results with the scalar expression functions:
+//   - comparison is derived from (l == r) and (l < r) like ObDatumCmpHelperByTC,
+//     so NaN is greater than any other double;
+//   - arithmetic reports overflow (int64 overflow or double infinity), the caller falls back
+//     to the scalar expression function to raise the error;
+//   - murmur_hash() is murmurhash64A() of the 8 bytes value.
+class ObBatchKernel {
+  public:
+  enum SimdLevel { SIMD_NONE = 0, SIMD_AVX2, SIMD_AVX512, SIMD_MAX };
+  enum ArithOp { ARITH_ADD = 0, ARITH_SUB, ARITH_MUL, ARITH_MAX };
+  // max values processed by one kernel call, gathered on stack by the batch evaluate functions.
+  static const int64_t KERNEL_BATCH_SIZE = 256;
+
+  static SimdLevel get_simd_level()
+  {
+    return simd_level_;
+  }
+  // highest level supported by CPU and OS
+  static SimdLevel get_cpu_simd_level();
+  // force to lower SIMD level (used by test), fail if not supported by CPU.
+  static int set_simd_level(const SimdLevel level);
+
+  // res[i] = (l[i] cmp_op r[i]) ? 1 : 0, or -1/0/1 for CO_CMP
+  static void cmp(const common::ObCmpOp cmp_op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t n);
+  static void cmp(const common::ObCmpOp cmp_op, const double* l, const double* r, int64_t* res, const int64_t n);
+
+  // res[i] = l[i] op r[i], return true if any result overflow.
+  static bool arith(const ArithOp op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t n);
+  static bool arith(const ArithOp op, const double* l, const double* r, double* res, const int64_t n);
+
+  // hash[i] = murmurhash64A(&vals[i], sizeof(vals[i]), hash[i])
+  static void murmur_hash(const uint64_t* vals, uint64_t* hash, const int64_t n);
+
+  private:
+  static SimdLevel simd_level_;
+};
+
+// Batch evaluate functions of fixed width expressions based on ObBatchKernel, values of
+// a batch are gathered from datums to arrays, computed by kernel and scattered back.
+class ObExprBatchEvalHelper {
+  public:
+  // batch evaluate function of relational expression, NULL if not supported.
+  static ObExpr::EvalBatchFunc get_relational_batch_func(
+      const common::ObObjType type1, const common::ObObjType type2, const common::ObCmpOp cmp_op);
+  // batch evaluate function of + - * expression, NULL if not supported.
+  static ObExpr::EvalBatchFunc get_arith_batch_func(const ObBatchKernel::ArithOp op,
+      const common::ObObjType res_type, const common::ObObjType type1, const common::ObObjType type2);
+
+  // hash_vals[i] = expr.basic_funcs_->murmur_hash_(datum of row i, hash_vals[i]) for rows not skipped,
+  // %expr must be evaluated.
+  static int calc_murmur_hash_batch(
+      const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size, uint64_t* hash_vals);
+};
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_BATCH_KERNEL_H_
@@ -20,6 +20,7 @@
 #include "sql/session/ob_sql_session_info.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
 
 namespace oceanbase {
 using namespace common;
@@ -591,6 +592,9 @@ int ObExprMinus::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObEx
     if (OB_ISNULL(rt_expr.eval_func_)) {
       ret = OB_INVALID_ARGUMENT;
       LOG_WARN("unexpected params type.", K(ret), K(left_type), K(right_type), K(result_type));
+    } else {
+      rt_expr.eval_batch_func_ =
+          ObExprBatchEvalHelper::get_arith_batch_func(ObBatchKernel::ARITH_SUB, result_type, left_type, right_type);
     }
   }
   return ret;
@@ -15,6 +15,7 @@
 #include "sql/engine/expr/ob_expr_mul.h"
 #include "sql/engine/expr/ob_expr_result_type_util.h"
 #include "sql/session/ob_sql_session_info.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
 
 using namespace oceanbase::common;
 
@@ -799,6 +800,9 @@ int ObExprMul::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
   if (OB_ISNULL(rt_expr.eval_func_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("unexpected result type", K(ret), K(rt_expr.datum_meta_.type_), K(left), K(right));
+  } else {
+    rt_expr.eval_batch_func_ =
+        ObExprBatchEvalHelper::get_arith_batch_func(ObBatchKernel::ARITH_MUL, rt_expr.datum_meta_.type_, left, right);
   }
   return ret;
 }
@@ -29,6 +29,7 @@
 #include "sql/engine/subquery/ob_subplan_filter_op.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/engine/expr/ob_expr_util.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
 
 namespace oceanbase {
 using namespace common;
@@ -4714,6 +4715,7 @@ int ObRelationalExprOperator::cg_datum_cmp_expr(
       rt_expr.eval_func_ = ObExprCmpFuncsHelper::get_eval_expr_cmp_func(
           input_type1, input_type2, cmp_op, lib::is_oracle_mode(), cs_type);
       CK(NULL != rt_expr.eval_func_);
+      rt_expr.eval_batch_func_ = ObExprBatchEvalHelper::get_relational_batch_func(input_type1, input_type2, cmp_op);
     }
   }
   return ret;
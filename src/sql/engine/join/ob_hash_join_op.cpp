@@ -20,6 +20,9 @@
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "share/diagnosis/ob_sql_monitor_statname.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
+#include "sql/engine/table/ob_table_scan_op.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 using namespace omt;
@@ -31,10 +34,36 @@ ObHashJoinSpec::ObHashJoinSpec(common::ObIAllocator& alloc, const ObPhyOperatorT
       equal_join_conds_(alloc),
       all_join_keys_(alloc),
       all_hash_funcs_(alloc),
-      has_join_bf_(false)
+      has_join_bf_(false),
+      join_filter_scan_id_(OB_INVALID_ID),
+      join_filter_bits_(0)
 {}
 
-OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_);
+OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_,
+    join_filter_scan_id_, join_filter_bits_);
+
+int ObHashJoinSpec::register_to_datahub(ObExecContext& ctx) const
+{
+  int ret = OB_SUCCESS;
+  if (is_join_filter_enabled()) {
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else {
+      void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterWholeMsg::WholeMsgProvider));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        ObJoinFilterWholeMsg::WholeMsgProvider* provider = new (buf) ObJoinFilterWholeMsg::WholeMsgProvider();
+        ObSqcCtx& sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+        if (OB_FAIL(sqc_ctx.add_whole_msg_provider(get_id(), *provider))) {
+          LOG_WARN("fail add whole msg provider", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
 
 int ObHashJoinOp::PartHashJoinTable::init(ObIAllocator& alloc)
 {
@@ -148,6 +177,14 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext& ctx_, const ObOpSpec& spec, ObOpInput*
       cur_right_hist_(nullptr),
       cur_probe_row_idx_(0),
       max_right_bucket_idx_(0),
+      right_brs_datums_(NULL),
+      right_brs_cnt_(0),
+      right_brs_idx_(0),
+      right_brs_end_(false),
+      output_slot_(0),
+      break_output_batch_(false),
+      join_filter_(NULL),
+      join_filter_published_(false),
       probe_cnt_(0),
       bitset_filter_cnt_(0),
       hash_link_cnt_(0),
@@ -337,6 +374,19 @@ int ObHashJoinOp::inner_open()
       LOG_WARN("failed to init right last row", K(ret));
     }
   }
+  if (OB_SUCC(ret) && is_vectorized() && NULL == right_brs_datums_) {
+    const int64_t size = sizeof(ObDatum) * MY_SPEC.max_batch_size_ * right_->get_spec().output_.count();
+    if (size > 0 && OB_ISNULL(right_brs_datums_ = static_cast<ObDatum*>(ctx_.get_allocator().alloc(size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(size));
+    }
+  }
+  right_brs_cnt_ = 0;
+  right_brs_idx_ = 0;
+  right_brs_end_ = false;
+  if (OB_SUCC(ret) && MY_SPEC.is_join_filter_enabled() && OB_FAIL(init_join_filter())) {
+    LOG_WARN("init join filter failed", K(ret));
+  }
   return ret;
 }
 
@@ -454,12 +504,16 @@ int ObHashJoinOp::part_rescan(bool reset_all)
 int ObHashJoinOp::rescan()
 {
   int ret = OB_SUCCESS;
+  uninstall_join_filter();
   if (OB_FAIL(part_rescan(true))) {
     LOG_WARN("part rescan failed", K(ret));
   } else if (OB_FAIL(ObJoinOp::rescan())) {
     LOG_WARN("join rescan failed", K(ret));
   } else {
     iter_end_ = false;
+    right_brs_cnt_ = 0;
+    right_brs_idx_ = 0;
+    right_brs_end_ = false;
   }
   LOG_TRACE("hash join rescan", K(ret));
   return ret;
@@ -473,6 +527,10 @@ int ObHashJoinOp::next()
   ObJoinState& state = state_;
   int func = -1;
   while (OB_SUCC(ret) && !need_return_) {
+    if (OB_UNLIKELY(JS_READ_RIGHT == state && need_break_output_batch())) {
+      break_output_batch_ = true;
+      break;
+    }
     state_operation = this->ObHashJoinOp::state_operation_func_[state];
     if (OB_ISNULL(state_operation)) {
       ret = OB_BAD_NULL_ERROR;
@@ -528,6 +586,12 @@ int ObHashJoinOp::inner_get_next_row()
         break;
       }
       case ObHashJoinOp::HJState::NEXT_BATCH: {
+        if (output_slot_ > 0) {
+          // Output rows of batch reference the memory of current partition pair,
+          // return them before switch to the next partition pair.
+          ret = OB_ITER_END;
+          break;
+        }
         batch_mgr_->remove_undumped_batch();
         if (left_batch_ != NULL) {
           left_batch_->close();
@@ -582,6 +646,10 @@ int ObHashJoinOp::inner_get_next_row()
 
 void ObHashJoinOp::destroy()
 {
+  if (NULL != join_filter_) {
+    join_filter_->~ObRuntimeJoinFilter();
+    join_filter_ = NULL;
+  }
   if (OB_LIKELY(nullptr != alloc_)) {
     alloc_ = nullptr;
   }
@@ -595,6 +663,13 @@ void ObHashJoinOp::destroy()
 int ObHashJoinOp::inner_close()
 {
   int ret = OB_SUCCESS;
+  if (NULL != join_filter_ && !join_filter_published_ && NULL != ctx_.get_sqc_handler()) {
+    // other workers are waiting for the join filter of this worker
+    int tmp_ret = publish_join_filter(true /* is_empty */);
+    if (OB_SUCCESS != tmp_ret) {
+      LOG_WARN("send empty join filter failed", K(tmp_ret));
+    }
+  }
   sql_mem_processor_.unregister_profile();
   reset();
   tmp_hash_funcs_.reset();
@@ -1417,6 +1492,9 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
       if (NULL == left_read_row_) {
         if (OB_FAIL(calc_hash_value(left_join_keys_, left_hash_funcs_, hash_value))) {
           LOG_WARN("get left row hash_value failed", K(ret));
+        } else if (nullptr == left_batch_ && NULL != join_filter_ && !join_filter_published_ &&
+                   OB_FAIL(insert_join_filter())) {
+          LOG_WARN("insert join filter failed", K(ret));
         }
       } else {
         hash_value = left_read_row_->get_hash_value();
@@ -1653,6 +1731,8 @@ bool ObHashJoinOp::can_use_cache_aware_opt()
       K(sql_mem_processor_.get_mem_bound()),
       K(part_count_),
       K(cur_dumped_partition_));
+  // cache aware probing iterate right rows by partition, which is not supported in vectorized execution.
+  enable_cache_aware = enable_cache_aware && !is_vectorized();
   if (!enable_cache_aware) {
     level1_part_count_ = 0;
     level2_part_count_ = 0;
@@ -2428,6 +2508,9 @@ int ObHashJoinOp::recursive_process(bool& need_not_read_right)
     LOG_WARN("fail to init join ctx", K(ret));
   } else if (OB_FAIL(split_partition_and_build_hash_table(num_left_rows))) {
     LOG_WARN("failed to build hash table", K(ret), K(part_level_));
+  } else if (top_part_level() && NULL != join_filter_ && !join_filter_published_ &&
+             OB_FAIL(publish_join_filter(false /* is_empty */))) {
+    LOG_WARN("publish join filter failed", K(ret));
   }
   if (OB_SUCC(ret) && 0 == num_left_rows && RIGHT_ANTI_JOIN != MY_SPEC.join_type_ &&
       RIGHT_OUTER_JOIN != MY_SPEC.join_type_ && FULL_OUTER_JOIN != MY_SPEC.join_type_) {
@@ -2493,7 +2576,13 @@ int ObHashJoinOp::get_next_right_row()
   if (right_batch_ == NULL) {
     has_fill_right_row_ = true;
     clear_evaluated_flag();
-    if (OB_FAIL(OB_I(t1) right_->get_next_row())) {
+    if (is_vectorized()) {
+      if (OB_FAIL(get_next_right_batch_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get right row from child batch failed", K(ret));
+        }
+      }
+    } else if (OB_FAIL(OB_I(t1) right_->get_next_row())) {
       if (OB_ITER_END != ret) {
         LOG_WARN("get right row from child failed", K(ret));
       }
@@ -2525,6 +2614,122 @@ int ObHashJoinOp::get_next_right_row()
   return ret;
 }
 
+int ObHashJoinOp::get_next_right_batch_row()
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray& exprs = right_->get_spec().output_;
+  while (OB_SUCC(ret) && right_brs_idx_ >= right_brs_cnt_) {
+    const ObBatchRows* brs = NULL;
+    if (right_brs_end_) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(right_->get_next_batch(MY_SPEC.max_batch_size_, brs))) {
+      LOG_WARN("get next batch failed", K(ret));
+    } else {
+      right_brs_cnt_ = 0;
+      right_brs_idx_ = 0;
+      right_brs_end_ = brs->end_;
+      for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
+        if (OB_FAIL(exprs.at(i)->eval_batch(eval_ctx_, *brs->skip_, brs->size_))) {
+          LOG_WARN("expr evaluate failed", K(ret));
+        }
+      }
+      for (int64_t row = 0; OB_SUCC(ret) && row < brs->size_; row++) {
+        if (!brs->skip_->at(row)) {
+          ObDatum* datums = right_brs_datums_ + right_brs_cnt_ * exprs.count();
+          for (int64_t i = 0; i < exprs.count(); i++) {
+            const ObExpr* e = exprs.at(i);
+            datums[i] = e->locate_batch_datums(eval_ctx_)[e->is_batch_result() ? row : 0];
+          }
+          right_brs_cnt_++;
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    right_brs_idx_++;
+    if (OB_FAIL(restore_right_batch_row())) {
+      LOG_WARN("restore right row failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::restore_right_batch_row()
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray& exprs = right_->get_spec().output_;
+  if (OB_UNLIKELY(right_brs_idx_ <= 0 || right_brs_idx_ > right_brs_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid right row index", K(ret), K(right_brs_idx_), K(right_brs_cnt_));
+  } else {
+    const ObDatum* datums = right_brs_datums_ + (right_brs_idx_ - 1) * exprs.count();
+    eval_ctx_.set_batch_idx(output_slot_);
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      exprs.at(i)->locate_expr_datum(eval_ctx_) = datums[i];
+      exprs.at(i)->get_eval_info(eval_ctx_).evaluated_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::restore_cur_right_row()
+{
+  int ret = OB_SUCCESS;
+  if (first_get_row_) {
+    // no right row read
+  } else if (NULL == right_batch_) {
+    if (right_brs_idx_ > 0 && right_brs_idx_ <= right_brs_cnt_ && OB_FAIL(restore_right_batch_row())) {
+      LOG_WARN("restore right row failed", K(ret));
+    }
+  } else if (NULL != right_read_row_) {
+    has_fill_right_row_ = false;
+    if (OB_FAIL(only_join_right_row())) {
+      LOG_WARN("failed to fill right row", K(ret));
+    }
+  }
+  return ret;
+}
+
+bool ObHashJoinOp::need_break_output_batch() const
+{
+  return output_slot_ > 0 && NULL == right_batch_ && !first_get_row_ && right_brs_idx_ >= right_brs_cnt_ &&
+         !right_brs_end_;
+}
+
+// Produce rows to the output rows of batch one by one with the row interface, the current right
+// row is restored before producing each row.
+int ObHashJoinOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && brs_.size_ < max_row_cnt) {
+    output_slot_ = brs_.size_;
+    eval_ctx_.set_batch_idx(output_slot_);
+    if (OB_FAIL(restore_cur_right_row())) {
+      LOG_WARN("restore current right row failed", K(ret));
+    } else if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END == ret) {
+        // may be the end of partition pair, not the end of join
+        brs_.end_ = iter_end_;
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("get next row failed", K(ret));
+      }
+      break;
+    } else if (break_output_batch_) {
+      break_output_batch_ = false;
+      break;
+    } else {
+      brs_.size_++;
+      if (HJProcessor::NEST_LOOP == hj_processor_) {
+        // left rows are reloaded chunk by chunk, can not reference by multiple output rows.
+        break;
+      }
+    }
+  }
+  output_slot_ = 0;
+  return ret;
+}
+
 int ObHashJoinOp::insert_batch_row(const int64_t cur_partition_in_memory)
 {
   int ret = OB_SUCCESS;
@@ -3268,7 +3473,19 @@ int ObHashJoinOp::only_join_right_row()
 {
   int ret = OB_SUCCESS;
   if (right_read_row_ != NULL && !has_fill_right_row_) {
-    if (OB_FAIL(convert_exprs(right_read_row_, right_->get_spec().output_, has_fill_right_row_))) {
+    if (is_vectorized()) {
+      // The memory of row read from partition is reused when iterating, can not be referenced
+      // by output rows of batch, deep copy is needed.
+      const ObIArray<ObExpr*>& exprs = right_->get_spec().output_;
+      for (uint32_t i = 0; OB_SUCC(ret) && i < right_read_row_->cnt_; ++i) {
+        if (OB_FAIL(exprs.at(i)->deep_copy_datum(eval_ctx_, right_read_row_->cells()[i]))) {
+          LOG_WARN("deep copy datum failed", K(ret));
+        } else {
+          exprs.at(i)->get_eval_info(eval_ctx_).evaluated_ = true;
+        }
+      }
+      has_fill_right_row_ = OB_SUCC(ret);
+    } else if (OB_FAIL(convert_exprs(right_read_row_, right_->get_spec().output_, has_fill_right_row_))) {
       LOG_WARN("failed to convert right exprs", K(ret));
     }
   }
@@ -3607,5 +3824,101 @@ int ObHashJoinOp::fill_left_end()
   return ret;
 }
 
+int ObHashJoinOp::init_join_filter()
+{
+  int ret = OB_SUCCESS;
+  if (NULL == join_filter_) {
+    void* buf = ctx_.get_allocator().alloc(sizeof(ObRuntimeJoinFilter));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret));
+    } else {
+      join_filter_ = new (buf) ObRuntimeJoinFilter();
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // range filter is used only if the first join key is signed integer on both sides
+    const bool has_range = ObIntTC == left_join_keys_.at(0)->obj_meta_.get_type_class() &&
+                           ObIntTC == right_join_keys_.at(0)->obj_meta_.get_type_class();
+    if (OB_FAIL(join_filter_->init(MY_SPEC.join_filter_bits_, has_range))) {
+      LOG_WARN("init join filter failed", K(ret));
+    } else {
+      join_filter_published_ = false;
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::insert_join_filter()
+{
+  int ret = OB_SUCCESS;
+  uint64_t hash_value = 0;
+  ObDatum* first_key = NULL;
+  if (OB_FAIL(ObRuntimeJoinFilter::calc_hash_value(left_join_keys_, eval_ctx_, hash_value, first_key))) {
+    LOG_WARN("calc join filter hash value failed", K(ret));
+  } else if (OB_FAIL(join_filter_->insert(hash_value, *first_key))) {
+    LOG_WARN("insert join filter failed", K(ret));
+  }
+  return ret;
+}
+
+int ObHashJoinOp::publish_join_filter(const bool is_empty)
+{
+  int ret = OB_SUCCESS;
+  const ObRuntimeJoinFilter* filter = join_filter_;
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  // publish only once, even if the PX worker failed to send the piece message.
+  join_filter_published_ = true;
+  if (NULL != handler) {
+    ObPxSQCProxy& proxy = handler->get_sqc_proxy();
+    ObJoinFilterPieceMsg piece;
+    const ObJoinFilterWholeMsg* whole = NULL;
+    piece.op_id_ = MY_SPEC.id_;
+    piece.thread_id_ = GETTID();
+    piece.dfo_id_ = proxy.get_dfo_id();
+    if (!is_empty && OB_FAIL(piece.filter_.assign(*join_filter_))) {
+      LOG_WARN("assign join filter failed", K(ret));
+    } else if (OB_FAIL(proxy.get_dh_msg(
+                   MY_SPEC.id_, piece, whole, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("fail get join filter msg", K(ret));
+    } else if (OB_ISNULL(whole)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("whole msg is unexpected", K(ret));
+    } else if (whole->is_empty_) {
+      filter = NULL;
+    } else if (OB_FAIL(join_filter_->assign(whole->filter_))) {
+      LOG_WARN("assign join filter failed", K(ret));
+    }
+  } else {
+    join_filter_->finish();
+  }
+  if (OB_SUCC(ret) && !is_empty) {
+    ObOperatorKit* kit = ctx_.get_operator_kit(MY_SPEC.join_filter_scan_id_);
+    if (OB_ISNULL(kit) || OB_ISNULL(kit->op_) || OB_ISNULL(kit->spec_) || PHY_TABLE_SCAN != kit->spec_->type_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("join filter table scan not found", K(ret), K(MY_SPEC.join_filter_scan_id_));
+    } else {
+      static_cast<ObTableScanOp*>(kit->op_)->set_join_filter(filter, &right_join_keys_);
+      LOG_TRACE("publish runtime join filter", K(MY_SPEC.id_), K(MY_SPEC.join_filter_scan_id_), KPC(filter));
+    }
+  }
+  return ret;
+}
+
+void ObHashJoinOp::uninstall_join_filter()
+{
+  if (NULL != join_filter_ && join_filter_published_) {
+    ObOperatorKit* kit = ctx_.get_operator_kit(MY_SPEC.join_filter_scan_id_);
+    if (NULL != kit && NULL != kit->op_) {
+      static_cast<ObTableScanOp*>(kit->op_)->set_join_filter(NULL, NULL);
+    }
+    // the join filter of PX is merged from all workers, can not rebuild after rescan.
+    if (NULL == ctx_.get_sqc_handler()) {
+      join_filter_->reuse();
+      join_filter_published_ = false;
+    }
+  }
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
@@ -24,16 +24,28 @@
 namespace oceanbase {
 namespace sql {
 
+class ObRuntimeJoinFilter;
+
 class ObHashJoinSpec : public ObJoinSpec {
   OB_UNIS_VERSION_V(1);
 
   public:
   ObHashJoinSpec(common::ObIAllocator& alloc, const ObPhyOperatorType type);
 
+  bool is_join_filter_enabled() const
+  {
+    return common::OB_INVALID_ID != join_filter_scan_id_;
+  }
+  virtual int register_to_datahub(ObExecContext& ctx) const override;
+
   ExprFixedArray equal_join_conds_;
   ExprFixedArray all_join_keys_;
   common::ObHashFuncs all_hash_funcs_;
   bool has_join_bf_;
+  // Runtime join filter: built from the left (build side) join keys, pushed to the probe side
+  // table scan with id %join_filter_scan_id_, OB_INVALID_ID if disabled.
+  uint64_t join_filter_scan_id_;
+  int64_t join_filter_bits_;
 };
 
 // hash join has no expression result overwrite problem:
@@ -371,6 +383,7 @@ class ObHashJoinOp : public ObJoinOp {
   virtual int inner_open() override;
   virtual int rescan() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   virtual int inner_close() override;
 
@@ -449,6 +462,14 @@ class ObHashJoinOp : public ObJoinOp {
   int recursive_process(bool& need_not_read_right);
   int adaptive_process(bool& need_not_read_right);
   int get_next_right_row();
+  // get next row of right child's batch in vectorized execution
+  int get_next_right_batch_row();
+  // restore current right row to the output row of batch
+  int restore_right_batch_row();
+  int restore_cur_right_row();
+  // Right child overwrite the output expressions (also our output) when fetching the next
+  // batch, need return the output rows of batch first.
+  bool need_break_output_batch() const;
   int read_right_operate();
   int calc_hash_value(const ObIArray<ObExpr*>& join_keys, const ObIArray<ObHashFunc>& hash_funcs, uint64_t& hash_value);
   int calc_right_hash_value();
@@ -480,6 +501,13 @@ class ObHashJoinOp : public ObJoinOp {
   int get_match_row(bool& is_matched);
   int get_next_right_row_for_batch(NextFunc next_func);
 
+  int init_join_filter();
+  int insert_join_filter();
+  // merge join filter of all PX workers if needed, then install it to the probe side table scan.
+  // Send empty filter if %is_empty, which makes other workers do not wait for this worker.
+  int publish_join_filter(const bool is_empty);
+  void uninstall_join_filter();
+
   private:
   OB_INLINE int64_t get_part_idx(const uint64_t hash_value)
   {
@@ -710,6 +738,19 @@ class ObHashJoinOp : public ObJoinOp {
   int64_t cur_probe_row_idx_;
   int64_t max_right_bucket_idx_;
 
+  // Vectorized execution:
+  // The datums of right child's batch are shallow copied to %right_brs_datums_ after fetched,
+  // and restored to the output row of batch when probing.
+  common::ObDatum* right_brs_datums_;
+  int64_t right_brs_cnt_;
+  int64_t right_brs_idx_;  // next row to iterate of %right_brs_datums_
+  bool right_brs_end_;
+  int64_t output_slot_;  // output row index of batch
+  bool break_output_batch_;
+
+  ObRuntimeJoinFilter* join_filter_;
+  bool join_filter_published_;
+
   // statistics
   int64_t probe_cnt_;
   int64_t bitset_filter_cnt_;
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+#define OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Fixed size bit vector without length, the memory is managed by caller:
+//
+//   void *mem = alloc.alloc(ObBitVector::memory_size(size));
+//   ObBitVector *bv = to_bit_vector(mem);
+//   bv->reset(size);
+//
+// Used as skip bitmap of a batch of rows and evaluated flags of batch result expression.
+struct ObBitVector {
+  typedef uint64_t WordType;
+  static const int64_t WORD_BITS = sizeof(WordType) * 8;
+  static const int64_t WORD_SIZE = sizeof(WordType);
+
+  ObBitVector() = default;
+
+  OB_INLINE static int64_t word_count(const int64_t size)
+  {
+    return (size + WORD_BITS - 1) / WORD_BITS;
+  }
+  OB_INLINE static int64_t memory_size(const int64_t size)
+  {
+    return word_count(size) * WORD_SIZE;
+  }
+
+  OB_INLINE bool at(const int64_t idx) const
+  {
+    return data_[idx / WORD_BITS] & (1LU << (idx % WORD_BITS));
+  }
+  OB_INLINE bool contain(const int64_t idx) const
+  {
+    return at(idx);
+  }
+  OB_INLINE void set(const int64_t idx)
+  {
+    data_[idx / WORD_BITS] |= (1LU << (idx % WORD_BITS));
+  }
+  OB_INLINE void unset(const int64_t idx)
+  {
+    data_[idx / WORD_BITS] &= ~(1LU << (idx % WORD_BITS));
+  }
+
+  OB_INLINE void reset(const int64_t size)
+  {
+    MEMSET(data_, 0, memory_size(size));
+  }
+  OB_INLINE void set_all(const int64_t size)
+  {
+    const int64_t cnt = size / WORD_BITS;
+    for (int64_t i = 0; i < cnt; i++) {
+      data_[i] = ~static_cast<WordType>(0);
+    }
+    for (int64_t i = cnt * WORD_BITS; i < size; i++) {
+      set(i);
+    }
+  }
+
+  // bitwise or of the first %size bits
+  OB_INLINE void bit_or(const ObBitVector& other, const int64_t size)
+  {
+    const int64_t cnt = word_count(size);
+    for (int64_t i = 0; i < cnt; i++) {
+      data_[i] |= other.data_[i];
+    }
+  }
+
+  OB_INLINE bool is_all_true(const int64_t size) const
+  {
+    bool all_true = true;
+    const int64_t cnt = size / WORD_BITS;
+    for (int64_t i = 0; all_true && i < cnt; i++) {
+      all_true = (~static_cast<WordType>(0) == data_[i]);
+    }
+    for (int64_t i = cnt * WORD_BITS; all_true && i < size; i++) {
+      all_true = at(i);
+    }
+    return all_true;
+  }
+
+  // count of the set bits in the first %size bits
+  OB_INLINE int64_t accumulate_bit_cnt(const int64_t size) const
+  {
+    int64_t bit_cnt = 0;
+    const int64_t cnt = size / WORD_BITS;
+    for (int64_t i = 0; i < cnt; i++) {
+      bit_cnt += __builtin_popcountl(data_[i]);
+    }
+    if (size % WORD_BITS > 0) {
+      bit_cnt += __builtin_popcountl(data_[cnt] & ((1LU << (size % WORD_BITS)) - 1));
+    }
+    return bit_cnt;
+  }
+
+  WordType data_[0];
+};
+
+OB_INLINE ObBitVector* to_bit_vector(void* mem)
+{
+  return static_cast<ObBitVector*>(mem);
+}
+
+OB_INLINE const ObBitVector* to_bit_vector(const void* mem)
+{
+  return static_cast<const ObBitVector*>(mem);
+}
+
+// Rows of one batch: row at index i is valid if !skip_->at(i), i in [0, size_).
+struct ObBatchRows {
+  ObBatchRows() : skip_(NULL), size_(0), end_(false)
+  {}
+
+  void reset_skip(const int64_t size)
+  {
+    skip_->reset(size);
+  }
+
+  DECLARE_TO_STRING
+  {
+    int64_t pos = 0;
+    J_OBJ_START();
+    J_KV(K_(size), K_(end), "skip_cnt", NULL == skip_ ? 0 : skip_->accumulate_bit_cnt(size_));
+    J_OBJ_END();
+    return pos;
+  }
+
+  // row skip bitmap
+  ObBitVector* skip_;
+  // batch size
+  int64_t size_;
+  // iterate end
+  bool end_;
+};
+
+}  // end namespace sql
+}  // end namespace oceanbase
+#endif  // OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
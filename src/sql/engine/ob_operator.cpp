@@ -87,14 +87,15 @@ ObOpSpec::ObOpSpec(ObIAllocator& alloc, const ObPhyOperatorType type)
       rows_(0),
       width_(0),
       px_est_size_factor_(),
-      plan_depth_(0)
+      plan_depth_(0),
+      max_batch_size_(0)
 {}
 
 ObOpSpec::~ObOpSpec()
 {}
 
 OB_SERIALIZE_MEMBER(ObOpSpec, id_, output_, startup_filters_, filters_, calc_exprs_, cost_, rows_, width_,
-    px_est_size_factor_, plan_depth_);
+    px_est_size_factor_, plan_depth_, max_batch_size_);
 
 DEF_TO_STRING(ObOpSpec)
 {
@@ -369,7 +370,9 @@ ObOperator::ObOperator(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput*
       opened_(false),
       startup_passed_(spec_.startup_filters_.empty()),
       exch_drained_(false),
-      got_first_row_(false)
+      got_first_row_(false),
+      brs_(),
+      batch_row_idx_(0)
 {}
 
 ObOperator::~ObOperator()
@@ -449,6 +452,8 @@ int ObOperator::open()
       case OPEN_SELF_ONLY: {
         if (OB_FAIL(init_evaluated_flags())) {
           LOG_WARN("init evaluate flags failed", K(ret));
+        } else if (OB_FAIL(init_batch_rows())) {
+          LOG_WARN("init batch rows failed", K(ret));
         } else if (OB_FAIL(inner_open())) {
           if (OB_TRY_LOCK_ROW_CONFLICT != ret && OB_TRANSACTION_SET_VIOLATION != ret) {
             LOG_WARN("Open this operator failed", K(ret), "op_type", op_name());
@@ -488,6 +493,25 @@ int ObOperator::init_evaluated_flags()
   return ret;
 }
 
+int ObOperator::init_batch_rows()
+{
+  int ret = OB_SUCCESS;
+  if (spec_.is_vectorized() && NULL == brs_.skip_) {
+    void* mem = ctx_.get_allocator().alloc(ObBitVector::memory_size(spec_.max_batch_size_));
+    if (OB_ISNULL(mem)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(spec_.max_batch_size_));
+    } else {
+      brs_.skip_ = to_bit_vector(mem);
+      brs_.skip_->reset(spec_.max_batch_size_);
+    }
+  }
+  brs_.size_ = 0;
+  brs_.end_ = false;
+  batch_row_idx_ = 0;
+  return ret;
+}
+
 // copy from ob_phy_operator.cpp
 int ObOperator::rescan()
 {
@@ -499,6 +523,9 @@ int ObOperator::rescan()
   int ret = OB_SUCCESS;
 
   startup_passed_ = spec_.startup_filters_.empty();
+  brs_.size_ = 0;
+  brs_.end_ = false;
+  batch_row_idx_ = 0;
 
   for (int64_t i = 0; OB_SUCC(ret) && i < child_cnt_; ++i) {
     if (OB_FAIL(children_[i]->rescan())) {
@@ -522,6 +549,9 @@ int ObOperator::switch_iterator()
     ret = OB_ITER_END;
   } else {
     startup_passed_ = spec_.startup_filters_.empty();
+    brs_.size_ = 0;
+    brs_.end_ = false;
+    batch_row_idx_ = 0;
 
     // Differ from ObPhyOperator::switch_iterator(), current binding array index is moved from
     // ObExprCtx to ObPhysicalPlanCtx, can not increase in Operator.
@@ -580,6 +610,9 @@ int ObOperator::close()
 int ObOperator::get_next_row()
 {
   int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(spec_.is_vectorized())) {
+    return get_next_row_from_batch();
+  }
   if (OB_UNLIKELY(!startup_passed_)) {
     bool filtered = false;
     if (OB_FAIL(startup_filter(filtered))) {
@@ -632,6 +665,135 @@ int ObOperator::get_next_row()
   return ret;
 }
 
+// Row interface of vectorized operator: fetch batch and move the batch index of evaluate
+// context to the next unskipped row. The batch index is not restored, the consumer access
+// the output expressions' datum of current row with it.
+int ObOperator::get_next_row_from_batch()
+{
+  int ret = OB_SUCCESS;
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    while (batch_row_idx_ < brs_.size_ && brs_.skip_->at(batch_row_idx_)) {
+      batch_row_idx_++;
+    }
+    if (batch_row_idx_ < brs_.size_) {
+      eval_ctx_.set_batch_idx(batch_row_idx_);
+      eval_ctx_.set_batch_size(brs_.size_);
+      batch_row_idx_++;
+      got_row = true;
+    } else if (brs_.end_) {
+      ret = OB_ITER_END;
+    } else {
+      const ObBatchRows* brs = NULL;
+      batch_row_idx_ = 0;
+      if (OB_FAIL(get_next_batch(spec_.max_batch_size_, brs))) {
+        LOG_WARN("get next batch failed", K(ret), "op", op_name());
+      } else {
+        // project output expressions batch by batch
+        FOREACH_CNT_X(e, spec_.output_, OB_SUCC(ret) && brs->size_ > 0)
+        {
+          if (OB_FAIL((*e)->eval_batch(eval_ctx_, *brs->skip_, brs->size_))) {
+            LOG_WARN("expr evaluate failed", K(ret), "expr", *e);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows)
+{
+  int ret = OB_SUCCESS;
+  batch_rows = &brs_;
+  if (OB_UNLIKELY(!spec_.is_vectorized() || NULL == brs_.skip_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("operator is not vectorized", K(ret), "op", op_name(), K(spec_.max_batch_size_));
+  } else if (OB_UNLIKELY(!startup_passed_)) {
+    bool filtered = false;
+    if (OB_FAIL(startup_filter(filtered))) {
+      LOG_WARN("do startup filter failed", K(ret), "op", op_name());
+    } else if (filtered) {
+      brs_.end_ = true;
+    } else {
+      startup_passed_ = true;
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    const int64_t batch_size = std::min(max_row_cnt, spec_.max_batch_size_);
+    brs_.size_ = 0;
+    while (OB_SUCC(ret) && !brs_.end_) {
+      brs_.size_ = 0;
+      brs_.skip_->reset(spec_.max_batch_size_);
+      if (OB_FAIL(inner_get_next_batch(batch_size))) {
+        LOG_WARN("inner get next batch failed", K(ret), "type", spec_.type_, "op", op_name());
+      } else if (brs_.size_ > 0 && !spec_.filters_.empty()) {
+        if (OB_FAIL(filter_batch(spec_.filters_))) {
+          LOG_WARN("filter batch failed", K(ret), "type", spec_.type_, "op", op_name());
+        } else if (brs_.skip_->is_all_true(brs_.size_)) {
+          // all rows filtered, try next batch
+          continue;
+        }
+      }
+      break;
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    const int64_t row_cnt = brs_.size_ - brs_.skip_->accumulate_bit_cnt(brs_.size_);
+    op_monitor_info_.output_row_count_ += row_cnt;
+    if (!got_first_row_ && row_cnt > 0) {
+      op_monitor_info_.first_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+      got_first_row_ = true;
+    }
+    if (brs_.end_) {
+      int tmp_ret = drain_exch();
+      if (OB_SUCCESS != tmp_ret) {
+        LOG_WARN("drain exchange data failed", K(tmp_ret));
+      }
+      if (got_first_row_) {
+        op_monitor_info_.last_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  UNUSED(max_row_cnt);
+  int ret = OB_NOT_IMPLEMENT;
+  LOG_WARN("vectorized execution not supported", K(ret), "type", spec_.type_, "op", op_name());
+  return ret;
+}
+
+int ObOperator::filter_batch(const common::ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  FOREACH_CNT_X(e, exprs, OB_SUCC(ret))
+  {
+    OB_ASSERT(NULL != *e);
+    if (OB_FAIL((*e)->eval_batch(eval_ctx_, *brs_.skip_, brs_.size_))) {
+      LOG_WARN("expr evaluate failed", K(ret), "expr", *e);
+    } else {
+      OB_ASSERT(ob_is_int_tc((*e)->datum_meta_.type_));
+      const ObDatum* datums = (*e)->locate_batch_datums(eval_ctx_);
+      const bool batch_result = (*e)->is_batch_result();
+      for (int64_t i = 0; i < brs_.size_; i++) {
+        if (!brs_.skip_->at(i)) {
+          const ObDatum& datum = batch_result ? datums[i] : datums[0];
+          if (datum.null_ || 0 == *datum.int_) {
+            brs_.skip_->set(i);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObOperator::filter(const common::ObIArray<ObExpr*>& exprs, bool& filtered)
 {
   ObDatum* datum = NULL;
@@ -191,6 +191,10 @@ class ObOpSpec {
   {
     return plan_depth_;
   }
+  bool is_vectorized() const
+  {
+    return max_batch_size_ > 0;
+  }
 
   // find all specs of the DFO (stop when reach receive)
   template <typename T, typename FILTER>
@@ -248,6 +252,8 @@ class ObOpSpec {
   int64_t width_;
   PxOpSizeFactor px_est_size_factor_;
   int64_t plan_depth_;
+  // Max rows of one batch in vectorized execution, zero for row by row execution.
+  int64_t max_batch_size_;
 
   private:
   DISALLOW_COPY_AND_ASSIGN(ObOpSpec);
@@ -308,6 +314,15 @@ class ObOperator {
   virtual int get_next_row();
   virtual int inner_get_next_row() = 0;
 
+  // fetch next batch rows (at most %max_row_cnt rows) for vectorized operator,
+  // %batch_rows->end_ is set if reach end.
+  // Output expressions are not evaluated, consumer evaluate needed expressions by
+  // ObExpr::eval_batch() with %batch_rows->skip_.
+  int get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows);
+  // fill brs_ with at most %max_row_cnt rows, the evaluate context's batch index
+  // and batch size are restored after invoked.
+  virtual int inner_get_next_batch(const int64_t max_row_cnt);
+
   // close operator, cascading close child operators
   virtual int close();
   // close operator, not including child operators.
@@ -389,6 +404,13 @@ class ObOperator {
   {
     return filter(spec_.filters_, filtered);
   }
+  // Execute filter for rows of brs_, set skip flag for filtered rows.
+  int filter_batch(const common::ObIArray<ObExpr*>& exprs);
+
+  bool is_vectorized() const
+  {
+    return spec_.is_vectorized();
+  }
 
   // try open operator
   int try_open()
@@ -426,8 +448,16 @@ class ObOperator {
   bool got_first_row_;
   // gv$sql_plan_monitor
   ObMonitorNode op_monitor_info_;
+  // rows of the current batch in vectorized execution
+  ObBatchRows brs_;
 
   private:
+  int init_batch_rows();
+  // iterate rows of batch for get_next_row() of vectorized operator
+  int get_next_row_from_batch();
+
+  // next row index of brs_ to return in get_next_row_from_batch()
+  int64_t batch_row_idx_;
   DISALLOW_COPY_AND_ASSIGN(ObOperator);
 };
 
@@ -103,7 +103,8 @@ ObPhysicalPlan::ObPhysicalPlan(MemoryContext& mem_context /* = CURRENT_CONTEXT *
       has_link_table_(false),
       mock_rowid_tables_(allocator_),
       need_serial_exec_(false),
-      temp_sql_can_prepare_(false)
+      temp_sql_can_prepare_(false),
+      batch_size_(0)
 {}
 
 ObPhysicalPlan::~ObPhysicalPlan()
@@ -178,6 +179,7 @@ void ObPhysicalPlan::reset()
   has_link_table_ = false;
   mock_rowid_tables_.reset();
   need_serial_exec_ = false;
+  batch_size_ = 0;
 }
 
 void ObPhysicalPlan::destroy()
@@ -742,7 +744,7 @@ OB_SERIALIZE_MEMBER(ObPhysicalPlan,
     param_count_, plan_type_, signature_, stmt_type_, regexp_op_count_, literal_stmt_type_, like_op_count_,
     is_ignore_stmt_, object_id_, stat_.sql_id_, is_contain_inner_table_, is_update_uniq_index_, is_returning_,
     location_type_, use_px_, vars_, px_dop_, has_nested_sql_, stat_.enable_early_lock_release_, mock_rowid_tables_,
-    use_pdml_, is_new_engine_, use_temp_table_);
+    use_pdml_, is_new_engine_, use_temp_table_, batch_size_);
 
 int ObPhysicalPlan::set_table_locations(const ObTablePartitionInfoArray& infos)
 {
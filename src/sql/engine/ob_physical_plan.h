@@ -594,6 +594,18 @@ class ObPhysicalPlan : public ObCacheObject {
   {
     return use_temp_table_;
   }
+  inline void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+  inline int64_t get_batch_size() const
+  {
+    return batch_size_;
+  }
+  inline bool is_vectorized() const
+  {
+    return batch_size_ > 0;
+  }
   inline void set_has_link_table(bool value)
   {
     has_link_table_ = value;
@@ -886,6 +898,8 @@ class ObPhysicalPlan : public ObCacheObject {
   common::ObFixedArray<uint64_t, common::ObIAllocator> mock_rowid_tables_;
   bool need_serial_exec_;  // mark if need serial execute?
   bool temp_sql_can_prepare_;
+  // max rows of one batch (rowset) in vectorized execution, 0 for row by row execution.
+  int64_t batch_size_;
 };
 
 inline void ObPhysicalPlan::set_affected_last_insert_id(bool affected_last_insert_id)
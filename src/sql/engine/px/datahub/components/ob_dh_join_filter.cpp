@@ -0,0 +1,331 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/px/ob_px_util.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+ObRuntimeJoinFilter::ObRuntimeJoinFilter()
+    : bits_(),
+      in_list_(),
+      row_count_(0),
+      bloom_valid_(false),
+      in_list_valid_(false),
+      has_range_(false),
+      min_(INT64_MAX),
+      max_(INT64_MIN)
+{}
+
+int ObRuntimeJoinFilter::init(const int64_t bloom_bits, const bool has_range)
+{
+  int ret = OB_SUCCESS;
+  int64_t bits = MIN_BLOOM_BITS;
+  while (bits < bloom_bits && bits < MAX_BLOOM_BITS) {
+    bits <<= 1;
+  }
+  reset();
+  if (OB_FAIL(bits_.prepare_allocate(bits / WORD_BITS))) {
+    LOG_WARN("prepare allocate bloom filter bits failed", K(ret), K(bits));
+  } else {
+    MEMSET(&bits_.at(0), 0, bits_.count() * sizeof(uint64_t));
+    bloom_valid_ = true;
+    in_list_valid_ = true;
+    has_range_ = has_range;
+  }
+  return ret;
+}
+
+int ObRuntimeJoinFilter::calc_hash_value(
+    const ObIArray<ObExpr*>& keys, ObEvalCtx& eval_ctx, uint64_t& hash_value, ObDatum*& first_key)
+{
+  int ret = OB_SUCCESS;
+  hash_value = 0;
+  first_key = NULL;
+  ObDatum* datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < keys.count(); i++) {
+    ObExpr* expr = keys.at(i);
+    if (OB_FAIL(expr->eval(eval_ctx, datum))) {
+      LOG_WARN("expr evaluate failed", K(ret));
+    } else {
+      hash_value = expr->basic_funcs_->murmur_hash_(*datum, hash_value);
+      if (0 == i) {
+        first_key = datum;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObRuntimeJoinFilter::reuse()
+{
+  if (is_inited()) {
+    MEMSET(&bits_.at(0), 0, bits_.count() * sizeof(uint64_t));
+    bloom_valid_ = true;
+    in_list_valid_ = true;
+  }
+  in_list_.reuse();
+  row_count_ = 0;
+  min_ = INT64_MAX;
+  max_ = INT64_MIN;
+}
+
+void ObRuntimeJoinFilter::reset()
+{
+  bits_.reset();
+  in_list_.reset();
+  row_count_ = 0;
+  bloom_valid_ = false;
+  in_list_valid_ = false;
+  has_range_ = false;
+  min_ = INT64_MAX;
+  max_ = INT64_MIN;
+}
+
+int ObRuntimeJoinFilter::insert(const uint64_t hash_value, const ObDatum& first_key)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("join filter not inited", K(ret));
+  } else {
+    const uint64_t mask = static_cast<uint64_t>(bits_.count() * WORD_BITS - 1);
+    set_bit(hash_value & mask);
+    set_bit((hash_value >> 32) & mask);
+    if (in_list_valid_) {
+      if (in_list_.count() >= MAX_IN_LIST_COUNT) {
+        in_list_valid_ = false;
+        in_list_.reset();
+      } else if (OB_FAIL(in_list_.push_back(hash_value))) {
+        LOG_WARN("array push back failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (has_range_ && !first_key.is_null()) {
+        min_ = std::min(min_, first_key.get_int());
+        max_ = std::max(max_, first_key.get_int());
+      }
+      row_count_ += 1;
+    }
+  }
+  return ret;
+}
+
+int ObRuntimeJoinFilter::merge(const ObRuntimeJoinFilter& other)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited() || !other.is_inited() || bits_.count() != other.bits_.count() ||
+                  has_range_ != other.has_range_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("can not merge join filter", K(ret), K(*this), K(other));
+  } else {
+    for (int64_t i = 0; i < bits_.count(); i++) {
+      bits_.at(i) |= other.bits_.at(i);
+    }
+    bloom_valid_ = bloom_valid_ && other.bloom_valid_;
+    if (!in_list_valid_) {
+    } else if (!other.in_list_valid_ || in_list_.count() + other.in_list_.count() > MAX_IN_LIST_COUNT) {
+      in_list_valid_ = false;
+      in_list_.reset();
+    } else if (OB_FAIL(append(in_list_, other.in_list_))) {
+      LOG_WARN("append array failed", K(ret));
+    }
+    if (OB_SUCC(ret)) {
+      min_ = std::min(min_, other.min_);
+      max_ = std::max(max_, other.max_);
+      row_count_ += other.row_count_;
+    }
+  }
+  return ret;
+}
+
+void ObRuntimeJoinFilter::finish()
+{
+  if (in_list_valid_ && in_list_.count() > 1) {
+    std::sort(in_list_.begin(), in_list_.end());
+    int64_t cnt = 1;
+    for (int64_t i = 1; i < in_list_.count(); i++) {
+      if (in_list_.at(i) != in_list_.at(cnt - 1)) {
+        in_list_.at(cnt++) = in_list_.at(i);
+      }
+    }
+    while (in_list_.count() > cnt) {
+      in_list_.pop_back();
+    }
+  }
+}
+
+int ObRuntimeJoinFilter::assign(const ObRuntimeJoinFilter& other)
+{
+  int ret = OB_SUCCESS;
+  if (this == &other) {
+  } else if (OB_FAIL(bits_.assign(other.bits_))) {
+    LOG_WARN("array assign failed", K(ret));
+  } else if (OB_FAIL(in_list_.assign(other.in_list_))) {
+    LOG_WARN("array assign failed", K(ret));
+  } else {
+    row_count_ = other.row_count_;
+    bloom_valid_ = other.bloom_valid_;
+    in_list_valid_ = other.in_list_valid_;
+    has_range_ = other.has_range_;
+    min_ = other.min_;
+    max_ = other.max_;
+  }
+  return ret;
+}
+
+// bloom filter bits are random, copy them directly instead of variable length encoding.
+OB_DEF_SERIALIZE(ObRuntimeJoinFilter)
+{
+  int ret = OB_SUCCESS;
+  const int64_t word_cnt = bits_.count();
+  OB_UNIS_ENCODE(word_cnt);
+  if (OB_SUCC(ret) && word_cnt > 0) {
+    const int64_t size = word_cnt * sizeof(uint64_t);
+    if (buf_len - pos < size) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("buffer not enough", K(ret), K(buf_len), K(pos), K(size));
+    } else {
+      MEMCPY(buf + pos, &bits_.at(0), size);
+      pos += size;
+    }
+  }
+  LST_DO_CODE(OB_UNIS_ENCODE, in_list_, row_count_, bloom_valid_, in_list_valid_, has_range_, min_, max_);
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObRuntimeJoinFilter)
+{
+  int ret = OB_SUCCESS;
+  int64_t word_cnt = 0;
+  bits_.reset();
+  OB_UNIS_DECODE(word_cnt);
+  if (OB_SUCC(ret) && word_cnt > 0) {
+    const int64_t size = word_cnt * sizeof(uint64_t);
+    if (data_len - pos < size) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("data not enough", K(ret), K(data_len), K(pos), K(size));
+    } else if (OB_FAIL(bits_.prepare_allocate(word_cnt))) {
+      LOG_WARN("prepare allocate failed", K(ret), K(word_cnt));
+    } else {
+      MEMCPY(&bits_.at(0), buf + pos, size);
+      pos += size;
+    }
+  }
+  LST_DO_CODE(OB_UNIS_DECODE, in_list_, row_count_, bloom_valid_, in_list_valid_, has_range_, min_, max_);
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObRuntimeJoinFilter)
+{
+  int64_t len = 0;
+  const int64_t word_cnt = bits_.count();
+  OB_UNIS_ADD_LEN(word_cnt);
+  len += word_cnt * sizeof(uint64_t);
+  LST_DO_CODE(OB_UNIS_ADD_LEN, in_list_, row_count_, bloom_valid_, in_list_valid_, has_range_, min_, max_);
+  return len;
+}
+
+OB_SERIALIZE_MEMBER((ObJoinFilterPieceMsg, ObDatahubPieceMsg), filter_);
+OB_SERIALIZE_MEMBER((ObJoinFilterWholeMsg, ObDatahubWholeMsg), is_empty_, filter_);
+
+int ObJoinFilterWholeMsg::assign(const ObJoinFilterWholeMsg& other)
+{
+  int ret = OB_SUCCESS;
+  op_id_ = other.op_id_;
+  is_empty_ = other.is_empty_;
+  if (OB_FAIL(filter_.assign(other.filter_))) {
+    LOG_WARN("assign join filter failed", K(ret));
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::on_message(
+    ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (ctx.received_ >= ctx.task_cnt_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("should not receive any more pkt. already get all pkt expected", K(pkt), K(ctx));
+  } else if (!pkt.filter_.is_inited()) {
+    // the task finished without building the hash table, rows of this task are unknown,
+    // the merged filter can not filter any row.
+    ctx.whole_msg_.is_empty_ = true;
+    ctx.invalid_ = true;
+  } else if (ctx.invalid_) {
+    /*do nothing*/
+  } else if (ctx.whole_msg_.is_empty_) {
+    if (OB_FAIL(ctx.whole_msg_.filter_.assign(pkt.filter_))) {
+      LOG_WARN("assign join filter failed", K(ret));
+    } else {
+      ctx.whole_msg_.is_empty_ = false;
+    }
+  } else if (OB_FAIL(ctx.whole_msg_.filter_.merge(pkt.filter_))) {
+    LOG_WARN("merge join filter failed", K(ret));
+  }
+  if (OB_SUCC(ret)) {
+    ctx.received_++;
+    LOG_TRACE("got a join filter piece msg", "all_got", ctx.received_, "expected", ctx.task_cnt_);
+  }
+  // all piece received,send whole to all SQC
+  // and SQC will broadcast whole to its tasks
+  if (OB_SUCC(ret) && ctx.received_ == ctx.task_cnt_) {
+    ctx.whole_msg_.op_id_ = ctx.op_id_;
+    if (ctx.invalid_) {
+      ctx.whole_msg_.filter_.reset();
+    } else {
+      ctx.whole_msg_.filter_.finish();
+    }
+    ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret))
+    {
+      dtl::ObDtlChannel* ch = sqcs.at(idx)->get_qc_channel();
+      if (OB_ISNULL(ch)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("null expected", K(ret));
+      } else if (OB_FAIL(ch->send(ctx.whole_msg_, ctx.timeout_ts_))) {
+        LOG_WARN("fail push data to channel", K(ret));
+      } else if (OB_FAIL(ch->flush(true, false))) {
+        LOG_WARN("fail flush dtl data", K(ret));
+      } else {
+        LOG_DEBUG("dispatched join filter whole msg", K(idx), K(cnt), K(ctx.whole_msg_), K(*ch));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(ObPxChannelUtil::sqcs_channles_asyn_wait(sqcs))) {
+      LOG_WARN("failed to wait response", K(ret));
+    }
+    ctx.whole_msg_.reset();
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgCtx::alloc_piece_msg_ctx(
+    const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterPieceMsgCtx));
+  if (OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("physical plan ctx is null", K(ret));
+  } else if (OB_ISNULL(buf)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    msg_ctx =
+        new (buf) ObJoinFilterPieceMsgCtx(pkt.op_id_, task_cnt, ctx.get_physical_plan_ctx()->get_timeout_timestamp());
+  }
+  return ret;
+}
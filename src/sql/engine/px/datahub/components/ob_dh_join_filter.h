@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+#define __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+
+#include "lib/container/ob_array.h"
+#include "lib/container/ob_se_array.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+
+namespace oceanbase {
+namespace sql {
+
+class ObJoinFilterPieceMsg;
+class ObJoinFilterWholeMsg;
+typedef ObPieceMsgP<ObJoinFilterPieceMsg> ObJoinFilterPieceMsgP;
+typedef ObWholeMsgP<ObJoinFilterWholeMsg> ObJoinFilterWholeMsgP;
+class ObJoinFilterPieceMsgListener;
+class ObJoinFilterPieceMsgCtx;
+
+// Runtime filter built from the join keys of hash join build side, checked by the probe side
+// table scan to skip rows which can not find a match. Three filters are kept:
+//   1. bloom filter of the join key hash value;
+//   2. IN list of the join key hash values, exact while the build side is small;
+//   3. min/max range of the first join key, if it is a signed integer on both sides.
+// The join key hash value is always calculated by calc_hash_value() (murmur hash), it is
+// independent of the hash function used by hash join.
+// A row passes if it passes all of the available filters.
+class ObRuntimeJoinFilter {
+  OB_UNIS_VERSION(1);
+
+  public:
+  static const int64_t MIN_BLOOM_BITS = 1L << 13;
+  static const int64_t MAX_BLOOM_BITS = 1L << 27;
+  static const int64_t MAX_IN_LIST_COUNT = 1024;
+
+  public:
+  ObRuntimeJoinFilter();
+  ~ObRuntimeJoinFilter() = default;
+  // %bloom_bits is rounded up to power of 2 and limited in [MIN_BLOOM_BITS, MAX_BLOOM_BITS],
+  // all filters merged together must be initialized with the same bits.
+  int init(const int64_t bloom_bits, const bool has_range);
+  // evaluate join keys of current row and calculate the hash value, %first_key is the
+  // first join key, used for the range filter.
+  static int calc_hash_value(const common::ObIArray<ObExpr*>& keys, ObEvalCtx& eval_ctx, uint64_t& hash_value,
+      common::ObDatum*& first_key);
+  void reuse();
+  void reset();
+  // add one build side row, null first key is ignored by the range filter.
+  int insert(const uint64_t hash_value, const common::ObDatum& first_key);
+  // merge filter of other build side rows into this filter
+  int merge(const ObRuntimeJoinFilter& other);
+  // sort and deduplicate the IN list, must be called before might_contain()
+  void finish();
+  int assign(const ObRuntimeJoinFilter& other);
+  OB_INLINE bool might_contain(const uint64_t hash_value, const common::ObDatum& first_key) const
+  {
+    bool contain = true;
+    if (has_range_ && !first_key.is_null()) {
+      contain = (first_key.get_int() >= min_ && first_key.get_int() <= max_);
+    }
+    if (!contain) {
+    } else if (in_list_valid_) {
+      contain = std::binary_search(in_list_.begin(), in_list_.end(), hash_value);
+    } else if (bloom_valid_) {
+      const uint64_t mask = static_cast<uint64_t>(bits_.count() * WORD_BITS - 1);
+      const uint64_t h1 = hash_value & mask;
+      const uint64_t h2 = (hash_value >> 32) & mask;
+      contain = test_bit(h1) && test_bit(h2);
+    }
+    return contain;
+  }
+  // bloom filter bits are allocated, which means the filter is built and can be merged
+  bool is_inited() const
+  {
+    return bits_.count() > 0;
+  }
+  // filter can not skip any row
+  OB_INLINE bool is_pass_all() const
+  {
+    return !has_range_ && !in_list_valid_ && !bloom_valid_;
+  }
+  int64_t get_row_count() const
+  {
+    return row_count_;
+  }
+  TO_STRING_KV("bloom_bits", bits_.count() * WORD_BITS, K_(row_count), K_(bloom_valid), K_(in_list_valid),
+      "in_list_cnt", in_list_.count(), K_(has_range), K_(min), K_(max));
+
+  private:
+  static const int64_t WORD_BITS = 64;
+  OB_INLINE bool test_bit(const uint64_t pos) const
+  {
+    return bits_.at(pos / WORD_BITS) & (1UL << (pos % WORD_BITS));
+  }
+  OB_INLINE void set_bit(const uint64_t pos)
+  {
+    bits_.at(pos / WORD_BITS) |= (1UL << (pos % WORD_BITS));
+  }
+
+  private:
+  common::ObArray<uint64_t> bits_;
+  common::ObSEArray<uint64_t, 16> in_list_;
+  int64_t row_count_;
+  bool bloom_valid_;
+  // false if the IN list overflows MAX_IN_LIST_COUNT
+  bool in_list_valid_;
+  bool has_range_;
+  int64_t min_;
+  int64_t max_;
+  DISALLOW_COPY_AND_ASSIGN(ObRuntimeJoinFilter);
+};
+
+class ObJoinFilterPieceMsg : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+  public:
+  using PieceMsgListener = ObJoinFilterPieceMsgListener;
+  using PieceMsgCtx = ObJoinFilterPieceMsgCtx;
+
+  public:
+  ObJoinFilterPieceMsg() : filter_()
+  {}
+  ~ObJoinFilterPieceMsg() = default;
+  void reset()
+  {
+    filter_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG>, K_(op_id), K_(filter));
+
+  public:
+  // build side rows of one task, empty if the task finished without building the hash table
+  ObRuntimeJoinFilter filter_;
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsg);
+};
+
+class ObJoinFilterWholeMsg : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_WHOLE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+  public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObJoinFilterWholeMsg>;
+
+  public:
+  ObJoinFilterWholeMsg() : is_empty_(true), filter_()
+  {}
+  ~ObJoinFilterWholeMsg() = default;
+  int assign(const ObJoinFilterWholeMsg& other);
+  void reset()
+  {
+    is_empty_ = true;
+    filter_.reset();
+  }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(is_empty), K_(filter));
+  bool is_empty_;
+  // merged build side rows of all tasks
+  ObRuntimeJoinFilter filter_;
+};
+
+class ObJoinFilterPieceMsgCtx : public ObPieceMsgCtx {
+  public:
+  ObJoinFilterPieceMsgCtx(uint64_t op_id, int64_t task_cnt, int64_t timeout_ts)
+      : ObPieceMsgCtx(op_id, task_cnt, timeout_ts), received_(0), invalid_(false), whole_msg_()
+  {}
+  ~ObJoinFilterPieceMsgCtx() = default;
+  static int alloc_piece_msg_ctx(
+      const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx);
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(received), K_(invalid));
+  int received_;
+  // some task sent an empty filter, the merged filter can not be used
+  bool invalid_;
+  ObJoinFilterWholeMsg whole_msg_;
+
+  private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgCtx);
+};
+
+class ObJoinFilterPieceMsgListener {
+  public:
+  ObJoinFilterPieceMsgListener() = default;
+  ~ObJoinFilterPieceMsgListener() = default;
+  static int on_message(
+      ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt);
+
+  private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgListener);
+};
+
+}  // namespace sql
+}  // namespace oceanbase
+#endif /* __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__ */
+//// end of header file
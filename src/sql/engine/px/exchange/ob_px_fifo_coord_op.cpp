@@ -43,6 +43,7 @@ ObPxFifoCoordOp::ObPxFifoCoordOp(ObExecContext& exec_ctx, const ObOpSpec& spec,
       sqc_init_msg_proc_(exec_ctx, msg_proc_),
       barrier_piece_msg_proc_(exec_ctx, msg_proc_),
       winbuf_piece_msg_proc_(exec_ctx, msg_proc_),
+      join_filter_piece_msg_proc_(exec_ctx, msg_proc_),
       interrupt_proc_(exec_ctx, msg_proc_)
 {}
 
@@ -82,6 +83,7 @@ int ObPxFifoCoordOp::setup_loop_proc()
       .register_processor(sqc_finish_msg_proc_)
       .register_processor(barrier_piece_msg_proc_)
       .register_processor(winbuf_piece_msg_proc_)
+      .register_processor(join_filter_piece_msg_proc_)
       .register_interrupt_processor(interrupt_proc_);
   return ret;
 }
@@ -134,6 +136,7 @@ int ObPxFifoCoordOp::inner_get_next_row()
         case ObDtlMsgType::FINISH_SQC_RESULT:
         case ObDtlMsgType::DH_BARRIER_PIECE_MSG:
         case ObDtlMsgType::DH_WINBUF_PIECE_MSG:
+        case ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG:
           break;
         default:
           ret = OB_ERR_UNEXPECTED;
@@ -64,6 +64,7 @@ ObPxMSCoordOp::ObPxMSCoordOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOp
       sqc_init_msg_proc_(exec_ctx, msg_proc_),
       barrier_piece_msg_proc_(exec_ctx, msg_proc_),
       winbuf_piece_msg_proc_(exec_ctx, msg_proc_),
+      join_filter_piece_msg_proc_(exec_ctx, msg_proc_),
       interrupt_proc_(exec_ctx, msg_proc_),
       store_rows_(),
       last_pop_row_(nullptr),
@@ -116,6 +117,7 @@ int ObPxMSCoordOp::setup_loop_proc()
       .register_processor(sqc_finish_msg_proc_)
       .register_processor(barrier_piece_msg_proc_)
       .register_processor(winbuf_piece_msg_proc_)
+      .register_processor(join_filter_piece_msg_proc_)
       .register_interrupt_processor(interrupt_proc_);
   msg_loop_.set_tenant_id(ctx_.get_my_session()->get_effective_tenant_id());
   return ret;
@@ -244,6 +246,7 @@ int ObPxMSCoordOp::inner_get_next_row()
         case ObDtlMsgType::FINISH_SQC_RESULT:
         case ObDtlMsgType::DH_BARRIER_PIECE_MSG:
         case ObDtlMsgType::DH_WINBUF_PIECE_MSG:
+        case ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG:
           break;
         default:
           ret = OB_ERR_UNEXPECTED;
@@ -25,6 +25,7 @@
 #include "sql/engine/px/ob_dfo_scheduler.h"
 #include "sql/engine/px/datahub/components/ob_dh_barrier.h"
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 namespace sql {
@@ -126,6 +127,7 @@ class ObPxMSCoordOp : public ObPxCoordOp {
   ObPxInitSqcResultP sqc_init_msg_proc_;
   ObBarrierPieceMsgP barrier_piece_msg_proc_;
   ObWinbufPieceMsgP winbuf_piece_msg_proc_;
+  ObJoinFilterPieceMsgP join_filter_piece_msg_proc_;
   ObPxQcInterruptedP interrupt_proc_;
   ObArray<ObChunkDatumStore::LastStoredRow<>*> store_rows_;
   ObChunkDatumStore::LastStoredRow<>* last_pop_row_;
@@ -230,6 +230,7 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput& trans_input)
         ch->set_audit(enable_audit);
         ch->set_interm_result(use_interm_result);
         ch->set_compression_type(dfc_.get_compressor_type());
+        ch->set_columnar_encoding(dfc_.get_columnar_encoding());
       }
       LOG_TRACE("Transmit channel", K(ch), KP(ch->get_id()), K(ch->get_peer()));
     }
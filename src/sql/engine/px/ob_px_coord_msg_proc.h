@@ -23,6 +23,8 @@ class ObBarrierWholeMsg;
 class ObBarrierPieceMsg;
 class ObWinbufWholeMsg;
 class ObWinbufPieceMsg;
+class ObJoinFilterWholeMsg;
+class ObJoinFilterPieceMsg;
 class ObIPxCoordMsgProc {
   public:
   // msg processor callback
@@ -33,6 +35,7 @@ class ObIPxCoordMsgProc {
   virtual int on_interrupted(ObExecContext& ctx, const ObInterruptCode& ic) = 0;
   virtual int on_piece_msg(ObExecContext& ctx, const ObBarrierPieceMsg& pkt) = 0;
   virtual int on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMsg& pkt) = 0;
+  virtual int on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt) = 0;
 };
 
 class ObIPxSubCoordMsgProc {
@@ -41,6 +44,7 @@ class ObIPxSubCoordMsgProc {
   virtual int on_receive_data_ch_msg(const ObPxReceiveDataChannelMsg& pkt) const = 0;
   virtual int on_whole_msg(const ObBarrierWholeMsg& pkt) const = 0;
   virtual int on_whole_msg(const ObWinbufWholeMsg& pkt) const = 0;
+  virtual int on_whole_msg(const ObJoinFilterWholeMsg& pkt) const = 0;
   virtual int on_interrupted(const ObInterruptCode& ic) const = 0;
 };
 
@@ -56,6 +60,7 @@ class ObPxSubCoordMsgProc : public ObIPxSubCoordMsgProc {
   virtual int on_interrupted(const common::ObInterruptCode& pkt) const;
   virtual int on_whole_msg(const ObBarrierWholeMsg& pkt) const;
   virtual int on_whole_msg(const ObWinbufWholeMsg& pkt) const;
+  virtual int on_whole_msg(const ObJoinFilterWholeMsg& pkt) const;
 
   private:
   ObPxRpcInitSqcArgs& sqc_arg_;
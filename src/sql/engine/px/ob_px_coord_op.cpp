@@ -35,6 +35,7 @@
 #include "sql/engine/px/ob_px_basic_info.h"
 #include "sql/engine/px/datahub/components/ob_dh_barrier.h"
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 #include "sql/dtl/ob_dtl_utils.h"
 
 namespace oceanbase {
@@ -628,6 +629,7 @@ int ObPxCoordOp::wait_all_running_dfos_exit()
     ObPxInitSqcResultP sqc_init_msg_proc(ctx_, terminate_msg_proc);
     ObBarrierPieceMsgP barrier_piece_msg_proc(ctx_, terminate_msg_proc);
     ObWinbufPieceMsgP winbuf_piece_msg_proc(ctx_, terminate_msg_proc);
+    ObJoinFilterPieceMsgP join_filter_piece_msg_proc(ctx_, terminate_msg_proc);
     ObPxQcInterruptedP interrupt_proc(ctx_, terminate_msg_proc);
 
     // this register replaces old proc.
@@ -637,7 +639,8 @@ int ObPxCoordOp::wait_all_running_dfos_exit()
         .register_processor(px_row_msg_proc_)
         .register_interrupt_processor(interrupt_proc)
         .register_processor(barrier_piece_msg_proc)
-        .register_processor(winbuf_piece_msg_proc);
+        .register_processor(winbuf_piece_msg_proc)
+        .register_processor(join_filter_piece_msg_proc);
     loop.ignore_interrupt();
 
     ObPxControlChannelProc control_channels;
@@ -675,6 +678,7 @@ int ObPxCoordOp::wait_all_running_dfos_exit()
           case ObDtlMsgType::FINISH_SQC_RESULT:
           case ObDtlMsgType::DH_BARRIER_PIECE_MSG:
           case ObDtlMsgType::DH_WINBUF_PIECE_MSG:
+          case ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG:
             break;
           default:
             ret = OB_ERR_UNEXPECTED;
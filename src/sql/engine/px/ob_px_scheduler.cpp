@@ -34,6 +34,7 @@
 #include "sql/engine/px/ob_px_sqc_async_proxy.h"
 #include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 using namespace common;
@@ -348,6 +349,12 @@ int ObPxMsgProc::on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMsg& pkt)
   return proc.on_piece_msg(coord_info_, ctx, pkt);
 }
 
+int ObPxMsgProc::on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt)
+{
+  ObDhPieceMsgProc<ObJoinFilterPieceMsg> proc;
+  return proc.on_piece_msg(coord_info_, ctx, pkt);
+}
+
 int ObPxMsgProc::on_eof_row(ObExecContext& ctx)
 {
   int ret = OB_SUCCESS;
@@ -567,5 +574,13 @@ int ObPxTerminateMsgProc::on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMs
   return ret;
 }
 
+int ObPxTerminateMsgProc::on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = common::OB_SUCCESS;
+  UNUSED(ctx);
+  UNUSED(pkt);
+  return ret;
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
@@ -88,6 +88,7 @@ class ObPxTerminateMsgProc : public ObIPxCoordMsgProc {
   // begin DATAHUB msg processing
   int on_piece_msg(ObExecContext& ctx, const ObBarrierPieceMsg& pkt);
   int on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMsg& pkt);
+  int on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt);
   // end DATAHUB msg processing
 
   ObPxCoordInfo& coord_info_;
@@ -118,6 +119,7 @@ class ObPxMsgProc : public ObIPxCoordMsgProc {
   // begin DATAHUB msg processing
   int on_piece_msg(ObExecContext& ctx, const ObBarrierPieceMsg& pkt);
   int on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMsg& pkt);
+  int on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt);
   // end DATAHUB msg processing
   private:
   int do_cleanup_dfo(ObDfo& dfo);
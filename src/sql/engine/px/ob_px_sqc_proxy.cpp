@@ -76,6 +76,7 @@ int ObPxSQCProxy::setup_loop_proc(ObSqcCtx& sqc_ctx) const
         .register_processor(sqc_ctx.transmit_data_ch_msg_proc_)
         .register_processor(sqc_ctx.barrier_whole_msg_proc_)
         .register_processor(sqc_ctx.winbuf_whole_msg_proc_)
+        .register_processor(sqc_ctx.join_filter_whole_msg_proc_)
         .register_interrupt_processor(sqc_ctx.interrupt_proc_);
   }
   return ret;
@@ -23,6 +23,7 @@
 #include "sql/engine/px/datahub/ob_dh_msg_provider.h"
 #include "sql/engine/px/datahub/components/ob_dh_barrier.h"
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 namespace oceanbase {
 namespace sql {
 
@@ -35,6 +36,7 @@ class ObSqcCtx {
         transmit_data_ch_msg_proc_(msg_proc_),
         barrier_whole_msg_proc_(msg_proc_),
         winbuf_whole_msg_proc_(msg_proc_),
+        join_filter_whole_msg_proc_(msg_proc_),
         interrupt_proc_(msg_proc_),
         sqc_proxy_(*this, sqc_arg),
         all_tasks_finish_(false),
@@ -112,6 +114,7 @@ class ObSqcCtx {
   ObPxTransmitDataChannelMsgP transmit_data_ch_msg_proc_;
   ObBarrierWholeMsgP barrier_whole_msg_proc_;
   ObWinbufWholeMsgP winbuf_whole_msg_proc_;
+  ObJoinFilterWholeMsgP join_filter_whole_msg_proc_;
   ObPxSqcInterruptedP interrupt_proc_;
   ObPxSQCProxy sqc_proxy_;  // provide message control for each worker
   bool all_tasks_finish_;
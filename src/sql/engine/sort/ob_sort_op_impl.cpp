@@ -161,7 +161,8 @@ ObSortOpImpl::ObSortOpImpl()
       sql_mem_processor_(profile_),
       op_type_(PHY_INVALID),
       op_id_(UINT64_MAX),
-      exec_ctx_(nullptr)
+      exec_ctx_(nullptr),
+      normalized_key_type_(NORMALIZED_KEY_NONE)
 {}
 
 ObSortOpImpl::~ObSortOpImpl()
@@ -219,6 +220,39 @@ int ObSortOpImpl::init(const uint64_t tenant_id, const ObIArray<ObSortFieldColla
   return ret;
 }
 
+int ObSortOpImpl::init_normalized_key(const ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  normalized_key_type_ = NORMALIZED_KEY_NONE;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (sort_collations_->count() <= 0) {
+    // no sort key, do nothing
+  } else if (sort_collations_->at(0).field_idx_ >= exprs.count() ||
+             OB_ISNULL(exprs.at(sort_collations_->at(0).field_idx_))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid sort key expr", K(ret), K(sort_collations_->at(0)), K(exprs.count()));
+  } else {
+    switch (ob_obj_type_class(exprs.at(sort_collations_->at(0).field_idx_)->datum_meta_.type_)) {
+      case ObIntTC:
+      case ObDateTimeTC:
+      case ObTimeTC:
+        normalized_key_type_ = NORMALIZED_KEY_INT;
+        break;
+      case ObUIntTC:
+        normalized_key_type_ = NORMALIZED_KEY_UINT;
+        break;
+      case ObDateTC:
+        normalized_key_type_ = NORMALIZED_KEY_INT32;
+        break;
+      default:
+        break;
+    }
+  }
+  return ret;
+}
+
 void ObSortOpImpl::reuse()
 {
   sorted_ = false;
@@ -262,6 +296,7 @@ void ObSortOpImpl::reset()
   sorted_ = false;
   got_first_row_ = false;
   comp_.reset();
+  normalized_key_type_ = NORMALIZED_KEY_NONE;
   if (NULL != mem_context_) {
     if (NULL != imms_heap_) {
       imms_heap_->~IMMSHeap();
@@ -806,6 +841,102 @@ int ObSortOpImpl::imms_heap_next(const ObChunkDatumStore::StoredRow*& store_row)
   return ret;
 }
 
+int ObSortOpImpl::radix_sort(const int64_t begin, const int64_t end)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = end - begin;
+  const ObSortFieldCollation& collation = sort_collations_->at(0);
+  const bool multi_keys = sort_cmp_funs_->count() > 1;
+  // Null values are compared as the maximum value if NULL_LAST, reversed if descending.
+  const bool null_at_end = (NULL_LAST == collation.null_pos_) == collation.is_ascending_;
+  NormalizedKeyItem* items = NULL;
+  if (OB_UNLIKELY(begin < 0 || end > rows_.count() || cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(begin), K(end), K(rows_.count()));
+  } else if (OB_ISNULL(items = static_cast<NormalizedKeyItem*>(
+                           mem_context_->get_malloc_allocator().alloc(sizeof(NormalizedKeyItem) * cnt * 2)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(cnt));
+  } else {
+    // encode normalized keys, null rows are moved to the front of the range.
+    ObChunkDatumStore::StoredRow** rows = &rows_.at(begin);
+    int64_t key_cnt = 0;
+    int64_t null_cnt = 0;
+    const uint64_t desc_mask = collation.is_ascending_ ? 0 : UINT64_MAX;
+    for (int64_t i = 0; i < cnt; i++) {
+      ObChunkDatumStore::StoredRow* row = rows[i];
+      const ObDatum& datum = row->cells()[collation.field_idx_];
+      if (datum.is_null()) {
+        rows[null_cnt++] = row;
+      } else {
+        uint64_t key = 0;
+        if (NORMALIZED_KEY_INT == normalized_key_type_) {
+          key = static_cast<uint64_t>(datum.get_int()) ^ (1ULL << 63);
+        } else if (NORMALIZED_KEY_UINT == normalized_key_type_) {
+          key = datum.get_uint64();
+        } else {
+          key = static_cast<uint64_t>(static_cast<int64_t>(datum.get_date())) ^ (1ULL << 63);
+        }
+        items[key_cnt].key_ = key ^ desc_mask;
+        items[key_cnt].row_ = row;
+        key_cnt++;
+      }
+    }
+    // LSD radix sort by byte, skip the byte which is the same for all keys.
+    NormalizedKeyItem* src = items;
+    NormalizedKeyItem* dst = items + cnt;
+    int64_t hist[UINT8_MAX + 1];
+    for (int64_t shift = 0; shift < 64; shift += 8) {
+      MEMSET(hist, 0, sizeof(hist));
+      for (int64_t i = 0; i < key_cnt; i++) {
+        hist[(src[i].key_ >> shift) & 0xFF]++;
+      }
+      if (key_cnt > 0 && hist[(src[0].key_ >> shift) & 0xFF] == key_cnt) {
+        continue;
+      }
+      int64_t pos = 0;
+      for (int64_t i = 0; i <= UINT8_MAX; i++) {
+        const int64_t c = hist[i];
+        hist[i] = pos;
+        pos += c;
+      }
+      for (int64_t i = 0; i < key_cnt; i++) {
+        dst[hist[(src[i].key_ >> shift) & 0xFF]++] = src[i];
+      }
+      std::swap(src, dst);
+    }
+    // rearrange rows: [nulls], [sorted non-null rows] or [sorted non-null rows], [nulls]
+    ObChunkDatumStore::StoredRow** nulls = rows;
+    ObChunkDatumStore::StoredRow** keys = rows + null_cnt;
+    if (null_at_end) {
+      nulls = rows + key_cnt;
+      keys = rows;
+      if (null_cnt > 0) {
+        MEMMOVE(nulls, rows, sizeof(*rows) * null_cnt);
+      }
+    }
+    for (int64_t i = 0; i < key_cnt; i++) {
+      keys[i] = src[i].row_;
+    }
+    if (multi_keys) {
+      std::sort(nulls, nulls + null_cnt, CopyableComparer(comp_));
+      // sort rows with the same first sort key by the rest keys
+      for (int64_t i = 0; i < key_cnt && OB_SUCCESS == comp_.ret_;) {
+        int64_t j = i + 1;
+        while (j < key_cnt && src[j].key_ == src[i].key_) {
+          j++;
+        }
+        if (j - i > 1) {
+          std::sort(keys + i, keys + j, CopyableComparer(comp_));
+        }
+        i = j;
+      }
+    }
+    mem_context_->get_malloc_allocator().free(items);
+  }
+  return ret;
+}
+
 int ObSortOpImpl::sort_inmem_data()
 {
   int ret = OB_SUCCESS;
@@ -826,8 +957,14 @@ int ObSortOpImpl::sort_inmem_data()
           }
         }
       }
-      std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
-      if (OB_SUCCESS != comp_.ret_) {
+      if (NORMALIZED_KEY_NONE != normalized_key_type_ && rows_.count() - begin >= RADIX_SORT_THRESHOLD) {
+        if (OB_FAIL(radix_sort(begin, rows_.count()))) {
+          LOG_WARN("radix sort failed", K(ret), K(begin), K(rows_.count()));
+        }
+      } else {
+        std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
+      }
+      if (OB_SUCC(ret) && OB_SUCCESS != comp_.ret_) {
         ret = comp_.ret_;
         LOG_WARN("compare failed", K(ret));
       }
@@ -158,6 +158,10 @@ class ObSortOpImpl {
 
   void unregister_profile();
 
+  // Enable normalized key radix sort for in-memory sort if the first sort key is integer like
+  // (int, uint, datetime, date, time) type. %exprs are the expressions of the stored row.
+  int init_normalized_key(const common::ObIArray<ObExpr*>& exprs);
+
   class Compare {
     public:
     Compare();
@@ -247,6 +251,9 @@ class ObSortOpImpl {
     return rows_.count() > datum_store_.get_row_cnt();
   }
   int sort_inmem_data();
+  // Encode the first sort key of rows in [begin, end) to memcomparable 64 bits normalized key,
+  // LSD radix sort the normalized keys and sort rows with equal normalized key by comparator.
+  int radix_sort(const int64_t begin, const int64_t end);
   int do_dump();
   template <typename Input>
   int build_chunk(const int64_t level, Input& input);
@@ -274,6 +281,19 @@ class ObSortOpImpl {
   DISALLOW_COPY_AND_ASSIGN(ObSortOpImpl);
 
   protected:
+  enum NormalizedKeyType {
+    NORMALIZED_KEY_NONE = 0,
+    NORMALIZED_KEY_INT,
+    NORMALIZED_KEY_UINT,
+    NORMALIZED_KEY_INT32,
+  };
+  struct NormalizedKeyItem {
+    uint64_t key_;
+    ObChunkDatumStore::StoredRow* row_;
+  };
+  // radix sort is used only if rows count reach this threshold, comparator sort is fast enough
+  // for small data.
+  static const int64_t RADIX_SORT_THRESHOLD = 1024;
   typedef common::ObBinaryHeap<ObChunkDatumStore::StoredRow**, Compare, 16> IMMSHeap;
   typedef common::ObBinaryHeap<ObSortOpChunk*, Compare, MAX_MERGE_WAYS> EMSHeap;
   static const int64_t MAX_ROW_CNT = 268435456;  // (2G / 8)
@@ -309,6 +329,7 @@ class ObSortOpImpl {
   ObPhyOperatorType op_type_;
   uint64_t op_id_;
   ObExecContext* exec_ctx_;
+  NormalizedKeyType normalized_key_type_;
 };
 
 class ObPrefixSortImpl : public ObSortOpImpl {
@@ -20,6 +20,7 @@
 #include "storage/ob_table_scan_iterator.h"
 #include "observer/ob_server_struct.h"
 #include "observer/ob_server.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 using namespace common;
@@ -414,7 +415,11 @@ ObTableScanOp::ObTableScanOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOp
           exec_ctx.get_my_session()->get_effective_tenant_id()),
       filter_executor_(nullptr),
       index_back_filter_executor_(nullptr),
-      cur_trace_id_(nullptr)
+      cur_trace_id_(nullptr),
+      join_filter_(nullptr),
+      join_filter_keys_(nullptr),
+      join_filter_check_cnt_(0),
+      join_filter_filtered_cnt_(0)
 {
   scan_param_.partition_guard_ = &partition_guard_;
 }
@@ -690,6 +695,27 @@ int ObTableScanOp::prepare(bool is_rescan)
   return ret;
 }
 
+// Params of white filters evaluated by storage may be question marks or exec params of
+// nested loop join. Group rescan and array binding scan with several param values at once,
+// white filters are left unprepared and storage treats them as always true.
+int ObTableScanOp::prepare_pushdown_filter_params()
+{
+  int ret = OB_SUCCESS;
+  ObPhysicalPlanCtx* plan_ctx = GET_PHY_PLAN_CTX(ctx_);
+  if (0 == MY_SPEC.pd_storage_flag_ || MY_SPEC.batch_scan_flag_) {
+  } else if (OB_ISNULL(plan_ctx)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("plan ctx is null", K(ret));
+  } else if (plan_ctx->get_bind_array_count() > 0) {
+  } else if (OB_NOT_NULL(filter_executor_) && OB_FAIL(filter_executor_->prepare_filter_params())) {
+    LOG_WARN("failed to prepare filter params", K(ret));
+  } else if (OB_NOT_NULL(index_back_filter_executor_) &&
+             OB_FAIL(index_back_filter_executor_->prepare_filter_params())) {
+    LOG_WARN("failed to prepare index back filter params", K(ret));
+  }
+  return ret;
+}
+
 bool ObTableScanOp::partition_list_is_empty(const ObPhyTableLocationIArray& phy_table_locs) const
 {
   bool part_list_is_empty = true;
@@ -798,6 +824,10 @@ int ObTableScanOp::init_converter()
 int ObTableScanOp::inner_open()
 {
   int ret = OB_SUCCESS;
+  // Storage layer caches the output expressions' datum located in scan initialization,
+  // which is the reserved slot (after the last row of batch) in vectorized execution.
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_idx(MY_SPEC.max_batch_size_);
   ObTaskExecutorCtx& task_exec_ctx = ctx_.get_task_exec_ctx();
   MY_INPUT.set_location_idx(0);
   if (OB_FAIL(init_old_expr_ctx())) {
@@ -902,6 +932,16 @@ int ObTableScanOp::inner_close()
       }
     }
   }
+  if (join_filter_check_cnt_ > 0) {
+    LOG_TRACE("runtime join filter statistics",
+        K(MY_SPEC.id_),
+        K(join_filter_check_cnt_),
+        K(join_filter_filtered_cnt_),
+        "enabled",
+        NULL != join_filter_);
+  }
+  join_filter_ = NULL;
+  join_filter_keys_ = NULL;
 
   return ret;
 }
@@ -986,6 +1026,8 @@ int ObTableScanOp::fill_storage_feedback_info()
 int ObTableScanOp::rescan()
 {
   int ret = OB_SUCCESS;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_idx(MY_SPEC.max_batch_size_);
   if (ctx_.is_gi_restart()) {
     // this scan is started by a gi operator, so, scan a new range.
     if (OB_FAIL(get_gi_task_and_restart())) {
@@ -1030,6 +1072,8 @@ int ObTableScanOp::rt_rescan()
     LOG_WARN("failed to reset query range", K(ret));
   } else if (OB_FAIL(add_query_range())) {
     LOG_WARN("failed to add query range", K(ret));
+  } else if (OB_FAIL(prepare_pushdown_filter_params())) {
+    LOG_WARN("failed to prepare pushdown filter params", K(ret));
   } else if (OB_FAIL(rescan_after_adding_query_range())) {
     LOG_WARN("failed to rescan", K(ret));
   } else {
@@ -1297,6 +1341,61 @@ int ObTableScanOp::get_next_row_with_mode()
   return ret;
 }
 
+void ObTableScanOp::set_join_filter(const ObRuntimeJoinFilter* filter, const common::ObIArray<ObExpr*>* keys)
+{
+  if (NULL != filter && (NULL == keys || filter->is_pass_all())) {
+    filter = NULL;
+  }
+  join_filter_ = filter;
+  join_filter_keys_ = keys;
+  join_filter_check_cnt_ = 0;
+  join_filter_filtered_cnt_ = 0;
+  LOG_TRACE("set runtime join filter", K(MY_SPEC.id_), KPC(filter));
+}
+
+// Skip rows which can not pass the runtime join filter. The filter is disabled if it is
+// not selective enough after sampling JOIN_FILTER_SAMPLE_ROWS rows.
+int ObTableScanOp::get_next_row_with_join_filter()
+{
+  int ret = OB_SUCCESS;
+  static const int64_t JOIN_FILTER_SAMPLE_ROWS = 4096;
+  // disable join filter if less than 1/JOIN_FILTER_MIN_FILTER_RATE rows are filtered
+  static const int64_t JOIN_FILTER_MIN_FILTER_RATE = 20;
+  bool filtered = true;
+  uint64_t hash_value = 0;
+  ObDatum* first_key = NULL;
+  while (OB_SUCC(ret) && filtered) {
+    if (OB_FAIL(get_next_row_with_mode())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret));
+      }
+    } else if (NULL == join_filter_) {
+      filtered = false;
+    } else if (OB_FAIL(ObRuntimeJoinFilter::calc_hash_value(*join_filter_keys_, eval_ctx_, hash_value, first_key))) {
+      LOG_WARN("calc join filter hash value failed", K(ret));
+    } else {
+      filtered = !join_filter_->might_contain(hash_value, *first_key);
+      join_filter_check_cnt_ += 1;
+      if (filtered) {
+        join_filter_filtered_cnt_ += 1;
+        clear_evaluated_flag();
+        if (0 == (++iterated_rows_ % CHECK_STATUS_ROWS_INTERVAL) && OB_FAIL(ctx_.check_status())) {
+          LOG_WARN("check physical plan status failed", K(ret));
+        }
+      }
+      if (JOIN_FILTER_SAMPLE_ROWS == join_filter_check_cnt_ &&
+          join_filter_filtered_cnt_ * JOIN_FILTER_MIN_FILTER_RATE < join_filter_check_cnt_) {
+        LOG_TRACE("runtime join filter is not selective, disable it",
+            K(MY_SPEC.id_),
+            K(join_filter_check_cnt_),
+            K(join_filter_filtered_cnt_));
+        join_filter_ = NULL;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObTableScanOp::inner_get_next_row()
 {
   int ret = OB_SUCCESS;
@@ -1311,7 +1410,7 @@ int ObTableScanOp::inner_get_next_row()
     LOG_WARN("table scan result is not init", K(ret));
   } else if (0 == (++iterated_rows_ % CHECK_STATUS_ROWS_INTERVAL) && OB_FAIL(ctx_.check_status())) {
     LOG_WARN("check physical plan status failed", K(ret));
-  } else if (OB_FAIL(get_next_row_with_mode())) {
+  } else if (OB_FAIL(NULL == join_filter_ ? get_next_row_with_mode() : get_next_row_with_join_filter())) {
     if (OB_ITER_END != ret) {
       LOG_WARN("fail to get next row from ObNewRowIterator", K(ret));
     } else {
@@ -1360,6 +1459,52 @@ int ObTableScanOp::inner_get_next_row()
   return ret;
 }
 
+// Fetch rows to the reserved slot of batch one by one (the storage layer project row to it),
+// then copy to the row's slot.
+int ObTableScanOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t reserved_idx = MY_SPEC.max_batch_size_;
+  const ExprFixedArray& exprs = MY_SPEC.storage_output_;
+  int64_t row_cnt = 0;
+  while (OB_SUCC(ret) && row_cnt < max_row_cnt) {
+    eval_ctx_.set_batch_idx(reserved_idx);
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END == ret) {
+        brs_.end_ = true;
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("get next row failed", K(ret));
+      }
+      break;
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
+      ObExpr* e = exprs.at(i);
+      ObDatum* datum = NULL;
+      eval_ctx_.set_batch_idx(reserved_idx);
+      if (OB_FAIL(e->eval(eval_ctx_, datum))) {
+        LOG_WARN("expr evaluate failed", K(ret), KPC(e));
+      } else {
+        eval_ctx_.set_batch_idx(row_cnt);
+        if (OB_FAIL(e->deep_copy_datum(eval_ctx_, *datum))) {
+          LOG_WARN("deep copy datum failed", K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_cnt++;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = row_cnt;
+    // all rows of batch are projected
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      exprs.at(i)->get_eval_info(eval_ctx_).evaluated_ = true;
+    }
+  }
+  return ret;
+}
+
 int ObTableScanOp::calc_expr_int_value(const ObExpr& expr, int64_t& retval, bool& is_null_value)
 {
   int ret = OB_SUCCESS;
@@ -1412,6 +1557,9 @@ inline int ObTableScanOp::do_table_scan(bool is_rescan, bool need_prepare /*=tru
   } else if (OB_FAIL(prepare(is_rescan))) {  // prepare scan input param
     LOG_WARN("fail to prepare scan param", K(ret));
   }
+  if (OB_SUCC(ret) && OB_FAIL(prepare_pushdown_filter_params())) {
+    LOG_WARN("fail to prepare pushdown filter params", K(ret));
+  }
   /* step 1 */
   if (OB_SUCC(ret)) {
     output_row_count_ = 0;
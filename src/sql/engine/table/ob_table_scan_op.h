@@ -36,6 +36,7 @@ class ObPartitionService;
 namespace sql {
 
 class ObTableScanOp;
+class ObRuntimeJoinFilter;
 
 // table scan operator input
 // copy from ObTableScanInput
@@ -248,6 +249,7 @@ class ObTableScanOp : public ObOperator {
   int switch_iterator() override;
   int bnl_switch_iterator();
   int inner_get_next_row() override;
+  int inner_get_next_batch(const int64_t max_row_cnt) override;
   int inner_close() override;
   void destroy() override;
 
@@ -284,8 +286,13 @@ class ObTableScanOp : public ObOperator {
 
   int init_converter();
 
+  // Install runtime join filter built by hash join, rows of which %keys can not find a match
+  // in %filter are skipped. Pass NULL to uninstall.
+  void set_join_filter(const ObRuntimeJoinFilter* filter, const common::ObIArray<ObExpr*>* keys);
+
   protected:
   int init_pushdown_storage_filter();
+  int prepare_pushdown_filter_params();
   int calc_expr_int_value(const ObExpr& expr, int64_t& retval, bool& is_null_value);
   virtual int do_table_scan(bool is_rescan, bool need_prepare = true);
   virtual int prepare_scan_param();
@@ -322,6 +329,7 @@ class ObTableScanOp : public ObOperator {
 
   private:
   int get_next_row_with_mode();
+  int get_next_row_with_join_filter();
 
   protected:
   common::ObNewRowIterator* result_;
@@ -354,6 +362,12 @@ class ObTableScanOp : public ObOperator {
   ObPushdownFilterExecutor* index_back_filter_executor_;
 
   const uint64_t* cur_trace_id_;
+
+  // runtime join filter, see set_join_filter()
+  const ObRuntimeJoinFilter* join_filter_;
+  const common::ObIArray<ObExpr*>* join_filter_keys_;
+  int64_t join_filter_check_cnt_;
+  int64_t join_filter_filtered_cnt_;
 };
 
 }  // end namespace sql
@@ -115,6 +115,137 @@ DEF_TO_STRING(ObWindowFunctionOp::AggrCell)
   return pos;
 }
 
+int ObWindowFunctionOp::SegTree::init(
+    const uint64_t tenant_id, ObDatumCmpFuncType cmp_func, const bool is_max, const int64_t begin_idx)
+{
+  int ret = OB_SUCCESS;
+  reuse();
+  if (OB_ISNULL(cmp_func) || begin_idx < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(cmp_func), K(begin_idx));
+  } else if (OB_FAIL(values_.init(0 /*mem_limit*/, tenant_id, ObCtxIds::WORK_AREA, ObModIds::OB_SQL_WINDOW_ROW_STORE))) {
+    LOG_WARN("init values store failed", K(ret));
+  } else {
+    tenant_id_ = tenant_id;
+    cmp_func_ = cmp_func;
+    is_max_ = is_max;
+    begin_idx_ = begin_idx;
+  }
+  return ret;
+}
+
+// nodes are kept for the next partition, they are allocated by the local allocator of operator
+void ObWindowFunctionOp::SegTree::reuse()
+{
+  reader_.reset();
+  values_.reset();
+  leaf_cnt_ = 0;
+  begin_idx_ = 0;
+}
+
+int ObWindowFunctionOp::SegTree::add_value(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(values_.add_row(exprs, &eval_ctx))) {
+    LOG_WARN("add value failed", K(ret));
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::SegTree::build()
+{
+  int ret = OB_SUCCESS;
+  const ObRADatumStore::StoredRow* sr = NULL;
+  const int64_t leaf_cnt = values_.get_row_cnt();
+  if (OB_UNLIKELY(leaf_cnt <= 0 || leaf_cnt_ > 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid seg tree", K(ret), K(leaf_cnt), K(*this));
+  } else if (2 * leaf_cnt > nodes_cap_) {
+    // grow to twice at least, the nodes of smaller partitions are not released until close
+    const int64_t nodes_cap = MAX(2 * leaf_cnt, 2 * nodes_cap_);
+    int64_t* nodes = static_cast<int64_t*>(allocator_.alloc(nodes_cap * sizeof(int64_t)));
+    if (OB_ISNULL(nodes)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc seg tree nodes failed", K(ret), K(nodes_cap));
+    } else {
+      allocator_.free(nodes_);
+      nodes_ = nodes;
+      nodes_cap_ = nodes_cap;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    leaf_cnt_ = leaf_cnt;
+    // leaves are in [leaf_cnt_, 2 * leaf_cnt_), the parent of node i is i / 2
+    for (int64_t i = 0; OB_SUCC(ret) && i < leaf_cnt_; ++i) {
+      if (OB_FAIL(values_.get_row(i, sr))) {
+        LOG_WARN("get value failed", K(ret), K(i));
+      } else {
+        nodes_[leaf_cnt_ + i] = sr->cells()[0].is_null() ? -1 : i;
+      }
+    }
+    for (int64_t i = leaf_cnt_ - 1; OB_SUCC(ret) && i > 0; --i) {
+      if (OB_FAIL(choose(nodes_[2 * i], nodes_[2 * i + 1], nodes_[i]))) {
+        LOG_WARN("choose failed", K(ret), K(i));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      leaf_cnt_ = 0;
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::SegTree::query(const int64_t head, const int64_t tail, int64_t& row_idx)
+{
+  int ret = OB_SUCCESS;
+  int64_t idx = -1;
+  if (OB_UNLIKELY(leaf_cnt_ <= 0)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("seg tree not built", K(ret));
+  } else if (OB_UNLIKELY(head < begin_idx_ || head > tail || tail >= begin_idx_ + leaf_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid frame", K(ret), K(head), K(tail), K(*this));
+  } else {
+    int64_t left = head - begin_idx_ + leaf_cnt_;
+    int64_t right = tail - begin_idx_ + leaf_cnt_ + 1;
+    for (; OB_SUCC(ret) && left < right; left >>= 1, right >>= 1) {
+      if ((left & 1) && OB_FAIL(choose(idx, nodes_[left++], idx))) {
+        LOG_WARN("choose failed", K(ret), K(left));
+      } else if ((right & 1) && OB_FAIL(choose(idx, nodes_[--right], idx))) {
+        LOG_WARN("choose failed", K(ret), K(right));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    row_idx = idx < 0 ? -1 : begin_idx_ + idx;
+  }
+  return ret;
+}
+
+// the MIN/MAX of two values, -1 is NULL. The smaller offset wins on tie, the same with
+// aggregating in row order, so the result doesn't depend on the tree shape.
+int ObWindowFunctionOp::SegTree::choose(const int64_t left, const int64_t right, int64_t& idx)
+{
+  int ret = OB_SUCCESS;
+  const ObRADatumStore::StoredRow* left_sr = NULL;
+  const ObRADatumStore::StoredRow* right_sr = NULL;
+  if (left < 0 || right < 0) {
+    idx = left < 0 ? right : left;
+  } else if (OB_FAIL(values_.get_row(left, left_sr))) {
+    LOG_WARN("get value failed", K(ret), K(left));
+  } else if (OB_FAIL(reader_.get_row(right, right_sr))) {
+    LOG_WARN("get value failed", K(ret), K(right));
+  } else {
+    const int cmp = cmp_func_(left_sr->cells()[0], right_sr->cells()[0]);
+    if (0 == cmp) {
+      idx = std::min(left, right);
+    } else {
+      idx = (cmp < 0) == is_max_ ? right : left;
+    }
+  }
+  return ret;
+}
+
 int ObWindowFunctionOp::get_param_int_value(
     ObExpr& expr, ObEvalCtx& eval_ctx, bool& is_null, int64_t& value, const bool need_number /* = false*/)
 {
@@ -1015,6 +1146,10 @@ int ObWindowFunctionOp::compute(RowsReader& row_reader, WinFuncCell& wf_cell, co
                 LOG_WARN("invoke failed", K(use_trans), K(ret));
               }
             }
+          } else if (aggr_func->can_use_seg_tree(new_frame)) {
+            if (OB_FAIL(compute_by_seg_tree(*aggr_func, new_frame))) {
+              LOG_WARN("compute by seg tree failed", K(ret), K(new_frame));
+            }
           } else {
             aggr_func->reset_for_restart();
             LOG_DEBUG("restart agg", K(last_valid_frame), K(new_frame), KPC(aggr_func));
@@ -1068,6 +1203,56 @@ int ObWindowFunctionOp::compute(RowsReader& row_reader, WinFuncCell& wf_cell, co
   return ret;
 }
 
+// MIN/MAX of the frame is got from the seg tree, which is built on the first use in partition.
+// Only the row of MIN/MAX value is aggregated, which is also a valid state for the following
+// frames extended incrementally.
+int ObWindowFunctionOp::compute_by_seg_tree(AggrCell& aggr_func, const Frame& frame)
+{
+  int ret = OB_SUCCESS;
+  SegTree& seg_tree = aggr_func.seg_tree_;
+  const ObAggrInfo& aggr_info = aggr_func.wf_info_.aggr_info_;
+  const ObRADatumStore::StoredRow* cur_row = NULL;
+  int64_t row_idx = -1;
+  if (!seg_tree.is_built(aggr_func.part_first_row_idx_)) {
+    const uint64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+    if (OB_FAIL(seg_tree.init(tenant_id,
+            aggr_info.expr_->basic_funcs_->null_first_cmp_,
+            T_FUN_MAX == aggr_func.wf_info_.func_type_,
+            aggr_func.part_first_row_idx_))) {
+      LOG_WARN("init seg tree failed", K(ret));
+    }
+    for (int64_t i = aggr_func.part_first_row_idx_; OB_SUCC(ret) && i <= get_part_end_idx(); ++i) {
+      if (OB_FAIL(rows_store_.get_row(i, cur_row))) {
+        LOG_WARN("get cur row failed", K(ret), K(i));
+      } else if (FALSE_IT(clear_evaluated_flag())) {
+      } else if (OB_FAIL(cur_row->to_expr(get_all_expr(), eval_ctx_))) {
+        LOG_WARN("Failed to to_expr", K(ret));
+      } else if (OB_FAIL(seg_tree.add_value(aggr_info.param_exprs_, eval_ctx_))) {
+        LOG_WARN("add value to seg tree failed", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(seg_tree.build())) {
+      LOG_WARN("build seg tree failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(seg_tree.query(frame.head_, frame.tail_, row_idx))) {
+    LOG_WARN("query seg tree failed", K(ret), K(frame));
+  } else {
+    // any row of the frame gets NULL if all values are NULL
+    aggr_func.reset_for_restart();
+    if (OB_FAIL(rows_store_.get_row(-1 == row_idx ? frame.head_ : row_idx, cur_row))) {
+      LOG_WARN("get cur row failed", K(ret), K(row_idx));
+    } else if (FALSE_IT(clear_evaluated_flag())) {
+    } else if (OB_FAIL(cur_row->to_expr(get_all_expr(), eval_ctx_))) {
+      LOG_WARN("Failed to to_expr", K(ret));
+    } else if (OB_FAIL(aggr_func.trans(*cur_row))) {
+      LOG_WARN("trans failed", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObWindowFunctionOp::inner_get_next_row()
 {
   int ret = OB_SUCCESS;
@@ -1156,6 +1341,9 @@ int ObWindowFunctionOp::inner_get_next_row()
         for (WinFuncCell* wf = first; OB_SUCC(ret) && wf != end; wf = wf->get_next()) {
           // reset func before compute
           wf->reset_for_restart();
+          if (wf->is_aggr()) {
+            static_cast<AggrCell*>(wf)->seg_tree_.reuse();
+          }
           ObDatum result_datum;
           RowsReader row_reader(rows_store_);
           for (int64_t i = wf->part_first_row_idx_; i < rows_store_.count() && OB_SUCC(ret); ++i) {
@@ -240,6 +240,61 @@ class ObWindowFunctionOp : public ObOperator {
     ObRADatumStore::Reader reader_;
   };
 
+  // Segment tree of MIN/MAX over the param values of one partition, for the frames sliding out
+  // rows which can't be computed incrementally. Any frame is answered in O(log n) instead of
+  // aggregating the whole frame again. The values are kept in a ObRADatumStore which dumps
+  // like the rows store, tree nodes are the offsets of the MIN/MAX values and allocated by
+  // the local allocator of operator.
+  class SegTree {
+    public:
+    // smaller frame is aggregated again directly
+    static const int64_t MIN_FRAME_SIZE = 32;
+
+    explicit SegTree(common::ObIAllocator& allocator)
+        : values_(NULL /*allocator*/),
+          reader_(values_),
+          allocator_(allocator),
+          tenant_id_(common::OB_INVALID_ID),
+          cmp_func_(NULL),
+          is_max_(false),
+          begin_idx_(0),
+          leaf_cnt_(0),
+          nodes_cap_(0),
+          nodes_(NULL)
+    {}
+    ~SegTree()
+    {
+      reuse();
+    }
+    int init(const uint64_t tenant_id, common::ObDatumCmpFuncType cmp_func, const bool is_max, const int64_t begin_idx);
+    void reuse();
+    bool is_built(const int64_t begin_idx) const
+    {
+      return leaf_cnt_ > 0 && begin_idx_ == begin_idx;
+    }
+    // add param value of the next row in partition, evaluated from %exprs.
+    int add_value(const common::ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx);
+    int build();
+    // %row_idx is the row of MIN/MAX value in [head, tail], -1 if all values are NULL.
+    int query(const int64_t head, const int64_t tail, int64_t& row_idx);
+    TO_STRING_KV(K_(begin_idx), K_(leaf_cnt), K_(nodes_cap), KP_(nodes));
+
+    private:
+    int choose(const int64_t left, const int64_t right, int64_t& idx);
+
+    private:
+    ObRADatumStore values_;
+    ObRADatumStore::Reader reader_;
+    common::ObIAllocator& allocator_;
+    uint64_t tenant_id_;
+    common::ObDatumCmpFuncType cmp_func_;
+    bool is_max_;
+    int64_t begin_idx_;
+    int64_t leaf_cnt_;
+    int64_t nodes_cap_;
+    int64_t* nodes_;
+  };
+
   class WinFuncCell : public common::ObDLinkBase<WinFuncCell> {
     public:
     WinFuncCell(WinFuncInfo& wf_info, ObWindowFunctionOp& op)
@@ -285,7 +340,8 @@ class ObWindowFunctionOp : public ObOperator {
           finish_prepared_(false),
           aggr_processor_(op_.eval_ctx_, aggr_infos),
           result_(),
-          got_result_(false)
+          got_result_(false),
+          seg_tree_(op.local_allocator_)
     {}
     virtual ~AggrCell()
     {
@@ -313,6 +369,11 @@ class ObWindowFunctionOp : public ObOperator {
     {
       return use_trans ? trans(row) : inv_trans(row);
     }
+    bool can_use_seg_tree(const Frame& frame) const
+    {
+      return (T_FUN_MAX == wf_info_.func_type_ || T_FUN_MIN == wf_info_.func_type_) &&
+             1 == wf_info_.aggr_info_.param_exprs_.count() && frame.tail_ - frame.head_ + 1 >= SegTree::MIN_FRAME_SIZE;
+    }
 
     virtual int final(common::ObDatum& val);
     virtual bool is_aggr() const
@@ -343,6 +404,7 @@ class ObWindowFunctionOp : public ObOperator {
     ObAggregateProcessor aggr_processor_;
     ObDatum result_;
     bool got_result_;
+    SegTree seg_tree_;
   };
 
   class NonAggrCell : public WinFuncCell {
@@ -466,6 +528,7 @@ class ObWindowFunctionOp : public ObOperator {
   int fetch_child_row();
   int input_one_row(WinFuncCell& func_ctx, bool& part_end);
   int compute(RowsReader& row_reader, WinFuncCell& wf_cell, const int64_t row_idx, common::ObDatum& val);
+  int compute_by_seg_tree(AggrCell& aggr_func, const Frame& frame);
   int check_same_partition(
       const ExprFixedArray& other_exprs, bool& is_same_part, const ExprFixedArray* curr_exprs = NULL);
   int check_same_partition(WinFuncCell& cell, bool& same);
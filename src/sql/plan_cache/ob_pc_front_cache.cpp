@@ -0,0 +1,372 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include "sql/plan_cache/ob_pc_front_cache.h"
+#include "common/data_buffer.h"
+#include "sql/plan_cache/ob_pcv_set.h"
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+
+static inline int64_t align_size(const int64_t size)
+{
+  return (size + 7) & ~static_cast<int64_t>(7);
+}
+
+static inline int64_t str_copy_size(const char* str, const int64_t len)
+{
+  return NULL == str ? 0 : align_size(MAX(len, 0) + 1);
+}
+
+static int64_t parse_node_copy_size(const ParseNode* node)
+{
+  int64_t size = 0;
+  if (NULL != node) {
+    size = align_size(sizeof(ParseNode)) + str_copy_size(node->str_value_, node->str_len_) +
+           str_copy_size(node->raw_text_, node->text_len_);
+    if (node->num_child_ > 0 && NULL != node->children_) {
+      size += align_size(node->num_child_ * sizeof(ParseNode*));
+      for (int64_t i = 0; i < node->num_child_; ++i) {
+        size += parse_node_copy_size(node->children_[i]);
+      }
+    }
+  }
+  return size;
+}
+
+static int copy_str(ObIAllocator& allocator, const char* src, const int64_t len, const char*& dst)
+{
+  int ret = OB_SUCCESS;
+  char* buf = NULL;
+  dst = NULL;
+  if (NULL == src) {
+    // do nothing
+  } else if (OB_ISNULL(buf = static_cast<char*>(allocator.alloc(str_copy_size(src, len))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory", K(ret), K(len));
+  } else {
+    if (len > 0) {
+      MEMCPY(buf, src, len);
+    }
+    buf[MAX(len, 0)] = '\0';
+    dst = buf;
+  }
+  return ret;
+}
+
+static int copy_parse_node(ObIAllocator& allocator, const ParseNode* src, ParseNode*& dst)
+{
+  int ret = OB_SUCCESS;
+  dst = NULL;
+  if (NULL == src) {
+    // do nothing
+  } else if (OB_ISNULL(dst = static_cast<ParseNode*>(allocator.alloc(align_size(sizeof(ParseNode)))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc parse node", K(ret));
+  } else {
+    *dst = *src;
+    dst->children_ = NULL;
+    if (OB_FAIL(copy_str(allocator, src->str_value_, src->str_len_, dst->str_value_))) {
+      LOG_WARN("failed to copy str value", K(ret));
+    } else if (OB_FAIL(copy_str(allocator, src->raw_text_, src->text_len_, dst->raw_text_))) {
+      LOG_WARN("failed to copy raw text", K(ret));
+    } else if (src->num_child_ > 0 && NULL != src->children_) {
+      if (OB_ISNULL(dst->children_ = static_cast<ParseNode**>(
+                        allocator.alloc(align_size(src->num_child_ * sizeof(ParseNode*)))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc children", K(ret), K(src->num_child_));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < src->num_child_; ++i) {
+        if (OB_FAIL(copy_parse_node(allocator, src->children_[i], dst->children_[i]))) {
+          LOG_WARN("failed to copy child", K(ret), K(i));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObPCFrontCacheEntry::match(const uint64_t hash, const ObSQLMode sql_mode, const ObCollationType conn_coll,
+    const ObString& raw_sql, const ObPlanCacheKey& pc_key) const
+{
+  return hash == hash_ && sql_mode == sql_mode_ && conn_coll == conn_coll_ && pc_key.key_id_ == pc_key_.key_id_ &&
+         pc_key.db_id_ == pc_key_.db_id_ && pc_key.sessid_ == pc_key_.sessid_ &&
+         pc_key.is_ps_mode_ == pc_key_.is_ps_mode_ && pc_key.namespace_ == pc_key_.namespace_ &&
+         pc_key.sys_vars_str_ == pc_key_.sys_vars_str_ && raw_sql == raw_sql_;
+}
+
+int ObPCFrontCacheEntry::to_fp_result(ObIAllocator& allocator, ObFastParserResult& fp_result) const
+{
+  int ret = OB_SUCCESS;
+  char* ptr = NULL;
+  if (OB_FAIL(ob_write_string(allocator, pc_key_.name_, fp_result.pc_key_.name_))) {
+    LOG_WARN("failed to copy parameterized sql", K(ret));
+  } else if (param_cnt_ > 0) {
+    // same as ObSqlParameterization::fast_parser()
+    if (OB_ISNULL(ptr = static_cast<char*>(allocator.alloc(param_cnt_ * sizeof(ObPCParam))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc pc params", K(ret), K(param_cnt_));
+    } else {
+      fp_result.raw_params_.set_allocator(&allocator);
+      fp_result.raw_params_.set_capacity(param_cnt_);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt_; ++i) {
+      ObPCParam* pc_param = new (ptr) ObPCParam();
+      ptr += sizeof(ObPCParam);
+      if (OB_FAIL(copy_parse_node(allocator, params_[i], pc_param->node_))) {
+        LOG_WARN("failed to copy param node", K(ret), K(i));
+      } else if (OB_FAIL(fp_result.raw_params_.push_back(pc_param))) {
+        LOG_WARN("failed to push back pc param", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+ObPCFrontCache::ObPCFrontCache() : allocator_(NULL)
+{}
+
+ObPCFrontCache::~ObPCFrontCache()
+{
+  destroy();
+}
+
+int ObPCFrontCache::init(ObIAllocator* allocator)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited()) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_ISNULL(allocator)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret));
+  } else {
+    allocator_ = allocator;
+  }
+  return ret;
+}
+
+void ObPCFrontCache::destroy()
+{
+  if (is_inited()) {
+    for (int64_t i = 0; i < SHARD_CNT; ++i) {
+      Shard& shard = shards_[i];
+      shard.lock_.lock();
+      for (int64_t j = 0; j < SLOT_CNT; ++j) {
+        release_entry(shard.entries_[j]);
+        shard.entries_[j] = NULL;
+        shard.candidates_[j] = 0;
+      }
+      shard.lock_.unlock();
+    }
+    allocator_ = NULL;
+  }
+}
+
+uint64_t ObPCFrontCache::calc_hash(const ObSQLMode sql_mode, const ObCollationType conn_coll, const ObString& raw_sql)
+{
+  uint64_t hash = murmurhash(&sql_mode, sizeof(sql_mode), 0);
+  hash = murmurhash(&conn_coll, sizeof(conn_coll), hash);
+  return murmurhash(raw_sql.ptr(), raw_sql.length(), hash);
+}
+
+int ObPCFrontCache::get(ObIAllocator& allocator, const ObSQLMode sql_mode, const ObCollationType conn_coll,
+    const ObString& raw_sql, ObFastParserResult& fp_result, ObPCVSet*& pcv_set)
+{
+  int ret = OB_SUCCESS;
+  ObPCFrontCacheEntry* stale_entry = NULL;
+  pcv_set = NULL;
+  if (is_inited() && is_cacheable(raw_sql)) {
+    const uint64_t hash = calc_hash(sql_mode, conn_coll, raw_sql);
+    const int64_t slot = get_slot(hash);
+    Shard& shard = get_shard();
+    if (shard.lock_.try_lock()) {
+      ObPCFrontCacheEntry* entry = shard.entries_[slot];
+      if (NULL == entry) {
+        // do nothing
+      } else if (entry->pcv_set_->is_removed()) {
+        // being invalidated, release it after unlock
+        stale_entry = entry;
+        shard.entries_[slot] = NULL;
+      } else if (!entry->match(hash, sql_mode, conn_coll, raw_sql, fp_result.pc_key_)) {
+        // do nothing
+      } else if (OB_FAIL(entry->to_fp_result(allocator, fp_result))) {
+        LOG_WARN("failed to copy fast parser result", K(ret));
+      } else {
+        pcv_set = entry->pcv_set_;
+        pcv_set->inc_ref_count(PCV_RD_HANDLE);
+      }
+      shard.lock_.unlock();
+    }
+    if (NULL != pcv_set && OB_FAIL(pcv_set->lock(true /*rdlock*/))) {
+      LOG_DEBUG("failed to get read lock of pcv set", K(ret));
+      pcv_set->dec_ref_count(PCV_RD_HANDLE);
+      pcv_set = NULL;
+    }
+    if (OB_FAIL(ret)) {
+      fp_result.pc_key_.name_.reset();
+      fp_result.raw_params_.reuse();
+    }
+  }
+  release_entry(stale_entry);
+  return ret;
+}
+
+int ObPCFrontCache::prepare(const ObSQLMode sql_mode, const ObCollationType conn_coll, const ObString& raw_sql,
+    const ObFastParserResult& fp_result, ObPCFrontCacheEntry*& entry)
+{
+  int ret = OB_SUCCESS;
+  entry = NULL;
+  if (is_inited() && is_cacheable(raw_sql)) {
+    const uint64_t hash = calc_hash(sql_mode, conn_coll, raw_sql);
+    const int64_t slot = get_slot(hash);
+    Shard& shard = get_shard();
+    bool admit = false;
+    if (shard.lock_.try_lock()) {
+      admit = hash == shard.candidates_[slot];
+      shard.candidates_[slot] = admit ? 0 : hash;
+      shard.lock_.unlock();
+    }
+    if (admit && OB_FAIL(create_entry(hash, sql_mode, conn_coll, raw_sql, fp_result, entry))) {
+      LOG_WARN("failed to create front cache entry", K(ret));
+    }
+  }
+  return ret;
+}
+
+void ObPCFrontCache::put(ObPCFrontCacheEntry* entry, ObPCVSet* pcv_set)
+{
+  if (NULL != entry && NULL != pcv_set) {
+    Shard& shard = get_shard();
+    const int64_t slot = get_slot(entry->hash_);
+    pcv_set->inc_ref_count(PCV_FRONT_CACHE_HANDLE);
+    entry->pcv_set_ = pcv_set;
+    if (shard.lock_.try_lock()) {
+      // checked under the shard lock, see invalidate()
+      if (!pcv_set->is_removed()) {
+        ObPCFrontCacheEntry* old_entry = shard.entries_[slot];
+        shard.entries_[slot] = entry;
+        entry = old_entry;
+      }
+      shard.lock_.unlock();
+    }
+  }
+  release_entry(entry);
+}
+
+void ObPCFrontCache::invalidate(const ObPCVSet* pcv_set)
+{
+  if (is_inited() && NULL != pcv_set) {
+    for (int64_t i = 0; i < SHARD_CNT; ++i) {
+      Shard& shard = shards_[i];
+      ObPCFrontCacheEntry* stale_entries[SLOT_CNT];
+      int64_t stale_cnt = 0;
+      shard.lock_.lock();
+      for (int64_t j = 0; j < SLOT_CNT; ++j) {
+        if (NULL != shard.entries_[j] && pcv_set == shard.entries_[j]->pcv_set_) {
+          stale_entries[stale_cnt++] = shard.entries_[j];
+          shard.entries_[j] = NULL;
+        }
+      }
+      shard.lock_.unlock();
+      for (int64_t j = 0; j < stale_cnt; ++j) {
+        release_entry(stale_entries[j]);
+      }
+    }
+  }
+}
+
+void ObPCFrontCache::revert(ObPCFrontCacheEntry* entry)
+{
+  release_entry(entry);
+}
+
+int ObPCFrontCache::create_entry(const uint64_t hash, const ObSQLMode sql_mode, const ObCollationType conn_coll,
+    const ObString& raw_sql, const ObFastParserResult& fp_result, ObPCFrontCacheEntry*& entry)
+{
+  int ret = OB_SUCCESS;
+  const ObPlanCacheKey& pc_key = fp_result.pc_key_;
+  const int64_t param_cnt = fp_result.raw_params_.count();
+  int64_t size = align_size(sizeof(ObPCFrontCacheEntry)) + align_size(raw_sql.length()) +
+                 align_size(pc_key.name_.length()) + align_size(pc_key.sys_vars_str_.length()) +
+                 align_size(param_cnt * sizeof(ParseNode*));
+  for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+    if (OB_ISNULL(fp_result.raw_params_.at(i))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("pc param is null", K(ret), K(i));
+    } else {
+      size += parse_node_copy_size(fp_result.raw_params_.at(i)->node_);
+    }
+  }
+  char* buf = NULL;
+  entry = NULL;
+  if (OB_FAIL(ret) || size > MAX_ENTRY_SIZE) {
+    // do nothing
+  } else if (OB_ISNULL(buf = static_cast<char*>(allocator_->alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc front cache entry", K(ret), K(size));
+  } else {
+    ObDataBuffer data_buf(buf, size);
+    ObPCFrontCacheEntry* new_entry = new (data_buf.alloc(align_size(sizeof(ObPCFrontCacheEntry))))
+        ObPCFrontCacheEntry();
+    char* sql_buf = static_cast<char*>(data_buf.alloc(align_size(raw_sql.length())));
+    char* name_buf = static_cast<char*>(data_buf.alloc(align_size(pc_key.name_.length())));
+    char* vars_buf = static_cast<char*>(data_buf.alloc(align_size(pc_key.sys_vars_str_.length())));
+    new_entry->hash_ = hash;
+    new_entry->sql_mode_ = sql_mode;
+    new_entry->conn_coll_ = conn_coll;
+    new_entry->pc_key_ = pc_key;
+    new_entry->param_cnt_ = param_cnt;
+    if (NULL != sql_buf) {
+      MEMCPY(sql_buf, raw_sql.ptr(), raw_sql.length());
+    }
+    new_entry->raw_sql_.assign_ptr(sql_buf, raw_sql.length());
+    if (NULL != name_buf) {
+      MEMCPY(name_buf, pc_key.name_.ptr(), pc_key.name_.length());
+    }
+    new_entry->pc_key_.name_.assign_ptr(name_buf, pc_key.name_.length());
+    if (NULL != vars_buf) {
+      MEMCPY(vars_buf, pc_key.sys_vars_str_.ptr(), pc_key.sys_vars_str_.length());
+    }
+    new_entry->pc_key_.sys_vars_str_.assign_ptr(vars_buf, pc_key.sys_vars_str_.length());
+    if (param_cnt > 0) {
+      new_entry->params_ = static_cast<ParseNode**>(data_buf.alloc(align_size(param_cnt * sizeof(ParseNode*))));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+      if (OB_FAIL(copy_parse_node(data_buf, fp_result.raw_params_.at(i)->node_, new_entry->params_[i]))) {
+        LOG_WARN("failed to copy param node", K(ret), K(i));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      allocator_->free(buf);
+    } else {
+      entry = new_entry;
+    }
+  }
+  return ret;
+}
+
+void ObPCFrontCache::release_entry(ObPCFrontCacheEntry* entry)
+{
+  if (NULL != entry) {
+    if (NULL != entry->pcv_set_) {
+      entry->pcv_set_->dec_ref_count(PCV_FRONT_CACHE_HANDLE);
+    }
+    entry->~ObPCFrontCacheEntry();
+    allocator_->free(entry);
+  }
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
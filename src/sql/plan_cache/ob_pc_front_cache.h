@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_PLAN_CACHE_OB_PC_FRONT_CACHE_H_
+#define OCEANBASE_SQL_PLAN_CACHE_OB_PC_FRONT_CACHE_H_
+
+#include "lib/lock/ob_small_spin_lock.h"
+#include "lib/thread_local/ob_tsi_utils.h"
+#include "sql/plan_cache/ob_plan_cache_util.h"
+
+namespace oceanbase {
+namespace sql {
+class ObPCVSet;
+
+// Fast parser result of one raw sql text and the pcv set it hit, the parse nodes
+// and strings are packed in the same memory block with the entry.
+struct ObPCFrontCacheEntry {
+  ObPCFrontCacheEntry()
+      : hash_(0),
+        sql_mode_(0),
+        conn_coll_(common::CS_TYPE_INVALID),
+        raw_sql_(),
+        pc_key_(),
+        param_cnt_(0),
+        params_(NULL),
+        pcv_set_(NULL)
+  {}
+  bool match(const uint64_t hash, const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const common::ObString& raw_sql, const ObPlanCacheKey& pc_key) const;
+  // copy parameterized sql and raw params to %fp_result, allocated by %allocator.
+  int to_fp_result(common::ObIAllocator& allocator, ObFastParserResult& fp_result) const;
+  TO_STRING_KV(K_(hash), K_(sql_mode), K_(conn_coll), K_(pc_key), K_(param_cnt), KP_(pcv_set));
+
+  uint64_t hash_;
+  ObSQLMode sql_mode_;
+  common::ObCollationType conn_coll_;
+  common::ObString raw_sql_;
+  ObPlanCacheKey pc_key_;
+  int64_t param_cnt_;
+  ParseNode** params_;
+  ObPCVSet* pcv_set_;
+};
+
+// Per cpu cache in front of the sql_pcvs_map_ of ObPlanCache, keyed by the hash of raw sql text.
+//
+// A hit skips the fast parser and the global map: the fast parser result (parameterized sql
+// and raw params, the parameter extraction recipe) is copied from the entry and the pcv set
+// is referenced directly. Plan choosing in pcv set is unchanged, so schema version and
+// parameter type checks still apply.
+//
+// Each shard is only accessed by the threads running on the same cpu and protected by a
+// byte lock, which is only tried: a busy shard is treated as a miss. A raw sql text is
+// admitted on its second miss in the same slot, so one-off statements don't pay the copy.
+//
+// Every entry holds a reference of its pcv set. When a pcv set is erased from the map, it is
+// marked removed and invalidate() releases the entries pointing to it, so an evicted pcv set
+// is not pinned by the front cache. Marking before invalidating makes sure a concurrent put()
+// either sees the mark or installs an entry invalidate() will find.
+class ObPCFrontCache {
+  public:
+  static const int64_t SHARD_CNT = 64;
+  static const int64_t SLOT_CNT = 32;
+  static const int64_t MAX_RAW_SQL_LEN = 1024;
+  static const int64_t MAX_ENTRY_SIZE = 4 * 1024;
+
+  ObPCFrontCache();
+  ~ObPCFrontCache();
+  int init(common::ObIAllocator* allocator);
+  void destroy();
+  bool is_inited() const
+  {
+    return NULL != allocator_;
+  }
+  // Release the entries pointing to %pcv_set, which must be marked removed first.
+  void invalidate(const ObPCVSet* pcv_set);
+
+  // On hit, the fast parser result is copied to %fp_result and %pcv_set is returned with
+  // reference (PCV_RD_HANDLE) and read lock held, like ObPlanCache::get_value(). Otherwise
+  // %pcv_set is NULL. pc_key_ of %fp_result must be constructed except name_.
+  int get(common::ObIAllocator& allocator, const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const common::ObString& raw_sql, ObFastParserResult& fp_result, ObPCVSet*& pcv_set);
+  // Called after fast parser on miss, %entry is NULL if raw sql is not admitted.
+  int prepare(const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const common::ObString& raw_sql, const ObFastParserResult& fp_result, ObPCFrontCacheEntry*& entry);
+  // Install the prepared entry pointing to %pcv_set, which is referenced by the caller.
+  // The entry is dropped if %pcv_set has been removed.
+  void put(ObPCFrontCacheEntry* entry, ObPCVSet* pcv_set);
+  // Free the prepared entry not installed.
+  void revert(ObPCFrontCacheEntry* entry);
+
+  static uint64_t calc_hash(const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const common::ObString& raw_sql);
+
+  private:
+  struct Shard {
+    Shard() : lock_()
+    {
+      MEMSET(entries_, 0, sizeof(entries_));
+      MEMSET(candidates_, 0, sizeof(candidates_));
+    }
+    common::ObByteLock lock_;
+    ObPCFrontCacheEntry* entries_[SLOT_CNT];
+    // hash of the last missed raw sql of each slot
+    uint64_t candidates_[SLOT_CNT];
+  } CACHE_ALIGNED;
+
+  static bool is_cacheable(const common::ObString& raw_sql)
+  {
+    return raw_sql.length() > 0 && raw_sql.length() <= MAX_RAW_SQL_LEN;
+  }
+  Shard& get_shard()
+  {
+    return shards_[common::icpu_id() % SHARD_CNT];
+  }
+  static int64_t get_slot(const uint64_t hash)
+  {
+    return (hash >> 32) % SLOT_CNT;
+  }
+  int create_entry(const uint64_t hash, const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const common::ObString& raw_sql, const ObFastParserResult& fp_result, ObPCFrontCacheEntry*& entry);
+  void release_entry(ObPCFrontCacheEntry* entry);
+
+  private:
+  common::ObIAllocator* allocator_;
+  Shard shards_[SHARD_CNT];
+
+  private:
+  DISALLOW_COPY_AND_ASSIGN(ObPCFrontCache);
+};
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_SQL_PLAN_CACHE_OB_PC_FRONT_CACHE_H_
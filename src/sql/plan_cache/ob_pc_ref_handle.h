@@ -111,6 +111,7 @@ enum CacheRefHandleID {
   PCV_GET_PL_KEY_HANDLE,
   PCV_EXPIRE_BY_USED_HANDLE,
   PCV_EXPIRE_BY_MEM_HANDLE,
+  PCV_FRONT_CACHE_HANDLE,
   MAX_HANDLE
 };
 
@@ -65,7 +65,8 @@ class ObPCVSet {
         min_merged_version_(0),
         min_cluster_version_(0),
         plan_num_(0),
-        need_check_gen_tbl_col_(false)
+        need_check_gen_tbl_col_(false),
+        is_removed_(false)
   {}
   virtual ~ObPCVSet()
   {
@@ -130,7 +131,17 @@ class ObPCVSet {
   }
   int update_stmt_stat();
 
-  TO_STRING_KV(K_(is_inited), K_(ref_count), K_(min_merged_version));
+  // erased from sql_pcvs_map_ of plan cache, not cached by front cache any more
+  void set_removed()
+  {
+    ATOMIC_STORE(&is_removed_, true);
+  }
+  bool is_removed() const
+  {
+    return ATOMIC_LOAD(&is_removed_);
+  }
+
+  TO_STRING_KV(K_(is_inited), K_(ref_count), K_(min_merged_version), K_(is_removed));
 
   private:
   static const int64_t MAX_PCV_SET_PLAN_NUM = 200;
@@ -179,6 +190,7 @@ class ObPCVSet {
 
   bool need_check_gen_tbl_col_;
   common::ObFixedArray<PCColStruct, common::ObIAllocator> col_field_arr_;
+  bool is_removed_;
 };
 
 inline int ObPCVSet::lock(bool is_rdlock)
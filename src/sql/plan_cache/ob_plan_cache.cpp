@@ -249,7 +249,8 @@ ObPlanCache::ObPlanCache()
       location_cache_(NULL),
       plan_id_(0),
       ref_count_(0),
-      ref_handle_mgr_()
+      ref_handle_mgr_(),
+      front_cache_()
 {}
 
 ObPlanCache::~ObPlanCache()
@@ -260,6 +261,7 @@ ObPlanCache::~ObPlanCache()
 void ObPlanCache::destroy()
 {
   if (inited_) {
+    front_cache_.destroy();
     if (OB_SUCCESS != (cache_evict_all_plan())) {
       SQL_PC_LOG(WARN, "fail to evict all plan cache cache");
     }
@@ -290,6 +292,8 @@ int ObPlanCache::init(
                    ObModIds::OB_HASH_NODE_PLAN_STAT,
                    tenant_id))) {
       SQL_PC_LOG(WARN, "failed to init Deleted Map", K(ret));
+    } else if (OB_FAIL(front_cache_.init(&inner_allocator_))) {
+      SQL_PC_LOG(WARN, "failed to init front cache", K(ret));
     } else {
       ObMemAttr attr = get_mem_attr();
       attr.tenant_id_ = tenant_id;
@@ -307,14 +311,48 @@ int ObPlanCache::init(
   return ret;
 }
 
+int ObPlanCache::get_front_cache_value(ObIAllocator& allocator, ObPlanCacheCtx& pc_ctx, ObPCVSet*& pcv_set)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo* session = pc_ctx.sql_ctx_.session_info_;
+  ObPhysicalPlanCtx* plan_ctx = pc_ctx.exec_ctx_.get_physical_plan_ctx();
+  pcv_set = NULL;
+  if (OB_ISNULL(session) || OB_ISNULL(plan_ctx)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(ret));
+  } else if (pc_ctx.sql_ctx_.handle_batched_multi_stmt()) {
+    // fast parser result depends on it, not cached
+  } else if (OB_FAIL(construct_plan_cache_key(*session, NS_CRSR, pc_ctx.fp_result_.pc_key_))) {
+    LOG_WARN("failed to construct plan cache key", K(ret));
+  } else if (OB_FAIL(front_cache_.get(allocator,
+                 session->get_sql_mode(),
+                 session->get_local_collation_connection(),
+                 pc_ctx.raw_sql_,
+                 pc_ctx.fp_result_,
+                 pcv_set))) {
+    SQL_PC_LOG(DEBUG, "failed to get from front cache", K(ret));
+  } else if (NULL != pcv_set) {
+    pc_ctx.fp_result_.cache_params_ = &(plan_ctx->get_param_store_for_update());
+  }
+  return ret;
+}
+
 int ObPlanCache::get_cache_obj(ObPlanCacheCtx& pc_ctx, ObCacheObject*& cache_obj)
+{
+  return get_cache_obj(pc_ctx, NULL, NULL, cache_obj);
+}
+
+// @front_pcv_set: got from front cache, referenced and read locked, looked up in sql_pcvs_map_ if NULL
+// @front_entry: prepared front cache entry, installed if plan is got from pcv set
+int ObPlanCache::get_cache_obj(
+    ObPlanCacheCtx& pc_ctx, ObPCVSet* front_pcv_set, ObPCFrontCacheEntry* front_entry, ObCacheObject*& cache_obj)
 {
   int ret = OB_SUCCESS;
-  ObPCVSet* pcv_set = NULL;
+  ObPCVSet* pcv_set = front_pcv_set;
   // get the read lock and increase reference count
   ObPlanCacheRlockAndRef r_ref_lock(PCV_RD_HANDLE);
 
-  if (OB_FAIL(get_value(pc_ctx.fp_result_.pc_key_, pcv_set, r_ref_lock /* read locked */))) {
+  if (NULL == pcv_set && OB_FAIL(get_value(pc_ctx.fp_result_.pc_key_, pcv_set, r_ref_lock /* read locked */))) {
     SQL_PC_LOG(DEBUG, "failed to access plan cache", K(pc_ctx.fp_result_.pc_key_), K(ret));
   } else if (OB_UNLIKELY(NULL == pcv_set)) {
     ret = OB_SQL_PC_NOT_EXIST;
@@ -344,6 +382,9 @@ int ObPlanCache::get_cache_obj(ObPlanCacheCtx& pc_ctx, ObCacheObject*& cache_obj
       } else {
         ret = OB_SQL_PC_NOT_EXIST;
       }
+    } else if (OB_SUCC(ret) && NULL != front_entry) {
+      front_cache_.put(front_entry, pcv_set);
+      front_entry = NULL;
     }
     // release lock whatever
     (void)pcv_set->unlock();
@@ -351,6 +392,7 @@ int ObPlanCache::get_cache_obj(ObPlanCacheCtx& pc_ctx, ObCacheObject*& cache_obj
 
     NG_TRACE(pc_choose_plan);
   }
+  front_cache_.revert(front_entry);
 
   return ret;
 }
@@ -363,6 +405,8 @@ int ObPlanCache::get_plan(
 {
   int ret = OB_SUCCESS;
   ObCacheObject* cache_obj = NULL;
+  ObPCVSet* front_pcv_set = NULL;
+  ObPCFrontCacheEntry* front_entry = NULL;
   ObGlobalReqTimeService::check_req_timeinfo();
 
   pc_ctx.handle_id_ = ref_handle;
@@ -379,13 +423,24 @@ int ObPlanCache::get_plan(
       pc_ctx.fp_result_ = pc_ctx.multi_stmt_fp_results_.at(0);
     }
   } else {
-    if (OB_FAIL(construct_fast_parser_result(allocator, pc_ctx, pc_ctx.raw_sql_, pc_ctx.fp_result_))) {
+    if (OB_FAIL(get_front_cache_value(allocator, pc_ctx, front_pcv_set))) {
+      LOG_WARN("failed to get from front cache", K(ret));
+    } else if (NULL != front_pcv_set) {
+      // fast parser result is copied from front cache
+    } else if (OB_FAIL(construct_fast_parser_result(allocator, pc_ctx, pc_ctx.raw_sql_, pc_ctx.fp_result_))) {
       LOG_WARN("failed to construct fast parser results", K(ret));
+    } else if (!pc_ctx.sql_ctx_.handle_batched_multi_stmt() &&
+               OB_FAIL(front_cache_.prepare(pc_ctx.sql_ctx_.session_info_->get_sql_mode(),
+                   pc_ctx.sql_ctx_.session_info_->get_local_collation_connection(),
+                   pc_ctx.raw_sql_,
+                   pc_ctx.fp_result_,
+                   front_entry))) {
+      LOG_WARN("failed to prepare front cache entry", K(ret));
     } else { /*do nothing*/
     }
   }
   if (OB_SUCC(ret)) {
-    if (OB_FAIL(get_cache_obj(pc_ctx, cache_obj))) {
+    if (OB_FAIL(get_cache_obj(pc_ctx, front_pcv_set, front_entry, cache_obj))) {
       SQL_PC_LOG(DEBUG, "fail to get plan", K(ret));
     } else if (OB_ISNULL(cache_obj) || !cache_obj->is_sql_crsr()) {
       ret = OB_ERR_UNEXPECTED;
@@ -761,6 +816,8 @@ int ObPlanCache::add_cache_obj(ObCacheObject* cache_obj, ObPlanCacheCtx& pc_ctx)
               ret = OB_ERR_UNEXPECTED;
               LOG_WARN("unexpected error", K(ret), K(tmp_ret), K(del_pcvset), K(pcv_set));
             } else {
+              pcv_set->set_removed();
+              front_cache_.invalidate(pcv_set);
               pcv_set->unlock();
               pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in block
               pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in alloc
@@ -1038,6 +1095,9 @@ int ObPlanCache::remove_pcv_set(const ObPlanCacheKey& key)
   hash_err = sql_pcvs_map_.erase_refactored(key, &pcv_set);
   if (OB_SUCCESS == hash_err) {
     if (NULL != pcv_set) {
+      // release the references held by front cache entries of the removed pcv set
+      pcv_set->set_removed();
+      front_cache_.invalidate(pcv_set);
       // remove plan cache reference, even remove_plan_stat() failed
       pcv_set->dec_ref_count(PCV_SET_HANDLE);
     } else {
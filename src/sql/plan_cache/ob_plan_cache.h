@@ -21,6 +21,7 @@
 #include "sql/plan_cache/ob_sql_parameterization.h"
 #include "sql/plan_cache/ob_prepare_stmt_struct.h"
 #include "sql/plan_cache/ob_pc_ref_handle.h"
+#include "sql/plan_cache/ob_pc_front_cache.h"
 
 namespace oceanbase {
 namespace share {
@@ -318,6 +319,9 @@ class ObPlanCache {
   DISALLOW_COPY_AND_ASSIGN(ObPlanCache);
   int add_cache_obj(ObCacheObject* plan, ObPlanCacheCtx& pc_ctx);
   int get_cache_obj(ObPlanCacheCtx& pc_ctx, ObCacheObject*& cache_obj);
+  int get_cache_obj(ObPlanCacheCtx& pc_ctx, ObPCVSet* front_pcv_set, ObPCFrontCacheEntry* front_entry,
+      ObCacheObject*& cache_obj);
+  int get_front_cache_value(common::ObIAllocator& allocator, ObPlanCacheCtx& pc_ctx, ObPCVSet*& pcv_set);
   int get_value(const ObPlanCacheKey key, ObPCVSet*& pcv_set, ObPlanCacheAtomicOp& op);
   int add_cache_obj_stat(ObPlanCacheCtx& pc_ctx, ObCacheObject* plan);
   bool calc_evict_num(int64_t& plan_cache_evict_num);
@@ -366,6 +370,8 @@ class ObPlanCache {
   // ObSqlParameterization sql_parameterization_;
   // ref handle infos
   ObCacheRefHandleMgr ref_handle_mgr_;
+  // raw sql --> fast parser result and pcv_set, per cpu
+  ObPCFrontCache front_cache_;
 };
 
 }  // end namespace sql
@@ -574,7 +574,8 @@ int ObSuperBlockV2::fill_super_block_size()
 //======================ObSSTableMicroBlockHeader===============================
 bool ObMicroBlockHeader::is_valid() const
 {
-  return header_size_ > 0 && version_ >= MICRO_BLOCK_HEADER_VERSION && MICRO_BLOCK_HEADER_MAGIC == magic_ &&
+  return header_size_ > 0 && version_ >= MICRO_BLOCK_HEADER_VERSION &&
+         (MICRO_BLOCK_HEADER_MAGIC == magic_ || ENCODING_MICRO_BLOCK_HEADER_MAGIC == magic_) &&
          attr_ >= 0 && column_count_ > 0 && row_index_offset_ > 0 && row_count_ > 0;
 }
 
@@ -59,6 +59,7 @@ const int64_t RAID_STRIP_HEADER_MAGIC = 1016;
 const int64_t PG_ROOT_MAGIC = 1017;
 const int64_t SERVER_SUPER_BLOCK_MAGIC = 1018;
 const int64_t LINKED_MACRO_BLOCK_HEADER_MAGIC = 1019;
+const int64_t ENCODING_MICRO_BLOCK_HEADER_MAGIC = 1020;
 
 const int64_t MACRO_BLOCK_WITH_ENCODING_VERSION = 2;
 const int64_t SSTABLE_MACRO_BLOCK_HEADER_VERSION_v1 = 1;
@@ -66,6 +67,7 @@ const int64_t SSTABLE_MACRO_BLOCK_HEADER_VERSION_v2 = 2;
 const int64_t SSTABLE_MACRO_BLOCK_HEADER_VERSION_v3 = 3;  // add column order info to header
 const int64_t MICRO_BLOCK_HEADER_VERSION = 1;
 const int64_t MICRO_BLOCK_HEADERV2_VERSION = 1;
+const int64_t ENCODING_MICRO_BLOCK_HEADER_VERSION = 1;
 const int64_t LINKED_MACRO_BLOCK_HEADER_VERSION = 1;
 const int64_t LOB_MACRO_BLOCK_HEADER_VERSION_V1 = 1;
 const int64_t LOB_MACRO_BLOCK_HEADER_VERSION_V2 = 2;  // add column order info to header
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_COLUMN_ENCODING_STRUCT_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_COLUMN_ENCODING_STRUCT_H_
+
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+#include "common/object/ob_object.h"
+#include "ob_block_sstable_struct.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+// Encoded micro block layout (ENCODING_ROW_STORE):
+//
+//  |- ObMicroBlockHeader (magic ENCODING_MICRO_BLOCK_HEADER_MAGIC)
+//  |- ObColumnEncodingHeader[column_count]
+//  |- ObRowHeader[row_count], or one ObRowHeader if all rows share it (ENCODING_ATTR_SAME_ROW_HEADER)
+//  |- column payloads, addressed by ObColumnEncodingHeader::offset_
+//
+// Cell values are kept in "value tables": uint32_t offsets[count + 1] followed by the
+// ObObj serialized bytes, so any type the flat row store accepts can be encoded.
+enum ObColumnEncodingType {
+  OB_COLUMN_ENCODING_RAW = 0,        // value table with one value per row
+  OB_COLUMN_ENCODING_CONST = 1,      // value table with a single value
+  OB_COLUMN_ENCODING_DICT = 2,       // value table of distinct values + packed per-row refs
+  OB_COLUMN_ENCODING_RLE = 3,        // run start rows + value table with one value per run
+  OB_COLUMN_ENCODING_INT_DELTA = 4,  // meta + base + packed per-row (value - base)
+  OB_COLUMN_ENCODING_PREFIX = 5,     // meta + common prefix + per-row suffixes
+  OB_COLUMN_ENCODING_MAX
+};
+
+OB_INLINE const char* get_column_encoding_name(const int64_t type)
+{
+  static const char* names[OB_COLUMN_ENCODING_MAX] = {"RAW", "CONST", "DICT", "RLE", "INT_DELTA", "PREFIX"};
+  return (type >= 0 && type < OB_COLUMN_ENCODING_MAX) ? names[type] : "INVALID";
+}
+
+static const int32_t ENCODING_ATTR_SAME_ROW_HEADER = 0x1;
+
+struct ObColumnEncodingHeader {
+  uint8_t type_;
+  uint8_t packed_bytes_;  // byte width of dict refs or int deltas
+  uint16_t reserved_;
+  uint32_t count_;   // value count of the value table
+  uint32_t offset_;  // payload offset from the beginning of the micro block
+  uint32_t length_;  // payload length
+
+  ObColumnEncodingHeader()
+  {
+    MEMSET(this, 0, sizeof(*this));
+  }
+  OB_INLINE bool is_valid() const
+  {
+    return type_ < OB_COLUMN_ENCODING_MAX && offset_ > 0 && length_ > 0;
+  }
+  TO_STRING_KV(K_(type), K_(packed_bytes), K_(count), K_(offset), K_(length));
+} __attribute__((packed));
+
+// helpers for packed unsigned integers of 1/2/4/8 bytes
+OB_INLINE int64_t get_packed_bytes(const uint64_t max_value)
+{
+  int64_t bytes = 8;
+  if (max_value <= UINT8_MAX) {
+    bytes = 1;
+  } else if (max_value <= UINT16_MAX) {
+    bytes = 2;
+  } else if (max_value <= UINT32_MAX) {
+    bytes = 4;
+  }
+  return bytes;
+}
+
+OB_INLINE uint64_t read_packed(const char* buf, const int64_t idx, const int64_t bytes)
+{
+  uint64_t value = 0;
+  switch (bytes) {
+    case 1:
+      value = reinterpret_cast<const uint8_t*>(buf)[idx];
+      break;
+    case 2:
+      value = reinterpret_cast<const uint16_t*>(buf)[idx];
+      break;
+    case 4:
+      value = reinterpret_cast<const uint32_t*>(buf)[idx];
+      break;
+    default:
+      value = reinterpret_cast<const uint64_t*>(buf)[idx];
+      break;
+  }
+  return value;
+}
+
+OB_INLINE void write_packed(char* buf, const int64_t idx, const int64_t bytes, const uint64_t value)
+{
+  switch (bytes) {
+    case 1:
+      reinterpret_cast<uint8_t*>(buf)[idx] = static_cast<uint8_t>(value);
+      break;
+    case 2:
+      reinterpret_cast<uint16_t*>(buf)[idx] = static_cast<uint16_t>(value);
+      break;
+    case 4:
+      reinterpret_cast<uint32_t*>(buf)[idx] = static_cast<uint32_t>(value);
+      break;
+    default:
+      reinterpret_cast<uint64_t*>(buf)[idx] = value;
+      break;
+  }
+}
+
+// Integer-like type classes that can be stored as (value - base) deltas.
+OB_INLINE bool is_int_delta_type_class(const common::ObObjTypeClass tc)
+{
+  return common::ObIntTC == tc || common::ObUIntTC == tc || common::ObDateTimeTC == tc || common::ObDateTC == tc ||
+         common::ObTimeTC == tc;
+}
+
+OB_INLINE int64_t get_int_delta_value(const common::ObObj& obj)
+{
+  int64_t value = 0;
+  switch (obj.get_type_class()) {
+    case common::ObIntTC:
+      value = obj.get_int();
+      break;
+    case common::ObUIntTC:
+      value = static_cast<int64_t>(obj.get_uint64());
+      break;
+    case common::ObDateTimeTC:
+      value = obj.get_datetime();
+      break;
+    case common::ObDateTC:
+      value = obj.get_date();
+      break;
+    case common::ObTimeTC:
+      value = obj.get_time();
+      break;
+    default:
+      break;
+  }
+  return value;
+}
+
+OB_INLINE void set_int_delta_value(const common::ObObjMeta& meta, const int64_t value, common::ObObj& obj)
+{
+  switch (meta.get_type_class()) {
+    case common::ObIntTC:
+      obj.set_int(meta.get_type(), value);
+      break;
+    case common::ObUIntTC:
+      obj.set_uint(meta.get_type(), static_cast<uint64_t>(value));
+      break;
+    case common::ObDateTimeTC:
+      obj.set_datetime(meta.get_type(), value);
+      break;
+    case common::ObDateTC:
+      obj.set_date(static_cast<int32_t>(value));
+      break;
+    case common::ObTimeTC:
+      obj.set_time(value);
+      break;
+    default:
+      break;
+  }
+  obj.set_meta_type(meta);
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_COLUMN_ENCODING_STRUCT_H_
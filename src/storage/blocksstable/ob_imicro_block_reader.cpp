@@ -19,6 +19,8 @@
 #include "ob_row_reader.h"
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
+#include "lib/container/ob_bitmap.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 
 namespace oceanbase {
 using namespace common;
@@ -33,6 +35,38 @@ void ObIMicroBlockReader::reset()
   column_map_ = nullptr;
 }
 
+int ObIMicroBlockReader::filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+    const int64_t begin_idx, const int64_t end_idx, ObBitmap& result)
+{
+  int ret = OB_SUCCESS;
+  ObObj cell;
+  bool filtered = false;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(column_map_) || OB_UNLIKELY(col_idx < 0 || col_idx >= column_map_->get_request_count() ||
+                                                   begin_idx < begin() || end_idx > end() || begin_idx > end_idx ||
+                                                   result.size() < end_idx - begin_idx)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP_(column_map), K(col_idx), K(begin_idx), K(end_idx), K(result.size()));
+  }
+  for (int64_t row_idx = begin_idx; OB_SUCC(ret) && row_idx < end_idx; ++row_idx) {
+    if (OB_FAIL(get_cell(row_idx, col_idx, cell))) {
+      if (OB_NOT_SUPPORTED != ret) {
+        LOG_WARN("fail to get cell", K(ret), K(row_idx), K(col_idx));
+      }
+    } else if (cell.is_nop_value()) {
+      // filled with default value later, leave it to sql
+      ret = result.set(row_idx - begin_idx);
+    } else if (OB_FAIL(filter.filter(cell, filtered))) {
+      LOG_WARN("fail to filter cell", K(ret), K(row_idx), K(cell));
+    } else if (!filtered && OB_FAIL(result.set(row_idx - begin_idx))) {
+      LOG_WARN("fail to set filter result", K(ret), K(row_idx));
+    }
+  }
+  return ret;
+}
+
 int ObIMicroBlockReader::locate_rowkey(const common::ObStoreRowkey& rowkey, int64_t& row_idx)
 {
   int ret = OB_SUCCESS;
@@ -23,6 +23,12 @@
 #include "ob_macro_block_meta_mgr.h"
 
 namespace oceanbase {
+namespace common {
+class ObBitmap;
+}
+namespace sql {
+class ObWhiteFilterExecutor;
+}
 namespace storage {
 class ObStoreRow;
 struct ObStoreRowLockState;
@@ -254,6 +260,18 @@ class ObIMicroBlockReader {
   virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
       const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
       int64_t& version, int64_t& sql_sequence) = 0;
+  // cell of the %col_idx request column in column map, nop if the column is not stored
+  virtual int get_cell(const int64_t row_idx, const int64_t col_idx, common::ObObj& cell)
+  {
+    UNUSED(row_idx);
+    UNUSED(col_idx);
+    UNUSED(cell);
+    return common::OB_NOT_SUPPORTED;
+  }
+  // evaluate white filter on the %col_idx request column of rows [begin_idx, end_idx),
+  // bit (row_idx - begin_idx) of %result is set if the row is not filtered
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_idx, const int64_t end_idx, common::ObBitmap& result);
   int locate_rowkey(const common::ObStoreRowkey& rowkey, int64_t& row_idx);
   int locate_range(const common::ObStoreRange& range, const bool is_left_border, const bool is_right_border,
       int64_t& begin_idx, int64_t& end_idx);
@@ -48,8 +48,13 @@ int ObDataStoreDesc::cal_row_store_type(const share::schema::ObTableSchema& tabl
     } else {
       row_store_type_ = FLAT_ROW_STORE;
     }
+  } else if (ENCODING_ROW_STORE == table_schema.get_row_store_type() && !has_lob_column_ &&
+             !is_trans_table_id(table_schema.get_table_id()) && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_3101) {
+    // major merge encodes micro blocks by column when the table asks for it,
+    // tables with lob columns keep the flat format, and so does a cluster with
+    // observers that can not decode the encoded blocks
+    row_store_type_ = ENCODING_ROW_STORE;
   } else {
-    // major merge support flat only
     row_store_type_ = FLAT_ROW_STORE;
   }
   STORAGE_LOG(DEBUG, "row store type", K(row_store_type_), K(merge_type));
@@ -172,10 +177,10 @@ int ObDataStoreDesc::init(const ObTableSchema& table_schema, const int64_t data_
     }
 
     if (OB_FAIL(ret)) {
-    } else if (OB_FAIL(cal_row_store_type(table_schema, merge_type))) {
-      STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else if (OB_FAIL(table_schema.has_lob_column(has_lob_column_, true))) {
       STORAGE_LOG(WARN, "Failed to check lob column in table schema", K(ret));
+    } else if (OB_FAIL(cal_row_store_type(table_schema, merge_type))) {
+      STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else if (is_major_ && OB_FAIL(get_major_working_cluster_version())) {
       STORAGE_LOG(WARN, "Failed to get major working cluster version", K(ret));
     } else {
@@ -467,7 +472,8 @@ ObMacroBlock::~ObMacroBlock()
 int ObMacroBlock::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // the last rowkey of encoded micro block is written in flat row format
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -27,6 +27,7 @@ namespace blocksstable {
 void ObSSTableMacroBlockChecker::destroy()
 {
   flat_reader_.reset();
+  decoder_.reset();
   column_map_.reset();
   allocator_.reset();
 }
@@ -404,6 +405,10 @@ int ObSSTableMacroBlockChecker::check_micro_data(
       reader = static_cast<ObIMicroBlockReader*>(&flat_reader_);
       read_out_type = FLAT_ROW_STORE;
       column_map_ptr = &column_map_;
+    } else if (ENCODING_ROW_STORE == meta.meta_->row_store_type_) {
+      reader = static_cast<ObIMicroBlockReader*>(&decoder_);
+      read_out_type = FLAT_ROW_STORE;
+      column_map_ptr = &column_map_;
     } else if (SPARSE_ROW_STORE == meta.meta_->row_store_type_) {
       reader = static_cast<ObIMicroBlockReader*>(&sparse_reader_);
       read_out_type = SPARSE_ROW_STORE;  // write row type is sparse row
@@ -14,6 +14,7 @@
 #define OB_MACRO_BLOCK_CHECKER_H
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
 
 namespace oceanbase {
@@ -63,6 +64,7 @@ class ObSSTableMacroBlockChecker {
   private:
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   common::ObArenaAllocator allocator_;
   ObMacroBlockReader macro_reader_;
   ObColumnMap column_map_;
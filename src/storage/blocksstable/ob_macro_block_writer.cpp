@@ -39,6 +39,7 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       compressor_(),
       micro_writer_(&flat_writer_),
       flat_writer_(),
+      encoder_(),
       row_writer_(),
       flat_reader_(),
       sstable_index_writer_(NULL),
@@ -59,18 +60,24 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       allocator_("MacrBlocWriter"),
       macro_reader_(),
       micro_rowkey_hashs_(),
-      rowkey_helper_(nullptr)
+      rowkey_helper_(nullptr),
+      compress_task_start_(0),
+      compress_task_cnt_(0),
+      enable_pipeline_compress_(false)
 {
   // macro_blocks_
 }
 
 ObMacroBlockWriter::~ObMacroBlockWriter()
 {
+  wait_compress_tasks();
   COMMON_LOG(INFO, "ObMacroBlockWriter is destructed");
 }
 
 void ObMacroBlockWriter::reset()
 {
+  wait_compress_tasks();
+  enable_pipeline_compress_ = false;
   for (int i = 0; i < index_block_builders_.count(); i++) {
     index_block_builders_.at(i)->~IndexMicroBlockBuilder();
     allocator_.free(index_block_builders_.at(i));
@@ -87,7 +94,9 @@ void ObMacroBlockWriter::reset()
   // block_size_spec_
   micro_writer_ = &flat_writer_;
   flat_writer_.reuse();
+  encoder_.reuse();
   flat_reader_.reset();
+  decoder_.reset();
   sstable_index_writer_ = NULL;
   task_index_writer_ = NULL;
   macro_blocks_[0].reset();
@@ -109,6 +118,7 @@ void ObMacroBlockWriter::reset()
   lob_writer_.reset();
   check_flat_reader_.reset();
   check_sparse_reader_.reset();
+  check_decoder_.reset();
   micro_rowkey_hashs_.reset();
   rowkey_helper_ = nullptr;
   allocator_.reuse();
@@ -184,7 +194,16 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
       } else if (OB_FAIL(build_column_map(index_store_desc_, index_column_map_))) {
         STORAGE_LOG(WARN, "failed to build index column map", K(data_store_desc), K(ret));
       }
-      if (OB_SUCC(ret)) {
+      if (OB_FAIL(ret)) {
+      } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+        if (OB_FAIL(encoder_.init(data_store_desc_->micro_block_size_limit_,
+                data_store_desc_->rowkey_column_count_,
+                data_store_desc_->row_column_count_))) {
+          STORAGE_LOG(WARN, "Fail to init micro block encoder, ", K(ret));
+        } else {
+          micro_writer_ = &encoder_;
+        }
+      } else {
         if (OB_FAIL(flat_writer_.init(data_store_desc_->micro_block_size_limit_,
                 data_store_desc_->rowkey_column_count_,
                 data_store_desc_->row_column_count_))) {
@@ -222,6 +241,18 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
         }
       }
 
+      // index micro blocks are written along with the data micro blocks, only pipeline the data writer
+      if (OB_SUCC(ret) && this != sstable_index_writer_ && ObMicroBlockCompressPool::get_instance().is_inited() &&
+          NULL != data_store_desc_->compressor_name_ && '\0' != data_store_desc_->compressor_name_[0] &&
+          0 != STRCMP(data_store_desc_->compressor_name_, "none")) {
+        for (int64_t i = 0; OB_SUCC(ret) && i < COMPRESS_PIPELINE_DEPTH; ++i) {
+          if (OB_FAIL(compress_tasks_[i].init(*data_store_desc_))) {
+            STORAGE_LOG(WARN, "Fail to init micro block compress task", K(ret), K(i));
+          }
+        }
+        enable_pipeline_compress_ = OB_SUCC(ret);
+      }
+
       if (OB_SUCC(ret) && OB_NOT_NULL(data_store_desc_->rowkey_helper_)) {
         if (data_store_desc_->rowkey_helper_->is_valid()) {
           rowkey_helper_ = data_store_desc_->rowkey_helper_;
@@ -418,6 +449,9 @@ int ObMacroBlockWriter::append_micro_block(const ObMicroBlock& micro_block)
         STORAGE_LOG(WARN, "build_micro_block failed", K(ret));
       }
     }
+    if (OB_SUCC(ret) && OB_FAIL(flush_compress_tasks())) {
+      STORAGE_LOG(WARN, "Fail to flush compress tasks", K(ret));
+    }
     if (OB_SUCC(ret)) {
       ObMicroBlockDesc micro_block_desc;
       if (OB_FAIL(build_micro_block_desc(micro_block, micro_block_desc))) {
@@ -446,6 +480,8 @@ int ObMacroBlockWriter::close(storage::ObStoreRow* root, char* root_buf)
     STORAGE_LOG(WARN, "exceptional situation", K(ret), K_(data_store_desc), K_(micro_writer));
   } else if (micro_writer_->get_row_count() > 0 && OB_FAIL(build_micro_block())) {
     STORAGE_LOG(WARN, "macro block writer fail to build current micro block.", K(ret));
+  } else if (OB_FAIL(flush_compress_tasks())) {
+    STORAGE_LOG(WARN, "macro block writer fail to flush compress tasks.", K(ret));
   } else {
     ObMacroBlock& current_block = macro_blocks_[current_index_];
     ObMacroBlock& prev_block = macro_blocks_[1 - current_index_];
@@ -890,13 +926,21 @@ int ObMacroBlockWriter::build_micro_block(const bool force_split)
     STORAGE_LOG(WARN, "micro_block_writer is empty", K(ret));
   } else if (OB_FAIL(micro_writer_->build_block(block_buffer, block_size))) {
     STORAGE_LOG(WARN, "Fail to build block, ", K(ret));
+  } else if (enable_pipeline_compress_) {
+    // compressed by the compress task, checked before it is written to macro block
   } else if (OB_FAIL(
                  compressor_.compress(block_buffer, block_size, micro_block_desc.buf_, micro_block_desc.buf_size_))) {
     STORAGE_LOG(WARN, "macro block writer fail to compress.", K(ret), K(OB_P(block_buffer)), K(block_size));
   } else if (MICRO_BLOCK_MERGE_VERIFY_LEVEL::NONE != micro_writer_->get_micro_block_merge_verify_level() &&
-             OB_FAIL(check_micro_block(
-                 micro_block_desc.buf_, micro_block_desc.buf_size_, block_buffer, block_size, micro_writer_))) {
+             OB_FAIL(check_micro_block(micro_block_desc.buf_,
+                 micro_block_desc.buf_size_,
+                 block_buffer,
+                 block_size,
+                 micro_writer_->get_micro_block_merge_verify_level(),
+                 micro_writer_->get_micro_block_checksum()))) {
     STORAGE_LOG(WARN, "failed to check micro block", K(ret));
+  }
+  if (OB_FAIL(ret)) {
   } else if (OB_FAIL(can_mark_deletion(pre_micro_last_key_, last_key_, mark_deletion))) {
     STORAGE_LOG(WARN, "fail to run can mark deletion", K(ret));
   } else if (OB_FAIL(save_pre_micro_last_key(last_key_))) {
@@ -914,9 +958,14 @@ int ObMacroBlockWriter::build_micro_block(const bool force_split)
       micro_block_desc.max_merged_trans_version_ = micro_writer_->get_max_merged_trans_version();
       micro_block_desc.contain_uncommitted_row_ = micro_writer_->is_contain_uncommitted_row();
     }
-    if (OB_FAIL(write_micro_block(micro_block_desc, force_split))) {
+    if (enable_pipeline_compress_) {
+      if (OB_FAIL(submit_compress_task(block_buffer, block_size, micro_block_desc, force_split))) {
+        STORAGE_LOG(WARN, "Fail to submit compress task", K(micro_block_desc), K(force_split), K(ret));
+      }
+    } else if (OB_FAIL(write_micro_block(micro_block_desc, force_split))) {
       STORAGE_LOG(WARN, "build_micro_block failed", K(micro_block_desc), K(force_split), K(ret));
-    } else {
+    }
+    if (OB_SUCC(ret)) {
       micro_writer_->reuse();
       if (data_store_desc_->need_prebuild_bloomfilter_ && micro_rowkey_hashs_.count() > 0) {
         micro_rowkey_hashs_.reuse();
@@ -1053,6 +1102,21 @@ int ObMacroBlockWriter::build_micro_block_desc_with_rewrite(
 }
 
 int ObMacroBlockWriter::write_micro_block(const ObMicroBlockDesc& micro_block_desc, const bool force_split)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(do_write_micro_block(micro_block_desc, micro_rowkey_hashs_, force_split))) {
+    STORAGE_LOG(WARN, "Fail to write micro block", K(ret), K(micro_block_desc));
+  } else {
+    need_deletion_check_ = OB_ISNULL(mark_deletion_maker_) ? false : true;
+    if (data_store_desc_->need_calc_column_checksum_) {
+      MEMSET(curr_micro_column_checksum_, 0, sizeof(int64_t) * data_store_desc_->row_column_count_);
+    }
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::do_write_micro_block(
+    const ObMicroBlockDesc& micro_block_desc, ObArray<uint32_t>& rowkey_hashs, const bool force_split)
 {
   int ret = OB_SUCCESS;
   int64_t data_offset = 0;
@@ -1081,43 +1145,117 @@ int ObMacroBlockWriter::write_micro_block(const ObMicroBlockDesc& micro_block_de
           ret = OB_SUCCESS;
         }
       }
-      if (micro_rowkey_hashs_.count() != micro_block_desc.row_count_) {
+      if (rowkey_hashs.count() != micro_block_desc.row_count_) {
         // count=0 ,when micro block reused
-        if (OB_UNLIKELY(micro_rowkey_hashs_.count() > 0)) {
+        if (OB_UNLIKELY(rowkey_hashs.count() > 0)) {
           STORAGE_LOG(WARN,
-              "build bloomfilter: micro_rowkey_hashs_ and micro_block_desc count not same ",
-              K(micro_rowkey_hashs_.count()),
+              "build bloomfilter: rowkey_hashs and micro_block_desc count not same ",
+              K(rowkey_hashs.count()),
               K(micro_block_desc.row_count_));
         }
         current_writer.set_not_need_build();
       } else if (current_writer.is_need_build() &&
                  OB_LIKELY(current_writer.get_rowkey_column_count() == data_store_desc_->bloomfilter_rowkey_prefix_) &&
-                 OB_FAIL(current_writer.append(micro_rowkey_hashs_))) {
+                 OB_FAIL(current_writer.append(rowkey_hashs))) {
         STORAGE_LOG(WARN, "Fail to append rowkey hash to macro block, ", K(ret));
         current_writer.set_not_need_build();
         ret = OB_SUCCESS;
       }
-      micro_rowkey_hashs_.reuse();
+      rowkey_hashs.reuse();
     }
     if (force_split || macro_blocks_[current_index_].get_data_size() >= data_store_desc_->macro_store_size_) {
       if (OB_FAIL(try_switch_macro_block())) {
         STORAGE_LOG(WARN, "macro block writer fail to try switch macro block.", K(ret));
       }
     }
-    need_deletion_check_ = OB_ISNULL(mark_deletion_maker_) ? false : true;
   }
 
   if (OB_SUCC(ret) && NULL != data_store_desc_->merge_info_) {
     data_store_desc_->merge_info_->rewrite_macro_total_micro_block_count_++;
   }
 
-  if (OB_SUCC(ret) && data_store_desc_->need_calc_column_checksum_) {
-    MEMSET(curr_micro_column_checksum_, 0, sizeof(int64_t) * data_store_desc_->row_column_count_);
+  return ret;
+}
+
+int ObMacroBlockWriter::submit_compress_task(
+    const char* block_buf, const int64_t block_size, const ObMicroBlockDesc& micro_block_desc, const bool force_split)
+{
+  int ret = OB_SUCCESS;
+  if (COMPRESS_PIPELINE_DEPTH == compress_task_cnt_ && OB_FAIL(write_compressed_micro_block())) {
+    STORAGE_LOG(WARN, "Fail to write compressed micro block", K(ret));
+  } else {
+    const int64_t idx = (compress_task_start_ + compress_task_cnt_) % COMPRESS_PIPELINE_DEPTH;
+    ObMicroBlockCompressTask& task = compress_tasks_[idx];
+    if (OB_FAIL(task.assign(block_buf,
+            block_size,
+            micro_block_desc,
+            micro_writer_->get_micro_block_checksum(),
+            micro_rowkey_hashs_,
+            force_split))) {
+      STORAGE_LOG(WARN, "Fail to assign compress task", K(ret), K(micro_block_desc));
+    } else {
+      ++compress_task_cnt_;
+      ObMicroBlockCompressPool::get_instance().submit(task);
+      // the states below belong to the next micro block now
+      need_deletion_check_ = OB_ISNULL(mark_deletion_maker_) ? false : true;
+      if (data_store_desc_->need_calc_column_checksum_) {
+        MEMSET(curr_micro_column_checksum_, 0, sizeof(int64_t) * data_store_desc_->row_column_count_);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::write_compressed_micro_block()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(compress_task_cnt_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "no compress task to write", K(ret), K_(compress_task_cnt));
+  } else {
+    ObMicroBlockCompressTask& task = compress_tasks_[compress_task_start_];
+    const ObMicroBlockDesc& micro_block_desc = task.get_micro_block_desc();
+    const int64_t verify_level = micro_writer_->get_micro_block_merge_verify_level();
+    if (OB_FAIL(task.wait())) {
+      STORAGE_LOG(WARN, "macro block writer fail to compress.", K(ret), K(task));
+    } else if (MICRO_BLOCK_MERGE_VERIFY_LEVEL::NONE != verify_level &&
+               OB_FAIL(check_micro_block(micro_block_desc.buf_,
+                   micro_block_desc.buf_size_,
+                   task.get_block_buf(),
+                   task.get_block_size(),
+                   verify_level,
+                   task.get_micro_block_checksum()))) {
+      STORAGE_LOG(WARN, "failed to check micro block", K(ret));
+    } else if (OB_FAIL(do_write_micro_block(micro_block_desc, task.get_rowkey_hashs(), task.is_force_split()))) {
+      STORAGE_LOG(WARN, "Fail to write micro block", K(ret), K(micro_block_desc));
+    }
+    compress_task_start_ = (compress_task_start_ + 1) % COMPRESS_PIPELINE_DEPTH;
+    --compress_task_cnt_;
   }
+  return ret;
+}
 
+int ObMacroBlockWriter::flush_compress_tasks()
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && compress_task_cnt_ > 0) {
+    if (OB_FAIL(write_compressed_micro_block())) {
+      STORAGE_LOG(WARN, "Fail to write compressed micro block", K(ret));
+    }
+  }
   return ret;
 }
 
+void ObMacroBlockWriter::wait_compress_tasks()
+{
+  // discard the micro blocks not written yet, the tasks must not be running when the writer is reused
+  for (int64_t i = 0; i < COMPRESS_PIPELINE_DEPTH; ++i) {
+    compress_tasks_[i].reset();
+  }
+  compress_task_start_ = 0;
+  compress_task_cnt_ = 0;
+}
+
 int ObMacroBlockWriter::flush_macro_block(ObMacroBlock& macro_block)
 {
   int ret = OB_SUCCESS;
@@ -1301,7 +1439,10 @@ int ObMacroBlockWriter::check_micro_block_need_merge(const ObMicroBlock& micro_b
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid micro_block", K(micro_block), K(ret));
   } else {
-    if (micro_writer_->get_row_count() <= 0 &&
+    if (micro_block.row_store_type_ != data_store_desc_->row_store_type_) {
+      // rows must be rewritten in the row store type of the macro block
+      need_merge = true;
+    } else if (micro_writer_->get_row_count() <= 0 &&
         micro_block.origin_data_size_ > data_store_desc_->micro_block_size_ / 2) {
       need_merge = false;
     } else if (micro_writer_->get_block_size() > data_store_desc_->micro_block_size_ / 2 &&
@@ -1496,6 +1637,10 @@ OB_INLINE ObIMicroBlockReader* ObMacroBlockWriter::get_micro_block_reader(const
       reader = &flat_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader = &decoder_;
+      break;
+    }
     case SPARSE_ROW_STORE: {
       reader = &sparse_reader_;
       break;
@@ -1559,6 +1704,10 @@ int ObMacroBlockWriter::prepare_micro_block_reader(
       micro_reader = static_cast<ObIMicroBlockReader*>(&check_flat_reader_);
       read_out_type = FLAT_ROW_STORE;
       column_map_ptr = &column_map_;
+    } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+      micro_reader = static_cast<ObIMicroBlockReader*>(&check_decoder_);
+      read_out_type = FLAT_ROW_STORE;
+      column_map_ptr = &column_map_;
     } else if (SPARSE_ROW_STORE == data_store_desc_->row_store_type_) {
       micro_reader = static_cast<ObIMicroBlockReader*>(&check_sparse_reader_);
       read_out_type = SPARSE_ROW_STORE;  // read row type is sparse row
@@ -1599,7 +1748,7 @@ int ObMacroBlockWriter::print_micro_block_row(ObIMicroBlockReader* micro_reader)
 }
 
 int ObMacroBlockWriter::check_micro_block_checksum(
-    const char* buf, const int64_t size, const ObIMicroBlockWriter* micro_writer)
+    const char* buf, const int64_t size, const int64_t micro_block_checksum)
 {
   int ret = OB_SUCCESS;
   ObIMicroBlockReader* micro_reader = NULL;
@@ -1622,14 +1771,14 @@ int ObMacroBlockWriter::check_micro_block_checksum(
       }
     }
     if (OB_SUCC(ret)) {
-      if (micro_writer->get_micro_block_checksum() != new_checksum) {
+      if (micro_block_checksum != new_checksum) {
         if (OB_FAIL(print_micro_block_row(micro_reader))) {
           STORAGE_LOG(WARN, "failed to print micro block buffer", K(ret));
         }
         ret = OB_CHECKSUM_ERROR;  // ignore print error code
         FLOG_ERROR("micro block checksum is not equal",
             K(new_checksum),
-            K(micro_writer->get_micro_block_checksum()),
+            K(micro_block_checksum),
             K(ret),
             KPC(data_store_desc_));
       }
@@ -1657,12 +1806,13 @@ int ObMacroBlockWriter::dump_micro_block_writer_buffer()
 }
 
 int ObMacroBlockWriter::check_micro_block(const char* compressed_buf, const int64_t compressed_size,
-    const char* uncompressed_buf, const int64_t uncompressed_size, ObIMicroBlockWriter* micro_writer)
+    const char* uncompressed_buf, const int64_t uncompressed_size, const int64_t verify_level,
+    const int64_t micro_block_checksum)
 {
   int ret = OB_SUCCESS;
   const char* decomp_buf = nullptr;
   int64_t real_decomp_size = 0;
-  if (MICRO_BLOCK_MERGE_VERIFY_LEVEL::ENCODING == micro_writer->get_micro_block_merge_verify_level()) {
+  if (MICRO_BLOCK_MERGE_VERIFY_LEVEL::ENCODING == verify_level) {
     decomp_buf = const_cast<char*>(uncompressed_buf);
   } else if (OB_FAIL(compressor_.decompress(
                  compressed_buf, compressed_size, uncompressed_size, decomp_buf, real_decomp_size))) {
@@ -1673,7 +1823,7 @@ int ObMacroBlockWriter::check_micro_block(const char* compressed_buf, const int6
         ERROR, "decompressed size is not equal to original size", K(ret), K(uncompressed_size), K(real_decomp_size));
   }
   if (OB_SUCC(ret)) {
-    if (OB_FAIL(check_micro_block_checksum(decomp_buf, uncompressed_size, micro_writer))) {
+    if (OB_FAIL(check_micro_block_checksum(decomp_buf, uncompressed_size, micro_block_checksum))) {
       STORAGE_LOG(WARN, "failed to check_micro_block_checksum", K(ret));
     }
   }
@@ -1903,7 +2053,8 @@ int ObMacroBlockWriter::build_index_micro_block(const int32_t height, const ObSt
                  micro_block_desc.buf_size_,
                  block_buffer,
                  block_size,
-                 &current_level_builder->writer_))) {
+                 current_level_builder->writer_.get_micro_block_merge_verify_level(),
+                 current_level_builder->writer_.get_micro_block_checksum()))) {
     STORAGE_LOG(WARN, "failed to check micro block", K(ret));
   } else {
     int64_t data_offset = 0;
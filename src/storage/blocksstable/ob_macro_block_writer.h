@@ -13,6 +13,8 @@
 #ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_MACRO_BLOCK_WRITER_H_
 #define OCEANBASE_STORAGE_BLOCKSSTABLE_MACRO_BLOCK_WRITER_H_
 #include "ob_micro_block_writer.h"
+#include "ob_micro_block_encoder.h"
+#include "ob_micro_block_decoder.h"
 #include "ob_micro_block_index_writer.h"
 #include "ob_micro_block_reader.h"
 #include "lib/compress/ob_compressor.h"
@@ -32,6 +34,7 @@
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
 #include "storage/ob_pg_mgr.h"
 #include "ob_block_index_intermediate.h"
+#include "ob_micro_block_compress_task.h"
 
 namespace oceanbase {
 namespace blocksstable {
@@ -111,6 +114,13 @@ class ObMacroBlockWriter {
   int build_micro_block_desc_with_rewrite(const ObMicroBlock& micro_block, ObMicroBlockDesc& micro_block_desc);
   int build_micro_block_desc_with_reuse(const ObMicroBlock& micro_block, ObMicroBlockDesc& micro_block_desc);
   int write_micro_block(const ObMicroBlockDesc& micro_block_desc, const bool force_split = false);
+  int do_write_micro_block(
+      const ObMicroBlockDesc& micro_block_desc, common::ObArray<uint32_t>& rowkey_hashs, const bool force_split);
+  int submit_compress_task(
+      const char* block_buf, const int64_t block_size, const ObMicroBlockDesc& micro_block_desc, const bool force_split);
+  int write_compressed_micro_block();
+  int flush_compress_tasks();
+  void wait_compress_tasks();
   int check_micro_block_need_merge(const ObMicroBlock& micro_block, bool& need_merge);
   int merge_micro_block(const ObMicroBlock& micro_block);
   int flush_macro_block(ObMacroBlock& macro_block);
@@ -129,10 +139,9 @@ class ObMacroBlockWriter {
   {
     return data_store_desc_->enable_sparse_format();
   }
-  int check_micro_block_checksum(const char* buf, const int64_t size,
-      const ObIMicroBlockWriter* micro_writer /*do checksum for this micro writer*/);
+  int check_micro_block_checksum(const char* buf, const int64_t size, const int64_t micro_block_checksum);
   int check_micro_block(const char* compressed_buf, const int64_t compressed_size, const char* uncompressed_buf,
-      const int64_t uncompressed_size, ObIMicroBlockWriter* micro_writer /*check for this micro writer*/);
+      const int64_t uncompressed_size, const int64_t verify_level, const int64_t micro_block_checksum);
   int build_column_map(const ObDataStoreDesc* data_desc, ObColumnMap& column_map);
   int open_bf_cache_writer(const ObDataStoreDesc& desc);
   int flush_bf_to_cache(ObMacroBloomFilterCacheWriter& bf_cache_writer, const int32_t row_count);
@@ -166,6 +175,7 @@ class ObMacroBlockWriter {
   static const int64_t DEFAULT_MICRO_BLOCK_TREE_HIGH = 4;
   static const int64_t DEFAULT_MICRO_BLOCK_WRITER_COUNT = 64;
   static const int64_t INDEX_MACRO_BLOCK_MAX_SEQ_NUM = 0x100000;  // 1048576
+  static const int64_t COMPRESS_PIPELINE_DEPTH = 4;
   typedef common::ObSEArray<MacroBlockId, DEFAULT_MACRO_BLOCK_COUNT> MacroBlockList;
   typedef common::ObSEArray<IndexMicroBlockBuilder*, DEFAULT_MICRO_BLOCK_TREE_HIGH> IndexMicroBlockBuildList;
   typedef common::ObSEArray<IndexMicroBlockDesc*, DEFAULT_MICRO_BLOCK_WRITER_COUNT> IndexMicroBlockDescList;
@@ -178,10 +188,12 @@ class ObMacroBlockWriter {
   IndexMicroBlockDescList task_top_block_descs_;
   ObIMicroBlockWriter* micro_writer_;
   ObMicroBlockWriter flat_writer_;
+  ObMicroBlockEncoder encoder_;
   ObRowWriter row_writer_;
   char rowkey_buf_[common::OB_MAX_ROW_KEY_LENGTH];
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   ObMacroBlockWriter* sstable_index_writer_;
   ObMacroBlockWriter* task_index_writer_;
   ObMacroBlock macro_blocks_[2];
@@ -211,10 +223,16 @@ class ObMacroBlockWriter {
                                                                                     // NOT use same buf of data row
   ObMicroBlockReader check_flat_reader_;
   ObSparseMicroBlockReader check_sparse_reader_;
+  ObMicroBlockDecoder check_decoder_;
   common::ObArray<uint32_t> micro_rowkey_hashs_;
   storage::ObSSTableRowkeyHelper* rowkey_helper_;
   ObSSTableMacroBlockChecker macro_block_checker_;
   common::SpinRWLock lock_;
+  // micro blocks being compressed by ObMicroBlockCompressPool, written to macro block in order
+  ObMicroBlockCompressTask compress_tasks_[COMPRESS_PIPELINE_DEPTH];
+  int64_t compress_task_start_;
+  int64_t compress_task_cnt_;
+  bool enable_pipeline_compress_;
 };
 
 }  // end namespace blocksstable
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_compress_task.h"
+#include "lib/stat/ob_diagnose_info.h"
+
+namespace oceanbase {
+using namespace common;
+namespace blocksstable {
+/**
+ * ---------------------------------------------------------ObMicroBlockCompressTask--------------------------------------------------------------
+ */
+ObMicroBlockCompressTask::ObMicroBlockCompressTask()
+    : is_inited_(false),
+      compressor_(),
+      block_buf_(0, "MicrBlocCompTsk"),
+      column_checksums_(),
+      rowkey_hashs_(),
+      micro_block_desc_(),
+      block_size_(0),
+      micro_block_checksum_(0),
+      force_split_(false),
+      is_done_(true),
+      ret_code_(OB_SUCCESS),
+      cond_()
+{}
+
+ObMicroBlockCompressTask::~ObMicroBlockCompressTask()
+{
+  // the task may still be queued in the pool
+  if (is_inited_) {
+    wait();
+  }
+}
+
+int ObMicroBlockCompressTask::init(const ObDataStoreDesc& data_store_desc)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_ && OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    STORAGE_LOG(WARN, "fail to init cond", K(ret));
+  } else if (FALSE_IT(is_inited_ = true)) {
+  } else if (OB_FAIL(compressor_.init(data_store_desc.micro_block_size_, data_store_desc.compressor_name_))) {
+    STORAGE_LOG(WARN, "fail to init micro block compressor", K(ret), K(data_store_desc));
+  } else {
+    column_checksums_.reuse();
+    if (data_store_desc.need_calc_column_checksum_ &&
+        OB_FAIL(column_checksums_.prepare_allocate(data_store_desc.row_column_count_))) {
+      STORAGE_LOG(WARN, "fail to prepare column checksums", K(ret), K(data_store_desc.row_column_count_));
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressTask::reset()
+{
+  if (is_inited_) {
+    wait();
+  }
+  rowkey_hashs_.reuse();
+  micro_block_desc_.reset();
+  block_size_ = 0;
+  micro_block_checksum_ = 0;
+  force_split_ = false;
+  ret_code_ = OB_SUCCESS;
+}
+
+int ObMicroBlockCompressTask::assign(const char* block_buf, const int64_t block_size,
+    const ObMicroBlockDesc& micro_block_desc, const int64_t micro_block_checksum,
+    const ObIArray<uint32_t>& rowkey_hashs, const bool force_split)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_len = micro_block_desc.last_rowkey_.length();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "compress task is not inited", K(ret));
+  } else if (OB_ISNULL(block_buf) || OB_UNLIKELY(block_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(block_buf), K(block_size));
+  } else if (OB_UNLIKELY(!is_done_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "compress task is still running", K(ret), K(*this));
+  } else if (OB_FAIL(block_buf_.ensure_space(block_size + rowkey_len))) {
+    STORAGE_LOG(WARN, "fail to ensure space for micro block", K(ret), K(block_size), K(rowkey_len));
+  } else if (OB_FAIL(rowkey_hashs_.assign(rowkey_hashs))) {
+    STORAGE_LOG(WARN, "fail to assign rowkey hashs", K(ret));
+  } else {
+    char* buf = block_buf_.data();
+    MEMCPY(buf, block_buf, block_size);
+    MEMCPY(buf + block_size, micro_block_desc.last_rowkey_.ptr(), rowkey_len);
+    micro_block_desc_ = micro_block_desc;
+    micro_block_desc_.last_rowkey_.assign_ptr(buf + block_size, static_cast<ObString::obstr_size_t>(rowkey_len));
+    micro_block_desc_.buf_ = NULL;
+    micro_block_desc_.buf_size_ = 0;
+    if (NULL != micro_block_desc.column_checksums_ && column_checksums_.count() > 0) {
+      MEMCPY(&column_checksums_.at(0),
+          micro_block_desc.column_checksums_,
+          sizeof(int64_t) * column_checksums_.count());
+      micro_block_desc_.column_checksums_ = &column_checksums_.at(0);
+    }
+    block_size_ = block_size;
+    micro_block_checksum_ = micro_block_checksum;
+    force_split_ = force_split;
+    ret_code_ = OB_SUCCESS;
+    is_done_ = false;
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressTask::process()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(compressor_.compress(
+          block_buf_.data(), block_size_, micro_block_desc_.buf_, micro_block_desc_.buf_size_))) {
+    STORAGE_LOG(WARN, "fail to compress micro block", K(ret), K_(block_size));
+  }
+  ObThreadCondGuard guard(cond_);
+  ret_code_ = ret;
+  is_done_ = true;
+  cond_.broadcast();
+}
+
+int ObMicroBlockCompressTask::wait()
+{
+  ObThreadCondGuard guard(cond_);
+  while (!is_done_) {
+    cond_.wait();
+  }
+  return ret_code_;
+}
+
+/**
+ * ---------------------------------------------------------ObMicroBlockCompressPool--------------------------------------------------------------
+ */
+ObMicroBlockCompressPool& ObMicroBlockCompressPool::get_instance()
+{
+  static ObMicroBlockCompressPool instance_;
+  return instance_;
+}
+
+ObMicroBlockCompressPool::ObMicroBlockCompressPool() : is_inited_(false), thread_cnt_(0)
+{}
+
+ObMicroBlockCompressPool::~ObMicroBlockCompressPool()
+{
+  destroy();
+}
+
+int ObMicroBlockCompressPool::init(const int64_t thread_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "micro block compress pool has been inited", K(ret));
+  } else if (OB_UNLIKELY(thread_cnt < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(thread_cnt));
+  } else if (0 == thread_cnt) {
+    STORAGE_LOG(INFO, "micro block compress pool is disabled");
+  } else if (OB_FAIL(ObSimpleThreadPool::init(thread_cnt, TASK_NUM_LIMIT, "MicroCompress"))) {
+    STORAGE_LOG(WARN, "fail to init thread pool", K(ret), K(thread_cnt));
+  } else {
+    thread_cnt_ = thread_cnt;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressPool::destroy()
+{
+  if (is_inited_) {
+    is_inited_ = false;
+    ObSimpleThreadPool::destroy();
+    thread_cnt_ = 0;
+  }
+}
+
+void ObMicroBlockCompressPool::submit(ObMicroBlockCompressTask& task)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_ || get_queue_num() >= thread_cnt_) {
+    task.process();
+  } else if (OB_FAIL(push(&task))) {
+    STORAGE_LOG(DEBUG, "fail to push compress task, process it in place", K(ret));
+    task.process();
+  }
+}
+
+void ObMicroBlockCompressPool::handle(void* task)
+{
+  if (OB_ISNULL(task)) {
+    STORAGE_LOG(ERROR, "compress task is null");
+  } else {
+    static_cast<ObMicroBlockCompressTask*>(task)->process();
+  }
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
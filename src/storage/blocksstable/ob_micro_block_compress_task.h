@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_COMPRESS_TASK_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_COMPRESS_TASK_H_
+
+#include "lib/container/ob_array.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/thread/ob_simple_thread_pool.h"
+#include "ob_data_buffer.h"
+#include "ob_macro_block.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+/*
+ * One built micro block waiting for compression.
+ * The macro block writer keeps a small ring of these tasks, so the merge thread goes on encoding the
+ * next micro blocks while the previous ones are compressed by ObMicroBlockCompressPool. The task
+ * owns copies of everything the micro block writer reuses right after the block is built, and the
+ * compressed blocks are still written into the macro block in order by the merge thread.
+ */
+class ObMicroBlockCompressTask {
+  public:
+  ObMicroBlockCompressTask();
+  virtual ~ObMicroBlockCompressTask();
+  int init(const ObDataStoreDesc& data_store_desc);
+  void reset();
+  int assign(const char* block_buf, const int64_t block_size, const ObMicroBlockDesc& micro_block_desc,
+      const int64_t micro_block_checksum, const common::ObIArray<uint32_t>& rowkey_hashs, const bool force_split);
+  void process();
+  // wait until the task is processed, return the error code of compression
+  int wait();
+  OB_INLINE const ObMicroBlockDesc& get_micro_block_desc() const
+  {
+    return micro_block_desc_;
+  }
+  OB_INLINE const char* get_block_buf() const
+  {
+    return block_buf_.data();
+  }
+  OB_INLINE int64_t get_block_size() const
+  {
+    return block_size_;
+  }
+  OB_INLINE int64_t get_micro_block_checksum() const
+  {
+    return micro_block_checksum_;
+  }
+  OB_INLINE common::ObArray<uint32_t>& get_rowkey_hashs()
+  {
+    return rowkey_hashs_;
+  }
+  OB_INLINE bool is_force_split() const
+  {
+    return force_split_;
+  }
+  TO_STRING_KV(K_(micro_block_desc), K_(block_size), K_(micro_block_checksum), K_(force_split), K_(is_done),
+      K_(ret_code));
+
+  private:
+  bool is_inited_;
+  ObMicroBlockCompressor compressor_;
+  ObSelfBufferWriter block_buf_;  // uncompressed block followed by the last rowkey
+  common::ObArray<int64_t> column_checksums_;
+  common::ObArray<uint32_t> rowkey_hashs_;
+  ObMicroBlockDesc micro_block_desc_;
+  int64_t block_size_;
+  int64_t micro_block_checksum_;
+  bool force_split_;
+  bool is_done_;
+  int ret_code_;
+  common::ObThreadCond cond_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCompressTask);
+};
+
+class ObMicroBlockCompressPool : public common::ObSimpleThreadPool {
+  public:
+  static ObMicroBlockCompressPool& get_instance();
+  ObMicroBlockCompressPool();
+  virtual ~ObMicroBlockCompressPool();
+  int init(const int64_t thread_cnt);
+  void destroy();
+  OB_INLINE bool is_inited() const
+  {
+    return is_inited_;
+  }
+  // the task is processed in the caller thread if the pool is not started or all threads are busy
+  void submit(ObMicroBlockCompressTask& task);
+  virtual void handle(void* task) override;
+
+  private:
+  static const int64_t TASK_NUM_LIMIT = 1024;
+  bool is_inited_;
+  int64_t thread_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCompressPool);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_COMPRESS_TASK_H_
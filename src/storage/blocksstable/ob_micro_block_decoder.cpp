@@ -0,0 +1,781 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_decoder.h"
+#include "share/object/ob_obj_cast.h"
+#include "storage/ob_i_store.h"
+#include "ob_column_map.h"
+#include "lib/container/ob_bitmap.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+/**
+ * -------------------------------------------------------ObMicroBlockDecoder--------------------------------------------------------------
+ */
+ObMicroBlockDecoder::ObMicroBlockDecoder()
+    : header_(NULL),
+      block_buf_(NULL),
+      block_size_(0),
+      row_headers_(NULL),
+      same_row_header_(false),
+      column_ctxs_(NULL),
+      allocator_(ObModIds::OB_STORE_ROW_GETTER),
+      row_allocator_(NULL)
+{}
+
+ObMicroBlockDecoder::~ObMicroBlockDecoder()
+{
+  reset();
+}
+
+void ObMicroBlockDecoder::reset()
+{
+  ObIMicroBlockReader::reset();
+  header_ = NULL;
+  block_buf_ = NULL;
+  block_size_ = 0;
+  row_headers_ = NULL;
+  same_row_header_ = false;
+  column_ctxs_ = NULL;
+  allocator_.reuse();
+}
+
+bool ObMicroBlockDecoder::is_encoding_block(const ObMicroBlockData& block_data)
+{
+  return block_data.is_valid() && block_data.get_buf_size() >= static_cast<int64_t>(sizeof(ObMicroBlockHeader)) &&
+         ENCODING_MICRO_BLOCK_HEADER_MAGIC ==
+             reinterpret_cast<const ObMicroBlockHeader*>(block_data.get_buf())->magic_;
+}
+
+int ObMicroBlockDecoder::init(
+    const ObMicroBlockData& block_data, const ObColumnMap* column_map, const ObRowStoreType out_type)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_UNLIKELY(NULL == column_map || !column_map->is_valid() || FLAT_ROW_STORE != out_type)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(column_map), K(out_type));
+  } else if (OB_FAIL(base_init(block_data))) {
+    STORAGE_LOG(WARN, "fail to init decoder", K(ret), K(block_data));
+  } else {
+    column_map_ = column_map;
+    output_row_type_ = out_type;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::init(const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_FAIL(base_init(block_data))) {
+    STORAGE_LOG(WARN, "fail to init decoder", K(ret), K(block_data));
+  } else {
+    output_row_type_ = FLAT_ROW_STORE;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::base_init(const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_encoding_block(block_data))) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid encoding micro block", K(ret), K(block_data));
+  } else {
+    block_buf_ = block_data.get_buf();
+    block_size_ = block_data.get_buf_size();
+    header_ = reinterpret_cast<const ObMicroBlockHeader*>(block_buf_);
+    const int64_t col_headers_size = header_->column_count_ * sizeof(ObColumnEncodingHeader);
+    if (OB_UNLIKELY(header_->column_count_ <= 0 || header_->row_count_ <= 0 ||
+                    header_->header_size_ + col_headers_size > header_->row_index_offset_ ||
+                    header_->row_index_offset_ + static_cast<int64_t>(sizeof(ObRowHeader)) > block_size_)) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "invalid encoding micro block header", K(ret), K(*header_), K_(block_size));
+    } else if (OB_ISNULL(column_ctxs_ = static_cast<ObColumnDecoderCtx*>(
+                             allocator_.alloc(sizeof(ObColumnDecoderCtx) * header_->column_count_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      STORAGE_LOG(WARN, "fail to allocate column decoder ctx", K(ret), K(header_->column_count_));
+    } else {
+      const ObColumnEncodingHeader* col_headers =
+          reinterpret_cast<const ObColumnEncodingHeader*>(block_buf_ + header_->header_size_);
+      row_headers_ = reinterpret_cast<const ObRowHeader*>(block_buf_ + header_->row_index_offset_);
+      same_row_header_ = 0 != (header_->attr_ & ENCODING_ATTR_SAME_ROW_HEADER);
+      for (int64_t i = 0; OB_SUCC(ret) && i < header_->column_count_; ++i) {
+        new (&column_ctxs_[i]) ObColumnDecoderCtx();
+        if (OB_FAIL(init_column_ctx(col_headers[i], column_ctxs_[i]))) {
+          STORAGE_LOG(WARN, "fail to init column decoder ctx", K(ret), K(i), K(col_headers[i]));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        begin_ = 0;
+        end_ = header_->row_count_;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::init_column_ctx(const ObColumnEncodingHeader& col_header, ObColumnDecoderCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!col_header.is_valid() || col_header.offset_ + col_header.length_ > block_size_)) {
+    ret = OB_INVALID_DATA;
+    STORAGE_LOG(WARN, "invalid column encoding header", K(ret), K(col_header), K_(block_size));
+  } else {
+    const char* payload = block_buf_ + col_header.offset_;
+    ctx.header_ = &col_header;
+    switch (col_header.type_) {
+      case OB_COLUMN_ENCODING_RAW:
+      case OB_COLUMN_ENCODING_CONST:
+      case OB_COLUMN_ENCODING_DICT: {
+        ctx.value_offsets_ = reinterpret_cast<const uint32_t*>(payload);
+        ctx.values_ = payload + (col_header.count_ + 1) * sizeof(uint32_t);
+        ctx.packed_ = ctx.values_ + ctx.value_offsets_[col_header.count_];
+        break;
+      }
+      case OB_COLUMN_ENCODING_RLE: {
+        ctx.run_starts_ = reinterpret_cast<const uint32_t*>(payload);
+        ctx.value_offsets_ = ctx.run_starts_ + col_header.count_;
+        ctx.values_ = reinterpret_cast<const char*>(ctx.value_offsets_ + col_header.count_ + 1);
+        break;
+      }
+      case OB_COLUMN_ENCODING_INT_DELTA: {
+        MEMCPY(&ctx.meta_, payload, sizeof(ObObjMeta));
+        MEMCPY(&ctx.base_, payload + sizeof(ObObjMeta), sizeof(int64_t));
+        ctx.packed_ = payload + sizeof(ObObjMeta) + sizeof(int64_t);
+        break;
+      }
+      case OB_COLUMN_ENCODING_PREFIX: {
+        uint32_t prefix_len = 0;
+        MEMCPY(&ctx.meta_, payload, sizeof(ObObjMeta));
+        MEMCPY(&prefix_len, payload + sizeof(ObObjMeta), sizeof(uint32_t));
+        ctx.prefix_len_ = prefix_len;
+        ctx.prefix_ = payload + sizeof(ObObjMeta) + sizeof(uint32_t);
+        ctx.suffix_offsets_ = reinterpret_cast<const uint32_t*>(ctx.prefix_ + prefix_len);
+        ctx.suffixes_ = reinterpret_cast<const char*>(ctx.suffix_offsets_ + col_header.count_ + 1);
+        break;
+      }
+      default:
+        ret = OB_NOT_SUPPORTED;
+        STORAGE_LOG(WARN, "not supported column encoding", K(ret), K(col_header));
+    }
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::read_value(
+    const ObColumnDecoderCtx& ctx, const int64_t value_idx, ObObj& cell) const
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  const uint32_t offset = ctx.value_offsets_[value_idx];
+  const int64_t len = ctx.value_offsets_[value_idx + 1] - offset;
+  if (OB_FAIL(cell.deserialize(ctx.values_ + offset, len, pos))) {
+    STORAGE_LOG(WARN, "fail to deserialize cell", K(ret), K(value_idx), K(len));
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::decode_cell(
+    const int64_t col_idx, const int64_t row_idx, ObIAllocator& allocator, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= header_->column_count_ || row_idx < 0 || row_idx >= end_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(col_idx), K(row_idx), K(header_->column_count_), K_(end));
+  } else {
+    const ObColumnDecoderCtx& ctx = column_ctxs_[col_idx];
+    const ObColumnEncodingHeader& col_header = *ctx.header_;
+    switch (col_header.type_) {
+      case OB_COLUMN_ENCODING_RAW:
+        ret = read_value(ctx, row_idx, cell);
+        break;
+      case OB_COLUMN_ENCODING_CONST:
+        ret = read_value(ctx, 0, cell);
+        break;
+      case OB_COLUMN_ENCODING_DICT:
+        ret = read_value(ctx, read_packed(ctx.packed_, row_idx, col_header.packed_bytes_), cell);
+        break;
+      case OB_COLUMN_ENCODING_RLE: {
+        const uint32_t* run = std::upper_bound(
+            ctx.run_starts_, ctx.run_starts_ + col_header.count_, static_cast<uint32_t>(row_idx));
+        ret = read_value(ctx, run - ctx.run_starts_ - 1, cell);
+        break;
+      }
+      case OB_COLUMN_ENCODING_INT_DELTA: {
+        const uint64_t delta = read_packed(ctx.packed_, row_idx, col_header.packed_bytes_);
+        set_int_delta_value(ctx.meta_, static_cast<int64_t>(static_cast<uint64_t>(ctx.base_) + delta), cell);
+        break;
+      }
+      case OB_COLUMN_ENCODING_PREFIX: {
+        const uint32_t offset = ctx.suffix_offsets_[row_idx];
+        const int64_t suffix_len = ctx.suffix_offsets_[row_idx + 1] - offset;
+        const int64_t len = ctx.prefix_len_ + suffix_len;
+        const char* ptr = NULL;
+        if (0 == suffix_len) {
+          ptr = ctx.prefix_;
+        } else if (0 == ctx.prefix_len_) {
+          ptr = ctx.suffixes_ + offset;
+        } else {
+          char* buf = static_cast<char*>(allocator.alloc(len));
+          if (OB_ISNULL(buf)) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            STORAGE_LOG(WARN, "fail to allocate string", K(ret), K(len));
+          } else {
+            MEMCPY(buf, ctx.prefix_, ctx.prefix_len_);
+            MEMCPY(buf + ctx.prefix_len_, ctx.suffixes_ + offset, suffix_len);
+            ptr = buf;
+          }
+        }
+        if (OB_SUCC(ret)) {
+          cell.set_string(ctx.meta_.get_type(), ptr, static_cast<int32_t>(len));
+          cell.set_meta_type(ctx.meta_);
+        }
+        break;
+      }
+      default:
+        ret = OB_NOT_SUPPORTED;
+        STORAGE_LOG(WARN, "not supported column encoding", K(ret), K(col_header));
+    }
+  }
+  return ret;
+}
+
+// the same type conversions ObFlatRowReader::read_obj does for altered columns
+int ObMicroBlockDecoder::cast_cell(const ObObjMeta& request_meta, ObIAllocator& allocator, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (cell.is_null() || cell.is_ext() || cell.get_type() == request_meta.get_type() || request_meta.is_raw()) {
+    // stored type is kept
+  } else {
+    const ObObj ori_obj = cell;
+    const ObObjTypeClass ori_type_class = ori_obj.get_type_class();
+    const ObObjTypeClass type_class = request_meta.get_type_class();
+    const ObObjType column_type = request_meta.get_type();
+    if (ObIntTC == ori_type_class && ObUIntTC == type_class) {
+      cell.set_uint(column_type, static_cast<uint64_t>(ori_obj.get_int()));
+    } else if (ObIntTC == ori_type_class && ObBitTC == type_class) {
+      cell.set_bit(static_cast<uint64_t>(ori_obj.get_int()));
+    } else if (ObIntTC == ori_type_class && ObEnumType == column_type) {
+      cell.set_enum(static_cast<uint64_t>(ori_obj.get_int()));
+    } else if (ObIntTC == ori_type_class && ObSetType == column_type) {
+      cell.set_set(static_cast<uint64_t>(ori_obj.get_int()));
+    } else {
+      ObCastCtx cast_ctx(&allocator, NULL, CM_NONE, request_meta.get_collation_type());
+      if (OB_FAIL(ObObjCaster::to_type(column_type, cast_ctx, ori_obj, cell))) {
+        STORAGE_LOG(WARN, "fail to cast obj", K(ret), K(ori_obj), K(request_meta));
+      }
+    }
+  }
+  return ret;
+}
+
+OB_INLINE void ObMicroBlockDecoder::set_row_basic_info(const int64_t index, ObStoreRow& row) const
+{
+  const ObRowHeader& row_header = row_headers_[same_row_header_ ? 0 : index];
+  row.is_sparse_row_ = false;
+  row.flag_ = row_header.get_row_flag();
+  row.set_dml_val(row_header.get_row_dml());
+  row.row_type_flag_.flag_ = row_header.get_row_type_flag();
+}
+
+int ObMicroBlockDecoder::get_row(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(get_row_impl(index, row))) {
+    STORAGE_LOG(WARN, "get row failed", K(ret), K(index));
+  } else if (0 == index) {
+    row.row_pos_flag_.set_micro_first(true);
+  } else {
+    LOG_DEBUG("get row", K(row));
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_impl(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init decoder first, ", K(ret));
+  } else if (OB_ISNULL(column_map_)) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("no column map specified", K(ret), K(row));
+  } else if (OB_UNLIKELY(index < 0 || index >= end() || !row.row_val_.is_valid() ||
+                         column_map_->get_request_count() > row.row_val_.count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(index), K(row.row_val_), K(column_map_->get_request_count()));
+  } else {
+    const int64_t column_cnt = column_map_->get_request_count();
+    const ObColumnIndexItem* column_idx = column_map_->get_column_indexs();
+    ObIAllocator& allocator = get_row_allocator();
+    set_row_basic_info(index, row);
+    row.row_val_.count_ = column_cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt; ++i) {
+      ObObj& cell = row.row_val_.cells_[i];
+      if (column_idx[i].store_index_ < 0 || column_idx[i].store_index_ >= header_->column_count_) {
+        cell.set_nop_value();
+      } else if (OB_FAIL(decode_cell(column_idx[i].store_index_, index, allocator, cell))) {
+        STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(i), K(index), K(column_idx[i]));
+      } else if (OB_FAIL(cast_cell(column_idx[i].request_column_type_, allocator, cell))) {
+        STORAGE_LOG(WARN, "fail to cast cell", K(ret), K(i), K(cell), K(column_idx[i]));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+    ObStoreRow* rows, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY((begin_index == end_index) ||
+                         (begin_index < end_index && !(begin_index >= begin() && end_index <= end())) ||
+                         (begin_index > end_index && !(end_index >= begin() - 1 && begin_index <= end() - 1)) ||
+                         NULL == rows || row_capacity <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "invalid argument",
+        K(ret),
+        K(begin_index),
+        K(end_index),
+        K(begin()),
+        K(end()),
+        KP(rows),
+        K(row_capacity));
+  } else {
+    int64_t row_pos = 0;
+    const int64_t step = begin_index < end_index ? 1 : -1;
+    for (int64_t index = begin_index; OB_SUCC(ret) && index != end_index && row_pos < row_capacity; index += step) {
+      if (OB_FAIL(get_row_impl(index, rows[row_pos]))) {
+        STORAGE_LOG(WARN, "fail to get row", K(ret), K(index), K(row_pos));
+      } else {
+        ++row_pos;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_count = row_pos;
+      rows[0].row_pos_flag_.reset();
+      if (0 == begin_index) {
+        rows[0].row_pos_flag_.set_micro_first(true);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_cell(const int64_t row_idx, const int64_t col_idx, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_ISNULL(column_map_)) {
+    ret = OB_ERR_SYS;
+    STORAGE_LOG(WARN, "no column map specified", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= column_map_->get_request_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(col_idx), K(column_map_->get_request_count()));
+  } else {
+    const ObColumnIndexItem& column_index = column_map_->get_column_indexs()[col_idx];
+    if (column_index.store_index_ < 0 || column_index.store_index_ >= header_->column_count_) {
+      cell.set_nop_value();
+    } else if (OB_FAIL(decode_cell(column_index.store_index_, row_idx, get_row_allocator(), cell))) {
+      STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(row_idx), K(column_index));
+    } else if (OB_FAIL(cast_cell(column_index.request_column_type_, get_row_allocator(), cell))) {
+      STORAGE_LOG(WARN, "fail to cast cell", K(ret), K(cell), K(column_index));
+    }
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::filter_value(const sql::ObWhiteFilterExecutor& filter,
+    const ObColumnDecoderCtx& ctx, const ObObjMeta& request_meta, const int64_t value_idx, bool& filtered)
+{
+  int ret = OB_SUCCESS;
+  ObObj cell;
+  if (OB_FAIL(read_value(ctx, value_idx, cell))) {
+    STORAGE_LOG(WARN, "fail to read value", K(ret), K(value_idx));
+  } else if (OB_FAIL(cast_cell(request_meta, allocator_, cell))) {
+    STORAGE_LOG(WARN, "fail to cast cell", K(ret), K(cell), K(request_meta));
+  } else if (OB_FAIL(filter.filter(cell, filtered))) {
+    STORAGE_LOG(WARN, "fail to filter cell", K(ret), K(cell));
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::set_filter_result(
+    const int64_t begin_pos, const int64_t end_pos, ObBitmap& result) const
+{
+  int ret = OB_SUCCESS;
+  for (int64_t pos = begin_pos; OB_SUCC(ret) && pos < end_pos; ++pos) {
+    if (OB_FAIL(result.set(pos))) {
+      STORAGE_LOG(WARN, "fail to set filter result", K(ret), K(pos));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+    const int64_t begin_idx, const int64_t end_idx, ObBitmap& result)
+{
+  int ret = OB_SUCCESS;
+  const ObColumnIndexItem* column_index = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_ISNULL(column_map_)) {
+    ret = OB_ERR_SYS;
+    STORAGE_LOG(WARN, "no column map specified", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= column_map_->get_request_count() || begin_idx < begin() ||
+                         end_idx > end() || begin_idx > end_idx || result.size() < end_idx - begin_idx)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(col_idx), K(begin_idx), K(end_idx), K(result.size()));
+  } else if (FALSE_IT(column_index = column_map_->get_column_indexs() + col_idx)) {
+  } else if (column_index->store_index_ < 0 || column_index->store_index_ >= header_->column_count_) {
+    ret = ObIMicroBlockReader::filter_pushdown_filter(filter, col_idx, begin_idx, end_idx, result);
+  } else {
+    const ObColumnDecoderCtx& ctx = column_ctxs_[column_index->store_index_];
+    const ObColumnEncodingHeader& col_header = *ctx.header_;
+    const ObObjMeta& request_meta = column_index->request_column_type_;
+    bool filtered = false;
+    switch (col_header.type_) {
+      case OB_COLUMN_ENCODING_CONST: {
+        if (OB_FAIL(filter_value(filter, ctx, request_meta, 0, filtered))) {
+        } else if (!filtered) {
+          ret = set_filter_result(0, end_idx - begin_idx, result);
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_DICT: {
+        if (col_header.count_ > end_idx - begin_idx) {
+          // more distinct values than rows to filter
+          ret = ObIMicroBlockReader::filter_pushdown_filter(filter, col_idx, begin_idx, end_idx, result);
+        } else {
+          bool* value_filtered = static_cast<bool*>(allocator_.alloc(sizeof(bool) * col_header.count_));
+          if (OB_ISNULL(value_filtered)) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K(col_header));
+          }
+          for (int64_t i = 0; OB_SUCC(ret) && i < col_header.count_; ++i) {
+            ret = filter_value(filter, ctx, request_meta, i, value_filtered[i]);
+          }
+          for (int64_t row_idx = begin_idx; OB_SUCC(ret) && row_idx < end_idx; ++row_idx) {
+            if (!value_filtered[read_packed(ctx.packed_, row_idx, col_header.packed_bytes_)]) {
+              ret = result.set(row_idx - begin_idx);
+            }
+          }
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_RLE: {
+        // runs overlapped with [begin_idx, end_idx)
+        const uint32_t* run = std::upper_bound(
+            ctx.run_starts_, ctx.run_starts_ + col_header.count_, static_cast<uint32_t>(begin_idx));
+        for (int64_t run_idx = run - ctx.run_starts_ - 1;
+             OB_SUCC(ret) && run_idx < col_header.count_ && ctx.run_starts_[run_idx] < end_idx;
+             ++run_idx) {
+          const int64_t run_end = run_idx + 1 < col_header.count_ ? ctx.run_starts_[run_idx + 1] : end_;
+          if (OB_FAIL(filter_value(filter, ctx, request_meta, run_idx, filtered))) {
+          } else if (!filtered) {
+            ret = set_filter_result(std::max(begin_idx, static_cast<int64_t>(ctx.run_starts_[run_idx])) - begin_idx,
+                std::min(end_idx, run_end) - begin_idx,
+                result);
+          }
+        }
+        break;
+      }
+      default:
+        ret = ObIMicroBlockReader::filter_pushdown_filter(filter, col_idx, begin_idx, end_idx, result);
+        break;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_full_row(const int64_t index, const ObObjMeta* column_types, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  const int64_t column_cnt = row.row_val_.count_;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(index < 0 || index >= end() || NULL == column_types || NULL == row.row_val_.cells_ ||
+                         column_cnt <= 0 || column_cnt > header_->column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(index), KP(column_types), K(row.row_val_));
+  } else {
+    ObIAllocator& allocator = get_row_allocator();
+    set_row_basic_info(index, row);
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt; ++i) {
+      if (OB_FAIL(decode_cell(i, index, allocator, row.row_val_.cells_[i]))) {
+        STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(i), K(index));
+      } else if (OB_FAIL(cast_cell(column_types[i], allocator, row.row_val_.cells_[i]))) {
+        STORAGE_LOG(WARN, "fail to cast cell", K(ret), K(i), K(row.row_val_.cells_[i]));
+      }
+    }
+  }
+  return ret;
+}
+
+// compare with the column meta like ObFlatRowReader::compare_meta_rowkey, the stored meta is only
+// used when the decoder is inited without column map
+int ObMicroBlockDecoder::compare_rowkey(const int64_t row_idx, const ObStoreRowkey& key, int32_t& cmp_result)
+{
+  int ret = OB_SUCCESS;
+  ObObj cell;
+  cmp_result = 0;
+  int64_t compare_column_count = std::min(key.get_obj_cnt(), static_cast<int64_t>(header_->column_count_));
+  int64_t version_column_index = -1;
+  int64_t sql_sequence_index = -1;
+  const ObColumnIndexItem* items = NULL;
+  if (NULL != column_map_) {
+    const int64_t schema_rowkey_count = column_map_->get_rowkey_store_count();
+    const int64_t extra_multi_version_col_cnt = column_map_->get_multi_version_rowkey_cnt();
+    compare_column_count = std::min(compare_column_count, schema_rowkey_count + extra_multi_version_col_cnt);
+    version_column_index = ObMultiVersionRowkeyHelpper::get_trans_version_col_store_index(
+        schema_rowkey_count, extra_multi_version_col_cnt);
+    sql_sequence_index =
+        ObMultiVersionRowkeyHelpper::get_sql_sequence_col_store_index(schema_rowkey_count, extra_multi_version_col_cnt);
+    items = column_map_->get_column_indexs();
+  }
+  for (int64_t i = 0; 0 == cmp_result && OB_SUCC(ret) && i < compare_column_count; ++i) {
+    if (OB_FAIL(decode_cell(i, row_idx, allocator_, cell))) {
+      STORAGE_LOG(WARN, "fail to decode rowkey cell", K(ret), K(i), K(row_idx));
+    } else if (NULL != items && version_column_index != i && sql_sequence_index != i &&
+               OB_FAIL(cast_cell(items[i].get_obj_meta(), allocator_, cell))) {
+      STORAGE_LOG(WARN, "fail to cast rowkey cell", K(ret), K(i), K(cell), K(items[i]));
+    } else {
+      if (NULL != items && version_column_index != i && sql_sequence_index != i && cell.is_string_type()) {
+        cell.set_collation_type(items[i].get_obj_meta().get_collation_type());
+      }
+      cmp_result = cell.compare(key.get_obj_ptr()[i], CS_TYPE_INVALID);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::find_bound(const ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+    const int64_t end_idx, int64_t& row_idx, bool& equal)
+{
+  int ret = OB_SUCCESS;
+  equal = false;
+  row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!key.is_valid() || begin_idx < begin() || end_idx > end())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), K(begin_idx), K(begin()), K(end_idx), K(end()));
+  } else {
+    int64_t low = begin_idx;
+    int64_t high = end_idx;
+    int32_t cmp_result = 0;
+    while (OB_SUCC(ret) && low < high) {
+      const int64_t mid = low + (high - low) / 2;
+      if (OB_FAIL(compare_rowkey(mid, key, cmp_result))) {
+        LOG_WARN("fail to compare rowkey", K(ret), K(mid));
+      } else {
+        if (0 == cmp_result) {
+          equal = true;
+        }
+        if (lower_bound ? cmp_result < 0 : cmp_result <= 0) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_idx = low;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_count(int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else {
+    row_count = header_->row_count_;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_header(const int64_t row_idx, const ObRowHeader*& row_header)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "decoder not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < 0 || row_idx >= end())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid row index", K(ret), K(row_idx), K(end()));
+  } else {
+    row_header = &row_headers_[same_row_header_ ? 0 : row_idx];
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+    const int64_t sql_sequence_idx, ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+    int64_t& trans_version, int64_t& sql_sequence)
+{
+  int ret = OB_SUCCESS;
+  const ObRowHeader* row_header = NULL;
+  UNUSED(trans_id);  // encoded blocks are written by major merge only, no trans id is stored
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(version_column_idx < 0 || version_column_idx >= header_->column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(version_column_idx), K(header_->column_count_));
+  } else if (OB_FAIL(get_row_header(row_idx, row_header))) {
+    LOG_WARN("fail to get row header", K(ret), K(row_idx));
+  } else {
+    ObObj cell;
+    flag.flag_ = row_header->get_row_type_flag();
+    if (!flag.is_uncommitted_row()) {
+      sql_sequence = 0;
+      if (OB_FAIL(decode_cell(version_column_idx, row_idx, allocator_, cell))) {
+        LOG_WARN("fail to decode version column", K(ret), K(row_idx));
+      } else if (OB_FAIL(cell.get_int(trans_version))) {
+        LOG_WARN("fail to convert version cell to int", K(ret), K(cell));
+      } else {
+        trans_version = -trans_version;
+      }
+    } else {
+      trans_version = INT64_MAX;
+      if (sql_sequence_idx < 0) {
+        sql_sequence = 0;
+      } else if (OB_FAIL(decode_cell(sql_sequence_idx, row_idx, allocator_, cell))) {
+        LOG_WARN("fail to decode sql sequence column", K(ret), K(row_idx));
+      } else if (OB_FAIL(cell.get_int(sql_sequence))) {
+        LOG_WARN("fail to convert sql sequence cell to int", K(ret), K(cell));
+      } else {
+        sql_sequence = -sql_sequence;
+      }
+    }
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------ObEncodeBlockGetReader--------------------------------------------------------------
+ */
+ObEncodeBlockGetReader::ObEncodeBlockGetReader() : decoder_(), allocator_(ObModIds::OB_STORE_ROW_GETTER)
+{
+  decoder_.set_row_allocator(&allocator_);
+}
+
+ObEncodeBlockGetReader::~ObEncodeBlockGetReader()
+{}
+
+int ObEncodeBlockGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+    const ObSSTableRowkeyHelper* rowkey_helper, ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  UNUSED(macro_meta);
+  UNUSED(rowkey_helper);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  allocator_.reuse();
+  if (OB_FAIL(decoder_.init(block_data, &column_map))) {
+    STORAGE_LOG(WARN, "fail to init decoder", K(ret), K(block_data));
+  } else if (OB_FAIL(decoder_.locate_rowkey(rowkey, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      STORAGE_LOG(WARN, "fail to locate row", K(ret), K(rowkey));
+    }
+  } else if (OB_FAIL(decoder_.get_row(row_idx, row))) {
+    STORAGE_LOG(WARN, "fail to get row", K(ret), K(rowkey), K(row_idx));
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta, const ObSSTableRowkeyHelper* rowkey_helper,
+    ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  UNUSED(rowkey_helper);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  allocator_.reuse();
+  if (OB_FAIL(decoder_.init(block_data))) {
+    STORAGE_LOG(WARN, "fail to init decoder", K(ret), K(block_data));
+  } else if (OB_FAIL(decoder_.locate_rowkey(rowkey, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      STORAGE_LOG(WARN, "fail to locate row", K(ret), K(rowkey));
+    }
+  } else {
+    row.row_val_.count_ = macro_meta.meta_->column_number_;
+    if (OB_FAIL(decoder_.get_full_row(row_idx, macro_meta.schema_->column_type_array_, row))) {
+      STORAGE_LOG(WARN, "fail to read full row", K(ret), K(rowkey), K(row_idx));
+    }
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta, const ObSSTableRowkeyHelper* rowkey_helper,
+    bool& exist, bool& found)
+{
+  UNUSED(tenant_id);
+  UNUSED(macro_meta);
+  UNUSED(rowkey_helper);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  const ObRowHeader* row_header = NULL;
+  exist = false;
+  found = false;
+  if (OB_FAIL(decoder_.init(block_data))) {
+    STORAGE_LOG(WARN, "fail to init decoder", K(ret), K(block_data));
+  } else if (OB_FAIL(decoder_.locate_rowkey(rowkey, row_idx))) {
+    if (OB_BEYOND_THE_RANGE == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      STORAGE_LOG(WARN, "fail to locate row", K(ret), K(rowkey));
+    }
+  } else if (OB_FAIL(decoder_.get_row_header(row_idx, row_header))) {
+    STORAGE_LOG(WARN, "fail to get row header", K(ret), K(row_idx));
+  } else {
+    exist = ObActionFlag::OP_DEL_ROW != row_header->get_row_flag();
+    found = true;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "ob_block_sstable_struct.h"
+#include "ob_imicro_block_reader.h"
+#include "ob_column_encoding_struct.h"
+
+namespace oceanbase {
+namespace storage {
+class ObStoreRow;
+}
+namespace blocksstable {
+class ObColumnMap;
+
+// decoding context of one column, parsed from ObColumnEncodingHeader at init
+struct ObColumnDecoderCtx {
+  ObColumnDecoderCtx()
+  {
+    MEMSET(this, 0, sizeof(*this));
+  }
+  const ObColumnEncodingHeader* header_;
+  // value table of RAW / CONST / DICT / RLE
+  const uint32_t* value_offsets_;
+  const char* values_;
+  // DICT refs or INT_DELTA deltas
+  const char* packed_;
+  // RLE
+  const uint32_t* run_starts_;
+  // INT_DELTA / PREFIX
+  common::ObObjMeta meta_;
+  int64_t base_;
+  const char* prefix_;
+  int64_t prefix_len_;
+  const uint32_t* suffix_offsets_;
+  const char* suffixes_;
+  TO_STRING_KV(KPC_(header), K_(base), K_(prefix_len));
+};
+
+// Reader of the micro blocks written by ObMicroBlockEncoder.
+// Cells are decoded column by column on demand, only FLAT_ROW_STORE output is supported.
+class ObMicroBlockDecoder : public ObIMicroBlockReader {
+  public:
+  ObMicroBlockDecoder();
+  virtual ~ObMicroBlockDecoder();
+  virtual int init(const ObMicroBlockData& block_data, const ObColumnMap* column_map,
+      const common::ObRowStoreType out_type = common::FLAT_ROW_STORE) override;
+  // init without column map, only get_full_row and locate_rowkey are available
+  int init(const ObMicroBlockData& block_data);
+  virtual void reset() override;
+  virtual int get_row(const int64_t index, storage::ObStoreRow& row) override;
+  virtual int get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+      storage::ObStoreRow* rows, int64_t& row_count) override;
+  virtual int get_row_count(int64_t& row_count) override;
+  virtual int get_row_header(const int64_t row_idx, const ObRowHeader*& row_header) override;
+  virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+      const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+      int64_t& version, int64_t& sql_sequence) override;
+  virtual int get_cell(const int64_t row_idx, const int64_t col_idx, common::ObObj& cell) override;
+  // CONST / DICT / RLE columns are filtered by the distinct values instead of row by row
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_idx, const int64_t end_idx, common::ObBitmap& result) override;
+  // read all stored columns, cast to column_types like ObFlatRowReader::read_full_row
+  int get_full_row(const int64_t index, const common::ObObjMeta* column_types, storage::ObStoreRow& row);
+  // decode one cell with the stored type, strings rebuilt from PREFIX columns are allocated from allocator
+  int decode_cell(
+      const int64_t col_idx, const int64_t row_idx, common::ObIAllocator& allocator, common::ObObj& cell);
+  // cells of the returned rows are allocated from allocator, which must outlive the rows,
+  // the decoder's own allocator is reused on init and only used when no row allocator is set
+  void set_row_allocator(common::ObIAllocator* allocator)
+  {
+    row_allocator_ = allocator;
+  }
+
+  static bool is_encoding_block(const ObMicroBlockData& block_data);
+
+  protected:
+  virtual int find_bound(const common::ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+      const int64_t end_idx, int64_t& row_idx, bool& equal) override;
+
+  private:
+  int base_init(const ObMicroBlockData& block_data);
+  int init_column_ctx(const ObColumnEncodingHeader& col_header, ObColumnDecoderCtx& ctx);
+  int get_row_impl(const int64_t index, storage::ObStoreRow& row);
+  int read_value(const ObColumnDecoderCtx& ctx, const int64_t value_idx, common::ObObj& cell) const;
+  int cast_cell(const common::ObObjMeta& request_meta, common::ObIAllocator& allocator, common::ObObj& cell);
+  OB_INLINE common::ObIAllocator& get_row_allocator()
+  {
+    return NULL == row_allocator_ ? allocator_ : *row_allocator_;
+  }
+  int filter_value(const sql::ObWhiteFilterExecutor& filter, const ObColumnDecoderCtx& ctx,
+      const common::ObObjMeta& request_meta, const int64_t value_idx, bool& filtered);
+  int set_filter_result(const int64_t begin_pos, const int64_t end_pos, common::ObBitmap& result) const;
+  int compare_rowkey(const int64_t row_idx, const common::ObStoreRowkey& key, int32_t& cmp_result);
+  void set_row_basic_info(const int64_t index, storage::ObStoreRow& row) const;
+
+  private:
+  const ObMicroBlockHeader* header_;
+  const char* block_buf_;
+  int64_t block_size_;
+  const ObRowHeader* row_headers_;
+  bool same_row_header_;
+  ObColumnDecoderCtx* column_ctxs_;
+  common::ObArenaAllocator allocator_;
+  common::ObIAllocator* row_allocator_;
+};
+
+class ObEncodeBlockGetReader : public ObIMicroBlockGetReader {
+  public:
+  ObEncodeBlockGetReader();
+  virtual ~ObEncodeBlockGetReader();
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, storage::ObStoreRow& row) override;
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObFullMacroBlockMeta& macro_meta, const storage::ObSSTableRowkeyHelper* rowkey_helper,
+      storage::ObStoreRow& row) override;
+  virtual int exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+      const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, bool& exist, bool& found) override;
+
+  private:
+  ObMicroBlockDecoder decoder_;
+  // cells of the got row, valid until the next get
+  common::ObArenaAllocator allocator_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
@@ -0,0 +1,695 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_micro_block_encoder.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "common/row/ob_row.h"
+#include "storage/ob_i_store.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+ObMicroBlockEncoder::ObMicroBlockEncoder()
+    : micro_block_size_limit_(0),
+      rowkey_column_count_(0),
+      column_count_(0),
+      raw_data_size_(0),
+      expand_pct_(DEFAULT_EXPAND_PCT),
+      rows_(),
+      row_headers_(),
+      row_allocator_("MicrBlocEncoder"),
+      encode_allocator_("MicrBlocEncoder"),
+      data_buffer_(0, "MicrBlocEncoder", false),
+      col_buffer_(0, "MicrBlocEncoder", false),
+      rowkey_buffer_(0, "MicrBlocEncoder", false),
+      row_writer_(),
+      last_rowkey_length_(0),
+      encoding_types_(NULL),
+      is_inited_(false)
+{}
+
+ObMicroBlockEncoder::~ObMicroBlockEncoder()
+{}
+
+int ObMicroBlockEncoder::init(
+    const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_FAIL(check_input_param(micro_block_size_limit, rowkey_column_count, column_count))) {
+    STORAGE_LOG(WARN,
+        "micro block encoder fail to check input param.",
+        K(ret),
+        K(micro_block_size_limit),
+        K(rowkey_column_count),
+        K(column_count));
+  } else if (OB_FAIL(data_buffer_.ensure_space(DEFAULT_DATA_BUFFER_SIZE))) {
+    STORAGE_LOG(WARN, "data buffer fail to ensure space.", K(ret));
+  } else {
+    micro_block_size_limit_ = micro_block_size_limit;
+    rowkey_column_count_ = rowkey_column_count;
+    column_count_ = column_count;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::check_input_param(
+    const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count) const
+{
+  int ret = OB_SUCCESS;
+  if (micro_block_size_limit <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid micro block encoder input argument.", K(ret), K(micro_block_size_limit));
+  } else if (rowkey_column_count <= 0 || column_count <= 0 || column_count < rowkey_column_count) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid micro block encoder input argument.", K(ret), K(rowkey_column_count), K(column_count));
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::append_row(const ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  ObObj* cells = NULL;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init encoder before append row", K(ret));
+  } else if (!row.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "row was invalid", K(ret), K(row));
+  } else if (row.is_sparse_row_ || row.row_val_.count_ != column_count_) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "append row is not consistent with init column count.",
+        K(ret),
+        K_(column_count),
+        K(row.row_val_.count_),
+        K(row.is_sparse_row_));
+  } else {
+    const int64_t row_size = calc_row_size(row);
+    if (is_exceed_limit(row_size)) {
+      STORAGE_LOG(DEBUG,
+          "micro block exceed limit",
+          K(row_size),
+          "row_count",
+          rows_.count(),
+          K(get_block_size()),
+          K_(micro_block_size_limit));
+      ret = OB_BUF_NOT_ENOUGH;
+    } else if (OB_FAIL(copy_row(row, cells))) {
+      STORAGE_LOG(WARN, "fail to copy row", K(ret), K(row));
+    } else if (OB_FAIL(rows_.push_back(cells))) {
+      STORAGE_LOG(WARN, "fail to push back row", K(ret));
+    } else {
+      ObRowHeader row_header;
+      row_header.set_row_flag(static_cast<int8_t>(row.flag_));
+      row_header.set_row_dml(row.get_dml_val());
+      row_header.set_version(ObRowHeader::RHV_NO_TRANS_ID);
+      row_header.set_row_type_flag(row.row_type_flag_.flag_);
+      row_header.set_column_count(static_cast<int16_t>(column_count_));
+      if (OB_FAIL(row_headers_.push_back(row_header))) {
+        STORAGE_LOG(WARN, "fail to push back row header", K(ret));
+        rows_.pop_back();
+      } else {
+        raw_data_size_ += row_size;
+        cal_delta(row);
+        if (need_cal_row_checksum()) {
+          micro_block_checksum_ = cal_row_checksum(row, micro_block_checksum_);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObMicroBlockEncoder::calc_row_size(const ObStoreRow& row) const
+{
+  // every cell costs its serialized size plus one value table offset in the worst (RAW) case
+  int64_t row_size = sizeof(ObRowHeader);
+  for (int64_t i = 0; i < row.row_val_.count_; ++i) {
+    row_size += row.row_val_.cells_[i].get_serialize_size() + ROW_INDEX_OVERHEAD;
+  }
+  return row_size;
+}
+
+int ObMicroBlockEncoder::copy_row(const ObStoreRow& row, ObObj*& cells)
+{
+  int ret = OB_SUCCESS;
+  void* buf = NULL;
+  if (OB_ISNULL(buf = row_allocator_.alloc(sizeof(ObObj) * column_count_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate row cells", K(ret), K_(column_count));
+  } else {
+    cells = new (buf) ObObj[column_count_];
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      if (OB_FAIL(ob_write_obj(row_allocator_, row.row_val_.cells_[i], cells[i]))) {
+        STORAGE_LOG(WARN, "fail to deep copy cell", K(ret), K(i), K(row.row_val_.cells_[i]));
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObMicroBlockEncoder::is_exceed_limit(const int64_t row_size) const
+{
+  return rows_.count() > 0 && (rows_.count() >= MAX_MICRO_BLOCK_ROW_COUNT ||
+                                  get_block_size() + row_size * expand_pct_ / 100 > micro_block_size_limit_);
+}
+
+int64_t ObMicroBlockEncoder::get_block_size() const
+{
+  return sizeof(ObMicroBlockHeader) + column_count_ * sizeof(ObColumnEncodingHeader) +
+         raw_data_size_ * expand_pct_ / 100;
+}
+
+int64_t ObMicroBlockEncoder::get_row_count() const
+{
+  return rows_.count();
+}
+
+int64_t ObMicroBlockEncoder::get_data_size() const
+{
+  // the encoded size is only known after build_block
+  return data_buffer_.length() > 0 ? data_buffer_.length() : get_block_size();
+}
+
+int64_t ObMicroBlockEncoder::get_column_count() const
+{
+  return column_count_;
+}
+
+ObString ObMicroBlockEncoder::get_last_rowkey() const
+{
+  return ObString(0, static_cast<int32_t>(last_rowkey_length_), rowkey_buffer_.data());
+}
+
+int ObMicroBlockEncoder::reserve(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (data_buffer_.remain() < size && OB_FAIL(data_buffer_.expand(size))) {
+    STORAGE_LOG(WARN, "data buffer fail to expand.", K(ret), K(size));
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_block(char*& buf, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t header_size = sizeof(ObMicroBlockHeader);
+  const int64_t col_headers_size = column_count_ * sizeof(ObColumnEncodingHeader);
+  int64_t row_headers_offset = header_size + col_headers_size;
+  bool same_row_header = false;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init encoder before build block", K(ret));
+  } else if (rows_.count() <= 0) {
+    ret = OB_INNER_STAT_ERROR;
+    STORAGE_LOG(WARN, "micro block encoder is empty", K(ret));
+  } else {
+    encode_allocator_.reuse();
+    data_buffer_.reuse();
+    if (OB_ISNULL(encoding_types_ = static_cast<ObColumnEncodingType*>(
+                      encode_allocator_.alloc(sizeof(ObColumnEncodingType) * column_count_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      STORAGE_LOG(WARN, "fail to allocate encoding types", K(ret), K_(column_count));
+    } else if (OB_FAIL(reserve(row_headers_offset))) {
+    } else if (OB_FAIL(data_buffer_.advance_zero(row_headers_offset))) {
+      STORAGE_LOG(WARN, "data buffer fail to reserve headers.", K(ret), K(row_headers_offset));
+    } else if (OB_FAIL(build_row_headers(same_row_header))) {
+      STORAGE_LOG(WARN, "fail to build row headers", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      ColumnValues values;
+      ObColumnEncodingHeader col_header;
+      if (OB_FAIL(prepare_column_values(i, values))) {
+        STORAGE_LOG(WARN, "fail to prepare column values", K(ret), K(i));
+      } else if (OB_FAIL(choose_encoding(i, values, encoding_types_[i]))) {
+        STORAGE_LOG(WARN, "fail to choose column encoding", K(ret), K(i));
+      } else if (OB_FAIL(encode_column(i, values, encoding_types_[i], col_header))) {
+        STORAGE_LOG(WARN, "fail to encode column", K(ret), K(i), "type", encoding_types_[i]);
+      } else {
+        MEMCPY(data_buffer_.data() + header_size + i * sizeof(ObColumnEncodingHeader),
+            &col_header,
+            sizeof(ObColumnEncodingHeader));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (OB_FAIL(build_last_rowkey())) {
+        STORAGE_LOG(WARN, "fail to build last rowkey", K(ret));
+      } else {
+        ObMicroBlockHeader* header = reinterpret_cast<ObMicroBlockHeader*>(data_buffer_.data());
+        header->header_size_ = static_cast<int32_t>(header_size);
+        header->version_ = ENCODING_MICRO_BLOCK_HEADER_VERSION;
+        header->magic_ = ENCODING_MICRO_BLOCK_HEADER_MAGIC;
+        header->attr_ = same_row_header ? ENCODING_ATTR_SAME_ROW_HEADER : 0;
+        header->column_count_ = static_cast<int32_t>(column_count_);
+        header->row_index_offset_ = static_cast<int32_t>(row_headers_offset);
+        header->row_count_ = static_cast<int32_t>(rows_.count());
+
+        const int64_t encoded_size = data_buffer_.length() - row_headers_offset;
+        expand_pct_ = std::min(DEFAULT_EXPAND_PCT, std::max(MIN_EXPAND_PCT, encoded_size * 100 / raw_data_size_ + 1));
+        buf = data_buffer_.data();
+        size = data_buffer_.length();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_row_headers(bool& same_row_header)
+{
+  int ret = OB_SUCCESS;
+  same_row_header = true;
+  for (int64_t i = 1; same_row_header && i < row_headers_.count(); ++i) {
+    same_row_header = 0 == MEMCMP(&row_headers_.at(0), &row_headers_.at(i), sizeof(ObRowHeader));
+  }
+  const int64_t write_count = same_row_header ? 1 : row_headers_.count();
+  for (int64_t i = 0; OB_SUCC(ret) && i < write_count; ++i) {
+    if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(&row_headers_.at(i)), sizeof(ObRowHeader)))) {
+      STORAGE_LOG(WARN, "fail to write row header", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_last_rowkey()
+{
+  int ret = OB_SUCCESS;
+  ObNewRow rowkey;
+  rowkey.cells_ = rows_.at(rows_.count() - 1);
+  rowkey.count_ = rowkey_column_count_;
+  int64_t buf_size = std::max(rowkey_buffer_.capacity(), static_cast<int64_t>(OB_MAX_ROW_KEY_LENGTH));
+  last_rowkey_length_ = 0;
+  rowkey_buffer_.reuse();
+  do {
+    int64_t pos = 0;
+    if (OB_FAIL(rowkey_buffer_.ensure_space(buf_size))) {
+      STORAGE_LOG(WARN, "rowkey buffer fail to ensure space.", K(ret), K(buf_size));
+    } else if (OB_FAIL(row_writer_.write(rowkey, rowkey_buffer_.data(), buf_size, FLAT_ROW_STORE, pos))) {
+      if (OB_BUF_NOT_ENOUGH != ret) {
+        STORAGE_LOG(WARN, "fail to write last rowkey", K(ret), K(rowkey));
+      } else {
+        buf_size *= 2;
+      }
+    } else {
+      last_rowkey_length_ = pos;
+    }
+  } while (OB_BUF_NOT_ENOUGH == ret);
+  return ret;
+}
+
+int ObMicroBlockEncoder::prepare_column_values(const int64_t col_idx, ColumnValues& values)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  int64_t bucket_count = 1;
+  while (bucket_count < row_count * 2) {
+    bucket_count <<= 1;
+  }
+  int32_t* buckets = NULL;
+  col_buffer_.reuse();
+  if (OB_ISNULL(values.offsets_ = static_cast<uint32_t*>(encode_allocator_.alloc(sizeof(uint32_t) * row_count))) ||
+      OB_ISNULL(values.refs_ = static_cast<uint32_t*>(encode_allocator_.alloc(sizeof(uint32_t) * row_count))) ||
+      OB_ISNULL(values.distinct_ = static_cast<uint32_t*>(encode_allocator_.alloc(sizeof(uint32_t) * row_count))) ||
+      OB_ISNULL(buckets = static_cast<int32_t*>(encode_allocator_.alloc(sizeof(int32_t) * bucket_count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate column values", K(ret), K(row_count));
+  } else {
+    MEMSET(buckets, -1, sizeof(int32_t) * bucket_count);
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      values.offsets_[i] = static_cast<uint32_t>(col_buffer_.length());
+      if (OB_FAIL(col_buffer_.write_serialize(rows_.at(i)[col_idx]))) {
+        STORAGE_LOG(WARN, "fail to serialize cell", K(ret), K(i), K(col_idx));
+      }
+    }
+    // distinct values are identified by their serialized bytes, so values equal only under
+    // a case insensitive collation are never merged into one dictionary entry
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      const char* ptr = value_ptr(values, i);
+      const int64_t len = value_length(values, i);
+      int64_t pos = static_cast<int64_t>(murmurhash(ptr, static_cast<int32_t>(len), 0) & (bucket_count - 1));
+      int64_t ref = -1;
+      while (buckets[pos] >= 0 && ref < 0) {
+        const int64_t first_row = values.distinct_[buckets[pos]];
+        if (len == value_length(values, first_row) && 0 == MEMCMP(ptr, value_ptr(values, first_row), len)) {
+          ref = buckets[pos];
+        } else {
+          pos = (pos + 1) & (bucket_count - 1);
+        }
+      }
+      if (ref < 0) {
+        ref = values.distinct_count_++;
+        values.distinct_[ref] = static_cast<uint32_t>(i);
+        buckets[pos] = static_cast<int32_t>(ref);
+      }
+      values.refs_[i] = static_cast<uint32_t>(ref);
+      if (0 == i || values.refs_[i] != values.refs_[i - 1]) {
+        ++values.run_count_;
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObMicroBlockEncoder::calc_value_table_size(
+    const ColumnValues& values, const uint32_t* rows, const int64_t count) const
+{
+  int64_t size = (count + 1) * sizeof(uint32_t);
+  for (int64_t i = 0; i < count; ++i) {
+    size += value_length(values, NULL == rows ? i : rows[i]);
+  }
+  return size;
+}
+
+bool ObMicroBlockEncoder::is_same_meta_column(const int64_t col_idx) const
+{
+  const ObObjMeta& meta = rows_.at(0)[col_idx].get_meta();
+  bool bret = !meta.is_null() && !meta.is_ext();
+  for (int64_t i = 1; bret && i < rows_.count(); ++i) {
+    bret = meta == rows_.at(i)[col_idx].get_meta();
+  }
+  return bret;
+}
+
+void ObMicroBlockEncoder::calc_int_delta(const int64_t col_idx, int64_t& base, uint64_t& max_delta) const
+{
+  int64_t max_value = get_int_delta_value(rows_.at(0)[col_idx]);
+  base = max_value;
+  for (int64_t i = 1; i < rows_.count(); ++i) {
+    const int64_t value = get_int_delta_value(rows_.at(i)[col_idx]);
+    if (value < base) {
+      base = value;
+    } else if (value > max_value) {
+      max_value = value;
+    }
+  }
+  max_delta = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(base);
+}
+
+int64_t ObMicroBlockEncoder::calc_prefix_len(const int64_t col_idx) const
+{
+  const ObString first = rows_.at(0)[col_idx].get_string();
+  int64_t prefix_len = first.length();
+  for (int64_t i = 1; prefix_len > 0 && i < rows_.count(); ++i) {
+    const ObString str = rows_.at(i)[col_idx].get_string();
+    int64_t len = 0;
+    const int64_t max_len = std::min(prefix_len, static_cast<int64_t>(str.length()));
+    while (len < max_len && first.ptr()[len] == str.ptr()[len]) {
+      ++len;
+    }
+    prefix_len = len;
+  }
+  return prefix_len;
+}
+
+int ObMicroBlockEncoder::choose_encoding(const int64_t col_idx, const ColumnValues& values, ObColumnEncodingType& type)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  int64_t sizes[OB_COLUMN_ENCODING_MAX];
+  for (int64_t i = 0; i < OB_COLUMN_ENCODING_MAX; ++i) {
+    sizes[i] = INT64_MAX;
+  }
+  sizes[OB_COLUMN_ENCODING_RAW] = calc_value_table_size(values, NULL, row_count);
+  if (1 == values.distinct_count_) {
+    sizes[OB_COLUMN_ENCODING_CONST] = calc_value_table_size(values, values.distinct_, 1);
+  } else {
+    sizes[OB_COLUMN_ENCODING_DICT] = calc_value_table_size(values, values.distinct_, values.distinct_count_) +
+                                     row_count * get_packed_bytes(values.distinct_count_ - 1);
+    int64_t rle_size = (values.run_count_ * 2 + 1) * sizeof(uint32_t);
+    for (int64_t i = 0; i < row_count; ++i) {
+      if (0 == i || values.refs_[i] != values.refs_[i - 1]) {
+        rle_size += value_length(values, i);
+      }
+    }
+    sizes[OB_COLUMN_ENCODING_RLE] = rle_size;
+    if (is_same_meta_column(col_idx)) {
+      const ObObjTypeClass tc = rows_.at(0)[col_idx].get_type_class();
+      if (is_int_delta_type_class(tc)) {
+        int64_t base = 0;
+        uint64_t max_delta = 0;
+        calc_int_delta(col_idx, base, max_delta);
+        sizes[OB_COLUMN_ENCODING_INT_DELTA] =
+            sizeof(ObObjMeta) + sizeof(int64_t) + row_count * get_packed_bytes(max_delta);
+      } else if (ObStringTC == tc) {
+        const int64_t prefix_len = calc_prefix_len(col_idx);
+        int64_t prefix_size = sizeof(ObObjMeta) + sizeof(uint32_t) + prefix_len + (row_count + 1) * sizeof(uint32_t);
+        for (int64_t i = 0; i < row_count; ++i) {
+          prefix_size += rows_.at(i)[col_idx].get_string_len() - prefix_len;
+        }
+        sizes[OB_COLUMN_ENCODING_PREFIX] = prefix_size;
+      }
+    }
+  }
+  // on equal size prefer the encoding which is cheaper to decode
+  static const ObColumnEncodingType candidates[] = {OB_COLUMN_ENCODING_CONST,
+      OB_COLUMN_ENCODING_INT_DELTA,
+      OB_COLUMN_ENCODING_RLE,
+      OB_COLUMN_ENCODING_DICT,
+      OB_COLUMN_ENCODING_PREFIX,
+      OB_COLUMN_ENCODING_RAW};
+  type = OB_COLUMN_ENCODING_RAW;
+  int64_t min_size = INT64_MAX;
+  for (int64_t i = 0; i < static_cast<int64_t>(ARRAYSIZEOF(candidates)); ++i) {
+    if (sizes[candidates[i]] < min_size) {
+      min_size = sizes[candidates[i]];
+      type = candidates[i];
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::encode_column(const int64_t col_idx, const ColumnValues& values,
+    const ObColumnEncodingType type, ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t offset = data_buffer_.length();
+  col_header.type_ = static_cast<uint8_t>(type);
+  switch (type) {
+    case OB_COLUMN_ENCODING_RAW:
+      ret = write_raw(values, col_header);
+      break;
+    case OB_COLUMN_ENCODING_CONST:
+      ret = write_const(values, col_header);
+      break;
+    case OB_COLUMN_ENCODING_DICT:
+      ret = write_dict(values, col_header);
+      break;
+    case OB_COLUMN_ENCODING_RLE:
+      ret = write_rle(values, col_header);
+      break;
+    case OB_COLUMN_ENCODING_INT_DELTA:
+      ret = write_int_delta(col_idx, col_header);
+      break;
+    case OB_COLUMN_ENCODING_PREFIX:
+      ret = write_prefix(col_idx, col_header);
+      break;
+    default:
+      ret = OB_NOT_SUPPORTED;
+      STORAGE_LOG(WARN, "not supported column encoding", K(ret), K(type));
+  }
+  if (OB_SUCC(ret)) {
+    col_header.offset_ = static_cast<uint32_t>(offset);
+    col_header.length_ = static_cast<uint32_t>(data_buffer_.length() - offset);
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_value_table(const ColumnValues& values, const uint32_t* rows, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = calc_value_table_size(values, rows, count);
+  if (OB_FAIL(reserve(size))) {
+  } else {
+    uint32_t* offsets = reinterpret_cast<uint32_t*>(data_buffer_.current());
+    char* data = data_buffer_.current() + (count + 1) * sizeof(uint32_t);
+    uint32_t pos = 0;
+    for (int64_t i = 0; i < count; ++i) {
+      const int64_t row_idx = NULL == rows ? i : rows[i];
+      const int64_t len = value_length(values, row_idx);
+      offsets[i] = pos;
+      MEMCPY(data + pos, value_ptr(values, row_idx), len);
+      pos += static_cast<uint32_t>(len);
+    }
+    offsets[count] = pos;
+    if (OB_FAIL(data_buffer_.advance(size))) {
+      STORAGE_LOG(WARN, "data buffer fail to advance.", K(ret), K(size));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_raw(const ColumnValues& values, ObColumnEncodingHeader& col_header)
+{
+  col_header.count_ = static_cast<uint32_t>(rows_.count());
+  return write_value_table(values, NULL, rows_.count());
+}
+
+int ObMicroBlockEncoder::write_const(const ColumnValues& values, ObColumnEncodingHeader& col_header)
+{
+  col_header.count_ = 1;
+  return write_value_table(values, values.distinct_, 1);
+}
+
+int ObMicroBlockEncoder::write_dict(const ColumnValues& values, ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  const int64_t packed_bytes = get_packed_bytes(values.distinct_count_ - 1);
+  col_header.count_ = static_cast<uint32_t>(values.distinct_count_);
+  col_header.packed_bytes_ = static_cast<uint8_t>(packed_bytes);
+  if (OB_FAIL(write_value_table(values, values.distinct_, values.distinct_count_))) {
+    STORAGE_LOG(WARN, "fail to write dict values", K(ret));
+  } else if (OB_FAIL(reserve(row_count * packed_bytes))) {
+  } else {
+    for (int64_t i = 0; i < row_count; ++i) {
+      write_packed(data_buffer_.current(), i, packed_bytes, values.refs_[i]);
+    }
+    if (OB_FAIL(data_buffer_.advance(row_count * packed_bytes))) {
+      STORAGE_LOG(WARN, "data buffer fail to advance.", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_rle(const ColumnValues& values, ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  uint32_t* run_starts = NULL;
+  if (OB_ISNULL(
+          run_starts = static_cast<uint32_t*>(encode_allocator_.alloc(sizeof(uint32_t) * values.run_count_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate run starts", K(ret), K(values.run_count_));
+  } else {
+    int64_t run_idx = 0;
+    for (int64_t i = 0; i < rows_.count(); ++i) {
+      if (0 == i || values.refs_[i] != values.refs_[i - 1]) {
+        run_starts[run_idx++] = static_cast<uint32_t>(i);
+      }
+    }
+    col_header.count_ = static_cast<uint32_t>(values.run_count_);
+    // the first row of each run is both the run start and the row its value is taken from
+    if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(run_starts), sizeof(uint32_t) * values.run_count_))) {
+      STORAGE_LOG(WARN, "fail to write run starts", K(ret));
+    } else if (OB_FAIL(write_value_table(values, run_starts, values.run_count_))) {
+      STORAGE_LOG(WARN, "fail to write run values", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_int_delta(const int64_t col_idx, ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  const ObObjMeta meta = rows_.at(0)[col_idx].get_meta();
+  int64_t base = 0;
+  uint64_t max_delta = 0;
+  calc_int_delta(col_idx, base, max_delta);
+  const int64_t packed_bytes = get_packed_bytes(max_delta);
+  col_header.count_ = static_cast<uint32_t>(row_count);
+  col_header.packed_bytes_ = static_cast<uint8_t>(packed_bytes);
+  if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(&meta), sizeof(meta)))) {
+    STORAGE_LOG(WARN, "fail to write meta", K(ret));
+  } else if (OB_FAIL(data_buffer_.write_pod(base))) {
+    STORAGE_LOG(WARN, "fail to write base", K(ret));
+  } else if (OB_FAIL(reserve(row_count * packed_bytes))) {
+  } else {
+    for (int64_t i = 0; i < row_count; ++i) {
+      const uint64_t delta =
+          static_cast<uint64_t>(get_int_delta_value(rows_.at(i)[col_idx])) - static_cast<uint64_t>(base);
+      write_packed(data_buffer_.current(), i, packed_bytes, delta);
+    }
+    if (OB_FAIL(data_buffer_.advance(row_count * packed_bytes))) {
+      STORAGE_LOG(WARN, "data buffer fail to advance.", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_prefix(const int64_t col_idx, ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  const ObObjMeta meta = rows_.at(0)[col_idx].get_meta();
+  const int64_t prefix_len = calc_prefix_len(col_idx);
+  const uint32_t prefix_len32 = static_cast<uint32_t>(prefix_len);
+  int64_t suffix_size = 0;
+  for (int64_t i = 0; i < row_count; ++i) {
+    suffix_size += rows_.at(i)[col_idx].get_string_len() - prefix_len;
+  }
+  const int64_t table_size = (row_count + 1) * sizeof(uint32_t) + suffix_size;
+  col_header.count_ = static_cast<uint32_t>(row_count);
+  if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(&meta), sizeof(meta)))) {
+    STORAGE_LOG(WARN, "fail to write meta", K(ret));
+  } else if (OB_FAIL(data_buffer_.write_pod(prefix_len32))) {
+    STORAGE_LOG(WARN, "fail to write prefix length", K(ret));
+  } else if (prefix_len > 0 && OB_FAIL(data_buffer_.write(rows_.at(0)[col_idx].get_string_ptr(), prefix_len))) {
+    STORAGE_LOG(WARN, "fail to write prefix", K(ret));
+  } else if (OB_FAIL(reserve(table_size))) {
+  } else {
+    uint32_t* offsets = reinterpret_cast<uint32_t*>(data_buffer_.current());
+    char* data = data_buffer_.current() + (row_count + 1) * sizeof(uint32_t);
+    uint32_t pos = 0;
+    for (int64_t i = 0; i < row_count; ++i) {
+      const ObObj& cell = rows_.at(i)[col_idx];
+      const int64_t len = cell.get_string_len() - prefix_len;
+      offsets[i] = pos;
+      MEMCPY(data + pos, cell.get_string_ptr() + prefix_len, len);
+      pos += static_cast<uint32_t>(len);
+    }
+    offsets[row_count] = pos;
+    if (OB_FAIL(data_buffer_.advance(table_size))) {
+      STORAGE_LOG(WARN, "data buffer fail to advance.", K(ret), K(table_size));
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockEncoder::reuse()
+{
+  ObIMicroBlockWriter::reuse();
+  raw_data_size_ = 0;
+  rows_.reuse();
+  row_headers_.reuse();
+  row_allocator_.reuse();
+  data_buffer_.reuse();
+  col_buffer_.reuse();
+  last_rowkey_length_ = 0;
+}
+
+void ObMicroBlockEncoder::reset()
+{
+  ObIMicroBlockWriter::reuse();
+  micro_block_size_limit_ = 0;
+  rowkey_column_count_ = 0;
+  column_count_ = 0;
+  raw_data_size_ = 0;
+  expand_pct_ = DEFAULT_EXPAND_PCT;
+  rows_.reset();
+  row_headers_.reset();
+  row_allocator_.reset();
+  encode_allocator_.reset();
+  data_buffer_.reuse();
+  col_buffer_.reuse();
+  rowkey_buffer_.reuse();
+  last_rowkey_length_ = 0;
+  encoding_types_ = NULL;
+  is_inited_ = false;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
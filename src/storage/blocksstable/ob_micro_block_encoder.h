@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_array.h"
+#include "ob_block_sstable_struct.h"
+#include "ob_data_buffer.h"
+#include "ob_row_writer.h"
+#include "ob_imicro_block_writer.h"
+#include "ob_column_encoding_struct.h"
+
+namespace oceanbase {
+namespace storage {
+class ObStoreRow;
+}
+namespace blocksstable {
+// Column-wise micro block writer for ENCODING_ROW_STORE.
+//
+// Rows are buffered (deep copied) until the block is built, then every column is
+// encoded separately with the smallest of RAW / CONST / DICT / RLE / INT_DELTA / PREFIX.
+// The last rowkey is still serialized in flat row format so that the micro block index
+// and the macro block end key stay readable by ObFlatRowReader.
+class ObMicroBlockEncoder : public ObIMicroBlockWriter {
+  static const int64_t DEFAULT_DATA_BUFFER_SIZE = common::OB_DEFAULT_MACRO_BLOCK_SIZE;
+  static const int64_t MAX_MICRO_BLOCK_ROW_COUNT = 16 * 1024;
+  // estimated encoded size = raw size * expand_pct_ / 100, adjusted after each block
+  static const int64_t DEFAULT_EXPAND_PCT = 100;
+  static const int64_t MIN_EXPAND_PCT = 20;
+  static const int64_t ROW_INDEX_OVERHEAD = sizeof(uint32_t);
+
+  public:
+  ObMicroBlockEncoder();
+  virtual ~ObMicroBlockEncoder();
+  int init(const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count);
+  virtual int append_row(const storage::ObStoreRow& row) override;
+  virtual int build_block(char*& buf, int64_t& size) override;
+  virtual void reuse() override;
+
+  virtual int64_t get_block_size() const override;
+  virtual int64_t get_row_count() const override;
+  virtual int64_t get_data_size() const override;
+  virtual int64_t get_column_count() const override;
+  virtual common::ObString get_last_rowkey() const override;
+  void reset();
+  OB_INLINE const ObColumnEncodingType* get_encoding_types() const
+  {
+    return encoding_types_;
+  }
+
+  INHERIT_TO_STRING_KV("ObIMicroBlockWriter", ObIMicroBlockWriter, K_(micro_block_size_limit), K_(column_count),
+      K_(rowkey_column_count), K_(raw_data_size), K_(expand_pct), "row_count", rows_.count(), K_(is_inited));
+
+  private:
+  // serialized cells of one column, the intermediate form all encodings are chosen from
+  struct ColumnValues {
+    ColumnValues() : offsets_(NULL), refs_(NULL), distinct_(NULL), distinct_count_(0), run_count_(0)
+    {}
+    uint32_t* offsets_;    // offsets_[row_count] into col_buffer_
+    uint32_t* refs_;       // refs_[row_count], dictionary ref of each row
+    uint32_t* distinct_;   // distinct_[distinct_count_], first row of each distinct value
+    int64_t distinct_count_;
+    int64_t run_count_;
+  };
+
+  int check_input_param(const int64_t micro_block_size_limit, const int64_t rowkey_column_count,
+      const int64_t column_count) const;
+  int64_t calc_row_size(const storage::ObStoreRow& row) const;
+  int copy_row(const storage::ObStoreRow& row, common::ObObj*& cells);
+  bool is_exceed_limit(const int64_t row_size) const;
+  int reserve(const int64_t size);
+  int build_row_headers(bool& same_row_header);
+  int build_last_rowkey();
+  int prepare_column_values(const int64_t col_idx, ColumnValues& values);
+  int choose_encoding(const int64_t col_idx, const ColumnValues& values, ObColumnEncodingType& type);
+  int encode_column(const int64_t col_idx, const ColumnValues& values, const ObColumnEncodingType type,
+      ObColumnEncodingHeader& col_header);
+  int write_value_table(const ColumnValues& values, const uint32_t* rows, const int64_t count);
+  int write_raw(const ColumnValues& values, ObColumnEncodingHeader& col_header);
+  int write_const(const ColumnValues& values, ObColumnEncodingHeader& col_header);
+  int write_dict(const ColumnValues& values, ObColumnEncodingHeader& col_header);
+  int write_rle(const ColumnValues& values, ObColumnEncodingHeader& col_header);
+  int write_int_delta(const int64_t col_idx, ObColumnEncodingHeader& col_header);
+  int write_prefix(const int64_t col_idx, ObColumnEncodingHeader& col_header);
+  OB_INLINE int64_t value_length(const ColumnValues& values, const int64_t row_idx) const
+  {
+    const int64_t end = row_idx + 1 < rows_.count() ? values.offsets_[row_idx + 1] : col_buffer_.length();
+    return end - values.offsets_[row_idx];
+  }
+  OB_INLINE const char* value_ptr(const ColumnValues& values, const int64_t row_idx) const
+  {
+    return col_buffer_.data() + values.offsets_[row_idx];
+  }
+  int64_t calc_value_table_size(const ColumnValues& values, const uint32_t* rows, const int64_t count) const;
+  bool is_same_meta_column(const int64_t col_idx) const;
+  void calc_int_delta(const int64_t col_idx, int64_t& base, uint64_t& max_delta) const;
+  int64_t calc_prefix_len(const int64_t col_idx) const;
+
+  private:
+  int64_t micro_block_size_limit_;
+  int64_t rowkey_column_count_;
+  int64_t column_count_;
+  int64_t raw_data_size_;
+  int64_t expand_pct_;
+  common::ObArray<common::ObObj*> rows_;
+  common::ObArray<ObRowHeader> row_headers_;
+  common::ObArenaAllocator row_allocator_;    // buffered rows, freed on reuse
+  common::ObArenaAllocator encode_allocator_; // per build scratch
+  ObSelfBufferWriter data_buffer_;
+  ObSelfBufferWriter col_buffer_;
+  ObSelfBufferWriter rowkey_buffer_;
+  ObRowWriter row_writer_;
+  int64_t last_rowkey_length_;
+  ObColumnEncodingType* encoding_types_;
+  bool is_inited_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
@@ -779,6 +779,37 @@ int ObMicroBlockReader::get_row_header(const int64_t row_idx, const ObRowHeader*
   return ret;
 }
 
+int ObMicroBlockReader::get_cell(const int64_t row_idx, const int64_t col_idx, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "reader not init", K(ret));
+  } else if (OB_ISNULL(column_map_) || OB_ISNULL(reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "column map or row reader is null", K(ret), KP_(column_map), KP_(reader));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || col_idx < 0 ||
+                         col_idx >= column_map_->get_request_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(row_idx), K(col_idx));
+  } else {
+    const ObColumnIndexItem& column_index = column_map_->get_column_indexs()[col_idx];
+    if (column_index.store_index_ < 0) {
+      cell.set_nop_value();
+    } else {
+      reader_->reset();
+      if (OB_FAIL(reader_->setup_row(
+              data_begin_, index_data_[row_idx + 1], index_data_[row_idx], column_map_->get_store_count()))) {
+        STORAGE_LOG(WARN, "failed to setup row", K(ret), K(row_idx));
+      } else if (OB_FAIL(
+                     reader_->read_column(column_index.get_obj_meta(), allocator_, column_index.store_index_, cell))) {
+        STORAGE_LOG(WARN, "failed to read column", K(ret), K(row_idx), K(column_index));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMicroBlockReader::get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
     const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
     int64_t& trans_version, int64_t& sql_sequence)
@@ -30,6 +30,7 @@ ObIMicroBlockRowFetcher::ObIMicroBlockRowFetcher()
       flat_reader_(NULL),
       multi_version_reader_(NULL),
       sparse_reader_(NULL),
+      encode_reader_(NULL),
       is_multi_version_(false),
       is_inited_(false)
 {}
@@ -48,6 +49,10 @@ ObIMicroBlockRowFetcher::~ObIMicroBlockRowFetcher()
     sparse_reader_->~ObSparseMicroBlockGetReader();
     sparse_reader_ = NULL;
   }
+  if (NULL != encode_reader_) {
+    encode_reader_->~ObEncodeBlockGetReader();
+    encode_reader_ = NULL;
+  }
 }
 
 int ObIMicroBlockRowFetcher::init(
@@ -65,6 +70,7 @@ int ObIMicroBlockRowFetcher::init(
     flat_reader_ = NULL;
     multi_version_reader_ = NULL;
     sparse_reader_ = NULL;
+    encode_reader_ = NULL;
     is_multi_version_ = sstable->is_multi_version_minor_sstable();
     is_inited_ = true;
   }
@@ -93,6 +99,11 @@ int ObIMicroBlockRowFetcher::prepare_reader(const ObFullMacroBlockMeta& macro_me
       sparse_reader_ = OB_NEWx(ObSparseMicroBlockGetReader, context_->allocator_);
     }
     reader_ = sparse_reader_;
+  } else if (ENCODING_ROW_STORE == store_type) {
+    if (NULL == encode_reader_) {
+      encode_reader_ = OB_NEWx(ObEncodeBlockGetReader, context_->allocator_);
+    }
+    reader_ = encode_reader_;
   } else {
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("not supported row store type", K(ret), K(store_type));
@@ -15,6 +15,7 @@
 #include "ob_micro_block_row_scanner.h"
 #include "storage/ob_i_store.h"
 #include "storage/blocksstable/ob_micro_block_reader.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 #include "storage/transaction/ob_trans_service.h"
 #include "storage/transaction/ob_trans_part_ctx.h"
 
@@ -99,6 +100,7 @@ int ObIMicroBlockRowScanner::get_next_row(const ObStoreRow*& store_row)
 {
   int ret = OB_SUCCESS;
   lob_reader_.reuse();
+  decoder_allocator_.reuse();
   if (OB_FAIL(inner_get_next_row(store_row))) {
   } else if (has_lob_column() && OB_FAIL(read_lob_columns(store_row))) {
     STORAGE_LOG(WARN, "Failed to read lob columns from store row", K(ret));
@@ -109,6 +111,7 @@ int ObIMicroBlockRowScanner::get_next_row(const ObStoreRow*& store_row)
 int ObIMicroBlockRowScanner::get_next_rows(const storage::ObStoreRow*& rows, int64_t& count)
 {
   int ret = OB_SUCCESS;
+  decoder_allocator_.reuse();
   if (has_lob_column()) {
     // To avoid reading lob rows in batches taking up too much memory,
     // temporarily degenerate into single row mode
@@ -134,6 +137,7 @@ int ObIMicroBlockRowScanner::get_next_rows(const storage::ObStoreRow*& rows, int
 void ObIMicroBlockRowScanner::reset()
 {
   lob_reader_.reset();
+  decoder_allocator_.reset();
   has_lob_column_ = false;
   param_ = NULL;
   context_ = NULL;
@@ -174,6 +178,10 @@ int ObIMicroBlockRowScanner::set_reader(const ObRowStoreType store_type)
       reader_ = &flat_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader_ = &decoder_;
+      break;
+    }
     case SPARSE_ROW_STORE: {
       reader_ = &sparse_reader_;
       break;
@@ -461,11 +469,49 @@ int ObMicroBlockRowScanner::init(const ObTableIterParam& param, ObTableAccessCon
       row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
       row.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
     }
+    pd_filter_ = nullptr;
+    filter_result_ = nullptr;
+    if (OB_NOT_NULL(param_->pd_storage_filters_) && OB_NOT_NULL(column_id_map)) {
+      // pushdown filter is only an optimization, fall back to return every row if it can not be applied
+      int tmp_ret = OB_SUCCESS;
+      const ObIArray<ObColumnParam*>* out_cols_param = nullptr;
+      if (OB_SUCCESS != (tmp_ret = param_->get_out_cols_param(false /*is get*/, out_cols_param))) {
+        STORAGE_LOG(WARN, "fail to get out cols param", K(tmp_ret));
+      } else if (OB_ISNULL(out_cols_param)) {
+      } else if (OB_SUCCESS !=
+                 (tmp_ret = init_pushdown_filter(*param_->pd_storage_filters_, column_id_map, out_cols_param))) {
+        STORAGE_LOG(WARN, "fail to init pushdown filter, ignore it", K(tmp_ret));
+      } else {
+        pd_filter_ = param_->pd_storage_filters_;
+      }
+    }
     is_inited_ = true;
   }
   return ret;
 }
 
+int ObMicroBlockRowScanner::init_pushdown_filter(sql::ObPushdownFilterExecutor& filter,
+    const share::schema::ColumnMap* column_id_map, const ObIArray<ObColumnParam*>* out_cols_param)
+{
+  int ret = OB_SUCCESS;
+  if (filter.is_filter_node()) {
+    if (OB_FAIL(filter.init_filter_param(column_id_map, out_cols_param, false /*need padding*/))) {
+      STORAGE_LOG(WARN, "fail to init filter param", K(ret), K(filter));
+    }
+  } else {
+    sql::ObPushdownFilterExecutor** childs = filter.get_childs();
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); ++i) {
+      if (OB_ISNULL(childs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(init_pushdown_filter(*childs[i], column_id_map, out_cols_param))) {
+        STORAGE_LOG(WARN, "fail to init child filter", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMicroBlockRowScanner::open(const MacroBlockId& macro_id, const ObFullMacroBlockMeta& macro_meta,
     const ObMicroBlockData& block_data, const bool is_left_border, const bool is_right_border)
 {
@@ -476,6 +522,85 @@ int ObMicroBlockRowScanner::open(const MacroBlockId& macro_id, const ObFullMacro
     STORAGE_LOG(WARN, "failed to init micro block reader", K(ret), K(macro_id));
   } else if (OB_FAIL(set_base_scan_param(is_left_border, is_right_border))) {
     STORAGE_LOG(WARN, "failed to set base scan param", K(ret), K(is_left_border), K(is_right_border), K(macro_id));
+  } else if (OB_FAIL(apply_pushdown_filter())) {
+    STORAGE_LOG(WARN, "failed to apply pushdown filter", K(ret), K(macro_id));
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::apply_pushdown_filter()
+{
+  int ret = OB_SUCCESS;
+  filter_result_ = nullptr;
+  // only rows of a single major sstable are final, rows of other tables need fuse before filtering
+  if (nullptr == pd_filter_ || !context_->enable_pushdown_filter_ || nullptr == sstable_ ||
+      !sstable_->is_major_sstable() || context_->query_flag_.is_multi_version_minor_merge()) {
+  } else if (ObIMicroBlockReader::INVALID_ROW_INDEX == start_ || ObIMicroBlockReader::INVALID_ROW_INDEX == last_) {
+  } else {
+    const int64_t begin = MIN(start_, last_);
+    const int64_t end = MAX(start_, last_) + 1;
+    const ObBitmap* result = nullptr;
+    if (OB_FAIL(filter_micro_block(*pd_filter_, begin, end, result))) {
+      STORAGE_LOG(WARN, "fail to filter micro block", K(ret), K(begin), K(end));
+    } else if (OB_ISNULL(result)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "unexpected null filter result", K(ret));
+    } else if (!result->is_all_true()) {
+      filter_begin_ = begin;
+      filter_result_ = result;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_micro_block(
+    sql::ObPushdownFilterExecutor& filter, const int64_t begin, const int64_t end, const ObBitmap*& result)
+{
+  int ret = OB_SUCCESS;
+  ObBitmap* bitmap = nullptr;
+  result = nullptr;
+  if (OB_FAIL(filter.init_bitmap(end - begin, bitmap))) {
+    STORAGE_LOG(WARN, "fail to init filter bitmap", K(ret), K(begin), K(end));
+  } else if (OB_ISNULL(bitmap)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected null filter bitmap", K(ret));
+  } else if (filter.is_filter_white_node()) {
+    sql::ObWhiteFilterExecutor& white_filter = static_cast<sql::ObWhiteFilterExecutor&>(filter);
+    if (!white_filter.is_params_ready() || 1 != white_filter.get_col_count() ||
+        nullptr == white_filter.get_col_offsets()) {
+      bitmap->reuse(true);
+    } else if (OB_FAIL(reader_->filter_pushdown_filter(
+                   white_filter, white_filter.get_col_offsets()[0], begin, end, *bitmap))) {
+      if (OB_NOT_SUPPORTED == ret) {
+        ret = OB_SUCCESS;
+        bitmap->reuse(true);
+      } else {
+        STORAGE_LOG(WARN, "fail to filter micro block", K(ret), K(begin), K(end));
+      }
+    }
+  } else if (filter.is_filter_node()) {
+    // black filter is evaluated by sql after projection
+    bitmap->reuse(true);
+  } else {
+    sql::ObPushdownFilterExecutor** childs = filter.get_childs();
+    const ObBitmap* child_result = nullptr;
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); ++i) {
+      if (OB_ISNULL(childs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(filter_micro_block(*childs[i], begin, end, child_result))) {
+        STORAGE_LOG(WARN, "fail to filter micro block", K(ret), K(i));
+      } else if (filter.is_logic_and_node()) {
+        if (OB_FAIL(bitmap->bit_and(*child_result))) {
+          STORAGE_LOG(WARN, "fail to merge and filter result", K(ret), K(i));
+        }
+      } else if (OB_FAIL(bitmap->bit_or(*child_result))) {
+        STORAGE_LOG(WARN, "fail to merge or filter result", K(ret), K(i));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    result = bitmap;
   }
   return ret;
 }
@@ -494,7 +619,10 @@ int ObMicroBlockRowScanner::inner_get_next_row(const ObStoreRow*& row)
 {
   int ret = OB_SUCCESS;
   row = NULL;
-  if (OB_FAIL(end_of_block())) {
+  while (OB_SUCC(end_of_block()) && is_row_filtered(current_)) {
+    current_ += step_;
+  }
+  if (OB_FAIL(ret)) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
     }
@@ -519,35 +647,73 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
   int ret = OB_SUCCESS;
   rows = nullptr;
   count = 0;
-  while (OB_SUCC(ret) && count == 0) {
-    if (OB_FAIL(end_of_block())) {
+  if (nullptr != filter_result_) {
+    if (OB_FAIL(inner_get_next_filtered_rows(rows, count))) {
       if (OB_UNLIKELY(OB_ITER_END != ret)) {
-        STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
+        STORAGE_LOG(WARN, "fail to get next filtered rows", K(ret), K(current_), K(last_), K(macro_id_));
       }
-    } else if (OB_FAIL(reader_->get_rows(
-                   current_, last_ + step_, ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT, rows_, count))) {
-      STORAGE_LOG(WARN, "fail to get rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_), K(*sstable_));
-    } else if (0 == count) {
-      current_ += step_ * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT;
-    } else {
-      rows = rows_;
-    }
-  }
-  STORAGE_LOG(DEBUG,
-      "inner get next rows",
-      K(ret),
-      "is_iter_end",
-      end_of_block(),
-      K(current_),
-      K(last_),
-      K(step_),
-      KP(rows),
-      K(count));
-  if (OB_SUCC(ret)) {
-    if (context_->query_flag_.is_multi_version_minor_merge()) {
-      compat_old_dump_sstable_row(const_cast<ObStoreRow*>(rows), count);
     }
-    current_ += step_ * count;
+  } else {
+    while (OB_SUCC(ret) && count == 0) {
+      if (OB_FAIL(end_of_block())) {
+        if (OB_UNLIKELY(OB_ITER_END != ret)) {
+          STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
+        }
+      } else if (OB_FAIL(reader_->get_rows(
+                     current_, last_ + step_, ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT, rows_, count))) {
+        STORAGE_LOG(WARN, "fail to get rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_), K(*sstable_));
+      } else if (0 == count) {
+        current_ += step_ * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT;
+      } else {
+        rows = rows_;
+      }
+    }
+    STORAGE_LOG(DEBUG,
+        "inner get next rows",
+        K(ret),
+        "is_iter_end",
+        end_of_block(),
+        K(current_),
+        K(last_),
+        K(step_),
+        KP(rows),
+        K(count));
+    if (OB_SUCC(ret)) {
+      if (context_->query_flag_.is_multi_version_minor_merge()) {
+        compat_old_dump_sstable_row(const_cast<ObStoreRow*>(rows), count);
+      }
+      current_ += step_ * count;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::inner_get_next_filtered_rows(const storage::ObStoreRow*& rows, int64_t& count)
+{
+  int ret = OB_SUCCESS;
+  rows = nullptr;
+  count = 0;
+  while (OB_SUCC(ret) && count < ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT && OB_SUCC(end_of_block())) {
+    if (!is_row_filtered(current_)) {
+      ObStoreRow& dest_row = rows_[count];
+      dest_row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
+      if (OB_FAIL(reader_->get_row(current_, dest_row))) {
+        STORAGE_LOG(WARN, "micro block reader fail to get row.", K(ret), K(current_), K(macro_id_));
+      } else {
+        ++count;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      current_ += step_;
+    }
+  }
+  if (OB_ITER_END == ret && count > 0) {
+    ret = OB_SUCCESS;
+  }
+  if (OB_SUCC(ret)) {
+    rows = rows_;
+  } else {
+    count = 0;
   }
   return ret;
 }
@@ -555,6 +721,9 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
 void ObMicroBlockRowScanner::reset()
 {
   ObIMicroBlockRowScanner::reset();
+  pd_filter_ = nullptr;
+  filter_result_ = nullptr;
+  filter_begin_ = 0;
 }
 
 int ObMultiVersionMicroBlockRowScanner::init(
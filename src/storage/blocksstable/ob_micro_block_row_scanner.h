@@ -14,6 +14,7 @@
 #define OB_MICRO_BLOCK_ROW_SCANNER_H_
 
 #include "lib/container/ob_raw_se_array.h"
+#include "lib/container/ob_bitmap.h"
 #include "ob_row_queue.h"
 #include "storage/ob_sstable.h"
 #include "storage/ob_row_fuse.h"
@@ -21,10 +22,14 @@
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_lob_data_reader.h"
 #include "storage/transaction/ob_trans_define.h"
 
 namespace oceanbase {
+namespace sql {
+class ObPushdownFilterExecutor;
+}  // namespace sql
 namespace storage {
 class ObTableIterParam;
 class ObTableAccessContext;
@@ -51,8 +56,11 @@ class ObIMicroBlockRowScanner {
         has_lob_column_(false),
         lob_reader_(),
         macro_id_(),
+        decoder_allocator_(common::ObModIds::OB_SSTABLE_READER),
         is_inited_(false)
-  {}
+  {
+    decoder_.set_row_allocator(&decoder_allocator_);
+  }
   virtual ~ObIMicroBlockRowScanner()
   {}
   virtual int init(const storage::ObTableIterParam& param, storage::ObTableAccessContext& context,
@@ -102,6 +110,7 @@ class ObIMicroBlockRowScanner {
   ObIMicroBlockReader* reader_;
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   int64_t current_;  // current cursor
   int64_t start_;    // start of scan, inclusive.
   int64_t last_;     // end of scan, inclusive.
@@ -112,13 +121,15 @@ class ObIMicroBlockRowScanner {
   bool has_lob_column_;
   ObLobDataReader lob_reader_;
   MacroBlockId macro_id_;
+  // cells decoded by decoder_, valid until the next get_next_row(s)
+  common::ObArenaAllocator decoder_allocator_;
   bool is_inited_;
 };
 
 // major sstable micro block scanner for query and merge
 class ObMicroBlockRowScanner : public ObIMicroBlockRowScanner {
   public:
-  ObMicroBlockRowScanner()
+  ObMicroBlockRowScanner() : pd_filter_(nullptr), filter_result_(nullptr), filter_begin_(0)
   {}
   virtual ~ObMicroBlockRowScanner()
   {}
@@ -132,9 +143,27 @@ class ObMicroBlockRowScanner : public ObIMicroBlockRowScanner {
   virtual int inner_get_next_row(const storage::ObStoreRow*& row) override;
   virtual int inner_get_next_rows(const storage::ObStoreRow*& rows, int64_t& count) override;
 
+  private:
+  int init_pushdown_filter(sql::ObPushdownFilterExecutor& filter, const share::schema::ColumnMap* column_id_map,
+      const common::ObIArray<share::schema::ObColumnParam*>* out_cols_param);
+  int apply_pushdown_filter();
+  int inner_get_next_filtered_rows(const storage::ObStoreRow*& rows, int64_t& count);
+  int filter_micro_block(
+      sql::ObPushdownFilterExecutor& filter, const int64_t begin, const int64_t end, const common::ObBitmap*& result);
+  OB_INLINE bool is_row_filtered(const int64_t row_idx) const
+  {
+    return nullptr != filter_result_ && !filter_result_->test(row_idx - filter_begin_);
+  }
+
   protected:
   storage::ObStoreRow rows_[ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
   char obj_buf_[common::OB_ROW_MAX_COLUMNS_COUNT * sizeof(ObObj) * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
+  // white filters pushed down from the table scan, evaluated on the encoded micro block
+  sql::ObPushdownFilterExecutor* pd_filter_;
+  // rows in [filter_begin_, filter_begin_ + size) of current micro block which may satisfy pd_filter_,
+  // null if every row has to be returned
+  const common::ObBitmap* filter_result_;
+  int64_t filter_begin_;
 };
 
 /*
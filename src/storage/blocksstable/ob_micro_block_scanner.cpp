@@ -81,6 +81,10 @@ int ObMicroBlockScanner::set_reader(const ObRowStoreType store_type)
       reader_ = &flat_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader_ = &decoder_;
+      break;
+    }
     case SPARSE_ROW_STORE: {
       reader_ = &sparse_reader_;
       break;
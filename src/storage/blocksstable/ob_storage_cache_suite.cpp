@@ -45,6 +45,7 @@ int ObStorageCacheSuite::init(const int64_t index_cache_priority, const int64_t
     STORAGE_LOG(ERROR, "init user block cache failed, ", K(ret));
   } else if (OB_FAIL(user_row_cache_.init("user_row_cache", user_row_cache_priority))) {
     STORAGE_LOG(ERROR, "init user sstable row cache failed, ", K(ret));
+  } else if (FALSE_IT(user_row_cache_.set_admission_enabled(true))) {
   } else if (OB_FAIL(bf_cache_.init("bf_cache", bf_cache_priority))) {
     STORAGE_LOG(ERROR, "init bloom filter cache failed, ", K(ret));
   } else if (OB_FAIL(bf_cache_.set_bf_cache_miss_count_threshold(bf_cache_miss_count_threshold))) {
@@ -203,7 +203,7 @@ void BtreeNode::copy(BtreeNode& dest, const int dest_start, const int start, con
 {
   if (OB_LIKELY(start < end)) {
     for (int i = 0; i < end - start; ++i) {
-      dest.set_key_value(dest_start + i, get_key(start + i), get_val_with_tag(start + i));
+      dest.set_key_value(dest_start + i, get_key(start + i), get_prefix(start + i), get_val_with_tag(start + i));
       if (dest.is_leaf()) {
         dest.index_.unsafe_insert(dest_start + i, dest_start + i);
       }
@@ -1514,6 +1514,8 @@ int64_t BtreeNodeAllocator::pop_idx()
   return (pop_idx++) % MAX_LIST_COUNT;
 }
 
+STATIC_ASSERT(sizeof(BtreeNode) <= NODE_SIZE && 0 == NODE_SIZE % CACHE_ALIGN_SIZE, "btree node size mismatch");
+
 BtreeNode* BtreeNodeAllocator::alloc_node(const bool is_emergency)
 {
   BtreeNode* p = nullptr;
@@ -1531,7 +1533,9 @@ int BtreeNodeAllocator::pop(BtreeNode*& p)
   if (OB_ISNULL(p = free_list_array_[pop_list_idx].pop())) {
     // queue is empty, fill nodes.
     char* block = nullptr;
-    if (OB_NOT_NULL(block = (char*)allocator_.alloc(NODE_SIZE * NODE_COUNT_PER_ALLOC))) {
+    // nodes are aligned to cache line, so the header and key prefixes of node share the first lines.
+    if (OB_NOT_NULL(block = (char*)allocator_.alloc(NODE_SIZE * NODE_COUNT_PER_ALLOC + CACHE_ALIGN_SIZE))) {
+      block = reinterpret_cast<char*>(upper_align(reinterpret_cast<int64_t>(block), CACHE_ALIGN_SIZE));
       int64_t pushed_node_cnt = 0;
       // init all nodes
       for (int64_t idx = 0; (idx + 1) <= NODE_COUNT_PER_ALLOC; ++idx) {
@@ -28,7 +28,7 @@ namespace oceanbase {
 namespace keybtree {
 using RawType = uint64_t;
 
-enum { NODE_SIZE = 280, MAX_CPU_NUM = 64, RETIRE_LIMIT = 1024, NODE_KEY_COUNT = 15, NODE_COUNT_PER_ALLOC = 128 };
+enum { NODE_SIZE = 448, MAX_CPU_NUM = 64, RETIRE_LIMIT = 1024, NODE_KEY_COUNT = 15, NODE_COUNT_PER_ALLOC = 128 };
 
 struct BtreeKV {
   BtreeKey key_;
@@ -36,10 +36,63 @@ struct BtreeKV {
 };
 
 struct CompHelper {
+  // 0 means the key has no normalized prefix and can only be compared by full comparison.
+  static const uint64_t INVALID_PREFIX = 0;
+  static const uint64_t MIN_PREFIX = 1;
+  static const uint64_t MAX_PREFIX = UINT64_MAX;
+
   OB_INLINE int compare(const BtreeKey search_key, const BtreeKey idx_key, int& cmp) const
   {
     return search_key.compare(idx_key, cmp);
   }
+  // Compare by the normalized prefixes first, keys are dereferenced only if the prefixes are
+  // equal or invalid.
+  OB_INLINE int compare(const BtreeKey search_key, const uint64_t search_prefix, const BtreeKey idx_key,
+      const uint64_t idx_prefix, int& cmp) const
+  {
+    int ret = common::OB_SUCCESS;
+    if (INVALID_PREFIX != search_prefix && INVALID_PREFIX != idx_prefix && search_prefix != idx_prefix) {
+      cmp = search_prefix < idx_prefix ? -1 : 1;
+    } else {
+      ret = search_key.compare(idx_key, cmp);
+    }
+    return ret;
+  }
+  // Memcomparable prefix of the first rowkey column: a signed integer with its sign bit
+  // flipped, or an unsigned integer no larger than INT64_MAX in the same space, so that
+  // prefix(a) < prefix(b) implies a < b. Min and max values map to both ends, other types
+  // (strings depend on collation) are not normalized.
+  static OB_INLINE uint64_t get_prefix(const BtreeKey& key)
+  {
+    uint64_t prefix = INVALID_PREFIX;
+    const common::ObStoreRowkey* rowkey = key.get_rowkey();
+    if (OB_NOT_NULL(rowkey) && rowkey->get_obj_cnt() > 0) {
+      const common::ObObj& obj = rowkey->get_obj_ptr()[0];
+      switch (obj.get_type_class()) {
+        case common::ObIntTC:
+          prefix = std::max(static_cast<uint64_t>(obj.get_int()) ^ SIGN_BIT, MIN_PREFIX);
+          break;
+        case common::ObUIntTC:
+          if (obj.get_uint64() <= static_cast<uint64_t>(INT64_MAX)) {
+            prefix = obj.get_uint64() ^ SIGN_BIT;
+          }
+          break;
+        case common::ObExtendTC:
+          if (obj.is_min_value()) {
+            prefix = MIN_PREFIX;
+          } else if (obj.is_max_value()) {
+            prefix = MAX_PREFIX;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    return prefix;
+  }
+
+  private:
+  static const uint64_t SIGN_BIT = 1ULL << 63;
 };
 
 class RWLock {
@@ -272,6 +325,10 @@ struct BtreeNode : public common::ObLink {
   {
     return kvs_[get_real_pos(pos, index)].key_;
   }
+  OB_INLINE uint64_t get_prefix(int pos, MultibitSet* index = nullptr) const
+  {
+    return prefixes_[get_real_pos(pos, index)];
+  }
   OB_INLINE BtreeVal get_val_with_tag(int pos, MultibitSet* index = nullptr) const
   {
     return ATOMIC_LOAD(&kvs_[get_real_pos(pos, index)].val_);
@@ -312,6 +369,11 @@ struct BtreeNode : public common::ObLink {
   int get_prev_active_child(int pos, int64_t version, int64_t* cnt, MultibitSet* index = nullptr);
   OB_INLINE void set_key_value(int pos, BtreeKey key, BtreeVal val)
   {
+    set_key_value(pos, key, CompHelper::get_prefix(key), val);
+  }
+  OB_INLINE void set_key_value(int pos, BtreeKey key, const uint64_t prefix, BtreeVal val)
+  {
+    prefixes_[pos] = prefix;
     kvs_[pos].key_ = key;
     ATOMIC_STORE(&kvs_[pos].val_, val);
   }
@@ -342,6 +404,7 @@ struct BtreeNode : public common::ObLink {
     int start = 0;
     int end = 0;
     int ret = OB_SUCCESS;
+    const uint64_t prefix = CompHelper::get_prefix(key);
     // Only leaf node try append directly, other scence do nothign with index.
     if (is_leaf()) {
       index->load(index_);
@@ -353,7 +416,7 @@ struct BtreeNode : public common::ObLink {
     while (OB_SUCC(ret) && start < end && !is_equal) {
       int mid = start + (end - start) / 2;
       int cmp_ret = 0;
-      if (OB_FAIL(nh.compare(key, get_key(mid, index), cmp_ret))) {
+      if (OB_FAIL(nh.compare(key, prefix, get_key(mid, index), get_prefix(mid, index), cmp_ret))) {
         OB_LOG(ERROR, "failed to compare", K(key), K(get_key(mid, index)));
       } else if (0 == cmp_ret) {
         is_equal = true;
@@ -388,6 +451,9 @@ struct BtreeNode : public common::ObLink {
   int16_t level_;
   uint16_t magic_num_;
   MultibitSet index_;  // this is the real position of kv.
+  // normalized prefixes of keys next to the header, binary search only touches the first cache
+  // lines of node unless prefixes are equal.
+  uint64_t prefixes_[NODE_KEY_COUNT];
   BtreeKV kvs_[NODE_KEY_COUNT];
 };
 
@@ -340,6 +340,63 @@ int ObMemtable::set(const storage::ObStoreCtx& ctx, const uint64_t table_id, con
   return ret;
 }
 
+struct ObMemtableRowkeyCompare {
+  explicit ObMemtableRowkeyCompare(const int64_t rowkey_len) : rowkey_len_(rowkey_len)
+  {}
+  OB_INLINE bool operator()(const ObStoreRow* left, const ObStoreRow* right) const
+  {
+    const ObStoreRowkey left_key(left->row_val_.cells_, rowkey_len_);
+    const ObStoreRowkey right_key(right->row_val_.cells_, rowkey_len_);
+    return left_key.compare(right_key) < 0;
+  }
+  int64_t rowkey_len_;
+};
+
+int ObMemtable::multi_set(const ObStoreCtx& ctx, const uint64_t table_id, const int64_t rowkey_len,
+    const ObIArray<ObColDesc>& columns, const ObStoreRow* rows, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  ObMvccWriteGuard guard;
+  ObSEArray<const ObStoreRow*, 64> sorted_rows;
+  if (IS_NOT_INIT) {
+    TRANS_LOG(WARN, "not init", K(*this));
+    ret = OB_NOT_INIT;
+  } else if (NULL == ctx.mem_ctx_ || 0 >= rowkey_len || rowkey_len > columns.count() || NULL == rows ||
+             0 >= row_count) {
+    TRANS_LOG(WARN, "invalid param", KP(rows), K(row_count));
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_FAIL(sorted_rows.reserve(row_count))) {
+    TRANS_LOG(WARN, "reserve sorted rows fail", K(ret), K(row_count));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      if (!rows[i].is_valid() || rows[i].row_val_.count_ < columns.count()) {
+        TRANS_LOG(WARN, "invalid param", K(i), K(rows[i]));
+        ret = OB_INVALID_ARGUMENT;
+      } else if (OB_FAIL(sorted_rows.push_back(&rows[i]))) {
+        TRANS_LOG(WARN, "push back row fail", K(ret));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(guard.write_auth(*ctx.mem_ctx_))) {
+    TRANS_LOG(WARN, "not allow to write", K(ctx));
+  } else {
+    share::CompatModeGuard compat_guard(mode_);
+    const bool for_replay = false;
+    ObMemtableCtx* mt_ctx = static_cast<ObMemtableCtx*>(ctx.mem_ctx_);
+    // rows adjacent in rowkey order land on the same keybtree leaves and keyhash buckets are
+    // touched in a cache friendly order, so sort the batch before writing it
+    if (row_count > 1) {
+      std::sort(sorted_rows.begin(), sorted_rows.end(), ObMemtableRowkeyCompare(rowkey_len));
+    }
+    ret = mt_ctx->set_leader_host(this, for_replay);
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      ret = set_(ctx, table_id, rowkey_len, columns, *sorted_rows.at(i), NULL, NULL);
+    }
+  }
+  return ret;
+}
+
 int ObMemtable::set(const ObStoreCtx& ctx, const uint64_t table_id, const int64_t rowkey_len,
     const ObIArray<ObColDesc>& columns, const ObIArray<int64_t>& update_idx, const ObStoreRow& old_row,
     const ObStoreRow& new_row)
@@ -151,6 +151,10 @@ class ObMemtable : public ObIMemtable {
       const common::ObIArray<share::schema::ObColDesc>& columns, storage::ObStoreRowIterator& row_iter);
   virtual int set(const storage::ObStoreCtx& ctx, const uint64_t table_id, const int64_t rowkey_len,
       const common::ObIArray<share::schema::ObColDesc>& columns, const storage::ObStoreRow& row);
+  // write a batch of rows in rowkey order, the write auth and leader host are checked once for the batch
+  virtual int multi_set(const storage::ObStoreCtx& ctx, const uint64_t table_id, const int64_t rowkey_len,
+      const common::ObIArray<share::schema::ObColDesc>& columns, const storage::ObStoreRow* rows,
+      const int64_t row_count);
   virtual int set(const storage::ObStoreCtx& ctx, const uint64_t table_id, const int64_t rowkey_len,
       const common::ObIArray<share::schema::ObColDesc>& columns, const ObIArray<int64_t>& update_idx,
       const storage::ObStoreRow& old_row, const storage::ObStoreRow& new_row);
@@ -28,6 +28,7 @@
 #include "sql/ob_sql_mock_schema_utils.h"
 #include "sql/engine/ob_phy_operator.h"
 #include "sql/engine/ob_operator.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
@@ -233,7 +234,8 @@ ObTableIterParam::ObTableIterParam()
       full_out_cols_(NULL),
       full_cols_id_map_(NULL),
       need_scn_(false),
-      iter_mode_(OIM_ITER_FULL)
+      iter_mode_(OIM_ITER_FULL),
+      pd_storage_filters_(NULL)
 {}
 
 ObTableIterParam::~ObTableIterParam()
@@ -310,6 +312,7 @@ void ObTableIterParam::reset()
   full_cols_id_map_ = NULL;
   need_scn_ = false;
   iter_mode_ = OIM_ITER_FULL;
+  pd_storage_filters_ = NULL;
 }
 
 bool ObTableIterParam::is_valid() const
@@ -518,6 +521,9 @@ int ObTableAccessParam::init(ObTableScanParam& scan_param, const bool is_mv)
     op_filters_ = scan_param.op_filters_;
     row2exprs_projector_ = scan_param.row2exprs_projector_;
     enable_fast_skip_ = false;
+    if (sql::ObPushdownFilterUtils::is_pushdown_storage(scan_param.pd_storage_flag_)) {
+      iter_param_.pd_storage_filters_ = scan_param.pd_storage_filters_;
+    }
 
     if (is_mv) {
       join_key_project_ = &table_param.get_join_key_projector();
@@ -629,6 +635,9 @@ int ObTableAccessParam::init_index_back(ObTableScanParam& scan_param)
     op_filters_ = scan_param.op_filters_before_index_back_;
     row2exprs_projector_ = scan_param.row2exprs_projector_;
     enable_fast_skip_ = false;
+    if (sql::ObPushdownFilterUtils::is_pushdown_storage_index_back(scan_param.pd_storage_flag_)) {
+      iter_param_.pd_storage_filters_ = scan_param.pd_storage_index_back_filters_;
+    }
 
     if (OB_SUCC(ret)) {
       iter_param_.full_out_cols_ = nullptr;
@@ -910,7 +919,8 @@ ObTableAccessContext::ObTableAccessContext()
       range_array_cursor_(0),
       merge_log_ts_(INT_MAX),
       read_out_type_(MAX_ROW_STORE),
-      lob_locator_helper_(nullptr)
+      lob_locator_helper_(nullptr),
+      enable_pushdown_filter_(false)
 {}
 
 ObTableAccessContext::~ObTableAccessContext()
@@ -1110,6 +1120,7 @@ void ObTableAccessContext::reset()
   range_array_pos_ = nullptr;
   range_array_cursor_ = 0;
   read_out_type_ = MAX_ROW_STORE;
+  enable_pushdown_filter_ = false;
 }
 
 void ObTableAccessContext::reuse()
@@ -1148,6 +1159,7 @@ void ObTableAccessContext::reuse()
   is_array_binding_ = false;
   range_array_pos_ = nullptr;
   range_array_cursor_ = 0;
+  enable_pushdown_filter_ = false;
 }
 
 void ObStoreRowLockState::reset()
@@ -1090,7 +1090,8 @@ struct ObTableIterParam {
   bool enable_fuse_row_cache() const;
   TO_STRING_KV(K_(table_id), K_(schema_version), K_(rowkey_cnt), KP_(out_cols), KP_(cols_id_map), KP_(projector),
       KP_(full_projector), KP_(out_cols_project), KP_(out_cols_param), KP_(full_out_cols_param),
-      K_(is_multi_version_minor_merge), KP_(full_out_cols), KP_(full_cols_id_map), K_(need_scn), K_(iter_mode));
+      K_(is_multi_version_minor_merge), KP_(full_out_cols), KP_(full_cols_id_map), K_(need_scn), K_(iter_mode),
+      KP_(pd_storage_filters));
 
   public:
   uint64_t table_id_;
@@ -1109,6 +1110,8 @@ struct ObTableIterParam {
   const share::schema::ColumnMap* full_cols_id_map_;
   bool need_scn_;
   ObIterTransNodeMode iter_mode_;
+  // filters pushed down from sql, white filters are evaluated on micro blocks of major sstable
+  sql::ObPushdownFilterExecutor* pd_storage_filters_;
 };
 
 class ObColDescArrayParam final {
@@ -1364,7 +1367,7 @@ struct ObTableAccessContext {
   TO_STRING_KV(K_(is_inited), K_(timeout), K_(pkey), K_(query_flag), K_(sql_mode), KP_(store_ctx), KP_(expr_ctx),
       KP_(limit_param), KP_(stmt_allocator), KP_(allocator), KP_(stmt_mem), KP_(scan_mem), KP_(table_scan_stat),
       KP_(block_cache_ws), K_(out_cnt), K_(is_end), K_(trans_version_range), KP_(row_filter), K_(merge_log_ts),
-      K_(read_out_type), K_(lob_locator_helper));
+      K_(read_out_type), K_(lob_locator_helper), K_(enable_pushdown_filter));
 
   private:
   int build_lob_locator_helper(ObTableScanParam& scan_param, const common::ObVersionRange& trans_version_range);
@@ -1402,6 +1405,9 @@ struct ObTableAccessContext {
   int64_t merge_log_ts_;
   common::ObRowStoreType read_out_type_;
   ObLobLocatorHelper* lob_locator_helper_;
+  // pushed down filters are only evaluated by storage when the scan reads a single major sstable,
+  // rows from other tables may be fused with them and must not be filtered before fuse
+  bool enable_pushdown_filter_;
 };
 
 struct ObRowsInfo final {
@@ -139,7 +139,13 @@ int ObIndexMerge::get_next_row(ObStoreRow*& row)
           }
 
           if (OB_SUCC(ret)) {
-            if (OB_FAIL(table_iter_.open(rowkeys_))) {
+            // read main table in rowkey order to group the lookups by block, the output keeps the
+            // index order. Rows of array binding are checked by range and a limit only needs a few
+            // rows, so the index order is used directly.
+            const bool sort_rowkeys =
+                !access_ctx_->is_array_binding_ &&
+                (NULL == access_ctx_->limit_param_ || access_ctx_->limit_param_->limit_ < 0);
+            if (OB_FAIL(table_iter_.open(rowkeys_, sort_rowkeys))) {
               STORAGE_LOG(WARN, "fail to open iterator", K(ret));
             } else {
               main_iter_ = &table_iter_;
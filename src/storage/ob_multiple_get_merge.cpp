@@ -31,7 +31,12 @@ ObMultipleGetMerge::ObMultipleGetMerge()
       has_frozen_memtable_(false),
       can_prefetch_all_(false),
       end_memtable_idx_(0),
-      sstable_begin_iter_idx_(0)
+      sstable_begin_iter_idx_(0),
+      sort_rowkeys_(false),
+      sorted_get_(false),
+      sorted_rows_fetched_(false),
+      sorted_rowkeys_(),
+      sorted_rowkey_idxs_()
 {}
 
 ObMultipleGetMerge::~ObMultipleGetMerge()
@@ -39,7 +44,7 @@ ObMultipleGetMerge::~ObMultipleGetMerge()
   reset();
 }
 
-int ObMultipleGetMerge::open(const common::ObIArray<common::ObExtStoreRowkey>& rowkeys)
+int ObMultipleGetMerge::open(const common::ObIArray<common::ObExtStoreRowkey>& rowkeys, const bool sort_rowkeys)
 {
   int ret = OB_SUCCESS;
 
@@ -53,6 +58,7 @@ int ObMultipleGetMerge::open(const common::ObIArray<common::ObExtStoreRowkey>& r
   } else {
     rowkeys_ = &rowkeys;
     row_filter_ = NULL;
+    sort_rowkeys_ = sort_rowkeys;
     if (OB_FAIL(construct_iters())) {
       STORAGE_LOG(WARN, "fail to construct iters", K(ret));
     } else if (OB_UNLIKELY(access_ctx_->need_prewarm())) {
@@ -82,6 +88,10 @@ void ObMultipleGetMerge::reset_with_fuse_row_cache()
     handles_ = nullptr;
   }
   prefetch_cnt_ = 0;
+  sorted_get_ = false;
+  sorted_rows_fetched_ = false;
+  sorted_rowkeys_.reuse();
+  sorted_rowkey_idxs_.reuse();
   reuse_iter_array();
 }
 
@@ -90,6 +100,7 @@ void ObMultipleGetMerge::reset()
   ObMultipleMerge::reset();
   rowkeys_ = NULL;
   cow_rowkeys_.reset();
+  sort_rowkeys_ = false;
   reset_with_fuse_row_cache();
 }
 
@@ -224,7 +235,7 @@ int ObMultipleGetMerge::construct_iters_with_fuse_row_cache()
   return ret;
 }
 
-int ObMultipleGetMerge::construct_iters_without_fuse_row_cache()
+int ObMultipleGetMerge::construct_iters_without_fuse_row_cache(const ObIArray<ObExtStoreRowkey>& rowkeys)
 {
   int ret = OB_SUCCESS;
   const ObIArray<ObITable*>& tables = tables_handle_.get_tables();
@@ -253,13 +264,13 @@ int ObMultipleGetMerge::construct_iters_without_fuse_row_cache()
         ret = OB_ERR_UNEXPECTED;
         STORAGE_LOG(WARN, "Fail to get access param", K(i), K(ret), K(*table));
       } else if (!use_cache_iter) {
-        if (OB_FAIL(table->multi_get(*iter_param, *access_ctx_, *rowkeys_, iter))) {
+        if (OB_FAIL(table->multi_get(*iter_param, *access_ctx_, rowkeys, iter))) {
           STORAGE_LOG(WARN, "Fail to get iterator, ", K(ret));
         } else if (OB_FAIL(iters_.push_back(iter))) {
           iter->~ObStoreRowIterator();
           STORAGE_LOG(WARN, "Fail to push iter to iterator array, ", K(ret));
         }
-      } else if (OB_FAIL(iters_.at(tables.count() - 1 - i)->init(*iter_param, *access_ctx_, table, rowkeys_))) {
+      } else if (OB_FAIL(iters_.at(tables.count() - 1 - i)->init(*iter_param, *access_ctx_, table, &rowkeys))) {
         STORAGE_LOG(WARN, "failed to init multi getter", K(ret), K(i));
       }
     }
@@ -277,13 +288,61 @@ int ObMultipleGetMerge::construct_iters()
     }
   } else {
     access_ctx_->use_fuse_row_cache_ = false;
-    if (OB_FAIL(construct_iters_without_fuse_row_cache())) {
+    if (sort_rowkeys_ && OB_FAIL(sort_rowkeys())) {
+      STORAGE_LOG(WARN, "fail to sort rowkeys", K(ret));
+    } else if (OB_FAIL(construct_iters_without_fuse_row_cache(sorted_get_ ? sorted_rowkeys_ : *rowkeys_))) {
       STORAGE_LOG(WARN, "fail to construct iters without fuse row cache", K(ret));
     }
   }
   return ret;
 }
 
+int ObMultipleGetMerge::sort_rowkeys()
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObITable*>& tables = tables_handle_.get_tables();
+  const int64_t rowkey_cnt = rowkeys_->count();
+  bool is_sorted = true;
+  reset_with_fuse_row_cache();
+  // memtables are at the end of tables, only sort when there is sstable to read by block
+  if (tables.count() > 0 && !tables.at(0)->is_memtable()) {
+    for (int64_t i = 1; is_sorted && i < rowkey_cnt; ++i) {
+      is_sorted = rowkeys_->at(i - 1).get_store_rowkey().compare(rowkeys_->at(i).get_store_rowkey()) <= 0;
+    }
+  }
+  if (!is_sorted) {
+    if (OB_FAIL(sorted_rowkey_idxs_.reserve(rowkey_cnt))) {
+      STORAGE_LOG(WARN, "fail to reserve sorted rowkey idxs", K(ret), K(rowkey_cnt));
+    } else if (OB_FAIL(sorted_rowkeys_.reserve(rowkey_cnt))) {
+      STORAGE_LOG(WARN, "fail to reserve sorted rowkeys", K(ret), K(rowkey_cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < rowkey_cnt; ++i) {
+      if (OB_FAIL(sorted_rowkey_idxs_.push_back(i))) {
+        STORAGE_LOG(WARN, "fail to push back rowkey idx", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      std::sort(&sorted_rowkey_idxs_.at(0), &sorted_rowkey_idxs_.at(0) + rowkey_cnt, RowkeyIdxCmp(*rowkeys_));
+      for (int64_t i = 0; OB_SUCC(ret) && i < rowkey_cnt; ++i) {
+        if (OB_FAIL(sorted_rowkeys_.push_back(rowkeys_->at(sorted_rowkey_idxs_.at(i))))) {
+          STORAGE_LOG(WARN, "fail to push back sorted rowkey", K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (OB_FAIL(alloc_resource())) {
+        STORAGE_LOG(WARN, "fail to alloc resource", K(ret));
+      } else {
+        for (int64_t i = 0; i < rowkey_cnt; ++i) {
+          reuse_row(i, rows_[i]);
+        }
+        sorted_get_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMultipleGetMerge::try_get_fuse_row_cache(int64_t& end_table_idx)
 {
   int ret = OB_SUCCESS;
@@ -736,6 +795,74 @@ int ObMultipleGetMerge::inner_get_next_row_without_fuse_row_cache(ObStoreRow& ro
   return ret;
 }
 
+int ObMultipleGetMerge::fetch_sorted_rows()
+{
+  int ret = OB_SUCCESS;
+  const ObStoreRow* tmp_row = NULL;
+  ObObjDeepCopy obj_copy(*access_ctx_->allocator_);
+  access_ctx_->use_fuse_row_cache_ = false;
+  // every iterator outputs one row for each sorted rowkey, fuse them into the row buffer at the
+  // position in rowkeys_, so the nop positions are kept per row until the row is output
+  for (int64_t i = 0; OB_SUCC(ret) && i < sorted_rowkey_idxs_.count(); ++i) {
+    const int64_t rowkey_idx = sorted_rowkey_idxs_.at(i);
+    ObQueryRowInfo& row_info = rows_[rowkey_idx];
+    for (int64_t j = 0; OB_SUCC(ret) && j < iters_.count(); ++j) {
+      if (OB_FAIL(iters_[j]->get_next_row(tmp_row))) {
+        STORAGE_LOG(WARN, "Iterator get next row failed", K(ret), K(i), K(j));
+      } else if (OB_ISNULL(tmp_row)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "tmp_row is NULL", K(ret));
+      } else if (OB_UNLIKELY(tmp_row->scan_index_ != i)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "invalid scan index", K(ret), K(i), K(tmp_row->scan_index_));
+      } else if (!row_info.final_result_ &&
+                 OB_FAIL(ObRowFuse::fuse_row(
+                     *tmp_row, row_info.row_, row_info.nop_pos_, row_info.final_result_, &obj_copy))) {
+        STORAGE_LOG(WARN, "fail to fuse row", K(ret), K(*tmp_row));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_info.row_.scan_index_ = rowkey_idx;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    sorted_rows_fetched_ = true;
+  }
+  return ret;
+}
+
+int ObMultipleGetMerge::inner_get_next_row_with_sorted_rowkeys(ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (!sorted_rows_fetched_ && OB_FAIL(fetch_sorted_rows())) {
+    STORAGE_LOG(WARN, "fail to fetch sorted rows", K(ret));
+  }
+  while (OB_SUCC(ret)) {
+    if (get_row_range_idx_ >= rowkeys_->count()) {
+      ret = OB_ITER_END;
+    } else {
+      const ObQueryRowInfo& row_info = rows_[get_row_range_idx_++];
+      if (ObActionFlag::OP_ROW_EXIST == row_info.row_.flag_) {
+        row.row_val_.count_ = row_info.row_.row_val_.count_;
+        if (OB_FAIL(project_row(row_info.row_, nullptr, 0 /*range idx delta*/, row))) {
+          STORAGE_LOG(WARN, "fail to project row", K(ret));
+        } else if (OB_FAIL(nop_pos_.set_count(row_info.nop_pos_.count()))) {
+          STORAGE_LOG(WARN, "fail to set nop count", K(ret), K(row_info.nop_pos_.count()));
+        } else {
+          // the rows are fused before any of them is output, restore the nop positions of this row
+          for (int64_t i = 0; OB_SUCC(ret) && i < row_info.nop_pos_.count(); ++i) {
+            if (OB_FAIL(nop_pos_.set_nop_pos(i, row_info.nop_pos_.nops_[i]))) {
+              STORAGE_LOG(WARN, "fail to set nop pos", K(ret), K(i));
+            }
+          }
+        }
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
 void ObMultipleGetMerge::collect_merge_stat(ObTableStoreStat& stat) const
 {
   stat.multi_get_stat_.call_cnt_++;
@@ -755,6 +882,12 @@ int ObMultipleGetMerge::inner_get_next_row(ObStoreRow& row)
         STORAGE_LOG(WARN, "fail to inner get next row with fuse row cache", K(ret));
       }
     }
+  } else if (sorted_get_) {
+    if (OB_FAIL(inner_get_next_row_with_sorted_rowkeys(row))) {
+      if (OB_ITER_END != ret) {
+        STORAGE_LOG(WARN, "fail to inner get next row with sorted rowkeys", K(ret));
+      }
+    }
   } else {
     if (OB_FAIL(inner_get_next_row_without_fuse_row_cache(row))) {
       if (OB_ITER_END != ret) {
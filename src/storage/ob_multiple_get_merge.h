@@ -52,7 +52,9 @@ class ObMultipleGetMerge : public ObMultipleMerge {
   public:
   ObMultipleGetMerge();
   virtual ~ObMultipleGetMerge();
-  int open(const common::ObIArray<common::ObExtStoreRowkey>& rowkeys);
+  // %sort_rowkeys: read sstables in rowkey order and output rows in the order of %rowkeys,
+  // only used when the rowkeys are neither array binding nor limited.
+  int open(const common::ObIArray<common::ObExtStoreRowkey>& rowkeys, const bool sort_rowkeys = false);
   static int estimate_row_count(const common::ObQueryFlag query_flag, const uint64_t table_id,
       const common::ObIArray<common::ObExtStoreRowkey>& rowkeys, const common::ObIArray<ObITable*>& tables,
       ObPartitionEst& part_estimate);
@@ -71,10 +73,23 @@ class ObMultipleGetMerge : public ObMultipleMerge {
   virtual int skip_to_range(const int64_t range_idx) override;
 
   private:
+  struct RowkeyIdxCmp {
+    explicit RowkeyIdxCmp(const common::ObIArray<common::ObExtStoreRowkey>& rowkeys) : rowkeys_(rowkeys)
+    {}
+    bool operator()(const int64_t l, const int64_t r) const
+    {
+      const int cmp = rowkeys_.at(l).get_store_rowkey().compare(rowkeys_.at(r).get_store_rowkey());
+      return cmp < 0 || (0 == cmp && l < r);
+    }
+    const common::ObIArray<common::ObExtStoreRowkey>& rowkeys_;
+  };
   int construct_iters_with_fuse_row_cache();
-  int construct_iters_without_fuse_row_cache();
+  int construct_iters_without_fuse_row_cache(const common::ObIArray<common::ObExtStoreRowkey>& rowkeys);
   int inner_get_next_row_with_fuse_row_cache(ObStoreRow& row);
   int inner_get_next_row_without_fuse_row_cache(ObStoreRow& row);
+  int sort_rowkeys();
+  int fetch_sorted_rows();
+  int inner_get_next_row_with_sorted_rowkeys(ObStoreRow& row);
   int get_table_row(const int64_t table_idx, const int64_t rowkey_idx, bool& stop_reading);
   int try_get_fuse_row_cache(int64_t& end_table_idx);
   int try_put_fuse_row_cache(ObQueryRowInfo& row_info);
@@ -101,6 +116,13 @@ class ObMultipleGetMerge : public ObMultipleMerge {
   bool can_prefetch_all_;
   int64_t end_memtable_idx_;
   int64_t sstable_begin_iter_idx_;
+  // rowkeys sorted for sstable reading and their positions in rowkeys_, the fused rows are
+  // buffered in rows_ by position.
+  bool sort_rowkeys_;
+  bool sorted_get_;
+  bool sorted_rows_fetched_;
+  GetRowkeyArray sorted_rowkeys_;
+  ObArray<int64_t> sorted_rowkey_idxs_;
 
   // disallow copy
   DISALLOW_COPY_AND_ASSIGN(ObMultipleGetMerge);
@@ -194,6 +194,7 @@ int ObMultipleMultiScanMerge::construct_iters()
   const ObIArray<ObITable*>& tables = tables_handle_.get_tables();
 
   consumer_.reset();
+  access_ctx_->enable_pushdown_filter_ = false;
 
   if (OB_UNLIKELY(iters_.count() > 0 && iters_.count() != tables.count())) {
     ret = OB_ERR_UNEXPECTED;
@@ -128,6 +128,8 @@ int ObMultipleScanMerge::construct_iters()
     const ObTableIterParam* iter_pram = NULL;
     const bool use_cache_iter = iters_.count() > 0;
     const int64_t table_cnt = tables.count() - 1;
+    // rows of a single table need no fuse, pushed down filters can be evaluated by the iterator
+    access_ctx_->enable_pushdown_filter_ = 0 == table_cnt;
 
     if (OB_FAIL(loser_tree_.init(tables.count(), *access_ctx_->stmt_allocator_))) {
       STORAGE_LOG(WARN, "init loser tree fail", K(ret));
@@ -61,6 +61,7 @@
 #include "share/stat/ob_table_stat.h"
 #include "sql/ob_end_trans_callback.h"
 #include "storage/blocksstable/slog/ob_base_storage_logger.h"
+#include "storage/blocksstable/ob_micro_block_compress_task.h"
 #include "storage/memtable/ob_memtable.h"
 #include "storage/ob_all_server_tracer.h"
 #include "storage/ob_build_index_scheduler.h"
@@ -455,6 +456,8 @@ int ObPartitionService::init(const blocksstable::ObStorageEnv& env, const ObAddr
     STORAGE_LOG(WARN, "Fail to init ObPartitionScheduler, ", K(ret));
   } else if (OB_FAIL(ObTmpFileManager::get_instance().init())) {
     STORAGE_LOG(WARN, "fail to init temp file manager", K(ret));
+  } else if (OB_FAIL(ObMicroBlockCompressPool::get_instance().init(GCONF._micro_block_compress_thread_count))) {
+    STORAGE_LOG(WARN, "fail to init micro block compress pool", K(ret));
   } else if (OB_FAIL(ObMemstoreAllocatorMgr::get_instance().init())) {
     STORAGE_LOG(WARN, "failed to init ObMemstoreAllocatorMgr", K(ret));
   } else if (OB_FAIL(cb_async_worker_.init(this))) {
@@ -1368,6 +1371,7 @@ int ObPartitionService::destroy()
   ObPartGroupMigrator::get_instance().destroy();
   ObPartitionScheduler::get_instance().destroy();
   ObTmpFileManager::get_instance().destroy();
+  ObMicroBlockCompressPool::get_instance().destroy();
 
   if (is_running_) {
     if (OB_FAIL(stop())) {
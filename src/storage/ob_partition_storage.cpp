@@ -2174,12 +2174,15 @@ int ObPartitionStorage::insert_table_rows(
           }
         }
       } else {
-        for (int64_t i = 0; OB_SUCC(ret) && i < rows_info.row_count_; i++) {
-          ObStoreRow& row = rows_info.rows_[i];
-          if (OB_FAIL(write_row(relative_table, ctx, relative_table.get_rowkey_column_num(), col_descs, row))) {
-            if (OB_TRY_LOCK_ROW_CONFLICT != ret) {
-              STORAGE_LOG(WARN, "failed to set row", K(row), K(ret));
-            }
+        if (OB_FAIL(ret)) {
+        } else if (OB_FAIL(write_rows(relative_table,
+                       ctx,
+                       relative_table.get_rowkey_column_num(),
+                       col_descs,
+                       rows_info.rows_,
+                       rows_info.row_count_))) {
+          if (OB_TRY_LOCK_ROW_CONFLICT != ret) {
+            STORAGE_LOG(WARN, "failed to set rows", "row_count", rows_info.row_count_, K(ret));
           }
         }
       }
@@ -6450,9 +6453,9 @@ int ObPartitionStorage::rowkeys_exists(
   return ret;
 }
 
-int ObPartitionStorage::write_row(ObRelativeTable& relative_table, const ObStoreCtx& store_ctx,
-    const int64_t rowkey_len, const common::ObIArray<share::schema::ObColDesc>& col_descs,
-    const storage::ObStoreRow& row)
+template <typename WriteFunc>
+int ObPartitionStorage::write_to_memtable(
+    ObRelativeTable& relative_table, const ObStoreCtx& store_ctx, WriteFunc& write_func)
 {
   int ret = OB_SUCCESS;
 
@@ -6462,27 +6465,15 @@ int ObPartitionStorage::write_row(ObRelativeTable& relative_table, const ObStore
     if (OB_UNLIKELY(!is_inited_)) {
       ret = OB_NOT_INIT;
       STORAGE_LOG(WARN, "partition storage is not initialized", K(ret));
-    } else if (!store_ctx.is_valid() || col_descs.count() <= 0 || rowkey_len <= 0 || !row.is_valid() ||
-               !relative_table.is_valid()) {
-      ret = OB_INVALID_ARGUMENT;
-      STORAGE_LOG(WARN,
-          "invalid argument",
-          KP(store_ctx.mem_ctx_),
-          K(relative_table),
-          K(rowkey_len),
-          K(col_descs),
-          K(row),
-          K(ret));
     } else if (OB_FAIL(guard.refresh_and_protect_table(relative_table))) {
       STORAGE_LOG(WARN, "fail to protect table", K(ret), K(pkey_));
     } else {
       ObMemtable* write_memtable = NULL;
-      const uint64_t table_id = relative_table.get_table_id();
       store_ctx.tables_ = &relative_table.tables_handle_.get_tables();
       if (OB_FAIL(relative_table.tables_handle_.get_last_memtable(write_memtable))) {
         STORAGE_LOG(WARN, "failed to get_last_memtable", K(ret));
-      } else if (OB_FAIL(write_memtable->set(store_ctx, table_id, rowkey_len, col_descs, row))) {
-        STORAGE_LOG(WARN, "failed to set memtable", K(ret));
+      } else if (OB_FAIL(write_func(*write_memtable))) {
+        STORAGE_LOG(WARN, "failed to write memtable", K(ret));
       }
     }
   }
@@ -6500,54 +6491,100 @@ int ObPartitionStorage::write_row(ObRelativeTable& relative_table, const ObStore
   return ret;
 }
 
-int ObPartitionStorage::write_row(ObRelativeTable& relative_table, const storage::ObStoreCtx& store_ctx,
+int ObPartitionStorage::write_row(ObRelativeTable& relative_table, const ObStoreCtx& store_ctx,
     const int64_t rowkey_len, const common::ObIArray<share::schema::ObColDesc>& col_descs,
-    const ObIArray<int64_t>& update_idx, const storage::ObStoreRow& old_row, const storage::ObStoreRow& new_row)
+    const storage::ObStoreRow& row)
 {
   int ret = OB_SUCCESS;
+  const uint64_t table_id = relative_table.get_table_id();
+  auto write_func = [&](ObMemtable& memtable) {
+    return memtable.set(store_ctx, table_id, rowkey_len, col_descs, row);
+  };
 
-  {
-    ObStorageWriterGuard guard(store_, store_ctx, true);
+  if (!store_ctx.is_valid() || col_descs.count() <= 0 || rowkey_len <= 0 || !row.is_valid() ||
+      !relative_table.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "invalid argument",
+        KP(store_ctx.mem_ctx_),
+        K(relative_table),
+        K(rowkey_len),
+        K(col_descs),
+        K(row),
+        K(ret));
+  } else if (OB_FAIL(write_to_memtable(relative_table, store_ctx, write_func))) {
+    STORAGE_LOG(WARN, "failed to set memtable", K(ret));
+  }
 
-    if (OB_UNLIKELY(!is_inited_)) {
-      ret = OB_NOT_INIT;
-      STORAGE_LOG(WARN, "partition storage is not initialized", K(ret));
-    } else if (!store_ctx.is_valid() || col_descs.count() <= 0 || rowkey_len <= 0 || !old_row.is_valid() ||
-               !new_row.is_valid() || !relative_table.is_valid()) {
+  return ret;
+}
+
+int ObPartitionStorage::write_rows(ObRelativeTable& relative_table, const ObStoreCtx& store_ctx,
+    const int64_t rowkey_len, const common::ObIArray<share::schema::ObColDesc>& col_descs,
+    const storage::ObStoreRow* rows, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t table_id = relative_table.get_table_id();
+
+  if (OB_ISNULL(rows) || row_count <= 0 || !store_ctx.is_valid() || col_descs.count() <= 0 || rowkey_len <= 0 ||
+      !relative_table.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "invalid argument",
+        KP(rows),
+        K(row_count),
+        KP(store_ctx.mem_ctx_),
+        K(relative_table),
+        K(rowkey_len),
+        K(col_descs),
+        K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+    if (!rows[i].is_valid()) {
       ret = OB_INVALID_ARGUMENT;
-      STORAGE_LOG(WARN,
-          "invalid argument",
-          KP(store_ctx.mem_ctx_),
-          K(relative_table),
-          K(rowkey_len),
-          K(col_descs),
-          K(update_idx),
-          K(old_row),
-          K(new_row),
-          K(ret));
-    } else if (OB_FAIL(guard.refresh_and_protect_table(relative_table))) {
-      STORAGE_LOG(WARN, "fail to protect table", K(ret), K(pkey_));
-    } else {
-      ObMemtable* write_memtable = NULL;
-      const uint64_t table_id = relative_table.get_table_id();
-      store_ctx.tables_ = &(relative_table.tables_handle_.get_tables());
-      if (OB_FAIL(relative_table.tables_handle_.get_last_memtable(write_memtable))) {
-        STORAGE_LOG(WARN, "failed to get write memtable", K(ret));
-      } else if (OB_FAIL(
-                     write_memtable->set(store_ctx, table_id, rowkey_len, col_descs, update_idx, old_row, new_row))) {
-        STORAGE_LOG(WARN, "failed to set write memtable", K(ret));
-      }
+      STORAGE_LOG(WARN, "invalid argument", K(i), K(rows[i]), K(ret));
+    }
+  }
+  // ObMemtable::multi_set sorts the rows of each chunk by rowkey, so the cache benefit of
+  // writing in rowkey order is limited to WRITE_ROWS_CHUNK_SIZE rows.
+  for (int64_t start = 0; OB_SUCC(ret) && start < row_count; start += WRITE_ROWS_CHUNK_SIZE) {
+    const int64_t chunk_count = MIN(WRITE_ROWS_CHUNK_SIZE, row_count - start);
+    auto write_func = [&](ObMemtable& memtable) {
+      return memtable.multi_set(store_ctx, table_id, rowkey_len, col_descs, rows + start, chunk_count);
+    };
+    if (OB_FAIL(write_to_memtable(relative_table, store_ctx, write_func))) {
+      STORAGE_LOG(WARN, "failed to multi set memtable", K(ret), K(start), K(chunk_count));
     }
   }
 
-  if (OB_SUCC(ret)) {
-    int tmp_ret = OB_SUCCESS;
-    ObMemtableCtx* mt_ctx = static_cast<ObMemtableCtx*>(store_ctx.mem_ctx_);
-    transaction::ObPartTransCtx* part_ctx = static_cast<transaction::ObPartTransCtx*>(mt_ctx->get_trans_ctx());
+  return ret;
+}
 
-    if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = part_ctx->submit_log_if_neccessary()))) {
-      TRANS_LOG(INFO, "submit log if neccesary failed", K(tmp_ret), K(store_ctx), K(relative_table));
-    }
+int ObPartitionStorage::write_row(ObRelativeTable& relative_table, const storage::ObStoreCtx& store_ctx,
+    const int64_t rowkey_len, const common::ObIArray<share::schema::ObColDesc>& col_descs,
+    const ObIArray<int64_t>& update_idx, const storage::ObStoreRow& old_row, const storage::ObStoreRow& new_row)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t table_id = relative_table.get_table_id();
+  auto write_func = [&](ObMemtable& memtable) {
+    return memtable.set(store_ctx, table_id, rowkey_len, col_descs, update_idx, old_row, new_row);
+  };
+
+  if (!store_ctx.is_valid() || col_descs.count() <= 0 || rowkey_len <= 0 || !old_row.is_valid() ||
+      !new_row.is_valid() || !relative_table.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "invalid argument",
+        KP(store_ctx.mem_ctx_),
+        K(relative_table),
+        K(rowkey_len),
+        K(col_descs),
+        K(update_idx),
+        K(old_row),
+        K(new_row),
+        K(ret));
+  } else if (OB_FAIL(write_to_memtable(relative_table, store_ctx, write_func))) {
+    STORAGE_LOG(WARN, "failed to set write memtable", K(ret));
   }
 
   return ret;
@@ -527,6 +527,8 @@ class ObPartitionStorage : public ObIPartitionStorage {
   };
 
   static const int32_t LOCK_WAIT_INTERVAL = 5;  // 5us
+  // rows written under one writer guard, the guard throttles and refreshes the memtable between chunks
+  static const int64_t WRITE_ROWS_CHUNK_SIZE = 64;
 
   private:
   int write_index_row(ObRelativeTable& relative_table, const ObStoreCtx& ctx, const ObColDescIArray& idx_columns,
@@ -645,8 +647,14 @@ class ObPartitionStorage : public ObIPartitionStorage {
   int do_rowkeys_prefix_exist(const common::ObIArray<ObITable*>& read_stores, ObRowsInfo& rows_info, bool& may_exist);
   int do_rowkeys_exists(const common::ObIArray<ObITable*>& read_stores, ObRowsInfo& rows_info, bool& exists);
   int rowkeys_exists(const ObStoreCtx& store_ctx, ObRelativeTable& relative_table, ObRowsInfo& rows_info, bool& exists);
+  // write into the last memtable of %relative_table under the writer guard, then submit log if necessary
+  template <typename WriteFunc>
+  int write_to_memtable(ObRelativeTable& relative_table, const ObStoreCtx& store_ctx, WriteFunc& write_func);
   int write_row(ObRelativeTable& relative_table, const ObStoreCtx& store_ctx, const int64_t rowkey_len,
       const common::ObIArray<share::schema::ObColDesc>& col_descs, const storage::ObStoreRow& row);
+  int write_rows(ObRelativeTable& relative_table, const ObStoreCtx& store_ctx, const int64_t rowkey_len,
+      const common::ObIArray<share::schema::ObColDesc>& col_descs, const storage::ObStoreRow* rows,
+      const int64_t row_count);
   int write_row(ObRelativeTable& relative_table, const storage::ObStoreCtx& ctx, const int64_t rowkey_len,
       const common::ObIArray<share::schema::ObColDesc>& col_descs, const common::ObIArray<int64_t>& update_idx,
       const storage::ObStoreRow& old_row, const storage::ObStoreRow& new_row);
@@ -325,6 +325,7 @@ ObReplayStatus::ObReplayStatus()
       offline_partition_log_id_(OB_INVALID_ID),
       offline_partition_task_submitted_(false),
       rp_eg_(NULL),
+      task_queue_cnt_(REPLAY_TASK_QUEUE_SIZE),
       submit_log_info_rwlock_(),
       allocator_(NULL),
       last_replay_log_id_(common::OB_INVALID_ID)
@@ -360,6 +361,8 @@ int ObReplayStatus::init(const uint64_t tenant_id, replayengine::ObILogReplayEng
   } else {
     rp_eg_ = rp_eg;
     safe_ref_ = safe_ref;
+    const int64_t task_queue_cnt = GCONF._replay_task_queue_count;
+    task_queue_cnt_ = std::max(1L, std::min(REPLAY_TASK_QUEUE_SIZE, task_queue_cnt));
     for (int64_t i = 0; OB_SUCC(ret) && i < REPLAY_TASK_QUEUE_SIZE; ++i) {
       if (OB_FAIL(task_queues_[i].init(this, i))) {
         REPLAY_LOG(WARN, "failed to init task_queue", K(ret));
@@ -845,7 +848,7 @@ int ObReplayStatus::push_task(ObReplayLogTask& task, uint64_t task_sign)
 int ObReplayStatus::push_(ObReplayLogTask& task, uint64_t task_sign)
 {
   int ret = OB_SUCCESS;
-  uint64_t queue_idx = task_sign % REPLAY_TASK_QUEUE_SIZE;
+  uint64_t queue_idx = task_sign % task_queue_cnt_;
   ObReplayLogTaskQueue& target_queue = task_queues_[queue_idx];
   if (OB_ISNULL(rp_eg_)) {
     ret = OB_NOT_INIT;
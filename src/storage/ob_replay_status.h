@@ -769,6 +769,8 @@ class ObReplayStatus {
   // be sure to clear these queues when the partition is offline to prevent old replay task is replayed in situation of
   // migrating out and then migrating in
   ObReplayLogTaskQueue task_queues_[common::REPLAY_TASK_QUEUE_SIZE];  // queues of replay task
+  // count of task queues in use, fixed after init to keep the queue of each transaction
+  int64_t task_queue_cnt_;
 
   RWLock submit_log_info_rwlock_;  // protect submit_log_info
   ObSubmitReplayLogTask submit_log_task_;
@@ -831,8 +831,8 @@ int ObSSTableRowIterator::prefetch()
       if ((prefetching_micro_cnt <= micro_handle_cnt_ / 2 && prefetching_micro_cnt <= prefetch_micro_depth_ / 4) ||
           0 == prefetching_micro_handle_cnt || 0 == prefetching_micro_cnt) {
         // prefetching micro count is less than free micro count and prefetch micro depth
+        // prefetch micro depth is adjusted by the access pattern in prefetch_block
         prefetch_micro_cnt = std::min(micro_handle_cnt_ - prefetching_micro_cnt, prefetch_micro_depth_);
-        prefetch_micro_depth_ = min(micro_handle_cnt_, prefetch_micro_depth_ * 2);
       }
     }
     STORAGE_LOG(DEBUG,
@@ -950,6 +950,7 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
   int64_t multiblock_read_gap_size_threshold = GCONF.multiblock_read_gap_size.get_value();
   int64_t multiblock_read_size_threshold = GCONF.multiblock_read_size.get_value();
   bool use_multiblock_io = false;
+  int64_t adjacent_micro_cnt = 0;
 
   if (sstable_micro_cnt > 0) {
     // sort micro info
@@ -958,12 +959,15 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
         &sorted_sstable_micro_infos_[0], &sorted_sstable_micro_infos_[sstable_micro_cnt], ObSSTableMicroBlockInfoCmp());
     for (int64_t i = 0; OB_SUCC(ret) && i < sstable_micro_cnt; ++i) {
       const ObSSTableMicroBlockInfo& sstable_micro = sstable_micro_infos_[i];
-      if (last_macro_ctx.get_macro_block_id() == sstable_micro.macro_ctx_.get_macro_block_id()) {
+      if (i > 0 && is_adjacent_micro(sstable_micro_infos_[i - 1], sstable_micro)) {
+        ++adjacent_micro_cnt;
+      }
+      if (use_multiblock_io) {
+      } else if (last_macro_ctx.get_macro_block_id() == sstable_micro.macro_ctx_.get_macro_block_id()) {
         read_size += sstable_micro.micro_info_.size_ + (sstable_micro.micro_info_.offset_ - prev_offset);
         prev_offset = sstable_micro.micro_info_.offset_ + sstable_micro.micro_info_.size_;
         if (read_size > multiblock_read_size_threshold) {
           use_multiblock_io = true;
-          break;
         }
       } else {
         read_size = sstable_micro.micro_info_.size_;
@@ -971,9 +975,21 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
         last_macro_ctx = sstable_micro.macro_ctx_;
       }
     }
+    // read ahead more on sequential access and less on random access, a batch of one micro block
+    // tells nothing about the access pattern and is treated as sequential
+    const bool is_sequential = adjacent_micro_cnt * 2 >= sstable_micro_cnt - 1;
+    if (is_sequential) {
+      prefetch_micro_depth_ = min(micro_handle_cnt_, prefetch_micro_depth_ * 2);
+    } else {
+      const int64_t shrunk_depth = prefetch_micro_depth_ / 2;
+      prefetch_micro_depth_ =
+          shrunk_depth > DEFAULT_PREFETCH_MICRO_DEPTH ? shrunk_depth : DEFAULT_PREFETCH_MICRO_DEPTH;
+    }
     if (!use_multiblock_io) {
+      // still coalesce the adjacent micro blocks of sequential access into one io, reverse scan
+      // reads them by offset too
       multiblock_read_gap_size_threshold = 0;
-      multiblock_read_size_threshold = 0;
+      multiblock_read_size_threshold = is_sequential ? multiblock_read_size_threshold : 0;
     }
 
     // group prefetch block
@@ -984,7 +1000,8 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
     prev_offset = 0;
     read_size = 0;
     last_macro_ctx.reset();
-    MicroInfoArray& sstable_micro_infos = use_multiblock_io ? sorted_sstable_micro_infos_ : sstable_micro_infos_;
+    MicroInfoArray& sstable_micro_infos =
+        use_multiblock_io || is_sequential ? sorted_sstable_micro_infos_ : sstable_micro_infos_;
 
     for (int64_t i = 0; OB_SUCC(ret) && i < sstable_micro_cnt; ++i) {
       const ObSSTableMicroBlockInfo& sstable_micro = sstable_micro_infos[i];
@@ -1023,6 +1040,9 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
                   io_param.block_count_++;
                 }
               }
+            } else if (sstable_micro.micro_info_.offset_ == io_micro_infos_.at(io_micro_infos_.count() - 1).offset_) {
+              // same micro block as the last one in io, e.g. rowkeys of multi get in one micro
+              // block, share the io instead of reading it again
             } else {
               need_submit_io = true;
             }
@@ -1072,6 +1092,15 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
   return ret;
 }
 
+bool ObSSTableRowIterator::is_adjacent_micro(
+    const ObSSTableMicroBlockInfo& prev_micro, const ObSSTableMicroBlockInfo& micro) const
+{
+  // forward or reverse scan reads the micro blocks of one macro block one by one
+  return prev_micro.macro_ctx_.get_macro_block_id() == micro.macro_ctx_.get_macro_block_id() &&
+         (prev_micro.micro_info_.offset_ + prev_micro.micro_info_.size_ == micro.micro_info_.offset_ ||
+             micro.micro_info_.offset_ + micro.micro_info_.size_ == prev_micro.micro_info_.offset_);
+}
+
 int ObSSTableRowIterator::submit_block_io(ObMultiBlockIOParam& io_param, MicroInfoArray& sstable_micro_infos,
     const int64_t start_sstable_micro_idx, const int64_t end_sstable_micro_idx)
 {
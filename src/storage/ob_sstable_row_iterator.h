@@ -359,6 +359,7 @@ class ObSSTableRowIterator : public ObISSTableRowIterator {
   int prefetch();
   int prefetch_handle(const int64_t prefetch_handle_cnt);
   int prefetch_block(const int64_t sstable_micro_cnt);
+  bool is_adjacent_micro(const ObSSTableMicroBlockInfo& prev_micro, const ObSSTableMicroBlockInfo& micro) const;
   int submit_block_io(blocksstable::ObMultiBlockIOParam& io_param, MicroInfoArray& sstable_micro_infos,
       const int64_t start_sstable_micro_idx, const int64_t end_sstable_micro_idx);
   int alloc_micro_getter();
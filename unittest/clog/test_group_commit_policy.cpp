@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "clog/ob_batch_buffer.h"
+
+using namespace oceanbase::clog;
+
+namespace oceanbase {
+namespace unittest {
+TEST(ObGroupCommitPolicy, low_load)
+{
+  ObGroupCommitPolicy policy;
+  // no sample
+  ASSERT_EQ(0, policy.get_wait_time(1000));
+  // 2 entries during a flush of 500us
+  policy.update(2, 500);
+  ASSERT_EQ(2, policy.get_target_entry_cnt(0));
+  ASSERT_EQ(0, policy.get_wait_time(1000));
+  // invalid samples are ignored
+  policy.update(100, 0);
+  policy.update(-1, 500);
+  ASSERT_EQ(0, policy.get_wait_time(1000));
+}
+
+TEST(ObGroupCommitPolicy, high_load)
+{
+  ObGroupCommitPolicy policy;
+  // 100 entries during a flush of 500us
+  policy.update(100, 500);
+  ASSERT_EQ(100, policy.get_target_entry_cnt(0));
+  // bounded by flush time and max wait time
+  ASSERT_EQ(500, policy.get_wait_time(1000));
+  ASSERT_EQ(200, policy.get_wait_time(200));
+  ASSERT_EQ(0, policy.get_wait_time(0));
+  ASSERT_EQ(200, policy.get_target_entry_cnt(500));
+
+  // load drops, the moving average goes below the threshold in a few flushes
+  int64_t flush_cnt = 0;
+  while (policy.get_wait_time(1000) > 0) {
+    policy.update(0, 500);
+    ASSERT_LT(++flush_cnt, 100);
+  }
+  ASSERT_LT(policy.get_target_entry_cnt(0), ObGroupCommitPolicy::MIN_GROUP_ENTRY_CNT);
+
+  policy.reset();
+  ASSERT_EQ(0, policy.get_target_entry_cnt(1000));
+  ASSERT_EQ(0, policy.get_wait_time(1000));
+}
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,7 @@
 #define protected public
 #include "share/cache/ob_kv_storecache.h"
 #include "share/ob_tenant_mgr.h"
+#include "share/ob_thread_mgr.h"
 #include "lib/utility/ob_tracepoint.h"
 //#include "ob_cache_get_stressor.h"
 #include "observer/ob_signal_handle.h"
@@ -352,6 +353,109 @@ TEST_F(TestKVCache, test_wash)
   ASSERT_TRUE(cache.size(tenant_id_) < upper_mem_limit_);
 }
 
+TEST(ObKVCacheFreqSketch, normal)
+{
+  ObKVCacheFreqSketch sketch;
+  ASSERT_EQ(0, sketch.estimate(1));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, sketch.init(1));
+  ASSERT_EQ(OB_SUCCESS, sketch.init(1024));
+  ASSERT_EQ(OB_INIT_TWICE, sketch.init(1024));
+
+  for (int64_t i = 0; i < 5; ++i) {
+    sketch.increment(1234);
+  }
+  ASSERT_EQ(5, sketch.estimate(1234));
+  ASSERT_EQ(0, sketch.estimate(4321));
+  // counter is saturated at MAX_FREQ
+  for (int64_t i = 0; i < 2 * ObKVCacheFreqSketch::MAX_FREQ; ++i) {
+    sketch.increment(1234);
+  }
+  ASSERT_EQ(ObKVCacheFreqSketch::MAX_FREQ, sketch.estimate(1234));
+  sketch.age();
+  ASSERT_EQ(ObKVCacheFreqSketch::MAX_FREQ / 2, sketch.estimate(1234));
+
+  // aging is triggered automatically
+  for (int64_t i = 0; i < 2 * sketch.sample_size_; ++i) {
+    sketch.increment(i);
+  }
+  ASSERT_TRUE(sketch.add_cnt_ < sketch.sample_size_);
+  sketch.destroy();
+  ASSERT_FALSE(sketch.is_inited());
+}
+
+TEST_F(TestKVCache, admission)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 64;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  TestKey key;
+  TestValue value;
+  const TestValue* pvalue = NULL;
+  ObKVCacheHandle handle;
+  ObKVCacheInstHandle inst_handle;
+  key.v_ = 1234;
+  key.tenant_id_ = tenant_id_;
+  value.v_ = 4321;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test"));
+  // close background wash task, which refreshes need_admission_
+  TG_CANCEL(lib::TGDefIDs::KVCacheWash, ObKVGlobalCache::get_instance().wash_task_);
+  ASSERT_EQ(OB_SUCCESS,
+      ObKVGlobalCache::get_instance().insts_.get_cache_inst(ObKVCacheInstKey(cache.cache_id_, tenant_id_), inst_handle));
+  ObKVCacheStatus& status = inst_handle.get_inst()->status_;
+
+  // no admission if the tenant is not under memory pressure
+  ObKVGlobalCache::get_instance().store_.set_admission_enabled(true);
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(0, status.total_reject_cnt_.value());
+
+  // no admission if the cache does not opt in
+  status.need_admission_ = true;
+  key.v_ = 1238;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(0, status.total_reject_cnt_.value());
+  cache.set_admission_enabled(true);
+
+  // overwriting the cached kvpair is never rejected
+  key.v_ = 1234;
+  value.v_ = 4322;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(4322, pvalue->v_);
+  ASSERT_EQ(0, status.total_reject_cnt_.value());
+  value.v_ = 4321;
+
+  // key accessed only once is rejected
+  key.v_ = 1235;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  ASSERT_EQ(1, status.total_reject_cnt_.value());
+  // put_and_fetch is never rejected
+  key.v_ = 1236;
+  ASSERT_EQ(OB_SUCCESS, cache.put_and_fetch(key, value, pvalue, handle));
+  ASSERT_EQ(value.v_, pvalue->v_);
+
+  // the second miss makes it admitted
+  key.v_ = 1235;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(1, status.total_admit_cnt_.value());
+
+  // admission is turned off
+  ObKVGlobalCache::get_instance().store_.set_admission_enabled(false);
+  key.v_ = 1237;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(1, status.total_reject_cnt_.value());
+  handle.reset();
+  inst_handle.reset();
+}
+
 TEST_F(TestKVCache, test_hold_size)
 {
   static const int64_t K_SIZE = 16;
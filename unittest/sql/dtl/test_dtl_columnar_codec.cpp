@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+#include "sql/dtl/ob_dtl_msg.h"
+#include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::sql::dtl;
+using namespace oceanbase::common;
+
+static const int64_t BUF_SIZE = 64 << 10;
+static const int64_t COLS = 3;
+
+class TestDtlColumnarCodec : public ::testing::Test {
+  public:
+  virtual void SetUp() override
+  {
+    MEMSET(src_, 0, sizeof(src_));
+    MEMSET(dst_, 0, sizeof(dst_));
+  }
+
+  // fill rows of (int, nullable int, varchar) until the block is full
+  int64_t fill_block(ObChunkDatumStore::Block*& blk)
+  {
+    int64_t rows = 0;
+    EXPECT_EQ(OB_SUCCESS, ObChunkDatumStore::init_block_buffer(src_, BUF_SIZE, blk));
+    ObChunkDatumStore::BlockBuffer* buf = blk->get_buffer();
+    char str[64];
+    while (true) {
+      int64_t int_val = rows * 7;
+      ObDatum datums[COLS];
+      datums[0].ptr_ = reinterpret_cast<const char*>(&int_val);
+      datums[0].len_ = sizeof(int_val);
+      if (0 == rows % 3) {
+        datums[1].set_null();
+      } else {
+        datums[1].ptr_ = reinterpret_cast<const char*>(&int_val);
+        datums[1].len_ = sizeof(int_val);
+      }
+      const int64_t str_len = rows % 50;
+      MEMSET(str, 'a' + rows % 26, str_len);
+      datums[2].ptr_ = str;
+      datums[2].len_ = static_cast<uint32_t>(str_len);
+      const int64_t row_size = ObChunkDatumStore::Block::row_store_size(datums, COLS);
+      if (row_size > buf->remain()) {
+        break;
+      }
+      ObChunkDatumStore::StoredRow* sr = reinterpret_cast<ObChunkDatumStore::StoredRow*>(buf->head());
+      EXPECT_EQ(OB_SUCCESS, sr->copy_datums(datums, COLS, sr->payload_, buf->remain(), row_size, 0));
+      EXPECT_EQ(OB_SUCCESS, buf->advance(row_size));
+      ++blk->rows_;
+      ++rows;
+    }
+    EXPECT_EQ(OB_SUCCESS, blk->unswizzling());
+    return rows;
+  }
+
+  // datum pointers of null cells are not kept, compare the swizzled rows
+  void check_rows(char* src, char* dst, const int64_t rows)
+  {
+    ObChunkDatumStore::Block* src_blk = reinterpret_cast<ObChunkDatumStore::Block*>(src);
+    ObChunkDatumStore::Block* dst_blk = reinterpret_cast<ObChunkDatumStore::Block*>(dst);
+    ASSERT_EQ(src_blk->rows_, dst_blk->rows_);
+    ASSERT_EQ(OB_SUCCESS, src_blk->swizzling(NULL));
+    ASSERT_EQ(OB_SUCCESS, dst_blk->swizzling(NULL));
+    int64_t src_pos = 0;
+    int64_t dst_pos = 0;
+    const ObChunkDatumStore::StoredRow* src_sr = NULL;
+    const ObChunkDatumStore::StoredRow* dst_sr = NULL;
+    for (int64_t i = 0; i < rows; ++i) {
+      ASSERT_EQ(OB_SUCCESS, src_blk->get_store_row(src_pos, src_sr));
+      ASSERT_EQ(OB_SUCCESS, dst_blk->get_store_row(dst_pos, dst_sr));
+      ASSERT_EQ(src_sr->cnt_, dst_sr->cnt_);
+      ASSERT_EQ(src_sr->row_size_, dst_sr->row_size_);
+      for (int64_t j = 0; j < COLS; ++j) {
+        ASSERT_TRUE(ObDatum::binary_equal(src_sr->cells()[j], dst_sr->cells()[j]));
+      }
+    }
+  }
+
+  protected:
+  char src_[BUF_SIZE];
+  char dst_[BUF_SIZE];
+};
+
+TEST_F(TestDtlColumnarCodec, encode_decode)
+{
+  ObChunkDatumStore::Block* blk = NULL;
+  const int64_t rows = fill_block(blk);
+  ASSERT_GT(rows, 0);
+  bool encoded = false;
+  ASSERT_EQ(OB_SUCCESS, ObDtlColumnarCodec::encode(src_, BUF_SIZE, dst_, encoded));
+  ASSERT_TRUE(encoded);
+  ASSERT_NE(0, MEMCMP(src_, dst_, BUF_SIZE));
+  ASSERT_EQ(OB_SUCCESS, ObDtlColumnarCodec::decode(dst_, BUF_SIZE, OB_SYS_TENANT_ID));
+
+  check_rows(src_, dst_, rows);
+}
+
+TEST_F(TestDtlColumnarCodec, serialize)
+{
+  ObChunkDatumStore::Block* blk = NULL;
+  const int64_t rows = fill_block(blk);
+  ObDtlLinkedBuffer buffer(src_, BUF_SIZE);
+  buffer.set_msg_type(ObDtlMsgType::PX_DATUM_ROW);
+  buffer.tenant_id() = OB_SYS_TENANT_ID;
+  buffer.add_flag(DTL_COLUMNAR_ENCODING);
+  const int64_t len = buffer.get_serialize_size();
+  char* ser_buf = static_cast<char*>(ob_malloc(len, ObModIds::TEST));
+  ASSERT_TRUE(NULL != ser_buf);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, buffer.serialize(ser_buf, len, pos));
+  ASSERT_EQ(len, pos);
+
+  ObDtlLinkedBuffer recv_buffer;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, recv_buffer.deserialize(ser_buf, len, pos));
+  ASSERT_FALSE(recv_buffer.has_flag(DTL_COLUMNAR_ENCODING));
+  check_rows(src_, recv_buffer.buf(), rows);
+  ob_free(ser_buf);
+}
+
+TEST_F(TestDtlColumnarCodec, empty_block)
+{
+  ObChunkDatumStore::Block* blk = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObChunkDatumStore::init_block_buffer(src_, BUF_SIZE, blk));
+  bool encoded = true;
+  ASSERT_EQ(OB_SUCCESS, ObDtlColumnarCodec::encode(src_, BUF_SIZE, dst_, encoded));
+  ASSERT_FALSE(encoded);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
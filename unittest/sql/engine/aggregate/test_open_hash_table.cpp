@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "sql/engine/aggregate/ob_exec_hash_struct.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+struct TestItem {
+  TestItem() : key_(0), hash_(0)
+  {}
+  uint64_t hash() const
+  {
+    return hash_;
+  }
+  bool operator==(const TestItem& other) const
+  {
+    return key_ == other.key_;
+  }
+  TO_STRING_KV(K_(key), K_(hash));
+  int64_t key_;
+  uint64_t hash_;
+};
+
+class TestOpenHashTable : public ::testing::Test {
+  public:
+  TestOpenHashTable() : alloc_(ObModIds::TEST), attr_(OB_SERVER_TENANT_ID, ObModIds::TEST)
+  {}
+  void fill(ObOpenHashTable<TestItem>& ht, TestItem* items, const int64_t cnt, const uint64_t hash_mod)
+  {
+    for (int64_t i = 0; i < cnt; i++) {
+      items[i].key_ = i;
+      items[i].hash_ = i % hash_mod;
+      ASSERT_EQ(OB_SUCCESS, ht.set(items[i]));
+    }
+  }
+
+  protected:
+  ObArenaAllocator alloc_;
+  lib::ObMemAttr attr_;
+};
+
+struct CountCb {
+  CountCb() : cnt_(0)
+  {}
+  int operator()(TestItem& item)
+  {
+    UNUSED(item);
+    cnt_++;
+    return OB_SUCCESS;
+  }
+  int64_t cnt_;
+};
+
+TEST_F(TestOpenHashTable, basic)
+{
+  ObOpenHashTable<TestItem> ht;
+  const int64_t cnt = 10000;
+  TestItem items[cnt];
+  ASSERT_EQ(OB_SUCCESS, ht.init(&alloc_, attr_, 16));
+  ASSERT_TRUE(ht.is_inited());
+  fill(ht, items, cnt, UINT64_MAX);
+  ASSERT_EQ(cnt, ht.size());
+  // load factor is kept no more than 1 / SIZE_BUCKET_SCALE
+  ASSERT_GE(ht.get_bucket_num(), cnt * ObOpenHashTable<TestItem>::SIZE_BUCKET_SCALE);
+  ASSERT_EQ(0, ht.get_bucket_num() & (ht.get_bucket_num() - 1));
+  for (int64_t i = 0; i < cnt; i++) {
+    ht.prefetch(items[i].hash());
+    const TestItem* res = ht.get(items[i]);
+    ASSERT_TRUE(NULL != res);
+    ASSERT_EQ(&items[i], res);
+  }
+  TestItem miss;
+  miss.key_ = cnt + 1;
+  miss.hash_ = 1;
+  ASSERT_TRUE(NULL == ht.get(miss));
+  CountCb cb;
+  ASSERT_EQ(OB_SUCCESS, ht.foreach (cb));
+  ASSERT_EQ(cnt, cb.cnt_);
+
+  ht.reuse();
+  ASSERT_EQ(0, ht.size());
+  ASSERT_TRUE(NULL == ht.get(items[0]));
+  ht.destroy();
+  ASSERT_FALSE(ht.is_inited());
+}
+
+TEST_F(TestOpenHashTable, collision)
+{
+  ObOpenHashTable<TestItem> ht;
+  const int64_t cnt = 1000;
+  TestItem items[cnt];
+  ASSERT_EQ(OB_SUCCESS, ht.init(&alloc_, attr_));
+  // many items share the same hash value, found by probing
+  fill(ht, items, cnt, 7);
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(&items[i], ht.get(items[i]));
+  }
+  const int64_t bucket_num = ht.get_bucket_num();
+  ASSERT_EQ(OB_SUCCESS, ht.resize(&alloc_, bucket_num));
+  ASSERT_EQ(bucket_num, ht.get_bucket_num());
+  ASSERT_EQ(0, ht.size());
+  ASSERT_EQ(OB_SUCCESS, ht.resize(&alloc_, 2));
+  ASSERT_LT(ht.get_bucket_num(), bucket_num);
+  fill(ht, items, cnt, 3);
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(&items[i], ht.get(items[i]));
+  }
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
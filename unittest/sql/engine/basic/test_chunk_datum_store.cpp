@@ -625,6 +625,33 @@ TEST_F(TestChunkDatumStore, disk_with_chunk)
   rs.reset();
 }
 
+TEST_F(TestChunkDatumStore, disk_with_compress)
+{
+  int64_t cnt = 20000;
+  ObChunkDatumStore rs;
+  ObChunkDatumStore::Iterator it;
+  GCONF._chunk_row_store_compress_func.set_value("lz4_1.0");
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  rs.set_mem_limit(1L << 20);
+  CALL(append_rows, rs, cnt);
+  ASSERT_EQ(OB_SUCCESS, rs.finish_add_row());
+  ASSERT_TRUE(rs.is_file_compressed());
+  ASSERT_GT(rs.frames_.count(), 0);
+  ASSERT_LT(rs.tmp_file_size_, rs.get_file_size());
+  LOG_INFO("compressed file", K(rs.get_file_size()), K(rs.tmp_file_size_), K(rs.frames_.count()));
+
+  // read block by block and by chunks not aligned with blocks
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true);
+  it.reset();
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 1L << 20);
+  it.reset();
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 3L << 20);
+  it.reset();
+  rs.reset();
+  GCONF._chunk_row_store_compress_func.set_value("none");
+}
+
 TEST_F(TestChunkDatumStore, test_add_block)
 {
   int ret = OB_SUCCESS;
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+class ObExprBatchKernelTest : public ::testing::Test {
+  public:
+  // odd count to cover the scalar tail of every SIMD level
+  static const int64_t VALUE_CNT = 203;
+  virtual void SetUp();
+  virtual void TearDown();
+
+  protected:
+  template <typename T>
+  static int64_t cmp_ref(const ObCmpOp cmp_op, const T l, const T r)
+  {
+    const int cmp = l == r ? 0 : (l < r ? -1 : 1);
+    int64_t res = 0;
+    switch (cmp_op) {
+      case CO_EQ:
+        res = 0 == cmp;
+        break;
+      case CO_LE:
+        res = cmp <= 0;
+        break;
+      case CO_LT:
+        res = cmp < 0;
+        break;
+      case CO_GE:
+        res = cmp >= 0;
+        break;
+      case CO_GT:
+        res = cmp > 0;
+        break;
+      case CO_NE:
+        res = 0 != cmp;
+        break;
+      default:
+        res = cmp;
+        break;
+    }
+    return res;
+  }
+
+  ObBatchKernel::SimdLevel saved_level_;
+  int64_t int_l_[VALUE_CNT];
+  int64_t int_r_[VALUE_CNT];
+  double double_l_[VALUE_CNT];
+  double double_r_[VALUE_CNT];
+};
+
+void ObExprBatchKernelTest::SetUp()
+{
+  saved_level_ = ObBatchKernel::get_simd_level();
+  const int64_t specials[] = {INT64_MIN, INT64_MIN + 1, -1, 0, 1, INT64_MAX - 1, INT64_MAX};
+  const double double_specials[] = {-INFINITY, -1.5, -0.0, 0.0, 1.5, INFINITY, NAN};
+  const int64_t special_cnt = sizeof(specials) / sizeof(specials[0]);
+  for (int64_t i = 0; i < VALUE_CNT; ++i) {
+    int_l_[i] = specials[i % special_cnt];
+    int_r_[i] = specials[(i / special_cnt) % special_cnt];
+    double_l_[i] = double_specials[i % special_cnt];
+    double_r_[i] = double_specials[(i / special_cnt) % special_cnt];
+  }
+}
+
+void ObExprBatchKernelTest::TearDown()
+{
+  ASSERT_EQ(OB_SUCCESS, ObBatchKernel::set_simd_level(saved_level_));
+}
+
+TEST_F(ObExprBatchKernelTest, simd_level)
+{
+  ASSERT_LE(ObBatchKernel::get_simd_level(), ObBatchKernel::get_cpu_simd_level());
+  ASSERT_EQ(OB_SUCCESS, ObBatchKernel::set_simd_level(ObBatchKernel::SIMD_NONE));
+  ASSERT_EQ(ObBatchKernel::SIMD_NONE, ObBatchKernel::get_simd_level());
+  if (ObBatchKernel::get_cpu_simd_level() < ObBatchKernel::SIMD_AVX512) {
+    ASSERT_EQ(OB_NOT_SUPPORTED, ObBatchKernel::set_simd_level(ObBatchKernel::SIMD_AVX512));
+    ASSERT_EQ(ObBatchKernel::SIMD_NONE, ObBatchKernel::get_simd_level());
+  }
+}
+
+TEST_F(ObExprBatchKernelTest, cmp)
+{
+  int64_t res[VALUE_CNT];
+  for (int level = 0; level <= ObBatchKernel::get_cpu_simd_level(); ++level) {
+    ASSERT_EQ(OB_SUCCESS, ObBatchKernel::set_simd_level(static_cast<ObBatchKernel::SimdLevel>(level)));
+    for (int op = CO_EQ; op < CO_MAX; ++op) {
+      const ObCmpOp cmp_op = static_cast<ObCmpOp>(op);
+      ObBatchKernel::cmp(cmp_op, int_l_, int_r_, res, VALUE_CNT);
+      for (int64_t i = 0; i < VALUE_CNT; ++i) {
+        ASSERT_EQ(cmp_ref(cmp_op, int_l_[i], int_r_[i]), res[i]) << "level " << level << " op " << op << " i " << i;
+      }
+      ObBatchKernel::cmp(cmp_op, double_l_, double_r_, res, VALUE_CNT);
+      for (int64_t i = 0; i < VALUE_CNT; ++i) {
+        ASSERT_EQ(cmp_ref(cmp_op, double_l_[i], double_r_[i]), res[i])
+            << "level " << level << " op " << op << " i " << i;
+      }
+    }
+  }
+}
+
+TEST_F(ObExprBatchKernelTest, arith)
+{
+  int64_t int_res[VALUE_CNT];
+  double double_res[VALUE_CNT];
+  const int64_t small[] = {1, -2, 3, -4, 5};
+  for (int level = 0; level <= ObBatchKernel::get_cpu_simd_level(); ++level) {
+    ASSERT_EQ(OB_SUCCESS, ObBatchKernel::set_simd_level(static_cast<ObBatchKernel::SimdLevel>(level)));
+    // no overflow
+    ASSERT_FALSE(ObBatchKernel::arith(ObBatchKernel::ARITH_ADD, small, small, int_res, 5));
+    ASSERT_EQ(-8, int_res[3]);
+    ASSERT_FALSE(ObBatchKernel::arith(ObBatchKernel::ARITH_SUB, small, small, int_res, 5));
+    ASSERT_EQ(0, int_res[4]);
+    ASSERT_FALSE(ObBatchKernel::arith(ObBatchKernel::ARITH_MUL, small, small, int_res, 5));
+    ASSERT_EQ(25, int_res[4]);
+    // the extreme values overflow
+    ASSERT_TRUE(ObBatchKernel::arith(ObBatchKernel::ARITH_ADD, int_l_, int_r_, int_res, VALUE_CNT));
+    ASSERT_TRUE(ObBatchKernel::arith(ObBatchKernel::ARITH_SUB, int_l_, int_r_, int_res, VALUE_CNT));
+    ASSERT_TRUE(ObBatchKernel::arith(ObBatchKernel::ARITH_MUL, int_l_, int_r_, int_res, VALUE_CNT));
+    // overflow only in the tail
+    int_l_[VALUE_CNT - 1] = INT64_MAX;
+    int_r_[VALUE_CNT - 1] = 1;
+    for (int64_t i = 0; i < VALUE_CNT - 1; ++i) {
+      int_l_[i] = i;
+      int_r_[i] = -i;
+    }
+    ASSERT_FALSE(ObBatchKernel::arith(ObBatchKernel::ARITH_ADD, int_l_, int_r_, int_res, VALUE_CNT - 1));
+    ASSERT_TRUE(ObBatchKernel::arith(ObBatchKernel::ARITH_ADD, int_l_, int_r_, int_res, VALUE_CNT));
+    SetUp();
+
+    ASSERT_TRUE(ObBatchKernel::arith(ObBatchKernel::ARITH_ADD, double_l_, double_r_, double_res, VALUE_CNT));
+    for (int64_t i = 0; i < VALUE_CNT; ++i) {
+      double_l_[i] = static_cast<double>(i) / 3;
+      double_r_[i] = static_cast<double>(i) * 7;
+    }
+    ASSERT_FALSE(ObBatchKernel::arith(ObBatchKernel::ARITH_MUL, double_l_, double_r_, double_res, VALUE_CNT));
+    for (int64_t i = 0; i < VALUE_CNT; ++i) {
+      ASSERT_EQ(double_l_[i] * double_r_[i], double_res[i]);
+    }
+    SetUp();
+  }
+}
+
+TEST_F(ObExprBatchKernelTest, murmur_hash)
+{
+  uint64_t vals[VALUE_CNT];
+  uint64_t hash[VALUE_CNT];
+  for (int level = 0; level <= ObBatchKernel::get_cpu_simd_level(); ++level) {
+    ASSERT_EQ(OB_SUCCESS, ObBatchKernel::set_simd_level(static_cast<ObBatchKernel::SimdLevel>(level)));
+    for (int64_t i = 0; i < VALUE_CNT; ++i) {
+      vals[i] = static_cast<uint64_t>(int_l_[i]) * (i + 1);
+      hash[i] = static_cast<uint64_t>(int_r_[i]) ^ i;
+    }
+    ObBatchKernel::murmur_hash(vals, hash, VALUE_CNT);
+    for (int64_t i = 0; i < VALUE_CNT; ++i) {
+      const uint64_t seed = static_cast<uint64_t>(int_r_[i]) ^ i;
+      ASSERT_EQ(murmurhash64A(&vals[i], sizeof(vals[i]), seed), hash[i]) << "level " << level << " i " << i;
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
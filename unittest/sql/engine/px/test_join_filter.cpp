@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+#include "lib/hash_func/murmur_hash.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObRuntimeJoinFilterTest : public ::testing::Test {
+  public:
+  ObRuntimeJoinFilterTest() = default;
+  virtual ~ObRuntimeJoinFilterTest() = default;
+  virtual void SetUp(){};
+  virtual void TearDown(){};
+
+  protected:
+  static uint64_t hash(const int64_t v)
+  {
+    return murmurhash64A(&v, sizeof(v), 0);
+  }
+  ObDatum& key(const int64_t v)
+  {
+    datum_.ptr_ = buf_;
+    datum_.set_int(v);
+    return datum_;
+  }
+  // insert [begin, end) to filter
+  void insert(ObRuntimeJoinFilter& filter, const int64_t begin, const int64_t end)
+  {
+    for (int64_t i = begin; i < end; i++) {
+      ASSERT_EQ(OB_SUCCESS, filter.insert(hash(i), key(i)));
+    }
+  }
+  bool contain(const ObRuntimeJoinFilter& filter, const int64_t v)
+  {
+    return filter.might_contain(hash(v), key(v));
+  }
+
+  private:
+  char buf_[sizeof(int64_t)];
+  ObDatum datum_;
+
+  // disallow copy
+  ObRuntimeJoinFilterTest(const ObRuntimeJoinFilterTest& other);
+  ObRuntimeJoinFilterTest& operator=(const ObRuntimeJoinFilterTest& other);
+};
+
+TEST_F(ObRuntimeJoinFilterTest, in_list_and_range)
+{
+  ObRuntimeJoinFilter filter;
+  ASSERT_FALSE(filter.is_inited());
+  ASSERT_EQ(OB_NOT_INIT, filter.insert(hash(1), key(1)));
+
+  ASSERT_EQ(OB_SUCCESS, filter.init(100, true));
+  insert(filter, 100, 200);
+  filter.finish();
+  ASSERT_EQ(100, filter.get_row_count());
+  for (int64_t i = 100; i < 200; i++) {
+    ASSERT_TRUE(contain(filter, i));
+  }
+  // filtered by the range filter
+  ASSERT_FALSE(contain(filter, 99));
+  ASSERT_FALSE(contain(filter, 200));
+  // null passes the range filter, but not in the IN list
+  ObDatum null_datum;
+  null_datum.set_null();
+  ASSERT_FALSE(filter.might_contain(hash(300), null_datum));
+}
+
+TEST_F(ObRuntimeJoinFilterTest, bloom_filter)
+{
+  ObRuntimeJoinFilter filter;
+  const int64_t cnt = ObRuntimeJoinFilter::MAX_IN_LIST_COUNT * 4;
+  ASSERT_EQ(OB_SUCCESS, filter.init(cnt * 8, false));
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, filter.insert(hash(i * 2), key(i * 2)));
+  }
+  filter.finish();
+  int64_t false_positive = 0;
+  for (int64_t i = 0; i < cnt; i++) {
+    // no false negative
+    ASSERT_TRUE(contain(filter, i * 2));
+    false_positive += contain(filter, i * 2 + 1) ? 1 : 0;
+  }
+  LOG_INFO("bloom filter false positive", K(false_positive), K(cnt), K(filter));
+  ASSERT_LT(false_positive, cnt / 10);
+}
+
+TEST_F(ObRuntimeJoinFilterTest, merge_and_serialize)
+{
+  ObRuntimeJoinFilter f1;
+  ObRuntimeJoinFilter f2;
+  ObRuntimeJoinFilter f3;
+  ObRuntimeJoinFilter empty;
+  ASSERT_EQ(OB_SUCCESS, f1.init(1024, true));
+  ASSERT_EQ(OB_SUCCESS, f2.init(1024, true));
+  ASSERT_EQ(OB_SUCCESS, f3.init(1L << 20, true));
+  insert(f1, 0, 10);
+  insert(f2, 1000, 1010);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, f1.merge(f3));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, f1.merge(empty));
+  ASSERT_EQ(OB_SUCCESS, f1.merge(f2));
+  f1.finish();
+  ASSERT_EQ(20, f1.get_row_count());
+
+  const int64_t size = f1.get_serialize_size();
+  char* buf = static_cast<char*>(ob_malloc(size, ObModIds::TEST));
+  ASSERT_TRUE(NULL != buf);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, f1.serialize(buf, size, pos));
+  ASSERT_EQ(size, pos);
+  ObRuntimeJoinFilter f4;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, f4.deserialize(buf, size, pos));
+  ASSERT_EQ(size, pos);
+  ob_free(buf);
+
+  ASSERT_EQ(20, f4.get_row_count());
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_TRUE(contain(f4, i));
+    ASSERT_TRUE(contain(f4, 1000 + i));
+  }
+  // in range, but not in the IN list
+  ASSERT_FALSE(contain(f4, 500));
+  ASSERT_FALSE(contain(f4, 2000));
+}
+
+TEST_F(ObRuntimeJoinFilterTest, in_list_overflow)
+{
+  ObRuntimeJoinFilter f1;
+  ObRuntimeJoinFilter f2;
+  const int64_t half = ObRuntimeJoinFilter::MAX_IN_LIST_COUNT / 2 + 1;
+  ASSERT_EQ(OB_SUCCESS, f1.init(0, false));
+  ASSERT_EQ(OB_SUCCESS, f2.init(0, false));
+  insert(f1, 0, half);
+  insert(f2, half, half * 2);
+  ASSERT_EQ(OB_SUCCESS, f1.merge(f2));
+  f1.finish();
+  // fallback to bloom filter
+  ASSERT_FALSE(f1.is_pass_all());
+  for (int64_t i = 0; i < half * 2; i++) {
+    ASSERT_TRUE(contain(f1, i));
+  }
+}
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
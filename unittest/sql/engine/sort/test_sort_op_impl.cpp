@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include "lib/alloc/ob_malloc_allocator.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/ob_sql_init.h"
+#define private public
+#define protected public
+#include "sql/engine/sort/ob_sort_op_impl.h"
+#undef private
+#undef protected
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+class TestSortOpImpl : public ::testing::Test {
+  public:
+  static const int64_t COL_CNT = 3;
+  static const int64_t ROW_CNT = 4 * ObSortOpImpl::RADIX_SORT_THRESHOLD + 7;
+  TestSortOpImpl() : alloc_(ObModIds::TEST), eval_ctx_(exec_ctx_, eval_res_, eval_tmp_)
+  {}
+  virtual ~TestSortOpImpl()
+  {}
+  virtual void TearDown() override
+  {
+    alloc_.reset();
+  }
+
+  protected:
+  ObChunkDatumStore::StoredRow* make_row(
+      const ObObjType type, const bool k1_null, const int64_t k1, const int64_t k2, const int64_t seq);
+  // Radix sort ROW_CNT rows and compare the sort keys with the comparator sorted rows. The first
+  // sort key has %distinct_cnt distinct values, including negative and 64 bits wide values, every
+  // 11th is null. The second sort key is used to break the ties of the first if %multi_keys.
+  void check_radix_sort(const ObObjType type, const bool is_ascending, const ObCmpNullPos null_pos,
+      const bool multi_keys, const int64_t distinct_cnt, const int64_t begin = 0);
+
+  protected:
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObArenaAllocator eval_res_;
+  ObArenaAllocator eval_tmp_;
+  ObEvalCtx eval_ctx_;
+};
+
+ObChunkDatumStore::StoredRow* TestSortOpImpl::make_row(
+    const ObObjType type, const bool k1_null, const int64_t k1, const int64_t k2, const int64_t seq)
+{
+  ObChunkDatumStore::StoredRow* row = NULL;
+  const int64_t row_size = sizeof(ObChunkDatumStore::StoredRow) + (sizeof(ObDatum) + sizeof(int64_t)) * COL_CNT;
+  char* buf = static_cast<char*>(alloc_.alloc(row_size));
+  if (NULL != buf) {
+    row = new (buf) ObChunkDatumStore::StoredRow();
+    row->cnt_ = COL_CNT;
+    row->row_size_ = static_cast<uint32_t>(row_size);
+    char* data = row->payload_ + sizeof(ObDatum) * COL_CNT;
+    for (int64_t i = 0; i < COL_CNT; i++) {
+      ObDatum* datum = new (&row->cells()[i]) ObDatum();
+      datum->ptr_ = data + sizeof(int64_t) * i;
+    }
+    if (k1_null) {
+      row->cells()[0].set_null();
+    } else if (ObUInt64Type == type) {
+      row->cells()[0].set_uint(static_cast<uint64_t>(k1));
+    } else if (ObDateType == type) {
+      row->cells()[0].set_date(static_cast<int32_t>(k1));
+    } else {
+      row->cells()[0].set_int(k1);
+    }
+    row->cells()[1].set_int(k2);
+    row->cells()[2].set_int(seq);
+  }
+  return row;
+}
+
+void TestSortOpImpl::check_radix_sort(const ObObjType type, const bool is_ascending, const ObCmpNullPos null_pos,
+    const bool multi_keys, const int64_t distinct_cnt, const int64_t begin)
+{
+  ObSortOpImpl sort_impl;
+  ObSEArray<ObSortFieldCollation, 2> collations;
+  ObSEArray<ObSortCmpFunc, 2> cmp_funs;
+  ObSortCmpFunc cmp_fun;
+  ObExpr exprs[COL_CNT];
+  ObSEArray<ObExpr*, COL_CNT> expr_ptrs;
+  ObArray<ObChunkDatumStore::StoredRow*> expect_rows;
+  ObArray<bool> seq_found;
+  // null values of the first key are compared as minimal if NULL_FIRST, reversed if descending
+  const bool null_first = (NULL_FIRST == null_pos) == is_ascending;
+
+  exprs[0].datum_meta_.type_ = type;
+  exprs[1].datum_meta_.type_ = ObIntType;
+  exprs[2].datum_meta_.type_ = ObIntType;
+  for (int64_t i = 0; i < COL_CNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, expr_ptrs.push_back(&exprs[i]));
+  }
+  ASSERT_EQ(OB_SUCCESS, collations.push_back(ObSortFieldCollation(0, CS_TYPE_BINARY, is_ascending, null_pos)));
+  cmp_fun.cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(type, type, null_pos, CS_TYPE_BINARY, false);
+  ASSERT_EQ(OB_SUCCESS, cmp_funs.push_back(cmp_fun));
+  if (multi_keys) {
+    ASSERT_EQ(OB_SUCCESS, collations.push_back(ObSortFieldCollation(1, CS_TYPE_BINARY, !is_ascending, NULL_FIRST)));
+    cmp_fun.cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(ObIntType, ObIntType, NULL_FIRST, CS_TYPE_BINARY, false);
+    ASSERT_EQ(OB_SUCCESS, cmp_funs.push_back(cmp_fun));
+  }
+  ASSERT_EQ(OB_SUCCESS, sort_impl.init(OB_SYS_TENANT_ID, &collations, &cmp_funs, &eval_ctx_));
+  ASSERT_EQ(OB_SUCCESS, sort_impl.init_normalized_key(expr_ptrs));
+  ASSERT_NE(ObSortOpImpl::NORMALIZED_KEY_NONE, sort_impl.normalized_key_type_);
+  ASSERT_EQ(OB_SUCCESS, sort_impl.comp_.init(&collations, &cmp_funs));
+
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    int64_t k1 = (i * 7919) % distinct_cnt - distinct_cnt / 2;
+    if (ObDateType != type && 0 == i % 5) {
+      k1 *= (1LL << 40) + 1;
+    } else if (ObDateType != type && 1 == i % 101) {
+      k1 = 0 == i % 2 ? INT64_MAX : INT64_MIN;
+    }
+    ObChunkDatumStore::StoredRow* row = make_row(type, 3 == i % 11, k1, (i * 31) % 7 - 3, i);
+    ASSERT_TRUE(NULL != row);
+    ASSERT_EQ(OB_SUCCESS, sort_impl.rows_.push_back(row));
+    ASSERT_EQ(OB_SUCCESS, expect_rows.push_back(row));
+    ASSERT_EQ(OB_SUCCESS, seq_found.push_back(false));
+  }
+  ASSERT_GE(ROW_CNT - begin, ObSortOpImpl::RADIX_SORT_THRESHOLD);
+  std::sort(&expect_rows.at(begin), &expect_rows.at(0) + ROW_CNT, ObSortOpImpl::CopyableComparer(sort_impl.comp_));
+  ASSERT_EQ(OB_SUCCESS, sort_impl.comp_.ret_);
+  ASSERT_EQ(OB_SUCCESS, sort_impl.radix_sort(begin, ROW_CNT));
+  ASSERT_EQ(OB_SUCCESS, sort_impl.comp_.ret_);
+
+  // rows before %begin are not touched
+  for (int64_t i = 0; i < begin; i++) {
+    ASSERT_EQ(expect_rows.at(i), sort_impl.rows_.at(i));
+  }
+  ASSERT_EQ(null_first, sort_impl.rows_.at(begin)->cells()[0].is_null());
+  ASSERT_EQ(!null_first, sort_impl.rows_.at(ROW_CNT - 1)->cells()[0].is_null());
+  for (int64_t i = begin; i < ROW_CNT; i++) {
+    const ObDatum* expect = expect_rows.at(i)->cells();
+    const ObDatum* sorted = sort_impl.rows_.at(i)->cells();
+    // rows with the same sort keys may be in any order, compare the sort keys only
+    for (int64_t j = 0; j < cmp_funs.count(); j++) {
+      ASSERT_EQ(0, cmp_funs.at(j).cmp_func_(expect[j], sorted[j])) << "row: " << i << " key: " << j;
+    }
+    ASSERT_FALSE(seq_found.at(sorted[2].get_int()));
+    seq_found.at(sorted[2].get_int()) = true;
+  }
+  sort_impl.reset();
+}
+
+TEST_F(TestSortOpImpl, int_asc)
+{
+  check_radix_sort(ObIntType, true, NULL_FIRST, false, ROW_CNT);
+  check_radix_sort(ObIntType, true, NULL_LAST, false, ROW_CNT);
+}
+
+TEST_F(TestSortOpImpl, int_desc)
+{
+  check_radix_sort(ObIntType, false, NULL_FIRST, false, ROW_CNT);
+  check_radix_sort(ObIntType, false, NULL_LAST, false, ROW_CNT);
+}
+
+TEST_F(TestSortOpImpl, uint)
+{
+  check_radix_sort(ObUInt64Type, true, NULL_FIRST, false, ROW_CNT);
+  check_radix_sort(ObUInt64Type, false, NULL_LAST, false, ROW_CNT);
+}
+
+TEST_F(TestSortOpImpl, date)
+{
+  check_radix_sort(ObDateType, true, NULL_LAST, false, ROW_CNT);
+  check_radix_sort(ObDateType, false, NULL_FIRST, false, ROW_CNT);
+}
+
+TEST_F(TestSortOpImpl, multi_keys_with_ties)
+{
+  check_radix_sort(ObIntType, true, NULL_FIRST, true, 13);
+  check_radix_sort(ObIntType, true, NULL_LAST, true, 13);
+  check_radix_sort(ObIntType, false, NULL_FIRST, true, 13);
+  check_radix_sort(ObIntType, false, NULL_LAST, true, 13);
+  check_radix_sort(ObUInt64Type, false, NULL_LAST, true, 2);
+}
+
+TEST_F(TestSortOpImpl, increment_sort_range)
+{
+  check_radix_sort(ObIntType, true, NULL_LAST, true, 100, 1000);
+  check_radix_sort(ObIntType, false, NULL_FIRST, false, ROW_CNT, 1000);
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::sql::init_sql_factories();
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_sort_op_impl.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  int ret = oceanbase::lib::ObMallocAllocator::get_instance()->create_tenant_ctx_allocator(
+      oceanbase::common::OB_SYS_TENANT_ID, oceanbase::common::ObCtxIds::WORK_AREA);
+  if (oceanbase::common::OB_SUCCESS == ret) {
+    testing::InitGoogleTest(&argc, argv);
+    ret = RUN_ALL_TESTS();
+  }
+  return ret;
+}
@@ -0,0 +1,494 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/ob_operator.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/expr/ob_expr_batch_kernel.h"
+#undef protected
+#undef private
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+// Batch (vectorized) execution must produce the same results as row by row execution.
+
+static const int64_t ROW_CNT = 1000;
+static const int64_t BATCH_SIZE = 64;
+// short reserved buffer, longer strings are allocated in the dynamic reserved buffer of each row
+static const int64_t STR_RES_BUF_LEN = 4;
+
+static int eval_lt(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum)
+{
+  int ret = OB_SUCCESS;
+  ObDatum* l = NULL;
+  ObDatum* r = NULL;
+  if (OB_FAIL(expr.eval_param_value(ctx, l, r))) {
+  } else if (l->is_null() || r->is_null()) {
+    expr_datum.set_null();
+  } else {
+    expr_datum.set_int(l->get_int() < r->get_int());
+  }
+  return ret;
+}
+
+static int eval_add(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum)
+{
+  int ret = OB_SUCCESS;
+  ObDatum* l = NULL;
+  ObDatum* r = NULL;
+  if (OB_FAIL(expr.eval_param_value(ctx, l, r))) {
+  } else if (l->is_null() || r->is_null()) {
+    expr_datum.set_null();
+  } else {
+    expr_datum.set_int(l->get_int() + r->get_int());
+  }
+  return ret;
+}
+
+static int eval_str(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum)
+{
+  int ret = OB_SUCCESS;
+  ObDatum* v = NULL;
+  if (OB_FAIL(expr.eval_param_value(ctx, v))) {
+  } else if (v->is_null()) {
+    expr_datum.set_null();
+  } else {
+    char buf[64];
+    const int64_t len = snprintf(buf, sizeof(buf), "%ld:%ld", v->get_int(), v->get_int() * v->get_int());
+    char* mem = expr.get_str_res_mem(ctx, len);
+    if (OB_ISNULL(mem)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      MEMCPY(mem, buf, len);
+      expr_datum.set_string(mem, len);
+    }
+  }
+  return ret;
+}
+
+// Expressions of:
+//   select c1, c2, c1 + c2, str(c1) from t where c2 < c1
+// laid out in one frame like ObStaticEngineExprCG::arrange_datum_data() does.
+struct TestExprs {
+  enum { C1 = 0, C2, ADD, STR, LT, EXPR_CNT };
+
+  void init(ObIAllocator& alloc, const int64_t max_batch_size)
+  {
+    ObExpr* all[EXPR_CNT] = {&c1_, &c2_, &add_, &str_, &lt_};
+    for (int64_t i = 0; i < EXPR_CNT; i++) {
+      all[i]->reset();
+      all[i]->datum_meta_.type_ = ObIntType;
+      all[i]->res_buf_len_ = sizeof(int64_t);
+    }
+    str_.datum_meta_.type_ = ObVarcharType;
+    str_.datum_meta_.cs_type_ = CS_TYPE_UTF8MB4_GENERAL_CI;
+    str_.res_buf_len_ = STR_RES_BUF_LEN;
+
+    add_args_[0] = &c1_;
+    add_args_[1] = &c2_;
+    add_.args_ = add_args_;
+    add_.arg_cnt_ = 2;
+    add_.eval_func_ = eval_add;
+    add_.eval_batch_func_ =
+        ObExprBatchEvalHelper::get_arith_batch_func(ObBatchKernel::ARITH_ADD, ObIntType, ObIntType, ObIntType);
+
+    lt_args_[0] = &c2_;
+    lt_args_[1] = &c1_;
+    lt_.args_ = lt_args_;
+    lt_.arg_cnt_ = 2;
+    lt_.eval_func_ = eval_lt;
+    lt_.eval_batch_func_ = ObExprBatchEvalHelper::get_relational_batch_func(ObIntType, ObIntType, CO_LT);
+
+    // no batch function, evaluated row by row in eval_batch()
+    str_args_[0] = &c1_;
+    str_.args_ = str_args_;
+    str_.arg_cnt_ = 1;
+    str_.eval_func_ = eval_str;
+
+    const bool batch_result = max_batch_size > 0;
+    const int64_t slot_cnt = ObExpr::get_batch_slot_cnt(max_batch_size);
+    const int64_t datum_size =
+        batch_result ? sizeof(ObDatum) * slot_cnt + sizeof(ObEvalInfo) + ObBitVector::memory_size(slot_cnt)
+                     : sizeof(ObDatum) + sizeof(ObEvalInfo);
+    int64_t data_off = EXPR_CNT * datum_size;
+    for (int64_t i = 0; i < EXPR_CNT; i++) {
+      ObExpr* e = all[i];
+      e->frame_idx_ = 0;
+      e->datum_off_ = i * datum_size;
+      e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum) * slot_cnt;
+      e->max_batch_size_ = max_batch_size;
+      e->batch_idx_mask_ = batch_result ? UINT64_MAX : 0;
+      const int64_t consume_size =
+          e->res_buf_len_ + (ObDynReserveBuf::supported(e->datum_meta_.type_) ? sizeof(ObDynReserveBuf) : 0);
+      data_off += consume_size;
+      e->res_buf_off_ = data_off - e->res_buf_len_;
+      e->res_buf_stride_ = batch_result ? consume_size : 0;
+      data_off += consume_size * (slot_cnt - 1);
+    }
+    frame_ = static_cast<char*>(alloc.alloc(data_off));
+    ASSERT_TRUE(NULL != frame_);
+    MEMSET(frame_, 0, data_off);
+    frames_[0] = frame_;
+  }
+
+  ObExpr c1_;
+  ObExpr c2_;
+  ObExpr add_;
+  ObExpr str_;
+  ObExpr lt_;
+  ObExpr* add_args_[2];
+  ObExpr* lt_args_[2];
+  ObExpr* str_args_[1];
+  char* frame_;
+  char* frames_[1];
+};
+
+// c2 is null for every 5th row, c1 + c2 and c2 < c1 are null for those rows.
+static void gen_row(const int64_t idx, ObDatum& c1, ObDatum& c2)
+{
+  c1.set_int(idx - ROW_CNT / 2);
+  if (0 == idx % 5) {
+    c2.set_null();
+  } else {
+    c2.set_int((idx * 7919) % 1000 - 500);
+  }
+}
+
+class ObTestSourceOp : public ObOperator {
+  public:
+  ObTestSourceOp(ObExecContext& exec_ctx, const ObOpSpec& spec, TestExprs& exprs, const bool batch_supported)
+      : ObOperator(exec_ctx, spec, NULL), exprs_(exprs), batch_supported_(batch_supported), idx_(0)
+  {}
+
+  virtual int inner_get_next_row() override
+  {
+    int ret = OB_SUCCESS;
+    clear_evaluated_flag();
+    if (idx_ >= ROW_CNT) {
+      ret = OB_ITER_END;
+    } else {
+      gen_row(idx_, exprs_.c1_.locate_datum_for_write(eval_ctx_), exprs_.c2_.locate_datum_for_write(eval_ctx_));
+      idx_++;
+    }
+    return ret;
+  }
+
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override
+  {
+    int ret = OB_SUCCESS;
+    if (!batch_supported_) {
+      ret = ObOperator::inner_get_next_batch(max_row_cnt);
+    } else {
+      clear_evaluated_flag();
+      ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+      int64_t cnt = 0;
+      for (; cnt < max_row_cnt && idx_ < ROW_CNT; cnt++, idx_++) {
+        batch_info_guard.set_batch_idx(cnt);
+        gen_row(idx_, exprs_.c1_.locate_datum_for_write(eval_ctx_), exprs_.c2_.locate_datum_for_write(eval_ctx_));
+      }
+      brs_.size_ = cnt;
+      brs_.end_ = idx_ >= ROW_CNT;
+    }
+    return ret;
+  }
+
+  virtual void destroy() override
+  {
+    ObOperator::destroy();
+  }
+
+  private:
+  TestExprs& exprs_;
+  bool batch_supported_;
+  int64_t idx_;
+};
+
+struct ResultRow {
+  bool operator==(const ResultRow& other) const
+  {
+    return c1_ == other.c1_ && c2_null_ == other.c2_null_ && c2_ == other.c2_ && add_null_ == other.add_null_ &&
+           add_ == other.add_ && str_ == other.str_;
+  }
+  TO_STRING_KV(K_(c1), K_(c2_null), K_(c2), K_(add_null), K_(add), K_(str));
+
+  int64_t c1_;
+  bool c2_null_;
+  int64_t c2_;
+  bool add_null_;
+  int64_t add_;
+  ObString str_;
+};
+
+class TestBatchExec : public ::testing::Test {
+  public:
+  TestBatchExec()
+      : alloc_(ObModIds::TEST),
+        res_alloc_(ObModIds::TEST),
+        tmp_alloc_(ObModIds::TEST),
+        eval_ctx_(exec_ctx_, res_alloc_, tmp_alloc_),
+        spec_(alloc_, PHY_EXPR_VALUES)
+  {}
+
+  void init(const int64_t max_batch_size)
+  {
+    exec_ctx_.eval_ctx_ = &eval_ctx_;
+    exprs_.init(alloc_, max_batch_size);
+    ASSERT_FALSE(HasFatalFailure());
+    eval_ctx_.frames_ = exprs_.frames_;
+    eval_ctx_.batch_idx_ = 0;
+    eval_ctx_.batch_size_ = 0;
+    spec_.max_batch_size_ = max_batch_size;
+    spec_.output_.reset();
+    spec_.filters_.reset();
+    spec_.calc_exprs_.reset();
+    ASSERT_EQ(OB_SUCCESS, spec_.output_.init(4));
+    ASSERT_EQ(OB_SUCCESS, spec_.output_.push_back(&exprs_.c1_));
+    ASSERT_EQ(OB_SUCCESS, spec_.output_.push_back(&exprs_.c2_));
+    ASSERT_EQ(OB_SUCCESS, spec_.output_.push_back(&exprs_.add_));
+    ASSERT_EQ(OB_SUCCESS, spec_.output_.push_back(&exprs_.str_));
+    ASSERT_EQ(OB_SUCCESS, spec_.filters_.init(1));
+    ASSERT_EQ(OB_SUCCESS, spec_.filters_.push_back(&exprs_.lt_));
+    ASSERT_EQ(OB_SUCCESS, spec_.calc_exprs_.init(3));
+    ASSERT_EQ(OB_SUCCESS, spec_.calc_exprs_.push_back(&exprs_.add_));
+    ASSERT_EQ(OB_SUCCESS, spec_.calc_exprs_.push_back(&exprs_.str_));
+    ASSERT_EQ(OB_SUCCESS, spec_.calc_exprs_.push_back(&exprs_.lt_));
+  }
+
+  // evaluate output expressions of current row, the batch index of evaluate context locates the row
+  void eval_row(ResultRow& row)
+  {
+    ObDatum* c1 = NULL;
+    ObDatum* c2 = NULL;
+    ObDatum* add = NULL;
+    ObDatum* str = NULL;
+    ASSERT_EQ(OB_SUCCESS, exprs_.c1_.eval(eval_ctx_, c1));
+    ASSERT_EQ(OB_SUCCESS, exprs_.c2_.eval(eval_ctx_, c2));
+    ASSERT_EQ(OB_SUCCESS, exprs_.add_.eval(eval_ctx_, add));
+    ASSERT_EQ(OB_SUCCESS, exprs_.str_.eval(eval_ctx_, str));
+    row.c1_ = c1->get_int();
+    row.c2_null_ = c2->is_null();
+    row.c2_ = c2->is_null() ? 0 : c2->get_int();
+    row.add_null_ = add->is_null();
+    row.add_ = add->is_null() ? 0 : add->get_int();
+    // deep copy, the string is overwritten by next row or batch
+    ASSERT_EQ(OB_SUCCESS, ob_write_string(alloc_, str->get_string(), row.str_));
+  }
+
+  void get_rows(ObOperator& op, ObIArray<ResultRow>& rows)
+  {
+    int ret = OB_SUCCESS;
+    ASSERT_EQ(OB_SUCCESS, op.open());
+    while (OB_SUCC(op.get_next_row())) {
+      ResultRow row;
+      eval_row(row);
+      ASSERT_FALSE(HasFatalFailure());
+      ASSERT_EQ(OB_SUCCESS, rows.push_back(row));
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+  }
+
+  void get_row_result(ObIArray<ResultRow>& rows)
+  {
+    init(0);
+    ASSERT_FALSE(HasFatalFailure());
+    ObTestSourceOp op(exec_ctx_, spec_, exprs_, false);
+    get_rows(op, rows);
+  }
+
+  protected:
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObArenaAllocator res_alloc_;
+  ObArenaAllocator tmp_alloc_;
+  ObEvalCtx eval_ctx_;
+  ObOpSpec spec_;
+  TestExprs exprs_;
+};
+
+TEST_F(TestBatchExec, expr_eval_batch)
+{
+  TestExprs row_exprs;
+  ObArenaAllocator alloc(ObModIds::TEST);
+  row_exprs.init(alloc, 0);
+  ASSERT_FALSE(HasFatalFailure());
+  init(BATCH_SIZE);
+  ASSERT_FALSE(HasFatalFailure());
+  char* skip_mem = static_cast<char*>(alloc.alloc(ObBitVector::memory_size(BATCH_SIZE)));
+  ASSERT_TRUE(NULL != skip_mem);
+  ObBitVector& skip = *to_bit_vector(skip_mem);
+
+  for (int64_t start = 0; start < ROW_CNT; start += BATCH_SIZE) {
+    const int64_t size = std::min(BATCH_SIZE, ROW_CNT - start);
+    skip.reset(BATCH_SIZE);
+    for (int64_t i = 0; i < size; i++) {
+      eval_ctx_.set_batch_idx(i);
+      gen_row(start + i, exprs_.c1_.locate_datum_for_write(eval_ctx_), exprs_.c2_.locate_datum_for_write(eval_ctx_));
+      if (0 == (start + i) % 3) {
+        skip.set(i);
+      }
+    }
+    ObExpr* batch_exprs[] = {&exprs_.add_, &exprs_.str_, &exprs_.lt_};
+    for (int64_t i = 0; i < ARRAYSIZEOF(batch_exprs); i++) {
+      batch_exprs[i]->get_eval_info(eval_ctx_).clear_evaluated_flag();
+      ASSERT_EQ(OB_SUCCESS, batch_exprs[i]->eval_batch(eval_ctx_, skip, size));
+      // skipped rows are not evaluated
+      const ObBitVector& flags = batch_exprs[i]->get_evaluated_flags(eval_ctx_);
+      for (int64_t j = 0; j < size; j++) {
+        ASSERT_EQ(!skip.at(j), flags.at(j)) << "expr " << i << " row " << start + j;
+      }
+    }
+
+    ObDatum* add_datums = exprs_.add_.locate_batch_datums(eval_ctx_);
+    ObDatum* str_datums = exprs_.str_.locate_batch_datums(eval_ctx_);
+    ObDatum* lt_datums = exprs_.lt_.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < size; i++) {
+      if (skip.at(i)) {
+        continue;
+      }
+      // evaluate the same row with non batch result expressions
+      eval_ctx_.frames_ = row_exprs.frames_;
+      gen_row(start + i,
+          row_exprs.c1_.locate_datum_for_write(eval_ctx_),
+          row_exprs.c2_.locate_datum_for_write(eval_ctx_));
+      row_exprs.add_.get_eval_info(eval_ctx_).clear_evaluated_flag();
+      row_exprs.str_.get_eval_info(eval_ctx_).clear_evaluated_flag();
+      row_exprs.lt_.get_eval_info(eval_ctx_).clear_evaluated_flag();
+      ObDatum* add = NULL;
+      ObDatum* str = NULL;
+      ObDatum* lt = NULL;
+      ASSERT_EQ(OB_SUCCESS, row_exprs.add_.eval(eval_ctx_, add));
+      ASSERT_EQ(OB_SUCCESS, row_exprs.str_.eval(eval_ctx_, str));
+      ASSERT_EQ(OB_SUCCESS, row_exprs.lt_.eval(eval_ctx_, lt));
+      eval_ctx_.frames_ = exprs_.frames_;
+
+      ASSERT_EQ(add->is_null(), add_datums[i].is_null()) << "row " << start + i;
+      ASSERT_EQ(lt->is_null(), lt_datums[i].is_null()) << "row " << start + i;
+      if (!add->is_null()) {
+        ASSERT_EQ(add->get_int(), add_datums[i].get_int()) << "row " << start + i;
+        ASSERT_EQ(lt->get_int(), lt_datums[i].get_int()) << "row " << start + i;
+      }
+      ASSERT_EQ(str->get_string(), str_datums[i].get_string()) << "row " << start + i;
+
+      // eval() of batch result expression locates the datum by batch index
+      // and returns the evaluated result directly.
+      eval_ctx_.set_batch_idx(i);
+      ASSERT_EQ(OB_SUCCESS, exprs_.str_.eval(eval_ctx_, str));
+      ASSERT_EQ(&str_datums[i], str);
+      ASSERT_EQ(&str_datums[i], &exprs_.str_.locate_expr_datum(eval_ctx_));
+    }
+
+    // rows skipped by eval_batch() are evaluated on demand by eval()
+    for (int64_t i = 0; i < size; i++) {
+      if (skip.at(i)) {
+        ObDatum* str = NULL;
+        eval_ctx_.set_batch_idx(i);
+        ASSERT_EQ(OB_SUCCESS, exprs_.str_.eval(eval_ctx_, str));
+        ASSERT_EQ(&str_datums[i], str);
+        ASSERT_TRUE(exprs_.str_.get_evaluated_flags(eval_ctx_).at(i));
+        char buf[64];
+        const int64_t v = start + i - ROW_CNT / 2;
+        const int64_t len = snprintf(buf, sizeof(buf), "%ld:%ld", v, v * v);
+        ASSERT_EQ(ObString(len, buf), str->get_string());
+      }
+    }
+    // the datums of all rows are kept until the next batch
+    for (int64_t i = 0; i < size; i++) {
+      char buf[64];
+      const int64_t v = start + i - ROW_CNT / 2;
+      const int64_t len = snprintf(buf, sizeof(buf), "%ld:%ld", v, v * v);
+      ASSERT_EQ(ObString(len, buf), str_datums[i].get_string()) << "row " << start + i;
+    }
+  }
+}
+
+TEST_F(TestBatchExec, operator_get_next_row)
+{
+  ObSEArray<ResultRow, 16> row_result;
+  get_row_result(row_result);
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_LT(0, row_result.count());
+  ASSERT_GT(ROW_CNT, row_result.count());
+
+  // get_next_row() of vectorized operator iterates the rows of batch
+  ObSEArray<ResultRow, 16> batch_result;
+  init(BATCH_SIZE);
+  ASSERT_FALSE(HasFatalFailure());
+  ObTestSourceOp op(exec_ctx_, spec_, exprs_, true);
+  get_rows(op, batch_result);
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_EQ(row_result.count(), batch_result.count());
+  for (int64_t i = 0; i < row_result.count(); i++) {
+    ASSERT_TRUE(row_result.at(i) == batch_result.at(i)) << "row " << i;
+  }
+}
+
+TEST_F(TestBatchExec, operator_get_next_batch)
+{
+  ObSEArray<ResultRow, 16> row_result;
+  get_row_result(row_result);
+  ASSERT_FALSE(HasFatalFailure());
+
+  ObSEArray<ResultRow, 16> batch_result;
+  init(BATCH_SIZE);
+  ASSERT_FALSE(HasFatalFailure());
+  ObTestSourceOp op(exec_ctx_, spec_, exprs_, true);
+  ASSERT_EQ(OB_SUCCESS, op.open());
+  const ObBatchRows* brs = NULL;
+  // odd max row count to get batches not aligned with the max batch size
+  const int64_t max_row_cnt = BATCH_SIZE / 2 + 1;
+  do {
+    ASSERT_EQ(OB_SUCCESS, op.get_next_batch(max_row_cnt, brs));
+    ASSERT_LE(brs->size_, max_row_cnt);
+    for (int64_t i = 0; i < spec_.output_.count(); i++) {
+      ASSERT_EQ(OB_SUCCESS, spec_.output_.at(i)->eval_batch(eval_ctx_, *brs->skip_, brs->size_));
+    }
+    for (int64_t i = 0; i < brs->size_; i++) {
+      if (!brs->skip_->at(i)) {
+        ResultRow row;
+        eval_ctx_.set_batch_idx(i);
+        eval_row(row);
+        ASSERT_FALSE(HasFatalFailure());
+        ASSERT_EQ(OB_SUCCESS, batch_result.push_back(row));
+      }
+    }
+  } while (!brs->end_);
+  ASSERT_EQ(row_result.count(), batch_result.count());
+  for (int64_t i = 0; i < row_result.count(); i++) {
+    ASSERT_TRUE(row_result.at(i) == batch_result.at(i)) << "row " << i;
+  }
+}
+
+TEST_F(TestBatchExec, batch_not_implement)
+{
+  init(BATCH_SIZE);
+  ASSERT_FALSE(HasFatalFailure());
+  ObTestSourceOp op(exec_ctx_, spec_, exprs_, false);
+  ASSERT_EQ(OB_SUCCESS, op.open());
+  const ObBatchRows* brs = NULL;
+  ASSERT_EQ(OB_NOT_IMPLEMENT, op.get_next_batch(BATCH_SIZE, brs));
+  ASSERT_EQ(OB_NOT_IMPLEMENT, op.get_next_row());
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <sched.h>
+#include "sql/plan_cache/ob_pc_front_cache.h"
+#include "sql/plan_cache/ob_plan_cache.h"
+#include "sql/plan_cache/ob_pcv_set.h"
+#include "sql/plan_cache/ob_sql_parameterization.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/string/ob_sql_string.h"
+
+using namespace oceanbase;
+using namespace common;
+using namespace sql;
+
+class TestPCFrontCache : public ::testing::Test {
+  public:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  protected:
+  void fast_parse(const char* sql, ObFastParserResult& fp_result);
+  void prepare(const ObString& sql, const ObFastParserResult& fp_result, ObPCFrontCacheEntry*& entry);
+
+  ObArenaAllocator allocator_;
+  ObPlanCache plan_cache_;
+  ObPCFrontCache front_cache_;
+  ObPCVSet* pcv_set_;
+};
+
+void TestPCFrontCache::SetUp()
+{
+  // shard is chosen by cpu
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(0, &cpu_set);
+  ASSERT_EQ(0, sched_setaffinity(0, sizeof(cpu_set), &cpu_set));
+  ASSERT_EQ(OB_SUCCESS, plan_cache_.init(1024, ObAddr(), NULL, OB_SYS_TENANT_ID));
+  ASSERT_EQ(OB_SUCCESS, front_cache_.init(plan_cache_.get_pc_allocator()));
+  void* buf = plan_cache_.get_pc_allocator()->alloc(sizeof(ObPCVSet));
+  ASSERT_TRUE(NULL != buf);
+  pcv_set_ = new (buf) ObPCVSet(&plan_cache_);
+  pcv_set_->inc_ref_count(PCV_SET_HANDLE);
+}
+
+void TestPCFrontCache::TearDown()
+{
+  front_cache_.destroy();
+  ASSERT_EQ(1, pcv_set_->get_ref_count());
+  pcv_set_->dec_ref_count(PCV_SET_HANDLE);
+  plan_cache_.destroy();
+}
+
+void TestPCFrontCache::fast_parse(const char* sql, ObFastParserResult& fp_result)
+{
+  fp_result.pc_key_.db_id_ = 1;
+  fp_result.pc_key_.namespace_ = NS_CRSR;
+  ASSERT_EQ(OB_SUCCESS,
+      ObSqlParameterization::fast_parser(
+          allocator_, SMO_DEFAULT, ObCharset::get_system_collation(), ObString::make_string(sql), false, fp_result));
+}
+
+void TestPCFrontCache::prepare(const ObString& sql, const ObFastParserResult& fp_result, ObPCFrontCacheEntry*& entry)
+{
+  // admitted on second miss
+  ASSERT_EQ(OB_SUCCESS, front_cache_.prepare(SMO_DEFAULT, ObCharset::get_system_collation(), sql, fp_result, entry));
+  ASSERT_TRUE(NULL == entry);
+  ASSERT_EQ(OB_SUCCESS, front_cache_.prepare(SMO_DEFAULT, ObCharset::get_system_collation(), sql, fp_result, entry));
+  ASSERT_TRUE(NULL != entry);
+}
+
+TEST_F(TestPCFrontCache, get_and_put)
+{
+  const char* sql = "select c1, 'abc' from t1 where c1 = 3 and c2 = -1.5 and c3 = 'xyz'";
+  const ObString sql_str = ObString::make_string(sql);
+  const ObCollationType coll = ObCharset::get_system_collation();
+  ObFastParserResult fp_result;
+  ObFastParserResult front_result;
+  ObPCFrontCacheEntry* entry = NULL;
+  ObPCVSet* pcv_set = NULL;
+  fast_parse(sql, fp_result);
+  front_result.pc_key_ = fp_result.pc_key_;
+  front_result.pc_key_.name_.reset();
+
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_DEFAULT, coll, sql_str, front_result, pcv_set));
+  ASSERT_TRUE(NULL == pcv_set);
+  prepare(sql_str, fp_result, entry);
+  front_cache_.put(entry, pcv_set_);
+  ASSERT_EQ(2, pcv_set_->get_ref_count());
+
+  // sql mode, collation and plan cache key must match
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_ORACLE, coll, sql_str, front_result, pcv_set));
+  ASSERT_TRUE(NULL == pcv_set);
+  front_result.pc_key_.db_id_ = 2;
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_DEFAULT, coll, sql_str, front_result, pcv_set));
+  ASSERT_TRUE(NULL == pcv_set);
+  front_result.pc_key_.db_id_ = 1;
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_DEFAULT, coll, sql_str, front_result, pcv_set));
+  ASSERT_EQ(pcv_set_, pcv_set);
+  ASSERT_EQ(3, pcv_set_->get_ref_count());
+  pcv_set->unlock();
+  pcv_set->dec_ref_count(PCV_RD_HANDLE);
+
+  // same fast parser result in different memory
+  ASSERT_EQ(fp_result.pc_key_.name_, front_result.pc_key_.name_);
+  ASSERT_NE(fp_result.pc_key_.name_.ptr(), front_result.pc_key_.name_.ptr());
+  ASSERT_EQ(fp_result.raw_params_.count(), front_result.raw_params_.count());
+  for (int64_t i = 0; i < fp_result.raw_params_.count(); ++i) {
+    const ParseNode* node = fp_result.raw_params_.at(i)->node_;
+    const ParseNode* front_node = front_result.raw_params_.at(i)->node_;
+    ASSERT_NE(node, front_node);
+    ASSERT_EQ(node->type_, front_node->type_);
+    ASSERT_EQ(node->value_, front_node->value_);
+    ASSERT_EQ(node->num_child_, front_node->num_child_);
+    ASSERT_EQ(ObString(node->str_len_, node->str_value_), ObString(front_node->str_len_, front_node->str_value_));
+    ASSERT_EQ(ObString(node->text_len_, node->raw_text_), ObString(front_node->text_len_, front_node->raw_text_));
+  }
+
+  // only entries of the removed pcv set are invalidated
+  void* buf = plan_cache_.get_pc_allocator()->alloc(sizeof(ObPCVSet));
+  ASSERT_TRUE(NULL != buf);
+  ObPCVSet* other_pcv_set = new (buf) ObPCVSet(&plan_cache_);
+  other_pcv_set->inc_ref_count(PCV_SET_HANDLE);
+  other_pcv_set->set_removed();
+  front_cache_.invalidate(other_pcv_set);
+  other_pcv_set->dec_ref_count(PCV_SET_HANDLE);
+  ASSERT_EQ(2, pcv_set_->get_ref_count());
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_DEFAULT, coll, sql_str, front_result, pcv_set));
+  ASSERT_EQ(pcv_set_, pcv_set);
+  pcv_set->unlock();
+  pcv_set->dec_ref_count(PCV_RD_HANDLE);
+
+  // reference of the removed pcv set is released at once
+  pcv_set_->set_removed();
+  front_cache_.invalidate(pcv_set_);
+  ASSERT_EQ(1, pcv_set_->get_ref_count());
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_DEFAULT, coll, sql_str, front_result, pcv_set));
+  ASSERT_TRUE(NULL == pcv_set);
+
+  // entry of a removed pcv set is not installed
+  prepare(sql_str, fp_result, entry);
+  front_cache_.put(entry, pcv_set_);
+  ASSERT_EQ(1, pcv_set_->get_ref_count());
+  ASSERT_EQ(OB_SUCCESS, front_cache_.get(allocator_, SMO_DEFAULT, coll, sql_str, front_result, pcv_set));
+  ASSERT_TRUE(NULL == pcv_set);
+}
+
+TEST_F(TestPCFrontCache, not_cacheable)
+{
+  ObFastParserResult fp_result;
+  ObPCFrontCacheEntry* entry = NULL;
+  ObSqlString sql;
+  ASSERT_EQ(OB_SUCCESS, sql.append("select 1 from t1 where c1 in (1"));
+  for (int64_t i = 0; sql.length() <= ObPCFrontCache::MAX_RAW_SQL_LEN; ++i) {
+    ASSERT_EQ(OB_SUCCESS, sql.append_fmt(", %ld", i));
+  }
+  ASSERT_EQ(OB_SUCCESS, sql.append(")"));
+  fast_parse(sql.ptr(), fp_result);
+  for (int64_t i = 0; i < 2; ++i) {
+    ASSERT_EQ(OB_SUCCESS,
+        front_cache_.prepare(SMO_DEFAULT, ObCharset::get_system_collation(), sql.string(), fp_result, entry));
+    ASSERT_TRUE(NULL == entry);
+  }
+  front_cache_.revert(entry);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
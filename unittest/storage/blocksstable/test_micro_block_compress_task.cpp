@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "storage/blocksstable/ob_micro_block_compress_task.h"
+
+namespace oceanbase {
+using namespace common;
+namespace blocksstable {
+
+class TestMicroBlockCompressTask : public ::testing::Test {
+  public:
+  static const int64_t MICRO_BLOCK_SIZE = 16 * 1024;
+  static const int64_t COLUMN_CNT = 4;
+  static const int64_t TASK_CNT = 4;
+  virtual void SetUp();
+  void check_task(ObMicroBlockCompressTask& task, const int64_t idx);
+
+  protected:
+  ObDataStoreDesc desc_;
+  char block_[MICRO_BLOCK_SIZE];
+  char rowkey_[16];
+  int64_t column_checksums_[COLUMN_CNT];
+  ObArray<uint32_t> hashs_;
+  ObMicroBlockCompressor decompressor_;
+};
+
+void TestMicroBlockCompressTask::SetUp()
+{
+  desc_.micro_block_size_ = MICRO_BLOCK_SIZE;
+  desc_.row_column_count_ = COLUMN_CNT;
+  desc_.need_calc_column_checksum_ = true;
+  STRCPY(desc_.compressor_name_, "lz4_1.0");
+  for (int64_t i = 0; i < MICRO_BLOCK_SIZE; ++i) {
+    block_[i] = static_cast<char>('a' + (i / 64) % 26);
+  }
+  ASSERT_EQ(OB_SUCCESS, decompressor_.init(MICRO_BLOCK_SIZE, desc_.compressor_name_));
+}
+
+void TestMicroBlockCompressTask::check_task(ObMicroBlockCompressTask& task, const int64_t idx)
+{
+  const char* out = NULL;
+  int64_t out_size = 0;
+  const ObMicroBlockDesc& desc = task.get_micro_block_desc();
+  ASSERT_EQ(OB_SUCCESS, task.wait());
+  ASSERT_LT(desc.buf_size_, MICRO_BLOCK_SIZE);
+  ASSERT_EQ(OB_SUCCESS, decompressor_.decompress(desc.buf_, desc.buf_size_, MICRO_BLOCK_SIZE, out, out_size));
+  ASSERT_EQ(MICRO_BLOCK_SIZE, out_size);
+  ASSERT_EQ(0, MEMCMP(block_, out, MICRO_BLOCK_SIZE));
+  ASSERT_EQ(idx, desc.row_count_);
+  ASSERT_EQ(idx, task.get_micro_block_checksum());
+  ASSERT_EQ(0, MEMCMP(rowkey_, desc.last_rowkey_.ptr(), sizeof(rowkey_)));
+  ASSERT_NE(column_checksums_, desc.column_checksums_);
+  ASSERT_EQ(idx, desc.column_checksums_[COLUMN_CNT - 1]);
+  ASSERT_EQ(idx, task.get_rowkey_hashs().count());
+}
+
+TEST_F(TestMicroBlockCompressTask, pipeline)
+{
+  ObMicroBlockCompressPool pool;
+  ObMicroBlockCompressTask tasks[TASK_CNT];
+  ASSERT_EQ(OB_SUCCESS, pool.init(2));
+  for (int64_t i = 0; i < TASK_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, tasks[i].init(desc_));
+  }
+  for (int64_t round = 0; round < 8; ++round) {
+    for (int64_t i = 0; i < TASK_CNT; ++i) {
+      const int64_t idx = round * TASK_CNT + i + 1;
+      ObMicroBlockDesc desc;
+      MEMSET(rowkey_, 'k', sizeof(rowkey_));
+      desc.last_rowkey_.assign_ptr(rowkey_, sizeof(rowkey_));
+      desc.row_count_ = idx;
+      MEMSET(column_checksums_, 0, sizeof(column_checksums_));
+      column_checksums_[COLUMN_CNT - 1] = idx;
+      desc.column_checksums_ = column_checksums_;
+      hashs_.reuse();
+      for (int64_t j = 0; j < idx; ++j) {
+        ASSERT_EQ(OB_SUCCESS, hashs_.push_back(static_cast<uint32_t>(j)));
+      }
+      ASSERT_EQ(OB_SUCCESS, tasks[i].assign(block_, MICRO_BLOCK_SIZE, desc, idx, hashs_, false));
+      pool.submit(tasks[i]);
+    }
+    for (int64_t i = 0; i < TASK_CNT; ++i) {
+      check_task(tasks[i], round * TASK_CNT + i + 1);
+    }
+  }
+  pool.destroy();
+}
+
+TEST_F(TestMicroBlockCompressTask, process_in_place)
+{
+  ObMicroBlockCompressPool pool;
+  ObMicroBlockCompressTask task;
+  ObMicroBlockDesc desc;
+  ASSERT_FALSE(pool.is_inited());
+  ASSERT_EQ(OB_SUCCESS, pool.init(0));
+  ASSERT_FALSE(pool.is_inited());
+  ASSERT_EQ(OB_NOT_INIT, task.assign(block_, MICRO_BLOCK_SIZE, desc, 0, hashs_, false));
+  ASSERT_EQ(OB_SUCCESS, task.init(desc_));
+  MEMSET(rowkey_, 'k', sizeof(rowkey_));
+  desc.last_rowkey_.assign_ptr(rowkey_, sizeof(rowkey_));
+  desc.row_count_ = 1;
+  MEMSET(column_checksums_, 0, sizeof(column_checksums_));
+  column_checksums_[COLUMN_CNT - 1] = 1;
+  desc.column_checksums_ = column_checksums_;
+  hashs_.reuse();
+  ASSERT_EQ(OB_SUCCESS, hashs_.push_back(1));
+  ASSERT_EQ(OB_SUCCESS, task.assign(block_, MICRO_BLOCK_SIZE, desc, 1, hashs_, true));
+  pool.submit(task);
+  check_task(task, 1);
+  ASSERT_TRUE(task.is_force_split());
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_micro_block_compress_task.log*");
+  OB_LOGGER.set_file_name("test_micro_block_compress_task.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_encoder.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/ob_i_store.h"
+#include "ob_row_generate.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+class TestMicroBlockEncoder : public ::testing::Test {
+  public:
+  static const int64_t rowkey_column_count = 2;
+  static const int64_t column_num = ObHexStringType;
+  static const int64_t macro_block_size = 2L * 1024 * 1024L;
+
+  public:
+  TestMicroBlockEncoder() : allocator_(ObModIds::TEST){};
+  void SetUp();
+  virtual void TearDown()
+  {}
+  static void SetUpTestCase()
+  {}
+  static void TearDownTestCase()
+  {}
+  void init_column_map(const ObStoreRow& row, const int64_t rowkey_cnt, ObColumnMap& column_map);
+  // int sequence | int const | string runs | string cycle | string with common prefix
+  void fill_typed_row(const int64_t i, ObStoreRow& row);
+  void check_white_filter(ObMicroBlockDecoder& decoder, const int64_t col_idx, const sql::ObWhiteFilterOperatorType op,
+      const ObObj* params, const int64_t param_cnt, const int64_t begin, const int64_t end,
+      bool (*expected)(const int64_t));
+
+  protected:
+  ObRowGenerate row_generate_;
+  ObColumnMap column_map_;
+  ObArenaAllocator allocator_;
+};
+
+void TestMicroBlockEncoder::SetUp()
+{
+  const int64_t table_id = 3001;
+  ObTableSchema table_schema;
+  ObColumnSchemaV2 column;
+  table_schema.reset();
+  ASSERT_EQ(OB_SUCCESS, table_schema.set_table_name("test_micro_block_encoder"));
+  table_schema.set_tenant_id(1);
+  table_schema.set_tablegroup_id(1);
+  table_schema.set_database_id(1);
+  table_schema.set_table_id(table_id);
+  table_schema.set_rowkey_column_num(rowkey_column_count);
+  table_schema.set_max_used_column_id(column_num);
+  char name[OB_MAX_FILE_NAME_LENGTH];
+  memset(name, 0, sizeof(name));
+  for (int64_t i = 0; i < column_num; ++i) {
+    ObObjType obj_type = static_cast<ObObjType>(i + 1);
+    column.reset();
+    column.set_table_id(table_id);
+    column.set_column_id(i + OB_APP_MIN_COLUMN_ID);
+    sprintf(name, "test%020ld", i);
+    ASSERT_EQ(OB_SUCCESS, column.set_column_name(name));
+    column.set_data_type(obj_type);
+    if (obj_type == common::ObIntType) {
+      column.set_rowkey_position(1);
+    } else if (obj_type == common::ObNumberType) {
+      column.set_rowkey_position(2);
+    } else {
+      column.set_rowkey_position(0);
+    }
+    column.set_collation_type(ObCollationType::CS_TYPE_UTF8MB4_GENERAL_CI);
+    ASSERT_EQ(OB_SUCCESS, table_schema.add_column(column));
+  }
+  ASSERT_EQ(OB_SUCCESS, row_generate_.init(table_schema));
+}
+
+void TestMicroBlockEncoder::init_column_map(const ObStoreRow& row, const int64_t rowkey_cnt, ObColumnMap& column_map)
+{
+  ObArray<ObColDesc> columns;
+  for (int64_t i = 0; i < row.row_val_.count_; ++i) {
+    ObColDesc col_desc;
+    col_desc.col_id_ = static_cast<uint32_t>(i + OB_APP_MIN_COLUMN_ID);
+    col_desc.col_type_ = row.row_val_.cells_[i].get_meta();
+    ASSERT_EQ(OB_SUCCESS, columns.push_back(col_desc));
+  }
+  ASSERT_EQ(OB_SUCCESS, column_map.init(allocator_, 1, rowkey_cnt, row.row_val_.count_, columns));
+}
+
+void TestMicroBlockEncoder::fill_typed_row(const int64_t i, ObStoreRow& row)
+{
+  static const char* values[] = {"beijing", "hangzhou", "shanghai", "shenzhen"};
+  char str_buf[64];
+  ObObj* objs = row.row_val_.cells_;
+  objs[0].set_int(1000000 + i);
+  objs[1].set_int(7);
+  objs[2].set_varchar(values[i / 250]);
+  objs[2].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  objs[3].set_varchar(values[(i * 7) % 4]);
+  objs[3].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  const int64_t len = snprintf(str_buf, sizeof(str_buf), "http://www.oceanbase.com/docs/%08ld", i * 13);
+  ObString str;
+  ASSERT_EQ(OB_SUCCESS, ob_write_string(allocator_, ObString(static_cast<int32_t>(len), str_buf), str));
+  objs[4].set_varchar(str);
+  objs[4].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+}
+
+void TestMicroBlockEncoder::check_white_filter(ObMicroBlockDecoder& decoder, const int64_t col_idx,
+    const sql::ObWhiteFilterOperatorType op, const ObObj* params, const int64_t param_cnt, const int64_t begin,
+    const int64_t end, bool (*expected)(const int64_t))
+{
+  sql::ObPushdownWhiteFilterNode node(allocator_);
+  node.op_type_ = op;
+  sql::ObWhiteFilterExecutor filter(allocator_, node);
+  ASSERT_EQ(OB_SUCCESS, filter.params_.reserve(param_cnt));
+  for (int64_t i = 0; i < param_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, filter.params_.push_back(params[i]));
+  }
+  filter.params_ready_ = true;
+
+  ObBitmap result(allocator_);
+  ASSERT_EQ(OB_SUCCESS, result.init(end - begin));
+  ASSERT_EQ(OB_SUCCESS, decoder.filter_pushdown_filter(filter, col_idx, begin, end, result));
+  int64_t expected_cnt = 0;
+  for (int64_t i = begin; i < end; ++i) {
+    ASSERT_EQ(expected(i), result.test(i - begin)) << "col: " << col_idx << " row: " << i;
+    expected_cnt += expected(i) ? 1 : 0;
+  }
+  ASSERT_EQ(expected_cnt, result.popcnt());
+}
+
+TEST_F(TestMicroBlockEncoder, test_init)
+{
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, encoder.init(0, 2, 5));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, encoder.init(1024, 2, 0));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, encoder.init(1024, 6, 5));
+  ASSERT_EQ(OB_SUCCESS, encoder.init(1024, 2, 5));
+  ASSERT_EQ(0, encoder.get_row_count());
+  ASSERT_EQ(5, encoder.get_column_count());
+
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_NE(OB_SUCCESS, encoder.build_block(buf, size));
+}
+
+TEST_F(TestMicroBlockEncoder, all_types_round_trip)
+{
+  const int64_t test_row_num = 100;
+  ObObj objs[column_num];
+  ObStoreRow row;
+  row.row_val_.cells_ = objs;
+  row.row_val_.count_ = column_num;
+
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(macro_block_size, rowkey_column_count, column_num));
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(row));
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  ASSERT_EQ(size, encoder.get_data_size());
+
+  init_column_map(row, rowkey_column_count, column_map_);
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_TRUE(ObMicroBlockDecoder::is_encoding_block(block));
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  int64_t row_count = 0;
+  ASSERT_EQ(OB_SUCCESS, decoder.get_row_count(row_count));
+  ASSERT_EQ(test_row_num, row_count);
+
+  ObObj read_objs[column_num];
+  ObStoreRow read_row;
+  read_row.row_val_.cells_ = read_objs;
+  read_row.row_val_.count_ = column_num;
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, read_row));
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    for (int64_t j = 0; j < column_num; ++j) {
+      ASSERT_TRUE(row.row_val_.cells_[j] == read_row.row_val_.cells_[j])
+          << "\n i: " << i << " j: " << j << "\n writer:  " << to_cstring(row.row_val_.cells_[j])
+          << "\n reader:  " << to_cstring(read_row.row_val_.cells_[j]);
+    }
+  }
+
+  // locate every rowkey by binary search on the encoded rowkey columns
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    ObStoreRowkey rowkey(row.row_val_.cells_, rowkey_column_count);
+    int64_t row_idx = -1;
+    ASSERT_EQ(OB_SUCCESS, decoder.locate_rowkey(rowkey, row_idx));
+    ASSERT_EQ(i, row_idx);
+  }
+
+  // last rowkey stays in flat row format
+  ObString last_rowkey = encoder.get_last_rowkey();
+  ASSERT_TRUE(last_rowkey.length() > 0);
+}
+
+TEST_F(TestMicroBlockEncoder, choose_encoding)
+{
+  static const int64_t col_cnt = 5;
+  static const int64_t row_cnt = 1000;
+  ObObj objs[col_cnt];
+  ObStoreRow row;
+  row.flag_ = ObActionFlag::OP_ROW_EXIST;
+  row.row_val_.cells_ = objs;
+  row.row_val_.count_ = col_cnt;
+
+  ObMicroBlockEncoder encoder;
+  ObMicroBlockWriter writer;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(macro_block_size, 1, col_cnt));
+  ASSERT_EQ(OB_SUCCESS, writer.init(macro_block_size, 1, col_cnt));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    fill_typed_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+    ASSERT_EQ(OB_SUCCESS, writer.append_row(row));
+  }
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  const ObColumnEncodingType* types = encoder.get_encoding_types();
+  ASSERT_TRUE(NULL != types);
+  ASSERT_EQ(OB_COLUMN_ENCODING_INT_DELTA, types[0]);
+  ASSERT_EQ(OB_COLUMN_ENCODING_CONST, types[1]);
+  ASSERT_EQ(OB_COLUMN_ENCODING_RLE, types[2]);
+  ASSERT_EQ(OB_COLUMN_ENCODING_DICT, types[3]);
+  ASSERT_EQ(OB_COLUMN_ENCODING_PREFIX, types[4]);
+
+  char* flat_buf = NULL;
+  int64_t flat_size = 0;
+  ASSERT_EQ(OB_SUCCESS, writer.build_block(flat_buf, flat_size));
+  ASSERT_LT(size, flat_size / 2);
+
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block));
+  ObObj cell;
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    fill_typed_row(i, row);
+    for (int64_t j = 0; j < col_cnt; ++j) {
+      ASSERT_EQ(OB_SUCCESS, decoder.decode_cell(j, i, allocator_, cell));
+      ASSERT_TRUE(objs[j] == cell) << "\n i: " << i << " j: " << j << "\n writer:  " << to_cstring(objs[j])
+                                   << "\n reader:  " << to_cstring(cell);
+    }
+  }
+
+  // prefix strings of the returned row stay valid after the decoder is reused for other rows
+  ObArenaAllocator row_allocator(ObModIds::TEST);
+  ObObj read_objs[col_cnt];
+  ObObj other_objs[col_cnt];
+  ObStoreRow read_row;
+  ObStoreRow other_row;
+  read_row.row_val_.cells_ = read_objs;
+  read_row.row_val_.count_ = col_cnt;
+  other_row.row_val_.cells_ = other_objs;
+  other_row.row_val_.count_ = col_cnt;
+  init_column_map(row, 1, column_map_);
+  decoder.set_row_allocator(&row_allocator);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  ASSERT_EQ(OB_SUCCESS, decoder.get_row(row_cnt - 1, read_row));
+  decoder.reset();
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  for (int64_t i = 0; i < row_cnt - 1; ++i) {
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, other_row));
+  }
+  fill_typed_row(row_cnt - 1, row);
+  for (int64_t j = 0; j < col_cnt; ++j) {
+    ASSERT_TRUE(objs[j] == read_objs[j]) << "\n j: " << j << "\n writer:  " << to_cstring(objs[j])
+                                         << "\n reader:  " << to_cstring(read_objs[j]);
+  }
+}
+
+TEST_F(TestMicroBlockEncoder, filter_pushdown_filter)
+{
+  static const int64_t col_cnt = 5;
+  static const int64_t row_cnt = 1000;
+  ObObj objs[col_cnt];
+  ObStoreRow row;
+  row.flag_ = ObActionFlag::OP_ROW_EXIST;
+  row.row_val_.cells_ = objs;
+  row.row_val_.count_ = col_cnt;
+
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(macro_block_size, 1, col_cnt));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    fill_typed_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+
+  init_column_map(row, 1, column_map_);
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+
+  const int64_t begin = 100;
+  const int64_t end = 900;
+  ObObj params[2];
+  // const column
+  params[0].set_int(7);
+  check_white_filter(decoder, 1, sql::WHITE_OP_EQ, params, 1, begin, end, [](const int64_t) { return true; });
+  check_white_filter(decoder, 1, sql::WHITE_OP_NE, params, 1, begin, end, [](const int64_t) { return false; });
+  // integer delta column, filtered row by row
+  params[0].set_int(1000150);
+  check_white_filter(
+      decoder, 0, sql::WHITE_OP_LT, params, 1, begin, end, [](const int64_t i) { return i < 150; });
+  // rle column
+  params[0].set_varchar("hangzhou");
+  params[0].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  check_white_filter(
+      decoder, 2, sql::WHITE_OP_GT, params, 1, begin, end, [](const int64_t i) { return i >= 500; });
+  // dict column
+  check_white_filter(
+      decoder, 3, sql::WHITE_OP_EQ, params, 1, begin, end, [](const int64_t i) { return 1 == (i * 7) % 4; });
+  params[0].set_varchar("beijing");
+  params[0].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  params[1].set_varchar("shenzhen");
+  params[1].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  check_white_filter(decoder, 3, sql::WHITE_OP_IN, params, 2, begin, end, [](const int64_t i) {
+    return 0 == (i * 7) % 4 || 3 == (i * 7) % 4;
+  });
+  check_white_filter(decoder, 3, sql::WHITE_OP_NN, params, 0, begin, end, [](const int64_t) { return true; });
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -rf test_micro_block_encoder.log");
+  OB_LOGGER.set_file_name("test_micro_block_encoder.log");
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
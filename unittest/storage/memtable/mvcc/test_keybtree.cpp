@@ -11,6 +11,7 @@
  */
 
 #include "storage/memtable/mvcc/ob_keybtree.h"
+#include "storage/memtable/mvcc/ob_keybtree_deps.h"
 
 #include "common/object/ob_object.h"
 #include "common/rowkey/ob_store_rowkey.h"
@@ -457,6 +458,48 @@ TEST(TestKeyBtree, smoke_test)
   }
 }
 
+TEST(TestKeyBtree, normalized_prefix)
+{
+  ObObj objs[10];
+  objs[0].set_min_value();
+  objs[1].set_int(INT64_MIN);
+  objs[2].set_int(INT64_MIN + 1);
+  objs[3].set_tinyint(-5);
+  objs[4].set_int(0);
+  objs[5].set_uint64(7);
+  objs[6].set_int(8);
+  objs[7].set_uint64(INT64_MAX);
+  objs[8].set_uint64(UINT64_MAX);
+  objs[9].set_max_value();
+  BtreeKey* keys[10];
+  for (int64_t i = 0; i < 10; ++i) {
+    ObStoreRowkey* rowkey = (ObStoreRowkey*)ob_malloc(sizeof(ObStoreRowkey), attr);
+    ASSERT_TRUE(nullptr != rowkey);
+    new (rowkey) ObStoreRowkey(&objs[i], 1);
+    keys[i] = (BtreeKey*)ob_malloc(sizeof(BtreeKey), attr);
+    ASSERT_TRUE(nullptr != keys[i]);
+    new (keys[i]) BtreeKey(rowkey);
+  }
+  ASSERT_EQ(CompHelper::MIN_PREFIX, CompHelper::get_prefix(*keys[0]));
+  ASSERT_EQ(CompHelper::MIN_PREFIX, CompHelper::get_prefix(*keys[1]));
+  ASSERT_EQ(CompHelper::INVALID_PREFIX, CompHelper::get_prefix(*keys[8]));
+  ASSERT_EQ(CompHelper::MAX_PREFIX, CompHelper::get_prefix(*keys[9]));
+
+  // comparison with prefixes is the same as the full comparison
+  CompHelper comp;
+  for (int64_t i = 0; i < 10; ++i) {
+    for (int64_t j = 0; j < 10; ++j) {
+      int cmp = 0;
+      int full_cmp = 0;
+      ASSERT_EQ(OB_SUCCESS,
+          comp.compare(*keys[i], CompHelper::get_prefix(*keys[i]), *keys[j], CompHelper::get_prefix(*keys[j]), cmp));
+      ASSERT_EQ(OB_SUCCESS, comp.compare(*keys[i], *keys[j], full_cmp));
+      ASSERT_EQ(full_cmp < 0, cmp < 0);
+      ASSERT_EQ(full_cmp > 0, cmp > 0);
+    }
+  }
+}
+
 }  // namespace unittest
 }  // namespace oceanbase
 
@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "share/schema/ob_table_param.h"
+#include "utils_rowkey_builder.h"
+#include <gtest/gtest.h>
+#include "share/ob_srv_rpc_proxy.h"
+#include "share/ob_common_rpc_proxy.h"
+#include "share/ob_rs_mgr.h"
+#define private public
+#define protected public
+#include "storage/memtable/ob_memtable_iterator.h"
+#include "storage/memtable/ob_memtable.h"
+#include "storage/memtable/mvcc/ob_mvcc_ctx.h"
+#undef private
+#undef protected
+
+namespace oceanbase {
+using namespace common;
+using namespace share::schema;
+using namespace storage;
+using namespace unittest;
+namespace memtable {
+class TestMemtableMultiSet : public ::testing::Test {
+  public:
+  static const int64_t TEST_ROW_CNT = 200;
+  static const int64_t TEST_ROWKEY_CNT = 2;
+  static const int64_t TEST_COLUMN_CNT = 3;
+  static const int64_t TEST_TRANS_VERSION = 10;
+  TestMemtableMultiSet();
+  virtual ~TestMemtableMultiSet()
+  {}
+  virtual void SetUp();
+  virtual void TearDown();
+
+  protected:
+  void init_memtable(ObMemtable& mt);
+  void write_rows(ObMemtable& mt, const bool use_multi_set);
+  void scan_rows(ObMemtable& mt, ObIArray<ObStoreRow>& rows);
+
+  protected:
+  static const uint64_t TEST_TABLE_ID = 3000000000000001L;
+  CD cd_;
+  ObArenaAllocator allocator_;
+  ObMemtableCtxFactory f_;
+  ObObj cells_[TEST_ROW_CNT][TEST_COLUMN_CNT];
+  ObStoreRow rows_[TEST_ROW_CNT];
+};
+
+TestMemtableMultiSet::TestMemtableMultiSet()
+    : cd_(16, ObIntType, CS_TYPE_BINARY, 17, ObIntType, CS_TYPE_BINARY, 18, ObIntType, CS_TYPE_BINARY),
+      allocator_(ObModIds::TEST),
+      f_()
+{}
+
+void TestMemtableMultiSet::SetUp()
+{
+  // rows are generated out of rowkey order with duplicated first rowkey columns
+  for (int64_t i = 0; i < TEST_ROW_CNT; ++i) {
+    const int64_t seq = (i * 37) % TEST_ROW_CNT;
+    cells_[i][0].set_int(seq % 7);
+    cells_[i][1].set_int(TEST_ROW_CNT - seq);
+    cells_[i][2].set_int(seq * 10);
+    rows_[i].reset();
+    rows_[i].flag_ = ObActionFlag::OP_ROW_EXIST;
+    rows_[i].set_dml(T_DML_INSERT);
+    rows_[i].row_val_.cells_ = cells_[i];
+    rows_[i].row_val_.count_ = TEST_COLUMN_CNT;
+  }
+}
+
+void TestMemtableMultiSet::TearDown()
+{
+  allocator_.clear();
+}
+
+void TestMemtableMultiSet::init_memtable(ObMemtable& mt)
+{
+  ObITable::TableKey table_key;
+  table_key.table_type_ = ObITable::MEMTABLE;
+  table_key.pkey_ = ObPartitionKey(TEST_TABLE_ID, 1, 1);
+  table_key.table_id_ = TEST_TABLE_ID;
+  table_key.version_ = 1;
+  table_key.trans_version_range_.base_version_ = 0;
+  table_key.trans_version_range_.multi_version_start_ = 0;
+  table_key.trans_version_range_.snapshot_version_ = INT64_MAX - 2;
+  ASSERT_EQ(OB_SUCCESS, mt.init(table_key));
+}
+
+void TestMemtableMultiSet::write_rows(ObMemtable& mt, const bool use_multi_set)
+{
+  ObStoreCtx wctx;
+  ObArray<ObITable*> tables;
+  wctx.tables_ = &tables;
+  wctx.mem_ctx_ = f_.alloc();
+  wctx.mem_ctx_->trans_begin();
+  wctx.mem_ctx_->sub_trans_begin(0, 1000000 + ObTimeUtility::current_time());
+  if (use_multi_set) {
+    ASSERT_EQ(OB_SUCCESS, mt.multi_set(wctx, TEST_TABLE_ID, TEST_ROWKEY_CNT, cd_.get_columns(), rows_, TEST_ROW_CNT));
+  } else {
+    for (int64_t i = 0; i < TEST_ROW_CNT; ++i) {
+      ASSERT_EQ(OB_SUCCESS, mt.set(wctx, TEST_TABLE_ID, TEST_ROWKEY_CNT, cd_.get_columns(), rows_[i]));
+    }
+  }
+  wctx.mem_ctx_->trans_end(true, TEST_TRANS_VERSION);
+  f_.free(wctx.mem_ctx_);
+}
+
+void TestMemtableMultiSet::scan_rows(ObMemtable& mt, ObIArray<ObStoreRow>& rows)
+{
+  ObStoreCtx rctx;
+  ObTableIterParam param;
+  ObTableAccessContext context;
+  blocksstable::ObBlockCacheWorkingSet block_cache_ws;
+  ObQueryFlag query_flag(ObQueryFlag::Forward,
+      false, /*is daily merge scan*/
+      false, /*is read multiple macro block*/
+      false, /*sys task scan, read one macro block in single io*/
+      true /*is full row scan?*/,
+      false,
+      false);
+  ObStoreRange range;
+  ObStoreRowIterator* iter = NULL;
+  const ObStoreRow* row = NULL;
+  int ret = OB_SUCCESS;
+
+  rctx.mem_ctx_ = f_.alloc();
+  rctx.mem_ctx_->trans_begin();
+  rctx.mem_ctx_->sub_trans_begin(TEST_TRANS_VERSION, 1000000 + ObTimeUtility::current_time());
+  param.table_id_ = TEST_TABLE_ID;
+  param.rowkey_cnt_ = TEST_ROWKEY_CNT;
+  param.schema_version_ = 1;
+  param.out_cols_ = &cd_.get_columns();
+  context.query_flag_ = query_flag;
+  context.store_ctx_ = &rctx;
+  context.allocator_ = &allocator_;
+  context.stmt_allocator_ = &allocator_;
+  context.block_cache_ws_ = &block_cache_ws;
+  context.is_inited_ = true;  // just for test case
+  range.set_whole_range();
+  range.set_table_id(TEST_TABLE_ID);
+  ObExtStoreRange ext_range(range);
+
+  ASSERT_EQ(OB_SUCCESS, mt.scan(param, context, ext_range, iter));
+  while (OB_SUCC(iter->get_next_row(row))) {
+    ObStoreRow copy;
+    ObObj* cells = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * row->row_val_.count_));
+    ASSERT_TRUE(NULL != cells);
+    copy.flag_ = row->flag_;
+    copy.row_val_.cells_ = cells;
+    copy.row_val_.count_ = row->row_val_.count_;
+    for (int64_t i = 0; i < row->row_val_.count_; ++i) {
+      ASSERT_EQ(OB_SUCCESS, ob_write_obj(allocator_, row->row_val_.cells_[i], cells[i]));
+    }
+    ASSERT_EQ(OB_SUCCESS, rows.push_back(copy));
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+  iter->~ObStoreRowIterator();
+  rctx.mem_ctx_->trans_end(true, TEST_TRANS_VERSION);
+  f_.free(rctx.mem_ctx_);
+}
+
+TEST_F(TestMemtableMultiSet, same_contents_as_row_by_row)
+{
+  ObMemtable mt;
+  ObMemtable batch_mt;
+  ObArray<ObStoreRow> rows;
+  ObArray<ObStoreRow> batch_rows;
+  init_memtable(mt);
+  init_memtable(batch_mt);
+
+  write_rows(mt, false);
+  write_rows(batch_mt, true);
+  scan_rows(mt, rows);
+  scan_rows(batch_mt, batch_rows);
+
+  ASSERT_EQ(TEST_ROW_CNT, rows.count());
+  ASSERT_EQ(rows.count(), batch_rows.count());
+  for (int64_t i = 0; i < rows.count(); ++i) {
+    const ObStoreRowkey rowkey(rows.at(i).row_val_.cells_, TEST_ROWKEY_CNT);
+    const ObStoreRowkey batch_rowkey(batch_rows.at(i).row_val_.cells_, TEST_ROWKEY_CNT);
+    if (i > 0) {
+      const ObStoreRowkey prev_rowkey(batch_rows.at(i - 1).row_val_.cells_, TEST_ROWKEY_CNT);
+      ASSERT_LT(prev_rowkey.compare(batch_rowkey), 0);
+    }
+    ASSERT_EQ(rows.at(i).flag_, batch_rows.at(i).flag_);
+    ASSERT_EQ(0, rowkey.compare(batch_rowkey));
+    ASSERT_EQ(rows.at(i).row_val_.count_, batch_rows.at(i).row_val_.count_);
+    for (int64_t j = 0; j < rows.at(i).row_val_.count_; ++j) {
+      ASSERT_EQ(rows.at(i).row_val_.cells_[j], batch_rows.at(i).row_val_.cells_[j]);
+    }
+  }
+
+  batch_mt.destroy();
+  mt.destroy();
+}
+
+TEST_F(TestMemtableMultiSet, invalid_row)
+{
+  ObMemtable mt;
+  ObStoreCtx wctx;
+  ObArray<ObITable*> tables;
+  init_memtable(mt);
+
+  rows_[TEST_ROW_CNT / 2].row_val_.cells_ = NULL;
+  wctx.tables_ = &tables;
+  wctx.mem_ctx_ = f_.alloc();
+  wctx.mem_ctx_->trans_begin();
+  wctx.mem_ctx_->sub_trans_begin(0, 1000000 + ObTimeUtility::current_time());
+  ASSERT_EQ(OB_INVALID_ARGUMENT,
+      mt.multi_set(wctx, TEST_TABLE_ID, TEST_ROWKEY_CNT, cd_.get_columns(), rows_, TEST_ROW_CNT));
+  wctx.mem_ctx_->trans_end(false, TEST_TRANS_VERSION);
+  f_.free(wctx.mem_ctx_);
+  mt.destroy();
+}
+
+int init_tenant_mgr()
+{
+  ObTenantManager& tm = ObTenantManager::get_instance();
+  ObAddr self;
+  self.set_ip_addr("127.0.0.1", 8086);
+  rpc::frame::ObReqTransport req_transport(NULL, NULL);
+  obrpc::ObSrvRpcProxy rpc_proxy;
+  obrpc::ObCommonRpcProxy rs_rpc_proxy;
+  share::ObRsMgr rs_mgr;
+  int ret = tm.init(self, rpc_proxy, rs_rpc_proxy, rs_mgr, &req_transport, &ObServerConfig::get_instance());
+  EXPECT_EQ(OB_SUCCESS, ret);
+  ret = tm.add_tenant(OB_SYS_TENANT_ID);
+  EXPECT_EQ(OB_SUCCESS, ret);
+  const int64_t ulmt = 16LL << 30;
+  const int64_t llmt = 8LL << 30;
+  ret = tm.set_tenant_mem_limit(OB_SYS_TENANT_ID, ulmt, llmt);
+  EXPECT_EQ(OB_SUCCESS, ret);
+  return OB_SUCCESS;
+}
+
+}  // namespace memtable
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_memtable_multi_set.log");
+  OB_LOGGER.set_file_name("test_memtable_multi_set.log");
+  OB_LOGGER.set_log_level("INFO");
+  oceanbase::memtable::init_tenant_mgr();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -12,9 +12,13 @@
 
 #include <gtest/gtest.h>
 #define private public
+#define protected public
 #include "storage/ob_multiple_merge.h"
+#include "storage/ob_multiple_get_merge.h"
 #include "storage/ob_sstable.h"
 #undef private
+#undef protected
+#include "mockcontainer/mock_ob_iterator.h"
 
 namespace oceanbase {
 using namespace common;
@@ -90,6 +94,84 @@ TEST_F(ObMultipleMergeTest, test_sort_sstables_overlap)
   ASSERT_EQ(OB_SUCCESS, ret);
 }
 
+TEST_F(ObMultipleMergeTest, test_sorted_get_nop_pos)
+{
+  const int64_t ROWKEY_CNT = 3;
+  const int64_t COL_CNT = 3;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObTableAccessContext access_ctx;
+  ObSEArray<ObExtStoreRowkey, ROWKEY_CNT> rowkeys;
+  ObObj rowkey_objs[ROWKEY_CNT];
+  ObObj cells[COL_CNT];
+  ObStoreRow row;
+  ObMockStoreRowIterator expect_iter;
+  const ObStoreRow* expect_row = NULL;
+  // rowkeys in the order of output, key 2, key 3, key 1
+  const int64_t sorted_rowkey_idxs[ROWKEY_CNT] = {2, 0, 1};
+  const int64_t nop_cnts[ROWKEY_CNT] = {0, 1, 2};
+  // rows of the sorted rowkeys, key 1, key 2, key 3
+  const char* newer_rows = "bigint bigint bigint flag  scan_index\n"
+                           "1      nop    nop    EXIST 0\n"
+                           "2      20     nop    EXIST 1\n"
+                           "3      nop    nop    EXIST 2\n";
+  const char* older_rows = "bigint bigint bigint flag  scan_index\n"
+                           "1      nop    nop    EXIST 0\n"
+                           "2      nop    21     EXIST 1\n"
+                           "3      nop    32     EXIST 2\n";
+  const char* expect_rows = "bigint bigint bigint flag\n"
+                            "2      20     21     EXIST\n"
+                            "3      nop    32     EXIST\n"
+                            "1      nop    nop    EXIST\n";
+
+  access_ctx.allocator_ = &allocator;
+  for (int64_t i = 0; i < ROWKEY_CNT; ++i) {
+    rowkey_objs[i].set_int((i + 1) % ROWKEY_CNT + 1);
+    ASSERT_EQ(OB_SUCCESS, rowkeys.push_back(ObExtStoreRowkey(ObStoreRowkey(&rowkey_objs[i], 1))));
+  }
+  row.row_val_.cells_ = cells;
+  row.capacity_ = COL_CNT;
+  ASSERT_EQ(OB_SUCCESS, expect_iter.from(expect_rows));
+
+  {
+    ObMultipleGetMerge merge;
+    ObMockStoreRowIterator* newer_iter = new (allocator.alloc(sizeof(ObMockStoreRowIterator))) ObMockStoreRowIterator();
+    ObMockStoreRowIterator* older_iter = new (allocator.alloc(sizeof(ObMockStoreRowIterator))) ObMockStoreRowIterator();
+    ASSERT_EQ(OB_SUCCESS, merge.iters_.push_back(newer_iter));
+    ASSERT_EQ(OB_SUCCESS, merge.iters_.push_back(older_iter));
+    ASSERT_EQ(OB_SUCCESS, newer_iter->from(newer_rows));
+    ASSERT_EQ(OB_SUCCESS, older_iter->from(older_rows));
+    ASSERT_EQ(OB_SUCCESS, merge.nop_pos_.init(allocator, COL_CNT));
+    merge.access_ctx_ = &access_ctx;
+    merge.rowkeys_ = &rowkeys;
+    merge.prefetch_cnt_ = ROWKEY_CNT;
+    merge.rows_ = new (allocator.alloc(sizeof(ObQueryRowInfo) * ROWKEY_CNT)) ObQueryRowInfo[ROWKEY_CNT];
+    for (int64_t i = 0; i < ROWKEY_CNT; ++i) {
+      ObQueryRowInfo& row_info = merge.rows_[i];
+      row_info.row_.row_val_.cells_ = new (allocator.alloc(sizeof(ObObj) * COL_CNT)) ObObj[COL_CNT];
+      row_info.row_.capacity_ = COL_CNT;
+      ASSERT_EQ(OB_SUCCESS, row_info.nop_pos_.init(allocator, COL_CNT));
+      merge.reuse_row(i, row_info);
+      ASSERT_EQ(OB_SUCCESS, merge.sorted_rowkey_idxs_.push_back(sorted_rowkey_idxs[i]));
+    }
+    merge.sorted_get_ = true;
+
+    // all rows are fused before the first one is output, the nop positions follow each output row
+    for (int64_t i = 0; i < ROWKEY_CNT; ++i) {
+      ASSERT_EQ(OB_SUCCESS, merge.inner_get_next_row_with_sorted_rowkeys(row));
+      ASSERT_EQ(OB_SUCCESS, expect_iter.get_next_row(expect_row));
+      ASSERT_TRUE(ObMockIterator::equals(*expect_row, row));
+      ASSERT_EQ(i, row.scan_index_);
+      ASSERT_EQ(nop_cnts[i], merge.nop_pos_.count());
+      for (int64_t j = 0; j < merge.nop_pos_.count(); ++j) {
+        int64_t pos = 0;
+        ASSERT_EQ(OB_SUCCESS, merge.nop_pos_.get_nop_pos(j, pos));
+        ASSERT_TRUE(row.row_val_.cells_[pos].is_nop_value());
+      }
+    }
+    ASSERT_EQ(OB_ITER_END, merge.inner_get_next_row_with_sorted_rowkeys(row));
+  }
+}
+
 }  // end namespace unittest
 }  // end namespace oceanbase
 
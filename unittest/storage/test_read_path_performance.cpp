@@ -0,0 +1,405 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "ob_sstable_test.h"
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/blocksstable/ob_micro_block_reader.h"
+#include "storage/blocksstable/ob_row_writer.h"
+#include "storage/blocksstable/ob_row_reader.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "storage/blocksstable/ob_fuse_row_cache.h"
+#include "storage/ob_row_fuse.h"
+
+namespace oceanbase {
+using namespace blocksstable;
+using namespace common;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+
+/*
+ * Micro benchmarks of the storage read path.
+ * Each case builds its input once, then runs the measured loop TEST_LOOP_CNT times and reports rows/s and
+ * ns/row to stdout and the log, so a read path change can be compared before and after on the same box.
+ */
+class TestReadPathPerformance : public ObSSTableTest {
+  public:
+  TestReadPathPerformance();
+  virtual ~TestReadPathPerformance();
+  virtual void SetUp();
+  virtual void TearDown();
+
+  protected:
+  static const int64_t TEST_ROW_CNT = 20000;
+  static const int64_t TEST_LOOP_CNT = 5;
+  static const int64_t TEST_MICRO_BLOCK_SIZE = 64 * 1024;
+  static const int64_t TEST_ROW_BUF_SIZE = 64 * 1024 * 1024;
+  static const int64_t TEST_FUSE_TABLE_CNT = 4;
+  void report(const char* case_name, const int64_t row_cnt, const int64_t cost_us);
+  void init_column_map(ObColumnMap& column_map);
+  void generate_rowkeys(const int64_t step, ObIArray<ObExtStoreRowkey>& rowkeys);
+  void run_sstable_get(const char* case_name, const ObIArray<ObExtStoreRowkey>& rowkeys);
+  void run_sstable_scan(const char* case_name);
+  void build_fuse_rows(const int64_t seed, ObStoreRow* rows);
+
+  protected:
+  ObArenaAllocator query_allocator_;
+  ObArenaAllocator key_allocator_;
+};
+
+TestReadPathPerformance::TestReadPathPerformance()
+    : ObSSTableTest("read_path_performance", 64 * 1024, 1000),
+      query_allocator_(ObModIds::TEST),
+      key_allocator_(ObModIds::TEST)
+{}
+
+TestReadPathPerformance::~TestReadPathPerformance()
+{}
+
+void TestReadPathPerformance::SetUp()
+{
+  TestDataFilePrepare::SetUp();
+  prepare_schema();
+  ASSERT_EQ(OB_SUCCESS, sstable_.init(table_key_));
+  ASSERT_EQ(OB_SUCCESS, sstable_.set_storage_file_handle(get_storage_file_handle()));
+  prepare_data(TEST_ROW_CNT, sstable_);
+  STORAGE_LOG(INFO, "sstable info", K(sstable_));
+}
+
+void TestReadPathPerformance::TearDown()
+{
+  destroy_query_param();
+  query_allocator_.reset();
+  key_allocator_.reset();
+  ObSSTableTest::TearDown();
+}
+
+void TestReadPathPerformance::report(const char* case_name, const int64_t row_cnt, const int64_t cost_us)
+{
+  const double rows_per_sec = cost_us > 0 ? static_cast<double>(row_cnt) * 1000000 / cost_us : 0;
+  const double ns_per_row = row_cnt > 0 ? static_cast<double>(cost_us) * 1000 / row_cnt : 0;
+  STORAGE_LOG(INFO, "read path performance", K(case_name), K(row_cnt), K(cost_us), K(rows_per_sec), K(ns_per_row));
+  fprintf(stdout,
+      "%-40s rows: %10ld cost: %10ld us %16.2f rows/s %12.2f ns/row\n",
+      case_name,
+      row_cnt,
+      cost_us,
+      rows_per_sec,
+      ns_per_row);
+}
+
+void TestReadPathPerformance::init_column_map(ObColumnMap& column_map)
+{
+  ASSERT_EQ(OB_SUCCESS, table_schema_.get_column_ids(columns_));
+  ASSERT_EQ(OB_SUCCESS,
+      column_map.init(allocator_,
+          table_schema_.get_schema_version(),
+          table_schema_.get_rowkey_column_num(),
+          TEST_COLUMN_CNT,
+          columns_));
+}
+
+void TestReadPathPerformance::generate_rowkeys(const int64_t step, ObIArray<ObExtStoreRowkey>& rowkeys)
+{
+  ObStoreRow row;
+  for (int64_t i = 0; i < row_cnt_; i += step) {
+    ObObj* cells = static_cast<ObObj*>(key_allocator_.alloc(sizeof(ObObj) * TEST_COLUMN_CNT));
+    ASSERT_TRUE(NULL != cells);
+    row.row_val_.assign(cells, TEST_COLUMN_CNT);
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    ObExtStoreRowkey ext_rowkey;
+    convert_rowkey(ObStoreRowkey(cells, TEST_ROWKEY_COLUMN_CNT), ext_rowkey, key_allocator_);
+    ASSERT_EQ(OB_SUCCESS, rowkeys.push_back(ext_rowkey));
+  }
+}
+
+void TestReadPathPerformance::run_sstable_get(const char* case_name, const ObIArray<ObExtStoreRowkey>& rowkeys)
+{
+  ObStoreRowIterator* getter = NULL;
+  const ObStoreRow* prow = NULL;
+  int64_t row_cnt = 0;
+  context_.allocator_ = &query_allocator_;
+  context_.stmt_allocator_ = &query_allocator_;
+  const int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < TEST_LOOP_CNT; ++loop) {
+    for (int64_t i = 0; i < rowkeys.count(); ++i) {
+      ASSERT_EQ(OB_SUCCESS, sstable_.get(param_, context_, rowkeys.at(i), getter));
+      ASSERT_EQ(OB_SUCCESS, getter->get_next_row(prow));
+      ASSERT_EQ(OB_ITER_END, getter->get_next_row(prow));
+      getter->~ObStoreRowIterator();
+      ++row_cnt;
+    }
+    query_allocator_.reuse();
+  }
+  report(case_name, row_cnt, ObTimeUtility::current_time() - start_time);
+}
+
+void TestReadPathPerformance::run_sstable_scan(const char* case_name)
+{
+  ObStoreRowIterator* scanner = NULL;
+  const ObStoreRow* prow = NULL;
+  ObStoreRange range;
+  ObExtStoreRange ext_range;
+  int64_t row_cnt = 0;
+  int ret = OB_SUCCESS;
+  range.set_whole_range();
+  convert_range(range, ext_range, key_allocator_);
+  context_.allocator_ = &query_allocator_;
+  context_.stmt_allocator_ = &query_allocator_;
+  const int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < TEST_LOOP_CNT; ++loop) {
+    ASSERT_EQ(OB_SUCCESS, sstable_.scan(param_, context_, ext_range, scanner));
+    while (OB_SUCC(ret = scanner->get_next_row(prow))) {
+      ++row_cnt;
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+    scanner->~ObStoreRowIterator();
+    query_allocator_.reuse();
+  }
+  report(case_name, row_cnt, ObTimeUtility::current_time() - start_time);
+  ASSERT_EQ(row_cnt_ * TEST_LOOP_CNT, row_cnt);
+}
+
+// rows[0] is the newest version from the active memtable and rows[TEST_FUSE_TABLE_CNT - 1] is the full row
+// of the major sstable, the incremental versions each update a disjoint part of the columns and keep nop
+// in the others, so every table has to be fused before the row is final
+void TestReadPathPerformance::build_fuse_rows(const int64_t seed, ObStoreRow* rows)
+{
+  ObStoreRow& base_row = rows[TEST_FUSE_TABLE_CNT - 1];
+  ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(seed, base_row));
+  for (int64_t i = 0; i < TEST_FUSE_TABLE_CNT - 1; ++i) {
+    ObStoreRow& row = rows[i];
+    row.flag_ = ObActionFlag::OP_ROW_EXIST;
+    row.row_val_.count_ = TEST_COLUMN_CNT;
+    for (int64_t j = 0; j < TEST_COLUMN_CNT; ++j) {
+      if (j % (TEST_FUSE_TABLE_CNT - 1) == i) {
+        row.row_val_.cells_[j] = base_row.row_val_.cells_[j];
+      } else {
+        row.row_val_.cells_[j].set_nop_value();
+      }
+    }
+  }
+}
+
+TEST_F(TestReadPathPerformance, micro_block_reader)
+{
+  ObMicroBlockWriter writer;
+  ObMicroBlockReader reader;
+  ObColumnMap column_map;
+  ObStoreRow row;
+  ObObj cells[TEST_COLUMN_CNT];
+  char* buf = NULL;
+  int64_t size = 0;
+  int64_t block_row_cnt = 0;
+  int ret = OB_SUCCESS;
+  row.row_val_.assign(cells, TEST_COLUMN_CNT);
+  ASSERT_EQ(OB_SUCCESS, writer.init(TEST_MICRO_BLOCK_SIZE, TEST_ROWKEY_COLUMN_CNT, TEST_COLUMN_CNT));
+  while (OB_SUCC(ret) && block_row_cnt < row_cnt_) {
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(block_row_cnt, row));
+    if (OB_SUCC(ret = writer.append_row(row))) {
+      ++block_row_cnt;
+    }
+  }
+  ASSERT_TRUE(OB_SUCCESS == ret || OB_BUF_NOT_ENOUGH == ret);
+  ASSERT_GT(block_row_cnt, 0);
+  ASSERT_EQ(OB_SUCCESS, writer.build_block(buf, size));
+  init_column_map(column_map);
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, reader.init(block, &column_map));
+
+  // single row
+  const int64_t loop_cnt = TEST_LOOP_CNT * (row_cnt_ / block_row_cnt + 1);
+  int64_t row_cnt = 0;
+  int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < loop_cnt; ++loop) {
+    for (int64_t i = 0; i < block_row_cnt; ++i) {
+      row.row_val_.count_ = TEST_COLUMN_CNT;
+      ASSERT_EQ(OB_SUCCESS, reader.get_row(i, row));
+      ++row_cnt;
+    }
+  }
+  report("micro block reader get_row", row_cnt, ObTimeUtility::current_time() - start_time);
+
+  // batch rows
+  const int64_t batch_capacity = ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT;
+  ObStoreRow batch_rows[batch_capacity];
+  ObObj* batch_cells = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * TEST_COLUMN_CNT * batch_capacity));
+  ASSERT_TRUE(NULL != batch_cells);
+  for (int64_t i = 0; i < batch_capacity; ++i) {
+    batch_rows[i].row_val_.assign(batch_cells + TEST_COLUMN_CNT * i, TEST_COLUMN_CNT);
+  }
+  row_cnt = 0;
+  start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < loop_cnt; ++loop) {
+    int64_t begin = 0;
+    while (begin < block_row_cnt) {
+      int64_t batch_cnt = 0;
+      ASSERT_EQ(OB_SUCCESS, reader.get_rows(begin, block_row_cnt, batch_capacity, batch_rows, batch_cnt));
+      ASSERT_GT(batch_cnt, 0);
+      begin += batch_cnt;
+      row_cnt += batch_cnt;
+    }
+  }
+  report("micro block reader get_rows", row_cnt, ObTimeUtility::current_time() - start_time);
+}
+
+TEST_F(TestReadPathPerformance, row_reader)
+{
+  ObRowWriter writer;
+  ObFlatRowReader reader;
+  ObColumnMap column_map;
+  ObStoreRow row;
+  ObObj cells[TEST_COLUMN_CNT];
+  ObArray<int64_t> row_pos;
+  int64_t pos = 0;
+  int64_t rowkey_start_pos = 0;
+  int64_t rowkey_end_pos = 0;
+  char* buf = static_cast<char*>(allocator_.alloc(TEST_ROW_BUF_SIZE));
+  ASSERT_TRUE(NULL != buf);
+  row.row_val_.assign(cells, TEST_COLUMN_CNT);
+  for (int64_t i = 0; i < row_cnt_; ++i) {
+    ASSERT_EQ(OB_SUCCESS, row_pos.push_back(pos));
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    ASSERT_EQ(OB_SUCCESS,
+        writer.write(TEST_ROWKEY_COLUMN_CNT, row, buf, TEST_ROW_BUF_SIZE, pos, rowkey_start_pos, rowkey_end_pos));
+  }
+  init_column_map(column_map);
+
+  int64_t row_cnt = 0;
+  const int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < TEST_LOOP_CNT; ++loop) {
+    for (int64_t i = 0; i < row_pos.count(); ++i) {
+      row.row_val_.count_ = TEST_COLUMN_CNT;
+      ASSERT_EQ(OB_SUCCESS, reader.read_row(buf, pos, row_pos.at(i), column_map, query_allocator_, row));
+      ++row_cnt;
+    }
+    query_allocator_.reuse();
+  }
+  report("row reader read_row", row_cnt, ObTimeUtility::current_time() - start_time);
+}
+
+TEST_F(TestReadPathPerformance, sstable_scan)
+{
+  ASSERT_EQ(OB_SUCCESS, prepare_query_param(false, -1));
+  destroy_all_cache();
+  run_sstable_scan("sstable scan");
+  destroy_query_param();
+  ASSERT_EQ(OB_SUCCESS, prepare_query_param(true, -1));
+  run_sstable_scan("sstable reverse scan");
+}
+
+TEST_F(TestReadPathPerformance, sstable_get)
+{
+  ObArray<ObExtStoreRowkey> rowkeys;
+  generate_rowkeys(1, rowkeys);
+  ASSERT_EQ(OB_SUCCESS, prepare_query_param(false, -1));
+
+  // every get decodes the row from the cached micro block
+  context_.query_flag_.set_not_use_row_cache();
+  destroy_all_cache();
+  run_sstable_get("sstable get, block cache", rowkeys);
+
+  // the first loop fills the row cache, the next ones hit it
+  context_.query_flag_.use_row_cache_ = ObQueryFlag::UseCache;
+  destroy_all_cache();
+  run_sstable_get("sstable get, row cache", rowkeys);
+}
+
+TEST_F(TestReadPathPerformance, fuse_row_cache)
+{
+  ObFuseRowCache& cache = OB_STORE_CACHE.get_fuse_row_cache();
+  const uint64_t table_id = table_schema_.get_table_id();
+  const int64_t partition_id = 0;
+  const int64_t snapshot_version = 20;
+  ObStoreRow row;
+  ObArray<ObStoreRowkey> rowkeys;
+  for (int64_t i = 0; i < row_cnt_; ++i) {
+    ObObj* key_cells = static_cast<ObObj*>(key_allocator_.alloc(sizeof(ObObj) * TEST_COLUMN_CNT));
+    ASSERT_TRUE(NULL != key_cells);
+    row.row_val_.assign(key_cells, TEST_COLUMN_CNT);
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    ObFuseRowCacheKey key(table_id, ObStoreRowkey(key_cells, TEST_ROWKEY_COLUMN_CNT));
+    ObFuseRowCacheValue value;
+    ObFastQueryContext fq_ctx;
+    ASSERT_EQ(OB_SUCCESS, value.init(row, table_schema_.get_schema_version(), snapshot_version, partition_id, 0, fq_ctx));
+    ASSERT_EQ(OB_SUCCESS, cache.put_row(key, value));
+    ASSERT_EQ(OB_SUCCESS, rowkeys.push_back(ObStoreRowkey(key_cells, TEST_ROWKEY_COLUMN_CNT)));
+  }
+
+  int64_t row_cnt = 0;
+  int64_t hit_cnt = 0;
+  const int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < TEST_LOOP_CNT; ++loop) {
+    for (int64_t i = 0; i < rowkeys.count(); ++i) {
+      ObFuseRowCacheKey key(table_id, rowkeys.at(i));
+      ObFuseRowValueHandle handle;
+      if (OB_SUCCESS == cache.get_row(key, partition_id, handle)) {
+        ++hit_cnt;
+      }
+      ++row_cnt;
+    }
+  }
+  report("fuse row cache get", row_cnt, ObTimeUtility::current_time() - start_time);
+  STORAGE_LOG(INFO, "fuse row cache hit", K(hit_cnt), K(row_cnt));
+}
+
+TEST_F(TestReadPathPerformance, row_fuse)
+{
+  ObStoreRow rows[TEST_FUSE_TABLE_CNT];
+  ObStoreRow* result = NULL;
+  ObNopPos nop_pos;
+  ObObj* cells = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * TEST_COLUMN_CNT * TEST_FUSE_TABLE_CNT));
+  ASSERT_TRUE(NULL != cells);
+  for (int64_t i = 0; i < TEST_FUSE_TABLE_CNT; ++i) {
+    rows[i].row_val_.assign(cells + TEST_COLUMN_CNT * i, TEST_COLUMN_CNT);
+  }
+  ASSERT_EQ(OB_SUCCESS, malloc_store_row(allocator_, TEST_COLUMN_CNT, result));
+  ASSERT_EQ(OB_SUCCESS, nop_pos.init(allocator_, TEST_COLUMN_CNT));
+
+  // fuse each generated row many times, so the timer overhead is negligible
+  const int64_t fuse_loop_cnt = TEST_LOOP_CNT * 20;
+  int64_t row_cnt = 0;
+  int64_t cost_us = 0;
+  for (int64_t seed = 0; seed < row_cnt_; ++seed) {
+    build_fuse_rows(seed, rows);
+    const int64_t start_time = ObTimeUtility::current_time();
+    for (int64_t loop = 0; loop < fuse_loop_cnt; ++loop) {
+      bool final_result = false;
+      nop_pos.reset();
+      result->row_val_.count_ = 0;
+      result->flag_ = ObActionFlag::OP_ROW_DOES_NOT_EXIST;
+      for (int64_t i = 0; i < TEST_FUSE_TABLE_CNT && !final_result; ++i) {
+        ASSERT_EQ(OB_SUCCESS, ObRowFuse::fuse_row(rows[i], *result, nop_pos, final_result));
+      }
+      ASSERT_TRUE(final_result);
+      ++row_cnt;
+    }
+    cost_us += ObTimeUtility::current_time() - start_time;
+  }
+  report("row fuse across memtables and sstable", row_cnt, cost_us);
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_read_path_performance.log*");
+  OB_LOGGER.set_file_name("test_read_path_performance.log");
+  OB_LOGGER.set_log_level("INFO");
+  STORAGE_LOG(INFO, "begin unittest: test_read_path_performance");
+  oceanbase::lib::set_memory_limit(30L * 1024 * 1024 * 1024);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
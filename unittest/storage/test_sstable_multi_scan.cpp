@@ -11,6 +11,11 @@
  */
 
 #include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/ob_sstable_row_iterator.h"
+#undef private
+#undef protected
 #include "ob_sstable_test.h"
 #include "lib/container/ob_array_iterator.h"
 
@@ -41,6 +46,11 @@ class TestSSTableMultiScanner : public ObSSTableTest {
   void test_multi_block_read_small_io(const bool is_reverse_scan, const int64_t limit);
   void test_multi_block_read_big_continue_io(const bool is_reverse_scan, const int64_t limit);
   void test_multi_block_read_big_discrete_io(const bool is_reverse_scan, const int64_t limit);
+  // scan ranges of [start_seeds[i], start_seeds[i] + counts[i]) without cache and check the rows, trace the
+  // prefetch micro depth and the most micro blocks read by one io.
+  void scan_with_prefetch_trace(const ObIArray<int64_t>& start_seeds, const ObIArray<int64_t>& counts,
+      const bool is_reverse_scan, int64_t& max_depth, bool& depth_shrunk, int64_t& max_io_micro_cnt);
+  void test_prefetch_depth(const bool is_reverse_scan);
 };
 
 TestSSTableMultiScanner::TestSSTableMultiScanner() : ObSSTableTest("multi_scan_sstable")
@@ -628,6 +638,129 @@ void TestSSTableMultiScanner::test_multi_block_read_big_discrete_io(const bool i
   destroy_query_param();
 }
 
+void TestSSTableMultiScanner::scan_with_prefetch_trace(const ObIArray<int64_t>& start_seeds,
+    const ObIArray<int64_t>& counts, const bool is_reverse_scan, int64_t& max_depth, bool& depth_shrunk,
+    int64_t& max_io_micro_cnt)
+{
+  static const int64_t MAX_RANGE_CNT = 64;
+  int ret = OB_SUCCESS;
+  ObStoreRange mscan_ranges[MAX_RANGE_CNT];
+  ObObj mscan_start_cells[MAX_RANGE_CNT][TEST_COLUMN_CNT];
+  ObObj mscan_end_cells[MAX_RANGE_CNT][TEST_COLUMN_CNT];
+  ObStoreRow mscan_start_rows[MAX_RANGE_CNT];
+  ObStoreRow mscan_end_rows[MAX_RANGE_CNT];
+  ObArray<ObStoreRange> ranges;
+  ObArray<ObExtStoreRange> ext_ranges;
+  ObObj check_cells[TEST_COLUMN_CNT];
+  ObStoreRow check_row;
+  ObStoreRowIterator* scanner = nullptr;
+  const ObStoreRow* prow = NULL;
+  int64_t last_depth = 0;
+  max_depth = 0;
+  depth_shrunk = false;
+  max_io_micro_cnt = 0;
+
+  ASSERT_LE(start_seeds.count(), MAX_RANGE_CNT);
+  ASSERT_EQ(start_seeds.count(), counts.count());
+  for (int64_t i = 0; i < start_seeds.count(); ++i) {
+    mscan_start_rows[i].row_val_.assign(mscan_start_cells[i], TEST_COLUMN_CNT);
+    mscan_end_rows[i].row_val_.assign(mscan_end_cells[i], TEST_COLUMN_CNT);
+    mscan_ranges[i].get_start_key().assign(mscan_start_cells[i], TEST_ROWKEY_COLUMN_CNT);
+    mscan_ranges[i].get_end_key().assign(mscan_end_cells[i], TEST_ROWKEY_COLUMN_CNT);
+    mscan_ranges[i].get_border_flag().set_inclusive_start();
+    mscan_ranges[i].get_border_flag().set_inclusive_end();
+    ret = row_generate_.get_next_row(start_seeds.at(i), mscan_start_rows[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ret = row_generate_.get_next_row(start_seeds.at(i) + counts.at(i) - 1, mscan_end_rows[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ret = ranges.push_back(mscan_ranges[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  destroy_all_cache();
+  convert_range(ranges, ext_ranges, allocator_);
+  ret = sstable_.multi_scan(param_, context_, ext_ranges, scanner);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ObSSTableRowIterator* iter = static_cast<ObSSTableRowIterator*>(scanner);
+  for (int64_t i = 0; i < start_seeds.count(); ++i) {
+    for (int64_t j = 0; j < counts.at(i); ++j) {
+      const int64_t k = is_reverse_scan ? start_seeds.at(i) + counts.at(i) - j - 1 : start_seeds.at(i) + j;
+      check_row.row_val_.assign(check_cells, TEST_COLUMN_CNT);
+      ret = row_generate_.get_next_row(k, check_row);
+      ASSERT_EQ(OB_SUCCESS, ret);
+      ret = scanner->get_next_row(prow);
+      ASSERT_EQ(OB_SUCCESS, ret) << "range: " << i << " k: " << k;
+      ASSERT_TRUE(check_row.row_val_ == prow->row_val_) << "range: " << i << " k: " << k;
+
+      const int64_t depth = iter->prefetch_micro_depth_;
+      ASSERT_GE(depth, ObSSTableRowIterator::DEFAULT_PREFETCH_MICRO_DEPTH);
+      ASSERT_LE(depth, iter->micro_handle_cnt_);
+      depth_shrunk = depth_shrunk || depth < last_depth;
+      max_depth = std::max(max_depth, depth);
+      last_depth = depth;
+      // block index is the index of the micro block in a multi block io
+      for (int64_t h = 0; h < iter->micro_handle_cnt_; ++h) {
+        const ObMicroBlockDataHandle& micro_handle = iter->micro_handles_[h];
+        if (ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_) {
+          max_io_micro_cnt = std::max(max_io_micro_cnt, static_cast<int64_t>(micro_handle.block_index_) + 1);
+        }
+      }
+    }
+  }
+  ret = scanner->get_next_row(prow);
+  ASSERT_EQ(OB_ITER_END, ret);
+  scanner->~ObStoreRowIterator();
+}
+
+void TestSSTableMultiScanner::test_prefetch_depth(const bool is_reverse_scan)
+{
+  int ret = OB_SUCCESS;
+  ObArray<int64_t> seeds;
+  ObArray<int64_t> counts;
+  int64_t max_depth = 0;
+  bool depth_shrunk = false;
+  int64_t max_io_micro_cnt = 0;
+  // big enough to coalesce the adjacent micro blocks of a macro block
+  GCONF.multiblock_read_size = 512 * 1024;
+  GCONF.multiblock_read_gap_size = 0;
+  ret = prepare_query_param(is_reverse_scan, -1);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  // sequential, read ahead goes deeper and the adjacent micro blocks are read by one io
+  ASSERT_EQ(OB_SUCCESS, seeds.push_back(0));
+  ASSERT_EQ(OB_SUCCESS, counts.push_back(row_cnt_));
+  scan_with_prefetch_trace(seeds, counts, is_reverse_scan, max_depth, depth_shrunk, max_io_micro_cnt);
+  ASSERT_GT(max_depth, ObSSTableRowIterator::DEFAULT_PREFETCH_MICRO_DEPTH);
+  ASSERT_FALSE(depth_shrunk);
+  ASSERT_GT(max_io_micro_cnt, 2);
+
+  // random, short ranges far from each other are read by separate io, one io reads at most the
+  // two micro blocks of one range
+  seeds.reuse();
+  counts.reuse();
+  for (int64_t i = 0; i < row_cnt_ - 2; i += 100) {
+    ASSERT_EQ(OB_SUCCESS, seeds.push_back(i));
+    ASSERT_EQ(OB_SUCCESS, counts.push_back(2));
+  }
+  std::random_shuffle(seeds.begin(), seeds.end());
+  scan_with_prefetch_trace(seeds, counts, is_reverse_scan, max_depth, depth_shrunk, max_io_micro_cnt);
+  ASSERT_LE(max_io_micro_cnt, 2);
+
+  // sequential then random, the depth grows and shrinks back while the rows stay the same
+  seeds.reuse();
+  counts.reuse();
+  ASSERT_EQ(OB_SUCCESS, seeds.push_back(0));
+  ASSERT_EQ(OB_SUCCESS, counts.push_back(row_cnt_ / 2));
+  for (int64_t i = row_cnt_ / 2 + 100; i < row_cnt_ - 2; i += 100) {
+    ASSERT_EQ(OB_SUCCESS, seeds.push_back(i));
+    ASSERT_EQ(OB_SUCCESS, counts.push_back(2));
+  }
+  std::random_shuffle(seeds.begin() + 1, seeds.end());
+  scan_with_prefetch_trace(seeds, counts, is_reverse_scan, max_depth, depth_shrunk, max_io_micro_cnt);
+  ASSERT_GT(max_depth, ObSSTableRowIterator::DEFAULT_PREFETCH_MICRO_DEPTH);
+  ASSERT_TRUE(depth_shrunk);
+  destroy_query_param();
+}
+
 TEST_F(TestSSTableMultiScanner, test_single_get_normal)
 {
   const bool is_reverse_scan = false;
@@ -1311,6 +1444,16 @@ TEST_F(TestSSTableMultiScanner, test_skip_multiple_range_reverse_scan)
   test_skip_range(start_seeds, count_per_range, true, skip_infos);
 }
 
+TEST_F(TestSSTableMultiScanner, test_prefetch_depth)
+{
+  test_prefetch_depth(false);
+}
+
+TEST_F(TestSSTableMultiScanner, test_prefetch_depth_reverse_scan)
+{
+  test_prefetch_depth(true);
+}
+
 }  // end namespace unittest
 }  // end namespace oceanbase
 